@@ -0,0 +1,17 @@
+
+if [[ ! -d "build_bench/" ]]
+then
+    echo "creating build_bench dir"
+    mkdir build_bench
+fi
+
+cd build_bench
+
+cmake .. -DBENCHMARKS=On -DCMAKE_BUILD_TYPE=Release
+
+make FramingBench DelimiterSearchBench TransportBench SocketDriverBench
+
+./sw/data_manager/benchmarks/DelimiterSearchBench
+./sw/data_manager/benchmarks/FramingBench
+./sw/data_manager/benchmarks/TransportBench
+./sw/data_manager/benchmarks/SocketDriverBench --benchmark_out=socket_driver_bench.json --benchmark_out_format=json
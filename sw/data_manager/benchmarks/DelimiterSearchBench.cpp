@@ -0,0 +1,90 @@
+#include "benchmark/benchmark.h"
+
+#include "DelimiterSearch.h"
+#include <algorithm>
+#include <random>
+/* ============================= */
+/**
+ * @file DelimiterSearchBench.cpp
+ *
+ * @brief Throughput of delimiter search kernels compared with std::find() loop.
+ *
+ * @details Buffer has size of the SocketDriver receive store, argument is the average frame size.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace delimiter_search;
+
+namespace
+{
+const size_t BENCH_BUFFER_SIZE = 4096;
+const uint8_t BENCH_DELIMITER = '\n';
+
+std::vector<uint8_t> make_buffer(size_t frame_size)
+{
+   std::mt19937 rng (1234);
+   std::uniform_int_distribution<int> byte (0, 255);
+   std::vector<uint8_t> result (BENCH_BUFFER_SIZE);
+   for (size_t i = 0; i < result.size(); i++)
+   {
+      do
+      {
+         result[i] = byte(rng);
+      } while (result[i] == BENCH_DELIMITER);
+      if ((i % frame_size) == (frame_size - 1))
+      {
+         result[i] = BENCH_DELIMITER;
+      }
+   }
+   return result;
+}
+}
+
+static void BM_StdFind(benchmark::State& state)
+{
+   const std::vector<uint8_t> buffer = make_buffer(state.range(0));
+   std::vector<size_t> positions;
+   positions.reserve(BENCH_BUFFER_SIZE);
+   for (auto _ : state)
+   {
+      positions.clear();
+      auto it = std::find(buffer.begin(), buffer.end(), BENCH_DELIMITER);
+      while (it != buffer.end())
+      {
+         positions.push_back(it - buffer.begin());
+         it = std::find(it + 1, buffer.end(), BENCH_DELIMITER);
+      }
+      benchmark::DoNotOptimize(positions.data());
+   }
+   state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+static void BM_Kernel(benchmark::State& state, Kernel kernel)
+{
+   if (!isSupported(kernel))
+   {
+      state.SkipWithError("kernel not supported");
+      return;
+   }
+   const std::vector<uint8_t> buffer = make_buffer(state.range(0));
+   std::vector<size_t> positions;
+   positions.reserve(BENCH_BUFFER_SIZE);
+   for (auto _ : state)
+   {
+      positions.clear();
+      benchmark::DoNotOptimize(findAll(kernel, buffer.data(), buffer.size(), BENCH_DELIMITER, positions));
+      benchmark::DoNotOptimize(positions.data());
+   }
+   state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+/* 9 bytes - env sensor notification, 64 - biggest accepted payload, 1000 - close to SOCKDRV_MAX_RW_SIZE */
+BENCHMARK(BM_StdFind)->Arg(9)->Arg(64)->Arg(1000);
+BENCHMARK_CAPTURE(BM_Kernel, scalar, Kernel::SCALAR)->Arg(9)->Arg(64)->Arg(1000);
+BENCHMARK_CAPTURE(BM_Kernel, sse2, Kernel::SSE2)->Arg(9)->Arg(64)->Arg(1000);
+BENCHMARK_CAPTURE(BM_Kernel, avx2, Kernel::AVX2)->Arg(9)->Arg(64)->Arg(1000);
+BENCHMARK_CAPTURE(BM_Kernel, neon, Kernel::NEON)->Arg(9)->Arg(64)->Arg(1000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,135 @@
+#include "benchmark/benchmark.h"
+
+#include "FrameAssembler.h"
+#include "Cobs.h"
+#include <random>
+#include <string.h>
+/* ============================= */
+/**
+ * @file FramingBench.cpp
+ *
+ * @brief Throughput of receive path framing modes and COBS codec.
+ *
+ * @details Stream of frames with notification-like sizes is passed to FrameAssembler in recv()-sized chunks.
+ *          Delimiter stream does not contain delimiter in payload - otherwise frames would be split.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+namespace
+{
+const size_t BENCH_FRAMES_COUNT = 4096;
+const size_t BENCH_STORE_SIZE = 4096;
+const uint8_t BENCH_DELIMITER = '\n';
+
+std::vector<uint8_t> random_payload(std::mt19937& rng, size_t size, bool allow_delimiter)
+{
+   std::uniform_int_distribution<int> byte (0, 255);
+   std::vector<uint8_t> result (size);
+   for (auto& b : result)
+   {
+      do
+      {
+         b = byte(rng);
+      } while (!allow_delimiter && b == BENCH_DELIMITER);
+   }
+   return result;
+}
+std::vector<uint8_t> make_stream(FramingMode mode, size_t frame_size)
+{
+   std::mt19937 rng (1234);
+   std::vector<uint8_t> result;
+   std::vector<uint8_t> encoded (frame_size + COBS_MAX_OVERHEAD(frame_size));
+   for (size_t i = 0; i < BENCH_FRAMES_COUNT; i++)
+   {
+      std::vector<uint8_t> frame = random_payload(rng, frame_size, mode == FramingMode::COBS);
+      if (mode == FramingMode::COBS)
+      {
+         size_t size = cobs::encode(frame.data(), frame.size(), encoded.data());
+         result.insert(result.end(), encoded.begin(), encoded.begin() + size);
+         result.push_back(COBS_DELIMITER);
+      }
+      else
+      {
+         result.insert(result.end(), frame.begin(), frame.end());
+         result.push_back(BENCH_DELIMITER);
+      }
+   }
+   return result;
+}
+void receive_stream(benchmark::State& state, FramingMode mode)
+{
+   const std::vector<uint8_t> stream = make_stream(mode, state.range(0));
+   FrameAssembler assembler (BENCH_STORE_SIZE);
+   assembler.setDelimiter(BENCH_DELIMITER);
+   assembler.setFraming(mode);
+   size_t frames = 0;
+   for (auto _ : state)
+   {
+      size_t pos = 0;
+      while (pos < stream.size())
+      {
+         size_t chunk = std::min(assembler.writeSpace(), stream.size() - pos);
+         memcpy(assembler.writePtr(), stream.data() + pos, chunk);
+         pos += chunk;
+         size_t count = assembler.commit(chunk);
+         for (size_t i = 0; i < count; i++)
+         {
+            benchmark::DoNotOptimize(assembler.frames()[i].data[0]);
+         }
+         frames += count;
+         assembler.release();
+      }
+   }
+   state.SetBytesProcessed(state.iterations() * stream.size());
+   state.counters["frames"] = benchmark::Counter(frames, benchmark::Counter::kIsRate);
+}
+}
+
+static void BM_ReceiveDelimiter(benchmark::State& state)
+{
+   receive_stream(state, FramingMode::DELIMITER);
+}
+static void BM_ReceiveCobs(benchmark::State& state)
+{
+   receive_stream(state, FramingMode::COBS);
+}
+static void BM_CobsEncode(benchmark::State& state)
+{
+   std::mt19937 rng (1234);
+   const std::vector<uint8_t> data = random_payload(rng, state.range(0), true);
+   std::vector<uint8_t> encoded (data.size() + COBS_MAX_OVERHEAD(data.size()));
+   for (auto _ : state)
+   {
+      benchmark::DoNotOptimize(cobs::encode(data.data(), data.size(), encoded.data()));
+      benchmark::ClobberMemory();
+   }
+   state.SetBytesProcessed(state.iterations() * data.size());
+}
+static void BM_CobsDecode(benchmark::State& state)
+{
+   std::mt19937 rng (1234);
+   const std::vector<uint8_t> data = random_payload(rng, state.range(0), true);
+   std::vector<uint8_t> encoded (data.size() + COBS_MAX_OVERHEAD(data.size()));
+   encoded.resize(cobs::encode(data.data(), data.size(), encoded.data()));
+   std::vector<uint8_t> buffer (encoded.size());
+   size_t decoded_size = 0;
+   for (auto _ : state)
+   {
+      /* decoding is done in place, so encoded data is restored every iteration */
+      memcpy(buffer.data(), encoded.data(), encoded.size());
+      benchmark::DoNotOptimize(cobs::decode(buffer.data(), buffer.size(), decoded_size));
+      benchmark::ClobberMemory();
+   }
+   state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+/* 9 bytes - env sensor notification, 64 - biggest accepted payload, 1000 - close to SOCKDRV_MAX_RW_SIZE */
+BENCHMARK(BM_ReceiveDelimiter)->Arg(9)->Arg(64)->Arg(1000);
+BENCHMARK(BM_ReceiveCobs)->Arg(9)->Arg(64)->Arg(1000);
+BENCHMARK(BM_CobsEncode)->Arg(9)->Arg(64)->Arg(1000);
+BENCHMARK(BM_CobsDecode)->Arg(9)->Arg(64)->Arg(1000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,208 @@
+#include "benchmark/benchmark.h"
+
+#include "SocketDriver.h"
+#include "Logger.h"
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <algorithm>
+#include <thread>
+/* ============================= */
+/**
+ * @file SocketDriverBench.cpp
+ *
+ * @brief Receive path throughput, latency and CPU cost of SocketDriver over TCP loopback.
+ *
+ * @details Benchmark thread plays the server - it sends burst of frames and waits until all of them are delivered
+ *          to listeners by the driver thread. Arguments are frame size (with delimiter), burst size and number
+ *          of listeners. Reported counters:
+ *          - frames_per_second - delivered frames,
+ *          - latency_p50_ns, latency_p99_ns, latency_max_ns - time from send() of the burst to delivery of each frame,
+ *          - cpu_ns_per_frame - user and system time of the whole process (server, driver) divided by frames.
+ *          For comparison of driver changes run with --benchmark_out=<file> --benchmark_out_format=json.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+namespace
+{
+const uint8_t BENCH_DELIMITER = '\n';
+
+struct CountingListener : public SocketListener
+{
+   void onSocketEvent(DriverEvent, const std::vector<uint8_t>&, size_t) override {}
+   void onSocketFrames(const FrameView*, size_t count) override
+   {
+      m_frames.fetch_add(count, std::memory_order_release);
+   }
+   std::atomic<size_t> m_frames {0};
+};
+
+/* first listener - measures latency of every delivered frame */
+struct LatencyListener : public CountingListener
+{
+   void onSocketFrames(const FrameView* frames, size_t count) override
+   {
+      const int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+      const int64_t sent = m_send_time.load(std::memory_order_acquire);
+      m_latencies.insert(m_latencies.end(), count, now - sent);
+      CountingListener::onSocketFrames(frames, count);
+   }
+   std::atomic<int64_t> m_send_time {0};
+   std::vector<int64_t> m_latencies;
+};
+
+int64_t cpu_time_ns()
+{
+   struct rusage usage = {};
+   getrusage(RUSAGE_SELF, &usage);
+   return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000000LL +
+          (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1000LL;
+}
+
+bool send_all(int fd, const std::vector<uint8_t>& data)
+{
+   size_t sent = 0;
+   while (sent < data.size())
+   {
+      ssize_t result = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+      if (result <= 0)
+      {
+         return false;
+      }
+      sent += result;
+   }
+   return true;
+}
+
+/* returns listening socket on loopback, port is written to the argument */
+int listen_loopback(uint16_t& port)
+{
+   struct sockaddr_in addr = {};
+   socklen_t len = sizeof(addr);
+   addr.sin_family = AF_INET;
+   addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+   int fd = socket(AF_INET, SOCK_STREAM, 0);
+   bind(fd, (struct sockaddr*)&addr, sizeof(addr));
+   getsockname(fd, (struct sockaddr*)&addr, &len);
+   listen(fd, 1);
+   port = ntohs(addr.sin_port);
+   return fd;
+}
+
+void receive_frames(benchmark::State& state, SocketBackend backend)
+{
+   const size_t frame_size = state.range(0);
+   const size_t burst_size = state.range(1);
+   const size_t listeners_count = state.range(2);
+   SocketDriver driver (backend);
+   ISocketDriver& drv = driver;
+   LatencyListener latency_listener;
+   std::vector<CountingListener> listeners (listeners_count - 1);
+   drv.addListener(&latency_listener);
+   for (CountingListener& listener : listeners)
+   {
+      drv.addListener(&listener);
+   }
+   drv.setDelimiter(BENCH_DELIMITER);
+   uint16_t port = 0;
+   int listen_fd = listen_loopback(port);
+   /* connection is completed by kernel before it is accepted */
+   int server_fd = drv.connect("127.0.0.1", port)? accept(listen_fd, nullptr, nullptr) : -1;
+   if (server_fd < 0)
+   {
+      state.SkipWithError("cannot connect");
+   }
+   else
+   {
+      std::vector<uint8_t> burst (frame_size * burst_size, 'a');
+      for (size_t i = 1; i <= burst_size; i++)
+      {
+         burst[i * frame_size - 1] = BENCH_DELIMITER;
+      }
+      latency_listener.m_latencies.reserve(1024 * 1024);
+      size_t expected = 0;
+      const int64_t cpu_start = cpu_time_ns();
+      for (auto _ : state)
+      {
+         latency_listener.m_send_time.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_release);
+         if (!send_all(server_fd, burst))
+         {
+            state.SkipWithError("cannot send");
+            break;
+         }
+         expected += burst_size;
+         while (latency_listener.m_frames.load(std::memory_order_acquire) != expected)
+         {
+            std::this_thread::yield();
+         }
+      }
+      const int64_t cpu_used = cpu_time_ns() - cpu_start;
+      std::vector<int64_t>& latencies = latency_listener.m_latencies;
+      if (!latencies.empty())
+      {
+         std::sort(latencies.begin(), latencies.end());
+         state.counters["latency_p50_ns"] = latencies[latencies.size() / 2];
+         state.counters["latency_p99_ns"] = latencies[latencies.size() * 99 / 100];
+         state.counters["latency_max_ns"] = latencies.back();
+         state.counters["cpu_ns_per_frame"] = static_cast<double>(cpu_used) / expected;
+      }
+      state.counters["frames_per_second"] = benchmark::Counter(expected, benchmark::Counter::kIsRate);
+      state.SetBytesProcessed(expected * frame_size);
+   }
+   drv.disconnect();
+   for (CountingListener& listener : listeners)
+   {
+      drv.removeListener(&listener);
+   }
+   drv.removeListener(&latency_listener);
+   if (server_fd >= 0)
+   {
+      close(server_fd);
+   }
+   close(listen_fd);
+}
+
+/* frame size, burst size, listeners count */
+void receive_args(benchmark::internal::Benchmark* bench)
+{
+   bench->ArgNames({"frame", "burst", "listeners"});
+   for (int64_t frame : {16, 64, 256})
+   {
+      for (int64_t burst : {1, 16, 128})
+      {
+         for (int64_t listeners : {1, 4})
+         {
+            bench->Args({frame, burst, listeners});
+         }
+      }
+   }
+}
+}
+
+static void BM_ReceiveSyscall(benchmark::State& state)
+{
+   receive_frames(state, SocketBackend::SYSCALL);
+}
+static void BM_ReceiveUring(benchmark::State& state)
+{
+   receive_frames(state, SocketBackend::URING);
+}
+
+BENCHMARK(BM_ReceiveSyscall)->Apply(receive_args)->UseRealTime();
+BENCHMARK(BM_ReceiveUring)->Apply(receive_args)->UseRealTime();
+
+int main(int argc, char** argv)
+{
+   /* per-frame driver logs would dominate the measured time */
+   logger_initialize();
+   logger_set_group_state(LOG_SOCKDRV, LOGGER_GROUP_DISABLE);
+   benchmark::Initialize(&argc, argv);
+   benchmark::RunSpecifiedBenchmarks();
+   logger_deinitialize();
+   return 0;
+}
@@ -0,0 +1,230 @@
+#include "benchmark/benchmark.h"
+
+#include "SocketDriver.h"
+#include "ShmDriver.h"
+#include "EventLoop.h"
+#include "Logger.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <thread>
+/* ============================= */
+/**
+ * @file TransportBench.cpp
+ *
+ * @brief Round trip latency of TCP loopback, Unix domain socket and shared memory transports,
+ *        socket transports with both system call and io_uring backends.
+ *
+ * @details Echo server runs in separate thread and sends back every received byte. Client sends one frame
+ *          through the driver and spins until the echoed frame is delivered to the listener.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+namespace
+{
+const uint8_t BENCH_DELIMITER = '\n';
+const char* BENCH_SHM_NAME = "/smarthome_bench";
+const char* BENCH_UNIX_PATH = "/tmp/smarthome_bench.sock";
+
+struct EchoListener : public SocketListener
+{
+   void onSocketEvent(DriverEvent, const std::vector<uint8_t>&, size_t) override {}
+   void onSocketFrames(const FrameView*, size_t count) override
+   {
+      m_frames.fetch_add(count, std::memory_order_release);
+   }
+   std::atomic<size_t> m_frames {0};
+};
+
+class SocketEchoServer
+{
+public:
+   /* returns TCP port or 0 for Unix socket */
+   uint16_t start(bool unix_socket)
+   {
+      uint16_t port = 0;
+      if (unix_socket)
+      {
+         struct sockaddr_un addr = {};
+         addr.sun_family = AF_UNIX;
+         strncpy(addr.sun_path, BENCH_UNIX_PATH, sizeof(addr.sun_path) - 1);
+         unlink(BENCH_UNIX_PATH);
+         m_listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+         bind(m_listen_fd, (struct sockaddr*)&addr, sizeof(addr));
+      }
+      else
+      {
+         struct sockaddr_in addr = {};
+         socklen_t len = sizeof(addr);
+         addr.sin_family = AF_INET;
+         addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+         m_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+         bind(m_listen_fd, (struct sockaddr*)&addr, sizeof(addr));
+         getsockname(m_listen_fd, (struct sockaddr*)&addr, &len);
+         port = ntohs(addr.sin_port);
+      }
+      listen(m_listen_fd, 1);
+      m_thread = std::thread([this]()
+      {
+         uint8_t buffer[4096];
+         int fd = accept(m_listen_fd, nullptr, nullptr);
+         ssize_t bytes;
+         while ((bytes = recv(fd, buffer, sizeof(buffer), 0)) > 0)
+         {
+            send(fd, buffer, bytes, 0);
+         }
+         close(fd);
+      });
+      return port;
+   }
+   /* driver disconnection ends the echo loop, shutdown() wakes up accept() if driver did not connect */
+   void stop()
+   {
+      shutdown(m_listen_fd, SHUT_RDWR);
+      m_thread.join();
+      close(m_listen_fd);
+      unlink(BENCH_UNIX_PATH);
+   }
+private:
+   int m_listen_fd;
+   std::thread m_thread;
+};
+
+class ShmEchoServer
+{
+public:
+   void start()
+   {
+      m_channel.create(BENCH_SHM_NAME);
+      m_running = true;
+      m_thread = std::thread([this]()
+      {
+         uint8_t buffer[4096];
+         while (m_running)
+         {
+            size_t bytes = m_channel.read(buffer, sizeof(buffer));
+            if (bytes > 0)
+            {
+               m_channel.write(buffer, bytes);
+            }
+            else
+            {
+               m_channel.waitReadable(std::chrono::milliseconds(100));
+            }
+         }
+      });
+   }
+   void stop()
+   {
+      m_running = false;
+      m_channel.wakeup();
+      m_thread.join();
+      m_channel.close();
+   }
+private:
+   ShmChannel m_channel;
+   std::atomic<bool> m_running;
+   std::thread m_thread;
+};
+
+void round_trip(benchmark::State& state, ISocketDriver& driver, EchoListener& listener)
+{
+   std::vector<uint8_t> frame (state.range(0), 'a');
+   frame.back() = BENCH_DELIMITER;
+   size_t expected = listener.m_frames.load();
+   for (auto _ : state)
+   {
+      driver.write(frame);
+      expected++;
+      while (listener.m_frames.load(std::memory_order_acquire) != expected)
+      {
+         std::this_thread::yield();
+      }
+   }
+   state.SetBytesProcessed(state.iterations() * frame.size());
+}
+void socket_round_trip(benchmark::State& state, bool unix_socket, SocketBackend backend)
+{
+   EventLoop loop;
+   loop.start();
+   SocketDriver driver (loop, backend);
+   ISocketDriver& drv = driver;
+   EchoListener listener;
+   SocketEchoServer server;
+   uint16_t port = server.start(unix_socket);
+   drv.addListener(&listener);
+   drv.setDelimiter(BENCH_DELIMITER);
+   if (drv.connect(unix_socket? std::string(SOCKDRV_UNIX_SCHEME) + BENCH_UNIX_PATH : "127.0.0.1", port))
+   {
+      round_trip(state, drv, listener);
+   }
+   else
+   {
+      state.SkipWithError("cannot connect");
+   }
+   drv.disconnect();
+   drv.removeListener(&listener);
+   server.stop();
+   loop.stop();
+}
+}
+
+static void BM_RoundTripTcp(benchmark::State& state)
+{
+   socket_round_trip(state, false, SocketBackend::SYSCALL);
+}
+static void BM_RoundTripTcpUring(benchmark::State& state)
+{
+   socket_round_trip(state, false, SocketBackend::URING);
+}
+static void BM_RoundTripUnix(benchmark::State& state)
+{
+   socket_round_trip(state, true, SocketBackend::SYSCALL);
+}
+static void BM_RoundTripUnixUring(benchmark::State& state)
+{
+   socket_round_trip(state, true, SocketBackend::URING);
+}
+static void BM_RoundTripShm(benchmark::State& state)
+{
+   ShmDriver driver;
+   ISocketDriver& drv = driver;
+   EchoListener listener;
+   ShmEchoServer server;
+   server.start();
+   drv.addListener(&listener);
+   drv.setDelimiter(BENCH_DELIMITER);
+   if (drv.connect(std::string(SHMDRV_SCHEME) + BENCH_SHM_NAME, 0))
+   {
+      round_trip(state, drv, listener);
+   }
+   else
+   {
+      state.SkipWithError("cannot connect");
+   }
+   drv.disconnect();
+   drv.removeListener(&listener);
+   server.stop();
+}
+
+BENCHMARK(BM_RoundTripTcp)->Arg(16)->Arg(256)->UseRealTime();
+BENCHMARK(BM_RoundTripTcpUring)->Arg(16)->Arg(256)->UseRealTime();
+BENCHMARK(BM_RoundTripUnix)->Arg(16)->Arg(256)->UseRealTime();
+BENCHMARK(BM_RoundTripUnixUring)->Arg(16)->Arg(256)->UseRealTime();
+BENCHMARK(BM_RoundTripShm)->Arg(16)->Arg(256)->UseRealTime();
+
+int main(int argc, char** argv)
+{
+   /* per-frame driver logs would dominate the measured latency */
+   logger_initialize();
+   logger_set_group_state(LOG_SOCKDRV, LOGGER_GROUP_DISABLE);
+   benchmark::Initialize(&argc, argv);
+   benchmark::RunSpecifiedBenchmarks();
+   logger_deinitialize();
+   return 0;
+}
@@ -0,0 +1,135 @@
+#ifndef _CAPTURE_FILE_H_
+#define _CAPTURE_FILE_H_
+
+/**
+ * @file CaptureFile.h
+ *
+ * @brief
+ *    Memory-mapped capture of received byte stream with timestamps of received chunks.
+ *
+ * @details
+ *    File consists of header, index of chunks (monotonic timestamp and end offset of each chunk) and data region.
+ *    Data of consecutive chunks is stored contiguously, so captured stream can be cut into frames directly in the mapping,
+ *    regardless of how it was split by the kernel. Data region is page aligned, index region is reserved on creation
+ *    (file is sparse, so unused entries do not take disk space).
+ *    CaptureWriter only appends - data is copied to the mapping and chunk is published by updating the header, so file
+ *    written by crashed application can still be replayed up to the last complete chunk. Mapping grows by remapping
+ *    when data region is full. On close, file is truncated to the used size.
+ *    CaptureReader maps the file privately (copy-on-write), so data can be modified in place, e.g. decoded.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include "stdint.h"
+#include <stddef.h>
+#include <string>
+/* =============================
+ *           Defines
+ * =============================*/
+#define CAPTURE_MAGIC "SHCAPT01"
+#define CAPTURE_INDEX_CAPACITY (1024 * 1024)
+#define CAPTURE_INITIAL_DATA_SIZE (1024 * 1024)
+
+/**
+ * @brief Header placed at the beginning of capture file.
+ */
+struct CaptureHeader
+{
+   char magic[8];            /**< CAPTURE_MAGIC without terminating zero */
+   uint64_t index_capacity;  /**< Number of reserved index entries */
+   uint64_t data_offset;     /**< Offset of data region in the file */
+   uint64_t chunks_count;    /**< Number of complete chunks */
+   uint64_t data_size;       /**< Number of bytes in data region */
+};
+
+/**
+ * @brief Index entry describing single received chunk.
+ */
+struct CaptureChunk
+{
+   uint64_t timestamp_ns;    /**< Monotonic time of reception */
+   uint64_t end;             /**< Offset of the end of chunk data in data region */
+};
+
+class CaptureWriter
+{
+public:
+   CaptureWriter();
+   ~CaptureWriter();
+   /**
+    * @brief Creates new capture file, existing one is overwritten.
+    * @param[in] path - path of the file.
+    * @param[in] index_capacity - maximal number of captured chunks.
+    * @return True if file is ready for writing, otherwise false.
+    */
+   bool create(const std::string& path, size_t index_capacity = CAPTURE_INDEX_CAPACITY);
+   /**
+    * @brief Appends chunk to capture.
+    * @param[in] data - received data.
+    * @param[in] size - number of bytes.
+    * @param[in] timestamp_ns - monotonic time of reception.
+    * @return True on success, false if file is not open, index is full or file cannot grow.
+    */
+   bool append(const uint8_t* data, size_t size, uint64_t timestamp_ns);
+   /**
+    * @brief Truncates file to used size and closes it.
+    * @return None.
+    */
+   void close();
+   /**
+    * @brief Checks if file is open.
+    * @return True if open, otherwise false.
+    */
+   bool isOpen() const;
+private:
+   bool grow(size_t data_size);
+
+   int m_fd;
+   uint8_t* m_mapping;
+   size_t m_mapping_size;
+};
+
+class CaptureReader
+{
+public:
+   CaptureReader();
+   ~CaptureReader();
+   /**
+    * @brief Maps capture file.
+    * @param[in] path - path of the file.
+    * @return True if file is valid, otherwise false.
+    */
+   bool open(const std::string& path);
+   /**
+    * @brief Unmaps the file.
+    * @return None.
+    */
+   void close();
+   /**
+    * @brief Returns number of captured chunks.
+    * @return Chunks count, 0 if file is not open.
+    */
+   size_t chunks() const;
+   /**
+    * @brief Returns description of captured chunk.
+    * @param[in] index - chunk index, lower than chunks().
+    * @return Chunk timestamp and end offset.
+    */
+   const CaptureChunk& chunk(size_t index) const;
+   /**
+    * @brief Returns captured data, chunks are placed one after another.
+    * @return Pointer to the mapping, valid until close().
+    */
+   uint8_t* data();
+private:
+   uint8_t* m_mapping;
+   size_t m_mapping_size;
+   const CaptureChunk* m_chunks;
+   size_t m_chunks_count;
+};
+
+#endif
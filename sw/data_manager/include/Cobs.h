@@ -0,0 +1,52 @@
+#ifndef _COBS_H_
+#define _COBS_H_
+
+/**
+ * @file Cobs.h
+ *
+ * @brief
+ *    Consistent Overhead Byte Stuffing codec.
+ *
+ * @details
+ *    Encoded data never contains COBS_DELIMITER byte, so it can be used to terminate frames carrying any binary payload.
+ *    Encoding adds at most COBS_MAX_OVERHEAD(size) bytes, decoding is done in place.
+ *    Data is copied in blocks between zero bytes (found by memchr), not byte by byte.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include "stdint.h"
+#include <stddef.h>
+/* =============================
+ *           Defines
+ * =============================*/
+#define COBS_DELIMITER 0x00
+#define COBS_MAX_OVERHEAD(size) (1 + (size) / 254)
+
+namespace cobs
+{
+/**
+ * @brief Encodes data, delimiter is not appended.
+ * @details Buffers may overlap if src is placed at least COBS_MAX_OVERHEAD(size) bytes after dst - it allows
+ *          to encode in place, when data was written with such headroom.
+ * @param[in] src - data to encode.
+ * @param[in] size - number of bytes to encode.
+ * @param[out] dst - output buffer, at least size + COBS_MAX_OVERHEAD(size) bytes.
+ * @return Number of bytes written to dst.
+ */
+size_t encode(const uint8_t* src, size_t size, uint8_t* dst);
+/**
+ * @brief Decodes data in place, delimiter shall not be passed.
+ * @param[in,out] data - encoded data, replaced by decoded data.
+ * @param[in] size - number of encoded bytes.
+ * @param[out] decoded_size - number of decoded bytes.
+ * @return True if data was encoded correctly, otherwise false.
+ */
+bool decode(uint8_t* data, size_t size, size_t& decoded_size);
+}
+
+#endif
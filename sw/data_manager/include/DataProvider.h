@@ -18,45 +18,137 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <array>
 /* =============================
  *   Includes of project headers
  * =============================*/
 #include "IDataProvider.h"
 #include "ISocketDriver.h"
+#include "IEventLoop.h"
 #include "IMainWindowWrapper.h"
+#include "ReconnectPolicy.h"
+#include "WakeupEvent.h"
+#include "StateCache.h"
 /* =============================
  *           Defines
  * =============================*/
+/* biggest payload accepted in length-prefixed mode, longer frames are dropped by driver */
+#define DATA_PROV_MAX_PAYLOAD_SIZE 64
+/* one dispatch table entry per possible command ID */
+#define DATA_PROV_HANDLERS_COUNT 256
+/* size of single item in NTF_ENV_SENSOR_DATA payload: id, type, hum_h, hum_l, temp_h, temp_l */
+#define DATA_PROV_ENV_ITEM_SIZE 6
+/* size of single item in NTF_INPUTS_STATE payload: id, state */
+#define DATA_PROV_INPUT_ITEM_SIZE 2
 
 class DataProvider : public IDataProvider, public SocketListener
 {
 
 public:
    DataProvider(IMainWindowWrapper& main_window, ISocketDriver& driver);
+   /**
+    * @brief Creates provider working in event loop mode - reconnection is handled by loop timer instead of own thread.
+    * @param[in] loop - started event loop, it have to outlive the provider.
+    */
+   DataProvider(IMainWindowWrapper& main_window, ISocketDriver& driver, IEventLoop& loop);
    ~DataProvider();
 private:
    /* IDataProvider */
    bool run (const std::string& ip_address, uint16_t port, char c) override;
+   bool run (const std::vector<SocketEndpoint>& endpoints, char c) override;
+   void setFraming(FramingMode mode) override;
+   void setLinkTimeout(std::chrono::milliseconds timeout, std::chrono::milliseconds ping_period) override;
+   void registerHandler(uint8_t id, NotificationHandler handler, size_t min_payload = 0) override;
+   uint64_t getUnknownCount() override;
+   void setEnvHysteresis(uint8_t temperature, uint8_t humidity) override;
+   uint32_t getSuppressedCount(uint8_t ntf_id, uint8_t item_id) override;
+   const HomeStateStore& getHomeState() override;
+   std::chrono::microseconds getPopulateTime() override;
+   size_t getPendingStateRequests() override;
    void stop() override;
    bool isConnected() override;
 
    /* SocketListener */
    void onSocketEvent(DriverEvent ev, const std::vector<uint8_t>& data, size_t size) override;
+   void onSocketBatch(const std::vector<std::vector<uint8_t>>& frames, size_t count) override;
+   void onSocketFrames(const FrameView* frames, size_t count) override;
 
    void executeThread();
-   void parse_message(const std::vector<uint8_t>& data, size_t size);
-   bool parse_env_event(const std::vector<uint8_t>& data, size_t size);
-   bool parse_input_event(const std::vector<uint8_t>& data, size_t size);
-   bool parse_fan_event(const std::vector<uint8_t>& data, size_t size);
+   std::chrono::milliseconds checkConnection();
+   std::vector<SocketEndpoint> nextEndpoints(size_t& first);
+   std::chrono::milliseconds onConnectResult(size_t first, int index);
+   std::chrono::milliseconds checkLink();
+   void onReconnectTimer();
+   void scheduleCheck(std::chrono::milliseconds delay);
+   void onRelinkTimer();
+   void onLinkDropped();
+   void releaseActiveEndpoint();
+   void touchLink();
+   std::chrono::milliseconds checkLiveness();
+   void sendPing();
+   bool sendRequest(uint8_t id);
+   void requestState();
+   void onStateResponse(uint8_t id);
+   void parse_message(const uint8_t* data, size_t size);
+   bool parse_env_event(const uint8_t* data, size_t size);
+   bool parse_input_event(const uint8_t* data, size_t size);
+   bool parse_fan_event(const uint8_t* data, size_t size);
+   bool parse_time_event(const uint8_t* data, size_t size);
+   bool parse_env_all_event(const uint8_t* data, size_t size);
+   bool parse_inputs_all_event(const uint8_t* data, size_t size);
+   void apply_env_state(const uint8_t* item);
+   void apply_input_state(const uint8_t* item);
+   void apply_fan_state(uint8_t state);
+   void flush_gui_updates();
+
+   struct BuiltinHandler
+   {
+      uint8_t id;
+      bool (DataProvider::*parse)(const uint8_t* data, size_t size);
+      size_t min_payload;
+   };
+   struct HandlerEntry
+   {
+      NotificationHandler handler;
+      /* frames with shorter payload are dropped before handler is called */
+      size_t min_payload;
+   };
+   static const BuiltinHandler BUILTIN_HANDLERS[];
+   /* requests sent after connection, bit N of pending mask is set until response to request N arrives */
+   static const uint8_t STATE_REQUESTS[];
 
    IMainWindowWrapper& m_main_window;
-   std::string m_server_address;
-   uint16_t m_port;
+   std::vector<SocketEndpoint> m_endpoints;
+   int m_active_endpoint;
+   size_t m_first_endpoint;
    char m_delimiter;
+   FramingMode m_framing;
    ISocketDriver& m_driver;
    std::atomic<bool> m_thread_running;
    std::thread m_thread;
    std::mutex m_mtx;
+   IEventLoop* m_loop;
+   IEventLoop::TimerId m_timer;
+   /* reconnection requested after link drop, EVLOOP_INVALID_TIMER when not pending */
+   IEventLoop::TimerId m_relink_timer;
+   ReconnectPolicy m_reconnect_policy;
+   WakeupEvent m_wakeup;
+   std::chrono::milliseconds m_link_timeout;
+   std::chrono::milliseconds m_ping_period;
+   /* time of last received frame, updated by driver thread */
+   std::atomic<std::chrono::steady_clock::rep> m_last_frame;
+   std::chrono::steady_clock::time_point m_last_ping;
+   std::array<HandlerEntry, DATA_PROV_HANDLERS_COUNT> m_handlers;
+   std::atomic<uint64_t> m_unknown_count;
+   StateCache m_state_cache;
+   HomeStateStore m_home_state;
+   /* changes parsed from frames of single read, passed to main window at once */
+   StateUpdateBatch m_gui_updates;
+   std::atomic<uint32_t> m_pending_requests;
+   /* time of the last connection */
+   std::atomic<std::chrono::steady_clock::rep> m_connected_at;
+   /* in microseconds, negative until all state requests are answered */
+   std::atomic<int64_t> m_populate_time;
 #if defined (DATA_PROVIDER_FRIEND_TESTS)
    DATA_PROVIDER_FRIEND_TESTS
 #endif
@@ -0,0 +1,69 @@
+#ifndef _DELIMITER_SEARCH_H_
+#define _DELIMITER_SEARCH_H_
+
+/**
+ * @file DelimiterSearch.h
+ *
+ * @brief
+ *    Search of all delimiter positions in received data.
+ *
+ * @details
+ *    Buffer is scanned once and offsets of all delimiters are returned, so frames can be cut without
+ *    restarting the search after each frame.
+ *    Data is compared in vector registers - SSE2/AVX2 on x86 (selected in runtime, depending on CPU)
+ *    and NEON on ARM (when NEON kernel is built, used only if CPU reports NEON support). Scalar implementation is used
+ *    on other targets.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include "stdint.h"
+#include <stddef.h>
+#include <vector>
+
+namespace delimiter_search
+{
+
+enum class Kernel
+{
+   SCALAR, /**< Byte by byte comparison, available on all targets */
+   SSE2,   /**< 16 bytes per step, x86 */
+   AVX2,   /**< 32 bytes per step, x86 */
+   NEON,   /**< 16 bytes per step, ARM */
+};
+
+/**
+ * @brief Checks if implementation can be used on current CPU.
+ * @param[in] kernel - implementation to check.
+ * @return True if kernel is supported, otherwise false.
+ */
+bool isSupported(Kernel kernel);
+/**
+ * @brief Returns the fastest implementation supported by current CPU - it is used by findAll() without kernel.
+ * @return Selected kernel.
+ */
+Kernel bestKernel();
+/**
+ * @brief Finds all delimiters in buffer.
+ * @param[in] data - buffer to search.
+ * @param[in] size - number of bytes to search.
+ * @param[in] delimiter - byte to find.
+ * @param[out] positions - offsets of found delimiters (relative to data) are appended, in ascending order.
+ * @return Number of found delimiters.
+ */
+size_t findAll(const uint8_t* data, size_t size, uint8_t delimiter, std::vector<size_t>& positions);
+/**
+ * @brief Finds all delimiters in buffer using selected implementation.
+ * @details If kernel is not supported, scalar implementation is used. Other parameters are the same as in findAll() above.
+ * @param[in] kernel - implementation to use.
+ * @return Number of found delimiters.
+ */
+size_t findAll(Kernel kernel, const uint8_t* data, size_t size, uint8_t delimiter, std::vector<size_t>& positions);
+
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef _DRIVER_COUNTERS_H_
+#define _DRIVER_COUNTERS_H_
+
+/**
+ * @file DriverCounters.h
+ *
+ * @brief
+ *    Statistics counters shared by driver implementations.
+ *
+ * @details
+ *    Counters are updated with relaxed ordering - each counter is consistent, but snapshot as a whole is not.
+ *    Receive path counters shall be updated from single thread.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <atomic>
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ISocketDriver.h"
+
+class DriverCounters
+{
+public:
+   DriverCounters();
+   /**
+    * @brief Starts or stops counting connection time, connection start is counted as reconnection (except the first one).
+    * @param[in] connected - new connection state.
+    * @return None.
+    */
+   void setConnected(bool connected);
+   /**
+    * @brief Counts received bytes.
+    * @param[in] bytes - number of received bytes.
+    * @param[in] stored_bytes - number of bytes kept in receive buffer, including received ones.
+    * @return None.
+    */
+   void addReceived(size_t bytes, size_t stored_bytes);
+   /**
+    * @brief Counts frames passed to listeners.
+    * @param[in] frames - number of frames.
+    * @return None.
+    */
+   void addDelivered(size_t frames);
+   /**
+    * @brief Sets total number of dropped frames.
+    * @param[in] frames - number of frames.
+    * @return None.
+    */
+   void setDropped(size_t frames);
+   /**
+    * @brief Counts sent bytes.
+    * @param[in] bytes - number of bytes.
+    * @return None.
+    */
+   void addSent(size_t bytes);
+   /**
+    * @brief Sets current depth of write queue.
+    * @param[in] bytes - number of bytes waiting.
+    * @param[in] frames - number of frames waiting.
+    * @return None.
+    */
+   void setWriteQueue(size_t bytes, size_t frames);
+   /**
+    * @brief Returns current values.
+    * @return Statistics snapshot.
+    */
+   SocketDriverStats get() const;
+private:
+   std::atomic<uint64_t> m_bytes_received;
+   std::atomic<uint64_t> m_bytes_sent;
+   std::atomic<uint64_t> m_frames_delivered;
+   std::atomic<uint64_t> m_frames_dropped;
+   std::atomic<uint64_t> m_connections;
+   std::atomic<int64_t> m_connected_since_ms;  /* steady clock, 0 when not connected */
+   std::atomic<size_t> m_recv_buffer_high_water;
+   std::atomic<size_t> m_write_queue_bytes;
+   std::atomic<size_t> m_write_queue_frames;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef _DRIVER_SELECTOR_H_
+#define _DRIVER_SELECTOR_H_
+
+/**
+ * @file DriverSelector.h
+ *
+ * @brief
+ *    Implementation of ISocketDriver interface which selects transport by address scheme.
+ *
+ * @details
+ *    Addresses starting with SHMDRV_SCHEME are handled by shared memory driver, all others by socket driver
+ *    (TCP or Unix domain socket). Listeners and settings are passed to both drivers, so transport can be
+ *    changed on connect() without any action from the user. connectAny() passes consecutive endpoints of the same
+ *    transport to its driver, groups are tried in order of the list. connectAsync() tries the next group when
+ *    the driver reports failure of the previous one, so event loop of the socket driver is not blocked.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <atomic>
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ISocketDriver.h"
+
+class DriverSelector : public ISocketDriver
+{
+public:
+   /**
+    * @brief Creates selector.
+    * @param[in] socket_driver - driver used for TCP and Unix socket addresses.
+    * @param[in] shm_driver - driver used for shared memory addresses.
+    */
+   DriverSelector(ISocketDriver& socket_driver, ISocketDriver& shm_driver);
+private:
+   /* ISocketDriver */
+   bool connect(const std::string& address, uint16_t port) override;
+   int connectAny(const std::vector<SocketEndpoint>& endpoints) override;
+   void connectAsync(const std::vector<SocketEndpoint>& endpoints, ConnectCallback callback) override;
+   bool disconnect() override;
+   bool isConnected() override;
+   void addListener(SocketListener* callback) override;
+   void removeListener(SocketListener* callback) override;
+   bool write(const std::vector<uint8_t>& data, size_t size = 0) override;
+   bool writeAsync(const std::vector<uint8_t>& data, WriteCallback callback = nullptr) override;
+   void setWriteHighWaterMark(size_t bytes) override;
+   void setDelimiter(char c) override;
+   void setFraming(FramingMode mode) override;
+   void setFrameLayout(const FrameLayout& layout) override;
+   SocketDriverStats getStats() override;
+   ISocketDriver* select(const std::string& address);
+   void connectGroup(const std::vector<SocketEndpoint>& endpoints, size_t begin, ConnectCallback callback);
+
+   ISocketDriver& m_socket_driver;
+   ISocketDriver& m_shm_driver;
+   std::atomic<ISocketDriver*> m_active;
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef _EVENTLOOP_H_
+#define _EVENTLOOP_H_
+
+/**
+ * @file EventLoop.h
+ *
+ * @brief
+ *    Implementation of IEventLoop interface based on epoll.
+ *
+ * @details
+ *    Timers are kept sorted by expiration time, the nearest one is used as epoll_wait() timeout.
+ *    Eventfd is used to wake up the loop when timer is added or loop is stopped from other thread.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "IEventLoop.h"
+/* =============================
+ *           Defines
+ * =============================*/
+#define EVLOOP_MAX_EVENTS 16
+
+class EventLoop : public IEventLoop
+{
+public:
+   EventLoop();
+   ~EventLoop();
+   /* IEventLoop */
+   bool start() override;
+   void stop() override;
+   bool isRunning() override;
+   bool isLoopThread() override;
+   bool addFd(int fd, uint32_t events, FdCallback callback) override;
+   bool modifyFd(int fd, uint32_t events) override;
+   void removeFd(int fd) override;
+   TimerId addTimer(std::chrono::milliseconds delay, TimerCallback callback) override;
+   void cancelTimer(TimerId id) override;
+private:
+   typedef std::chrono::steady_clock::time_point TimePoint;
+
+   void threadExecute();
+   int getTimeout();
+   void processTimers();
+   void processFdEvent(int fd, uint32_t epoll_events);
+   void wakeup();
+   void waitForCallback();
+
+   int m_epoll_fd;
+   int m_wakeup_fd;
+   std::atomic<bool> m_running;
+   std::thread m_thread;
+   std::thread::id m_thread_id;
+   std::mutex m_mutex;
+   std::mutex m_callback_mutex;
+   std::map<int, FdCallback> m_fds;
+   std::map<TimerId, TimerCallback> m_timers;
+   std::multimap<TimePoint, TimerId> m_timers_queue;
+   TimerId m_next_timer_id;
+#if defined (EVLOOP_FRIEND_TESTS)
+   EVLOOP_FRIEND_TESTS
+#endif
+};
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef _FRAMEASSEMBLER_H_
+#define _FRAMEASSEMBLER_H_
+
+/**
+ * @file FrameAssembler.h
+ *
+ * @brief
+ *    Ring-buffer receive store which cuts received byte stream into frames.
+ *
+ * @details
+ *    Data is written directly into the store (e.g. by recv()) using writePtr() and writeSpace(), then
+ *    commit() extracts all complete frames as views pointing into the store - frames are neither allocated nor copied.
+ *    Views are valid until release() is called.
+ *    Read and write positions only move forward, when there is not enough space at the end of the store, the
+ *    incomplete frame (if any) is moved to the beginning - it is the only copy, done once per store wrap.
+ *    When frame does not fit into the store, it is dropped and data is skipped until the next delimiter.
+ *    In FramingMode::LENGTH_PREFIXED frames are cut at offsets taken from header, without scanning the data. Until valid
+ *    layout is set, data received in this mode is dropped.
+ *    If trailer is not equal to delimiter, the stream is out of sync - frame is dropped and data after each next delimiter
+ *    is checked until a header with valid length and trailer is found.
+ *    In FramingMode::COBS frames are cut on COBS_DELIMITER and decoded in place, so views point to decoded data.
+ *    The store can be also external memory already filled with data (see attach()) - e.g. mapped capture file.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <vector>
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ISocketDriver.h"
+
+class FrameAssembler
+{
+public:
+   /**
+    * @brief Creates assembler.
+    * @param[in] capacity - size of the store, biggest accepted frame is one byte smaller (delimiter).
+    */
+   explicit FrameAssembler(size_t capacity);
+   /**
+    * @brief Creates assembler without own store - attach() has to be called before commit().
+    */
+   FrameAssembler();
+   /**
+    * @brief Uses external memory as the store, it is not owned and data is not copied.
+    * @details Data is expected to be already in the store, commit() only marks the next bytes as received. Data is
+    *          never moved, so the store is passed through once.
+    * @param[in] data - store, it has to be valid until next attach().
+    * @param[in] size - store size.
+    * @return None.
+    */
+   void attach(uint8_t* data, size_t size);
+   /**
+    * @brief Set frame delimiter.
+    * @param[in] delimiter - delimiter byte.
+    * @return None.
+    */
+   void setDelimiter(uint8_t delimiter);
+   /**
+    * @brief Set framing mode.
+    * @param[in] mode - framing mode.
+    * @return None.
+    */
+   void setFraming(FramingMode mode);
+   /**
+    * @brief Set frame layout used in FramingMode::LENGTH_PREFIXED.
+    * @param[in] layout - frame layout, header has to contain the length byte.
+    * @return True if layout accepted, otherwise false - previous layout is kept.
+    */
+   bool setFrameLayout(const FrameLayout& layout);
+   /**
+    * @brief Drops all buffered data.
+    * @return None.
+    */
+   void reset();
+   /**
+    * @brief Returns place where new data shall be written.
+    * @return Pointer to first free byte.
+    */
+   uint8_t* writePtr();
+   /**
+    * @brief Returns number of bytes which can be written at writePtr().
+    * @return Size of contiguous free space.
+    */
+   size_t writeSpace() const;
+   /**
+    * @brief Accepts bytes written at writePtr() and extracts complete frames.
+    * @param[in] bytes - number of written bytes.
+    * @return Number of complete frames available by frames().
+    */
+   size_t commit(size_t bytes);
+   /**
+    * @brief Returns frames extracted by last commit().
+    * @return Pointer to the array of frames.
+    */
+   const FrameView* frames() const;
+   /**
+    * @brief Releases frames returned by last commit() - views are not valid anymore.
+    * @return None.
+    */
+   void release();
+   /**
+    * @brief Returns number of bytes waiting for frame completion.
+    * @return Bytes count.
+    */
+   size_t pending() const;
+   /**
+    * @brief Returns number of frames dropped because of size or lost synchronization.
+    * @return Frames count.
+    */
+   size_t dropped() const;
+private:
+   void extractDelimited();
+   void extractLengthPrefixed();
+   bool skipToDelimiter();
+   void addFrame(size_t begin, size_t end);
+   void addEncodedFrame(size_t begin, size_t end);
+   void wrap();
+
+   std::vector<uint8_t> m_storage;
+   uint8_t* m_data;
+   size_t m_capacity;
+   bool m_external;
+   size_t m_read_pos;
+   size_t m_scan_pos;
+   size_t m_write_pos;
+   uint8_t m_delimiter;
+   FramingMode m_mode;
+   FrameLayout m_layout;
+   bool m_layout_valid;
+   bool m_discard;
+   /* set after invalid trailer until the next valid frame */
+   bool m_resync;
+   size_t m_skip;
+   size_t m_dropped;
+   std::vector<FrameView> m_frames;
+   size_t m_frames_count;
+   std::vector<size_t> m_positions;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef _FRAME_POOL_H_
+#define _FRAME_POOL_H_
+
+/**
+ * @file FramePool.h
+ *
+ * @brief
+ *    Fixed-capacity pool of equally sized frame buffers.
+ *
+ * @details
+ *    All blocks are allocated as single arena when the pool is created, acquire() and release() only move
+ *    block pointers on the free list, so frames can be stored without touching the heap once the driver runs.
+ *    It avoids heap fragmentation on long-running devices. Pool is not thread safe - owner has to serialize access.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+class FramePool
+{
+public:
+   /**
+    * @brief Creates pool and allocates all blocks.
+    * @param[in] block_size - size of single block in bytes.
+    * @param[in] blocks_count - number of blocks.
+    */
+   FramePool(size_t block_size, size_t blocks_count);
+   /**
+    * @brief Takes free block from the pool.
+    * @return Pointer to block of blockSize() bytes, nullptr if all blocks are in use.
+    */
+   uint8_t* acquire();
+   /**
+    * @brief Returns block to the pool.
+    * @param[in] block - block returned by acquire(), nullptr and blocks not owned by the pool are ignored.
+    * @return None.
+    */
+   void release(uint8_t* block);
+   /**
+    * @brief Checks if block belongs to the pool.
+    * @param[in] block - pointer to check.
+    * @return True if pointer is the beginning of pool block.
+    */
+   bool owns(const uint8_t* block) const;
+   /**
+    * @brief Returns size of single block.
+    * @return Size in bytes.
+    */
+   size_t blockSize() const;
+   /**
+    * @brief Returns number of free blocks.
+    * @return Blocks count.
+    */
+   size_t available() const;
+   /**
+    * @brief Returns number of all blocks.
+    * @return Blocks count.
+    */
+   size_t capacity() const;
+private:
+   size_t m_block_size;
+   std::vector<uint8_t> m_arena;
+   std::vector<uint8_t*> m_free;
+};
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef _HOST_RESOLVER_H_
+#define _HOST_RESOLVER_H_
+
+/**
+ * @file HostResolver.h
+ *
+ * @brief
+ *    Resolves host names to IPv4/IPv6 addresses on own thread and caches the results.
+ *
+ * @details
+ *    getaddrinfo() may block for seconds when DNS server is not available, so it is called only by resolver thread.
+ *    Caller waits for the result not longer than given timeout - when it expires, resolution continues in background
+ *    and the result is cached for the next call. Resolved addresses are kept for RESOLVER_CACHE_TTL_MS, failures
+ *    for RESOLVER_NEGATIVE_TTL_MS (negative caching). When cached addresses expire, they are still returned
+ *    until refreshed addresses are known, so reconnection is never delayed by resolution of known host.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <sys/socket.h>
+/* =============================
+ *           Defines
+ * =============================*/
+#define RESOLVER_CACHE_TTL_MS 60000
+#define RESOLVER_NEGATIVE_TTL_MS 5000
+
+enum class ResolveState
+{
+   RESOLVED,   /**< At least one address is known */
+   PENDING,    /**< Host is being resolved, no address known yet */
+   FAILED,     /**< Host cannot be resolved */
+};
+
+struct HostAddress
+{
+   struct sockaddr_storage address; /**< AF_INET or AF_INET6 address with port */
+   socklen_t length;                /**< Used size of address */
+};
+
+class HostResolver
+{
+public:
+   /**
+    * @brief Creates resolver, thread is started on first resolution.
+    * @param[in] ttl - validity of resolved addresses.
+    * @param[in] negative_ttl - time after which failed resolution is repeated.
+    */
+   HostResolver(std::chrono::milliseconds ttl = std::chrono::milliseconds(RESOLVER_CACHE_TTL_MS),
+                std::chrono::milliseconds negative_ttl = std::chrono::milliseconds(RESOLVER_NEGATIVE_TTL_MS));
+   ~HostResolver();
+   /**
+    * @brief Returns addresses of the host.
+    * @param[in] host - host name or numeric address.
+    * @param[in] port - port to set in returned addresses.
+    * @param[in] timeout - maximum time to wait when host is not cached.
+    * @param[out] result - addresses in order of preference.
+    * @return True if at least one address is known, false if host cannot be resolved or timeout expired.
+    */
+   bool resolve(const std::string& host, uint16_t port, std::chrono::milliseconds timeout, std::vector<HostAddress>& result);
+   /**
+    * @brief Returns addresses of the host without waiting - for callers that cannot block, e.g. event loop thread.
+    * @details Resolution is started the same as by resolve(), caller checks again later while it is pending.
+    * @param[in] host - host name or numeric address.
+    * @param[in] port - port to set in returned addresses.
+    * @param[out] result - addresses in order of preference.
+    * @return State of the resolution, result is empty unless RESOLVED.
+    */
+   ResolveState tryResolve(const std::string& host, uint16_t port, std::vector<HostAddress>& result);
+private:
+   struct CacheEntry
+   {
+      std::vector<HostAddress> addresses;
+      std::chrono::steady_clock::time_point expiry;
+      bool pending;
+   };
+   CacheEntry& request(const std::string& host);
+   void threadExecute();
+   std::vector<HostAddress> lookup(const std::string& host);
+
+   std::chrono::milliseconds m_ttl;
+   std::chrono::milliseconds m_negative_ttl;
+   std::map<std::string, CacheEntry> m_cache;
+   std::deque<std::string> m_requests;
+   std::mutex m_mutex;
+   std::condition_variable m_cv;
+   std::thread m_thread;
+   bool m_running;
+};
+
+#endif
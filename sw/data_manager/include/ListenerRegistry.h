@@ -0,0 +1,102 @@
+#ifndef _LISTENER_REGISTRY_H_
+#define _LISTENER_REGISTRY_H_
+
+/**
+ * @file ListenerRegistry.h
+ *
+ * @brief
+ *    List of socket listeners which can be notified without locking.
+ *
+ * @details
+ *    Listeners are kept in immutable list - add() and remove() publish a modified copy (copy-on-write),
+ *    so forEach() only counts itself as an active reader and iterates current list.
+ *    Replaced lists are released after grace period - when all readers which could still use them have finished.
+ *    Readers are counted in two slots switched by epoch, so waiting for old readers is not prolonged by new ones.
+ *    Grace period is awaited without the writer mutex, so other add() and remove() calls are not blocked by it.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <vector>
+#include <mutex>
+#include <atomic>
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ISocketDriver.h"
+/* =============================
+ *           Defines
+ * =============================*/
+/* registries tracked per thread in nested forEach() calls, deeper nesting is treated as notification in progress */
+#define LISTENER_REGISTRY_MAX_NESTING 8
+
+class ListenerRegistry
+{
+public:
+   ListenerRegistry();
+   ~ListenerRegistry();
+   /**
+    * @brief Adds listener, it is notified starting from the next forEach() call.
+    * @param[in] listener - listener to add, duplicates are ignored.
+    * @return None.
+    */
+   void add(SocketListener* listener);
+   /**
+    * @brief Removes listener.
+    * @details When called outside of forEach(), it waits until notifications in progress are finished, so the listener
+    *          is not called after return and can be destroyed. When called from listener callback of this registry, it does
+    *          not wait (it would wait for itself) - the listener may still be called by notifications which are in progress.
+    *          Callbacks of other registries wait as any other caller.
+    * @param[in] listener - listener to remove.
+    * @return None.
+    */
+   void remove(SocketListener* listener);
+   /**
+    * @brief Calls function for all listeners, lock-free.
+    * @param[in] function - called with SocketListener* argument.
+    * @return None.
+    */
+   template <typename Function>
+   void forEach(Function function)
+   {
+      const uint32_t slot = m_epoch.load() & 1;
+      m_readers[slot]++;
+      if (s_depth < LISTENER_REGISTRY_MAX_NESTING)
+      {
+         s_notifying[s_depth] = this;
+      }
+      s_depth++;
+      const ListenerList* list = m_list.load();
+      for (auto& listener : *list)
+      {
+         function(listener);
+      }
+      s_depth--;
+      m_readers[slot]--;
+   }
+   /**
+    * @brief Returns number of registered listeners.
+    * @return Number of listeners.
+    */
+   size_t size();
+private:
+   typedef std::vector<SocketListener*> ListenerList;
+   void publish(const ListenerList* list);
+   void synchronize();
+   bool isNotifying() const;
+
+   std::mutex m_mutex;
+   std::atomic<const ListenerList*> m_list;
+   std::atomic<uint32_t> m_epoch;
+   std::atomic<uint32_t> m_readers[2];
+   std::vector<const ListenerList*> m_retired;
+   /* forEach() calls in progress on current thread, registries notifying on each nesting level */
+   static thread_local uint32_t s_depth;
+   static thread_local const ListenerRegistry* s_notifying[LISTENER_REGISTRY_MAX_NESTING];
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef _RECONNECT_POLICY_H_
+#define _RECONNECT_POLICY_H_
+
+/**
+ * @file ReconnectPolicy.h
+ *
+ * @brief
+ *    Calculates delays between connection attempts.
+ *
+ * @details
+ *    First retry is done quickly, then the delay is doubled after each failed attempt, up to the limit.
+ *    Each delay is randomly shortened by up to jitter percent, so many clients do not reconnect at the same time
+ *    after server restart. After successful connection (reset()) the sequence starts again.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include "stdint.h"
+#include <chrono>
+#include <random>
+
+class ReconnectPolicy
+{
+public:
+   /**
+    * @brief Creates policy.
+    * @param[in] first_retry - delay after first failed attempt.
+    * @param[in] max_delay - limit of the delay.
+    * @param[in] jitter_percent - maximum random reduction of the delay [0-100].
+    * @param[in] seed - seed of the random generator, fixed value gives repeatable delays.
+    */
+   ReconnectPolicy(std::chrono::milliseconds first_retry, std::chrono::milliseconds max_delay, uint8_t jitter_percent, uint32_t seed);
+   /**
+    * @brief Returns delay to wait after failed attempt.
+    * @return Delay before next attempt.
+    */
+   std::chrono::milliseconds nextDelay();
+   /**
+    * @brief Starts the sequence again - shall be called when connection is established or lost.
+    * @return None.
+    */
+   void reset();
+   /**
+    * @brief Returns number of failed attempts since last reset().
+    * @return Attempts count.
+    */
+   uint32_t failedAttempts() const;
+private:
+   std::chrono::milliseconds m_first_retry;
+   std::chrono::milliseconds m_max_delay;
+   uint8_t m_jitter_percent;
+   uint32_t m_failed_attempts;
+   std::minstd_rand m_generator;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef _REPLAY_DRIVER_H_
+#define _REPLAY_DRIVER_H_
+
+/**
+ * @file ReplayDriver.h
+ *
+ * @brief
+ *    Implementation of ISocketDriver interface which replays stream recorded by SocketDriver::startCapture().
+ *
+ * @details
+ *    Address passed to connect() is a path of the capture file, port is not used. After connection, own thread delivers
+ *    captured chunks keeping original intervals divided by speed factor (REPLAY_SPEED_MAX - without delays).
+ *    Frames are cut directly in the mapped file by FrameAssembler (the same as used by SocketDriver) and passed to
+ *    listeners as views - captured data is never copied.
+ *    When the whole capture is delivered, DRIVER_DISCONNECTED is reported, as if the server closed the connection.
+ *    Written data is dropped, it is only counted in statistics.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ISocketDriver.h"
+#include "CaptureFile.h"
+#include "FrameAssembler.h"
+#include "ListenerRegistry.h"
+#include "DriverCounters.h"
+#include "WakeupEvent.h"
+/* =============================
+ *           Defines
+ * =============================*/
+#define REPLAY_SPEED_MAX 0.0
+
+class ReplayDriver : public ISocketDriver
+{
+public:
+   /**
+    * @brief Creates driver.
+    * @param[in] speed - replay speed, 1.0 - original timing, 2.0 - twice as fast, REPLAY_SPEED_MAX - no delays.
+    */
+   explicit ReplayDriver(double speed = 1.0);
+   ~ReplayDriver();
+private:
+   /* ISocketDriver */
+   bool connect(const std::string& address, uint16_t port) override;
+   int connectAny(const std::vector<SocketEndpoint>& endpoints) override;
+   bool disconnect() override;
+   bool isConnected() override;
+   void addListener(SocketListener* callback) override;
+   void removeListener(SocketListener* callback) override;
+   bool write(const std::vector<uint8_t>& data, size_t size = 0) override;
+   bool writeAsync(const std::vector<uint8_t>& data, WriteCallback callback = nullptr) override;
+   void setWriteHighWaterMark(size_t bytes) override;
+   void setDelimiter(char c) override;
+   void setFraming(FramingMode mode) override;
+   void setFrameLayout(const FrameLayout& layout) override;
+   SocketDriverStats getStats() override;
+
+   void threadExecute();
+   void deliverChunk(size_t begin, size_t end);
+   void notify_callbacks(DriverEvent ev);
+
+   double m_speed;
+   CaptureReader m_capture;
+   std::atomic<bool> m_is_connected;
+   /* cuts frames directly in the mapped capture */
+   FrameAssembler m_assembler;
+   std::mutex m_mutex;
+   std::thread m_thread;
+   std::atomic<bool> m_thread_running;
+   WakeupEvent m_wakeup;
+   ListenerRegistry m_listeners;
+   DriverCounters m_stats;
+};
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef _SHM_CHANNEL_H_
+#define _SHM_CHANNEL_H_
+
+/**
+ * @file ShmChannel.h
+ *
+ * @brief
+ *    Bidirectional byte stream between two processes on the same machine, placed in POSIX shared memory.
+ *
+ * @details
+ *    Segment is created by server and opened by single client. It contains two single-producer single-consumer rings,
+ *    one per direction. Positions in ring are free-running counters - producer owns head, consumer owns tail,
+ *    so data is passed without locks and without system calls.
+ *    Waiting side sleeps on futex placed in shared memory - the other side wakes it only when the waiting flag is set,
+ *    so there is no system call per frame when the consumer keeps up. Futex word is a wakeup sequence, so wakeup
+ *    requested just before the thread goes to sleep is not lost.
+ *    Each side stores its PID, so the peer which exited without closing the channel is detected.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include "stdint.h"
+#include <stddef.h>
+#include <atomic>
+#include <string>
+#include <chrono>
+/* =============================
+ *           Defines
+ * =============================*/
+#define SHM_CHANNEL_MAGIC 0x534D4843
+#define SHM_CHANNEL_RING_SIZE 16384
+
+/**
+ * @brief Single direction ring, shared between processes.
+ */
+struct ShmRing
+{
+   std::atomic<uint32_t> head;              /**< Number of bytes written */
+   std::atomic<uint32_t> tail;              /**< Number of bytes read */
+   std::atomic<uint32_t> consumer_wakeups;  /**< Futex word of waiting consumer */
+   std::atomic<uint32_t> producer_wakeups;  /**< Futex word of waiting producer */
+   std::atomic<uint32_t> consumer_waiting;
+   std::atomic<uint32_t> producer_waiting;
+   uint8_t data[SHM_CHANNEL_RING_SIZE];
+};
+
+/**
+ * @brief Layout of the shared memory segment.
+ */
+struct ShmSegment
+{
+   uint32_t magic;
+   std::atomic<int32_t> server_pid;  /**< 0 when server closed the channel */
+   std::atomic<int32_t> client_pid;  /**< 0 when client is not connected */
+   ShmRing to_client;
+   ShmRing to_server;
+};
+
+class ShmChannel
+{
+public:
+   ShmChannel();
+   ~ShmChannel();
+   /**
+    * @brief Creates the segment, called by server.
+    * @param[in] name - shared memory object name, e.g. "/smarthome".
+    * @return True if created, otherwise false.
+    */
+   bool create(const std::string& name);
+   /**
+    * @brief Opens segment created by server, called by client.
+    * @details Data left in ring by previous client is dropped.
+    * @param[in] name - shared memory object name.
+    * @return True if server is running and no other client is connected, otherwise false.
+    */
+   bool open(const std::string& name);
+   /**
+    * @brief Closes the channel and wakes up the peer. Server removes the segment.
+    * @return None.
+    */
+   void close();
+   /**
+    * @brief Checks if the channel is open.
+    * @return True if open, otherwise false.
+    */
+   bool isOpen() const;
+   /**
+    * @brief Checks if the other side keeps the channel open.
+    * @return True if peer is connected and its process is running, otherwise false.
+    */
+   bool isPeerAlive() const;
+   /**
+    * @brief Writes as many bytes as fit into the ring, without blocking.
+    * @param[in] data - bytes to write.
+    * @param[in] size - number of bytes.
+    * @return Number of written bytes.
+    */
+   size_t write(const uint8_t* data, size_t size);
+   /**
+    * @brief Reads available bytes, without blocking.
+    * @param[out] data - destination buffer.
+    * @param[in] size - size of the buffer.
+    * @return Number of read bytes.
+    */
+   size_t read(uint8_t* data, size_t size);
+   /**
+    * @brief Returns number of bytes waiting for read.
+    * @return Bytes count.
+    */
+   size_t readable() const;
+   /**
+    * @brief Returns number of bytes written, but not read by peer yet.
+    * @return Bytes count.
+    */
+   size_t unread() const;
+   /**
+    * @brief Waits until there is data to read.
+    * @param[in] timeout - maximum waiting time.
+    * @return True if data is available, false on timeout or wakeup().
+    */
+   bool waitReadable(std::chrono::milliseconds timeout);
+   /**
+    * @brief Waits until there is space for given number of bytes.
+    * @param[in] size - required space.
+    * @param[in] timeout - maximum waiting time.
+    * @return True if space is available, false on timeout or wakeup().
+    */
+   bool waitWritable(size_t size, std::chrono::milliseconds timeout);
+   /**
+    * @brief Wakes up local thread waiting in waitReadable() or waitWritable().
+    * @return None.
+    */
+   void wakeup();
+private:
+   bool map(int fd);
+   void wakePeer();
+
+   ShmSegment* m_segment;
+   ShmRing* m_rx;
+   ShmRing* m_tx;
+   std::atomic<int32_t>* m_own_pid;
+   std::atomic<int32_t>* m_peer_pid;
+   bool m_is_server;
+   std::string m_name;
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef _SHM_DRIVER_H_
+#define _SHM_DRIVER_H_
+
+/**
+ * @file ShmDriver.h
+ *
+ * @brief
+ *    Implementation of ISocketDriver interface using shared memory channel to server running on the same machine.
+ *
+ * @details
+ *    Address has form SHMDRV_SCHEME + shared memory object name (e.g. "shm:/smarthome"), port is not used.
+ *    Received stream is cut into frames the same way as in SocketDriver, all framing modes are supported.
+ *    Data is received by own thread, which sleeps until server writes to the channel. Once per SHMDRV_PEER_CHECK_PERIOD_MS
+ *    of silence it checks if the server is still running.
+ *    Data queued by writeAsync() is copied to the channel immediately, so callback is called before return.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ISocketDriver.h"
+#include "ShmChannel.h"
+#include "FrameAssembler.h"
+#include "ListenerRegistry.h"
+#include "DriverCounters.h"
+/* =============================
+ *           Defines
+ * =============================*/
+#define SHMDRV_SCHEME "shm:"
+#define SHMDRV_RECV_BUFFER_SIZE 4096
+#define SHMDRV_MAX_WRITE_SIZE 1024
+#define SHMDRV_PEER_CHECK_PERIOD_MS 1000
+#define SHMDRV_WRITE_TIMEOUT_MS 1000
+
+class ShmDriver : public ISocketDriver
+{
+public:
+   ShmDriver();
+   ~ShmDriver();
+private:
+   /* ISocketDriver */
+   bool connect(const std::string& address, uint16_t port) override;
+   int connectAny(const std::vector<SocketEndpoint>& endpoints) override;
+   bool disconnect() override;
+   bool isConnected() override;
+   void addListener(SocketListener* callback) override;
+   void removeListener(SocketListener* callback) override;
+   bool write(const std::vector<uint8_t>& data, size_t size = 0) override;
+   bool writeAsync(const std::vector<uint8_t>& data, WriteCallback callback = nullptr) override;
+   void setWriteHighWaterMark(size_t bytes) override;
+   void setDelimiter(char c) override;
+   void setFraming(FramingMode mode) override;
+   void setFrameLayout(const FrameLayout& layout) override;
+   SocketDriverStats getStats() override;
+
+   void threadExecute();
+   bool receiveData();
+   bool writeEncoded(const uint8_t* data, size_t size, bool wait);
+   void notify_callbacks(DriverEvent ev);
+
+   ShmChannel m_channel;
+   std::atomic<bool> m_is_connected;
+   FrameAssembler m_recv_buffer;
+   std::atomic<FramingMode> m_framing;
+   std::vector<uint8_t> m_send_buffer;
+   std::mutex m_mutex;
+   std::mutex m_write_mutex;
+   size_t m_write_high_water_mark;
+   std::thread m_thread;
+   std::atomic<bool> m_thread_running;
+   ListenerRegistry m_listeners;
+   DriverCounters m_stats;
+#if defined (SHMDRV_FRIEND_TESTS)
+   SHMDRV_FRIEND_TESTS
+#endif
+};
+
+#endif
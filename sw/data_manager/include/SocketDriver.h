@@ -7,6 +7,23 @@
  * @brief
  *    Implementation of ISocketDriver interface.
  *
+ * @details
+ *    Connects over TCP, or over Unix domain stream socket when address starts with SOCKDRV_UNIX_SCHEME.
+ *    Server address can be IPv4, IPv6 or host name - names are resolved by HostResolver and cached.
+ *    connectAny() keeps several non-blocking connects in flight, next one started every SOCKDRV_HEDGE_DELAY_MS
+ *    or as soon as previous one fails, so unreachable server delays the connection only by the hedge delay.
+ *    With SocketBackend::URING data is received by multishot io_uring request and queued frames are sent by io_uring,
+ *    so there is no system call per received chunk - completions are collected in batches, either by the driver thread
+ *    or by event loop (ring descriptor is observed instead of the socket). Received data is copied from io_uring buffer
+ *    to the frame assembler. When io_uring cannot be set up, driver falls back to recv()/sendmsg() on each connection.
+ *    io_uring backend is built only with SOCKDRV_URING defined (kernel headers support it), otherwise it is never used.
+ *    In event loop mode connectAsync() does not block the loop - all connecting sockets are observed by the loop,
+ *    hedged attempts are started by loop timer and the connection is finished from callback of the first ready socket.
+ *    TCP connections use keepalive probes and TCP_USER_TIMEOUT, so peer which disappeared is reported within seconds.
+ *    Received stream can be recorded to capture file (startCapture()) and replayed later by ReplayDriver.
+ *    Once connected, received frames and queued frames up to SOCKDRV_WRITE_POOL_BLOCK_SIZE do not allocate memory -
+ *    frames are cut in the receive store and written frames are copied to FramePool blocks kept in fixed ring.
+ *
  * @author Jacek Skowronek
  * @date   05/02/2021
  *
@@ -16,46 +33,222 @@
  * =============================*/
 #include <vector>
 #include <mutex>
+#include <condition_variable>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #include <thread>
 #include <atomic>
+#include <chrono>
 /* =============================
  *   Includes of project headers
  * =============================*/
 #include "ISocketDriver.h"
+#include "IEventLoop.h"
+#include "FrameAssembler.h"
+#include "ListenerRegistry.h"
+#include "DriverCounters.h"
+#if defined (SOCKDRV_URING)
+#include "UringQueue.h"
+#endif
+#include "CaptureFile.h"
+#include "HostResolver.h"
+#include "FramePool.h"
 /* =============================
  *           Defines
  * =============================*/
 #define SOCKDRV_MAX_RW_SIZE 1024
-#define SOCKDRV_RECV_BUFFER_SIZE 1024
+#define SOCKDRV_RECV_BUFFER_SIZE 4096
+#define SOCKDRV_WRITE_HIGH_WATER_MARK 16384
+/* queued frames are stored in pool allocated on startup, bigger frames are stored on heap */
+#define SOCKDRV_WRITE_POOL_BLOCK_SIZE 128
+/* also maximum number of queued frames */
+#define SOCKDRV_WRITE_POOL_BLOCKS 64
+#define SOCKDRV_MAX_IOV_COUNT 32
+#define SOCKDRV_WRITE_POLL_TIMEOUT_MS 100
+#define SOCKDRV_CONNECT_TIMEOUT_MS 1000
+/* time after which connectAny() starts connecting to next endpoint without waiting for previous ones */
+#define SOCKDRV_HEDGE_DELAY_MS 200
+/* time connect() waits for name resolution, it is continued in background and cached for next attempt */
+#define SOCKDRV_RESOLVE_TIMEOUT_MS 200
+/* period of checking name resolution by connectAsync(), loop thread never waits for resolver */
+#define SOCKDRV_RESOLVE_POLL_MS 10
+/* address prefix selecting Unix domain socket, e.g. "unix:/run/smarthome.sock" */
+#define SOCKDRV_UNIX_SCHEME "unix:"
+/* TCP keepalive - peer which disappeared without closing the connection is detected after IDLE + COUNT * INTERVAL seconds */
+#define SOCKDRV_KEEPALIVE_IDLE_S 1
+#define SOCKDRV_KEEPALIVE_INTERVAL_S 1
+#define SOCKDRV_KEEPALIVE_COUNT 3
+/* connection is dropped when written data is not acknowledged by peer within this time */
+#define SOCKDRV_USER_TIMEOUT_MS 3000
+#define SOCKDRV_URING_ENTRIES 16
+#define SOCKDRV_URING_BUFFER_COUNT 16
+#define SOCKDRV_URING_BUFFER_SIZE 1024
+#define SOCKDRV_URING_MAX_COMPLETIONS 32
+
+/**
+ * @brief Mechanism used to pass data to and from the socket.
+ */
+enum class SocketBackend
+{
+   SYSCALL,  /**< recv() and sendmsg() system calls */
+   URING,    /**< io_uring, SYSCALL is used if not supported by kernel or by build */
+};
 
 class SocketDriver : public ISocketDriver
 {
 public:
-   SocketDriver();
+   explicit SocketDriver(SocketBackend backend = SocketBackend::SYSCALL);
+   /**
+    * @brief Creates driver working in event loop mode - no thread is started on connect, data is received from loop thread.
+    * @param[in] loop - started event loop, it have to outlive the driver.
+    * @param[in] backend - mechanism used to receive and send data.
+    */
+   explicit SocketDriver(IEventLoop& loop, SocketBackend backend = SocketBackend::SYSCALL);
    ~SocketDriver();
+   /**
+    * @brief Starts recording of every received chunk, with monotonic timestamp, to capture file.
+    * @details Recording is kept over reconnections. Capture can be played back by ReplayDriver.
+    * @param[in] path - path of the file, existing file is overwritten.
+    * @return True if recording started, otherwise false.
+    */
+   bool startCapture(const std::string& path);
+   /**
+    * @brief Stops recording and closes capture file.
+    * @return None.
+    */
+   void stopCapture();
 private:
    /* ISocketDriver */
    bool connect(const std::string& ip_address, uint16_t port) override;
+   int connectAny(const std::vector<SocketEndpoint>& endpoints) override;
+   void connectAsync(const std::vector<SocketEndpoint>& endpoints, ConnectCallback callback) override;
    bool disconnect() override;
    bool isConnected() override;
    void addListener(SocketListener* callback) override;
    void removeListener(SocketListener* callback) override;
    bool write(const std::vector<uint8_t>& data, size_t size = 0) override;
-   void setDelimiter(char c);
+   bool writeAsync(const std::vector<uint8_t>& data, WriteCallback callback = nullptr) override;
+   void setWriteHighWaterMark(size_t bytes) override;
+   void setDelimiter(char c) override;
+   void setFraming(FramingMode mode) override;
+   void setFrameLayout(const FrameLayout& layout) override;
+   SocketDriverStats getStats() override;
+   struct PendingWrite
+   {
+      uint8_t* data;                  /**< Pool block or overflow data */
+      size_t size;
+      size_t offset;
+      WriteCallback callback;
+      std::vector<uint8_t> overflow;  /**< Storage of frame bigger than pool block */
+   };
+   struct ConnectAttempt
+   {
+      int fd;
+      int flags;
+      size_t index;
+      bool connected;
+      std::chrono::steady_clock::time_point deadline;
+   };
+   bool connectSocket(const struct sockaddr *address, socklen_t address_len);
+   ResolveState makeAddresses(const SocketEndpoint& endpoint, bool wait, std::vector<HostAddress>& result);
+   bool startAttempt(const SocketEndpoint& endpoint, const HostAddress& address, ConnectAttempt& attempt);
+   bool finishAttempt(ConnectAttempt& attempt);
+   int raceConnect(const std::vector<SocketEndpoint>& endpoints);
+   void onConnectTimer();
+   void onAttemptReady(int fd);
+   void continueConnect(std::unique_lock<std::mutex>& lock);
+   bool nextAddresses(std::chrono::steady_clock::time_point now);
+   void completeConnect(std::unique_lock<std::mutex>& lock, size_t attempt);
+   void dropAttempt(size_t attempt);
+   void cancelConnect();
+   bool startConnection(const std::string& ip_address, uint16_t port);
+   void setKeepalive();
    void threadExecute();
+   void writerExecute();
+   bool waitQueueSent(std::unique_lock<std::mutex>& lock);
+   void enqueueWrite(const uint8_t* data, size_t size, WriteCallback callback);
+   PendingWrite& queuedWrite(size_t index);
+   void popWrite();
+   void requestFlush();
+   void flushQueue(std::unique_lock<std::mutex>& lock);
+   size_t fillIovecs(struct iovec* iov);
+   void advanceQueue(size_t bytes_written, std::vector<WriteCallback>& completed);
+   void failPendingWrites();
+   void updateQueueStats();
+   void setConnected(bool connected);
+   void closeSocket();
+   bool receiveData();
+   void processReceived(size_t bytes_count);
+   void captureReceived(const uint8_t* data, size_t size);
+   bool handleReceiveError(int error);
+   void onSocketReady(uint32_t events);
+   bool startUring();
+   void stopUring();
+   bool isUringActive() const;
+   int uringFd() const;
+   bool receiveUring();
+   bool processCompletions();
+#if defined (SOCKDRV_URING)
+   bool onUringReceived(const UringCompletion& completion);
+   void onUringSent(int32_t result);
+#endif
+   void submitUringSend();
    void notify_callbacks(DriverEvent ev, const std::vector<uint8_t>& data, size_t count);
+   void notify_frames(const FrameView* frames, size_t count);
 
    std::string m_server_address;
    uint16_t m_server_port;
    std::atomic<bool> m_is_connected;
    char m_delimiter;
-   std::vector<uint8_t> m_recv_buffer;
-   size_t m_recv_buffer_size;
+   FrameAssembler m_recv_buffer;
+   std::atomic<FramingMode> m_framing;
+   std::vector<uint8_t> m_send_buffer;
+   std::mutex m_write_mutex;
+   std::condition_variable m_write_cv;
+   FramePool m_write_pool;
+   /* ring of SOCKDRV_WRITE_POOL_BLOCKS entries */
+   std::vector<PendingWrite> m_write_queue;
+   size_t m_write_head;
+   size_t m_write_count;
+   size_t m_queued_bytes;
+   size_t m_write_high_water_mark;
+   bool m_write_armed;
+   /* write() sends outside of m_write_mutex, queue is not flushed meanwhile */
+   bool m_direct_send;
+   bool m_writer_running;
+   std::thread m_writer_thread;
    std::thread m_thread;
    std::atomic<bool> m_thread_running;
    std::mutex m_mutex;
    int m_sock_fd;
-   std::vector<SocketListener*> m_listeners;
+   IEventLoop* m_loop;
+   SocketBackend m_backend;
+#if defined (SOCKDRV_URING)
+   UringQueue m_uring;
+   struct msghdr m_uring_msg;
+   struct iovec m_uring_iov [SOCKDRV_MAX_IOV_COUNT];
+   bool m_uring_send_pending;
+#endif
+   ListenerRegistry m_listeners;
+   DriverCounters m_stats;
+   std::mutex m_capture_mutex;
+   std::atomic<bool> m_capture_enabled;
+   CaptureWriter m_capture;
+   HostResolver m_resolver;
+   /* connection started by connectAsync() in event loop mode */
+   std::mutex m_connect_mutex;
+   std::vector<SocketEndpoint> m_connect_endpoints;
+   std::vector<ConnectAttempt> m_attempts;
+   size_t m_next_endpoint;
+   /* resolved addresses of endpoint m_next_endpoint - 1, each one is tried */
+   std::vector<HostAddress> m_next_addresses;
+   size_t m_next_address;
+   /* set while waiting for name resolution of endpoint m_next_endpoint */
+   std::chrono::steady_clock::time_point m_resolve_deadline;
+   std::chrono::steady_clock::time_point m_next_start;
+   ConnectCallback m_connect_callback;
+   /* armed for the earliest deadline of pending attempts */
+   IEventLoop::TimerId m_connect_timer;
 #if defined (SOCKDRV_FRIEND_TESTS)
    SOCKDRV_FRIEND_TESTS
 #endif
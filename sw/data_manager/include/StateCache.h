@@ -0,0 +1,110 @@
+#ifndef _STATE_CACHE_H_
+#define _STATE_CACHE_H_
+
+/**
+ * @file StateCache.h
+ *
+ * @brief
+ *    Last known state of environment sensors, inputs and fan - detects which notifications change the state.
+ *
+ * @details
+ *    CoreApplication resends the state periodically, update*() methods return true only when the value differs
+ *    from the last forwarded one, so unchanged values do not reach the GUI. Env values may use hysteresis -
+ *    temperature and humidity changes smaller than configured threshold (in tenths) are not forwarded, the next
+ *    value is compared with the last forwarded one, so slow drift is still reported.
+ *    Suppressed updates are counted per ID. Updates shall be done from single thread, counters can be read from any thread.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <array>
+#include <atomic>
+#include <stdint.h>
+/* =============================
+ *           Defines
+ * =============================*/
+/* one entry per possible item ID received in notification */
+#define STATE_CACHE_IDS_COUNT 256
+
+class StateCache
+{
+public:
+   StateCache();
+   /**
+    * @brief Sets hysteresis of env values.
+    * @param[in] temperature - smallest forwarded temperature change in tenths of degree, 0 forwards every change.
+    * @param[in] humidity - smallest forwarded humidity change in tenths of percent, 0 forwards every change.
+    * @return None.
+    */
+   void setEnvHysteresis(uint8_t temperature, uint8_t humidity);
+   /**
+    * @brief Updates env sensor state.
+    * @param[in] id - sensor ID.
+    * @param[in] temp_h - decimal part of temperature.
+    * @param[in] temp_l - fraction part of temperature.
+    * @param[in] hum_h - decimal part of humidity.
+    * @param[in] hum_l - fraction part of humidity.
+    * @return True if state shall be forwarded, false if it is unchanged or within hysteresis.
+    */
+   bool updateEnv(uint8_t id, int8_t temp_h, int8_t temp_l, uint8_t hum_h, uint8_t hum_l);
+   /**
+    * @brief Updates input state.
+    * @param[in] id - input ID.
+    * @param[in] state - input state.
+    * @return True if state shall be forwarded, false if it is unchanged.
+    */
+   bool updateInput(uint8_t id, uint8_t state);
+   /**
+    * @brief Updates fan state.
+    * @param[in] state - fan state.
+    * @return True if state shall be forwarded, false if it is unchanged.
+    */
+   bool updateFan(uint8_t state);
+   /**
+    * @brief Returns number of suppressed env updates.
+    * @param[in] id - sensor ID.
+    * @return Updates count.
+    */
+   uint32_t envSuppressed(uint8_t id) const;
+   /**
+    * @brief Returns number of suppressed input updates.
+    * @param[in] id - input ID.
+    * @return Updates count.
+    */
+   uint32_t inputSuppressed(uint8_t id) const;
+   /**
+    * @brief Returns number of suppressed fan updates.
+    * @return Updates count.
+    */
+   uint32_t fanSuppressed() const;
+private:
+   struct EnvEntry
+   {
+      int8_t temp_h;
+      int8_t temp_l;
+      uint8_t hum_h;
+      uint8_t hum_l;
+      bool valid;
+   };
+   struct StateEntry
+   {
+      uint8_t state;
+      bool valid;
+   };
+   bool updateState(StateEntry& entry, std::atomic<uint32_t>& suppressed, uint8_t state);
+
+   uint8_t m_temp_hysteresis;
+   uint8_t m_hum_hysteresis;
+   std::array<EnvEntry, STATE_CACHE_IDS_COUNT> m_env;
+   std::array<StateEntry, STATE_CACHE_IDS_COUNT> m_inputs;
+   StateEntry m_fan;
+   std::array<std::atomic<uint32_t>, STATE_CACHE_IDS_COUNT> m_env_suppressed;
+   std::array<std::atomic<uint32_t>, STATE_CACHE_IDS_COUNT> m_inputs_suppressed;
+   std::atomic<uint32_t> m_fan_suppressed;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef _URING_QUEUE_H_
+#define _URING_QUEUE_H_
+
+/**
+ * @file UringQueue.h
+ *
+ * @brief
+ *    Minimal io_uring instance used by SocketDriver to receive and send without a system call per operation.
+ *
+ * @details
+ *    Ring is set up with raw system calls (no liburing dependency). Receive uses multishot recv with provided buffer ring -
+ *    single submitted request keeps producing completions, each with one of the registered buffers, until it is cancelled
+ *    or runs out of buffers. Buffer has to be returned by recycle() after the data is consumed.
+ *    init() fails when kernel does not support io_uring or required operations (multishot receive needs Linux 6.0),
+ *    or when io_uring is blocked (e.g. by seccomp) - caller is expected to use regular system calls in such case.
+ *    Submission methods (recvMultishot(), sendmsg(), submit()) have to be serialized by the caller, completions
+ *    (reap(), recycle()) have to be consumed by single thread. wait() can be called concurrently with submission.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include "stdint.h"
+#include <stddef.h>
+#include <vector>
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+
+/**
+ * @brief Single completed operation.
+ */
+struct UringCompletion
+{
+   uint64_t user_data;  /**< Value passed on submission */
+   int32_t result;      /**< Number of bytes or negative errno */
+   uint32_t flags;      /**< IORING_CQE_F_* flags */
+   /**
+    * @brief Checks if multishot request is still active.
+    */
+   bool hasMore() const { return flags & IORING_CQE_F_MORE; }
+   /**
+    * @brief Checks if data was placed in provided buffer.
+    */
+   bool hasBuffer() const { return flags & IORING_CQE_F_BUFFER; }
+   /**
+    * @brief Returns ID of provided buffer holding the data.
+    */
+   uint16_t bufferId() const { return flags >> IORING_CQE_BUFFER_SHIFT; }
+};
+
+class UringQueue
+{
+public:
+   UringQueue();
+   ~UringQueue();
+   /**
+    * @brief Sets up the ring and registers receive buffers.
+    * @param[in] entries - size of submission queue.
+    * @param[in] buffer_count - number of receive buffers, power of 2.
+    * @param[in] buffer_size - size of single receive buffer.
+    * @return True if io_uring is ready to use, otherwise false.
+    */
+   bool init(uint32_t entries, uint32_t buffer_count, uint32_t buffer_size);
+   /**
+    * @brief Destroys the ring, kernel cancels all pending requests.
+    * @return None.
+    */
+   void deinit();
+   /**
+    * @brief Checks if the ring is set up.
+    * @return True if set up, otherwise false.
+    */
+   bool isActive() const;
+   /**
+    * @brief Returns ring file descriptor, it is readable when there are completions to reap.
+    * @return File descriptor, -1 if not set up.
+    */
+   int fd() const;
+   /**
+    * @brief Queues multishot receive to provided buffers.
+    * @param[in] socket - socket to read.
+    * @param[in] user_data - value returned in completions.
+    * @return True if queued, false if submission queue is full.
+    */
+   bool recvMultishot(int socket, uint64_t user_data);
+   /**
+    * @brief Queues sendmsg() request.
+    * @param[in] socket - socket to write.
+    * @param[in] message - message to send, it has to be valid until completion.
+    * @param[in] user_data - value returned in completion.
+    * @return True if queued, false if submission queue is full.
+    */
+   bool sendmsg(int socket, const struct msghdr* message, uint64_t user_data);
+   /**
+    * @brief Passes all queued requests to kernel in single system call.
+    * @return True on success, otherwise false.
+    */
+   bool submit();
+   /**
+    * @brief Waits until at least one completion is available.
+    * @return True if completions are available, false on error or signal.
+    */
+   bool wait();
+   /**
+    * @brief Takes available completions without waiting.
+    * @param[out] completions - destination array.
+    * @param[in] max - size of the array.
+    * @return Number of completions.
+    */
+   size_t reap(UringCompletion* completions, size_t max);
+   /**
+    * @brief Returns data of provided buffer.
+    * @param[in] id - buffer ID from completion.
+    * @return Pointer to the buffer.
+    */
+   const uint8_t* buffer(uint16_t id) const;
+   /**
+    * @brief Gives consumed buffer back to kernel.
+    * @param[in] id - buffer ID from completion.
+    * @return None.
+    */
+   void recycle(uint16_t id);
+private:
+   struct io_uring_sqe* nextSqe();
+   bool probe();
+   bool registerBuffers(uint32_t buffer_count, uint32_t buffer_size);
+
+   int m_fd;
+   void* m_ring;
+   size_t m_ring_size;
+   struct io_uring_sqe* m_sqes;
+   size_t m_sqes_size;
+   uint32_t* m_sq_head;
+   uint32_t* m_sq_tail;
+   uint32_t m_sq_mask;
+   uint32_t m_sq_entries;
+   uint32_t m_sq_local_tail;
+   uint32_t m_sq_submitted;
+   uint32_t* m_cq_head;
+   uint32_t* m_cq_tail;
+   uint32_t m_cq_mask;
+   struct io_uring_cqe* m_cqes;
+   struct io_uring_buf_ring* m_buf_ring;
+   size_t m_buf_ring_size;
+   uint32_t m_buf_mask;
+   uint16_t m_buf_tail;
+   uint32_t m_buffer_size;
+   std::vector<uint8_t> m_buffers;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef _WAKEUP_EVENT_H_
+#define _WAKEUP_EVENT_H_
+
+/**
+ * @file WakeupEvent.h
+ *
+ * @brief
+ *    Event used to wake up waiting thread before timeout expires.
+ *
+ * @details
+ *    Notification is remembered until consumed by waitFor(), so it is not lost when notify() is called
+ *    before the thread starts waiting.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+class WakeupEvent
+{
+public:
+   WakeupEvent();
+   /**
+    * @brief Wakes up waiting thread.
+    * @return None.
+    */
+   void notify();
+   /**
+    * @brief Waits until notified or timeout expires.
+    * @param[in] timeout - maximum waiting time.
+    * @return True if notified, false on timeout.
+    */
+   bool waitFor(std::chrono::milliseconds timeout);
+private:
+   std::mutex m_mutex;
+   std::condition_variable m_cv;
+   bool m_notified;
+};
+
+#endif
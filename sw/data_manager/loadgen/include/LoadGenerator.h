@@ -0,0 +1,102 @@
+#ifndef _LOAD_GENERATOR_H_
+#define _LOAD_GENERATOR_H_
+
+/**
+ * @file LoadGenerator.h
+ *
+ * @brief
+ *    Sends NTF notifications to connected client with configured rate, burst pattern and malformed frames ratio.
+ *
+ * @details
+ *    Frames are sent in bursts of LoadProfile::burst_size frames, bursts are spaced to keep average LoadProfile::rate.
+ *    Whole burst is written by single non-blocking send() - when socket buffer is full, because the client does not
+ *    keep up, remaining frames of the burst are dropped and counted, so the saturation point can be found by increasing
+ *    the rate until drops appear. Frame cut by partial write is always completed, stream is never desynchronized.
+ *    Bytes acknowledged by the client are taken from the kernel (sent bytes minus SIOCOUTQ).
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <chrono>
+#include <functional>
+#include <atomic>
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "NtfFrameFactory.h"
+/* =============================
+ *           Defines
+ * =============================*/
+#define LOADGEN_REPORT_PERIOD_MS 1000
+#define LOADGEN_WRITE_TIMEOUT_MS 1000
+
+/**
+ * @brief Parameters of generated load.
+ */
+struct LoadProfile
+{
+   uint32_t rate;                         /**< Average frames per second, 0 - as fast as possible */
+   uint32_t burst_size;                   /**< Frames sent back to back */
+   uint8_t malformed_percent;             /**< Percent of frames rejected by the client */
+   std::chrono::milliseconds duration;    /**< Time of the test */
+   FramingMode framing;                   /**< Framing expected by the client */
+   char delimiter;                        /**< Frame delimiter */
+   uint32_t seed;                         /**< Seed of frame content and malformed frames selection */
+};
+
+/**
+ * @brief Result of the test.
+ */
+struct LoadReport
+{
+   uint64_t frames_sent[static_cast<size_t>(NtfFrameKind::COUNT)]; /**< Frames written to the socket by type */
+   uint64_t malformed_sent;               /**< Malformed frames written to the socket */
+   uint64_t frames_dropped;               /**< Frames not written because socket buffer was full */
+   uint64_t bytes_sent;                   /**< Bytes written to the socket */
+   uint64_t bytes_acknowledged;           /**< Bytes confirmed by the client */
+   std::chrono::milliseconds elapsed;     /**< Time since start */
+   bool peer_closed;                      /**< Client closed the connection */
+   /**
+    * @brief Returns number of all frames written to the socket.
+    */
+   uint64_t totalSent() const;
+};
+
+class LoadGenerator
+{
+public:
+   typedef std::function<void(const LoadReport&)> ProgressCallback;
+   explicit LoadGenerator(const LoadProfile& profile);
+   /**
+    * @brief Sends frames to connected client until test duration elapses, client disconnects or stop() is called.
+    * @param[in] socket_fd - connected stream socket.
+    * @param[in] progress - called every LOADGEN_REPORT_PERIOD_MS with current results.
+    * @return Final results.
+    */
+   LoadReport run(int socket_fd, ProgressCallback progress = nullptr);
+   /**
+    * @brief Requests to finish run(), can be called from other thread or signal handler.
+    * @return None.
+    */
+   void stop();
+private:
+   bool sendBurst(int socket_fd, LoadReport& report);
+   bool completeWrite(int socket_fd, const uint8_t* data, size_t size);
+   bool isPeerClosed(int socket_fd);
+   void updateAcknowledged(int socket_fd, LoadReport& report);
+
+   LoadProfile m_profile;
+   NtfFrameFactory m_factory;
+   std::minstd_rand m_random;
+   std::atomic<bool> m_running;
+   std::vector<uint8_t> m_burst;
+   std::vector<size_t> m_frame_ends;
+   std::vector<NtfFrameKind> m_frame_kinds;
+   std::vector<bool> m_frame_malformed;
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef _NTF_FRAME_FACTORY_H_
+#define _NTF_FRAME_FACTORY_H_
+
+/**
+ * @file NtfFrameFactory.h
+ *
+ * @brief
+ *    Builds NTF_NTF notifications sent by CoreApplication, used by load generator.
+ *
+ * @details
+ *    Frames are built in turns: NTF_INPUTS_STATE, NTF_ENV_SENSOR_DATA, NTF_FAN_STATE, with random item IDs and values.
+ *    Malformed frame has byte count in header bigger than the real payload, so it is rejected by DataProvider
+ *    (or by driver in length-prefixed mode). In delimiter based framing payload never contains the delimiter.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include "stdint.h"
+#include <stddef.h>
+#include <vector>
+#include <random>
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ISocketDriver.h"
+#include "notification_types.h"
+/* =============================
+ *           Defines
+ * =============================*/
+#define NTF_INPUTS_STATE_PAYLOAD_SIZE 2
+#define NTF_ENV_SENSOR_DATA_PAYLOAD_SIZE 6
+#define NTF_FAN_STATE_PAYLOAD_SIZE 1
+
+/**
+ * @brief Type of generated notification.
+ */
+enum class NtfFrameKind
+{
+   INPUTS_STATE,
+   ENV_SENSOR_DATA,
+   FAN_STATE,
+   COUNT,
+};
+
+class NtfFrameFactory
+{
+public:
+   /**
+    * @brief Creates factory.
+    * @param[in] mode - framing expected by the client.
+    * @param[in] delimiter - frame delimiter, not used in FramingMode::COBS.
+    * @param[in] seed - seed of random values, the same seed gives the same frames.
+    */
+   NtfFrameFactory(FramingMode mode, char delimiter, uint32_t seed);
+   /**
+    * @brief Appends next frame, with delimiter, to the buffer.
+    * @param[in] malformed - true if frame shall be rejected by the client.
+    * @param[in,out] buffer - destination buffer.
+    * @return Type of appended frame.
+    */
+   NtfFrameKind append(bool malformed, std::vector<uint8_t>& buffer);
+private:
+   uint8_t random(uint8_t min, uint8_t max);
+
+   FramingMode m_mode;
+   uint8_t m_delimiter;
+   std::minstd_rand m_random;
+   NtfFrameKind m_next;
+   std::vector<uint8_t> m_frame;
+   std::vector<uint8_t> m_encoded;
+};
+
+#endif
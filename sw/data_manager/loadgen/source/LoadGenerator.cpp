@@ -0,0 +1,161 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "LoadGenerator.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <linux/sockios.h>
+#include <poll.h>
+#include <errno.h>
+#include <thread>
+#include <algorithm>
+
+uint64_t LoadReport::totalSent() const
+{
+   uint64_t result = 0;
+   for (uint64_t count : frames_sent)
+   {
+      result += count;
+   }
+   return result;
+}
+
+LoadGenerator::LoadGenerator(const LoadProfile& profile) :
+m_profile(profile),
+m_factory(profile.framing, profile.delimiter, profile.seed),
+m_random(profile.seed),
+m_running(false)
+{
+   m_profile.burst_size = std::max<uint32_t>(m_profile.burst_size, 1);
+   m_profile.malformed_percent = std::min<uint8_t>(m_profile.malformed_percent, 100);
+}
+LoadReport LoadGenerator::run(int socket_fd, ProgressCallback progress)
+{
+   LoadReport report = {};
+   const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   std::chrono::steady_clock::time_point next_report = start + std::chrono::milliseconds(LOADGEN_REPORT_PERIOD_MS);
+   uint64_t bursts = 0;
+   m_running = true;
+   while (m_running)
+   {
+      std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - start);
+      if (report.elapsed >= m_profile.duration)
+      {
+         break;
+      }
+      if (isPeerClosed(socket_fd) || !sendBurst(socket_fd, report))
+      {
+         report.peer_closed = true;
+         break;
+      }
+      bursts++;
+      if (progress && now >= next_report)
+      {
+         updateAcknowledged(socket_fd, report);
+         progress(report);
+         next_report += std::chrono::milliseconds(LOADGEN_REPORT_PERIOD_MS);
+      }
+      if (m_profile.rate != 0)
+      {
+         /* bursts are scheduled from the start time, so delays of single bursts do not lower the average rate */
+         std::this_thread::sleep_until(start + std::chrono::microseconds(bursts * m_profile.burst_size * 1000000 / m_profile.rate));
+      }
+   }
+   m_running = false;
+   report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+   updateAcknowledged(socket_fd, report);
+   return report;
+}
+void LoadGenerator::stop()
+{
+   m_running = false;
+}
+bool LoadGenerator::sendBurst(int socket_fd, LoadReport& report)
+{
+   bool result = true;
+   m_burst.clear();
+   m_frame_ends.clear();
+   m_frame_kinds.clear();
+   m_frame_malformed.clear();
+   for (uint32_t i = 0; i < m_profile.burst_size; i++)
+   {
+      const bool malformed = (m_random() % 100) < m_profile.malformed_percent;
+      m_frame_kinds.push_back(m_factory.append(malformed, m_burst));
+      m_frame_malformed.push_back(malformed);
+      m_frame_ends.push_back(m_burst.size());
+   }
+
+   ssize_t written = send(socket_fd, m_burst.data(), m_burst.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+   if (written < 0)
+   {
+      result = (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+      written = 0;
+   }
+   size_t sent_frames = std::upper_bound(m_frame_ends.begin(), m_frame_ends.end(), static_cast<size_t>(written)) - m_frame_ends.begin();
+   if (result && sent_frames < m_frame_ends.size() && static_cast<size_t>(written) > (sent_frames? m_frame_ends[sent_frames - 1] : 0))
+   {
+      /* frame cut in the middle has to be completed, otherwise client would lose synchronization */
+      const size_t end = m_frame_ends[sent_frames];
+      result = completeWrite(socket_fd, m_burst.data() + written, end - written);
+      written = end;
+      sent_frames++;
+   }
+   if (result)
+   {
+      for (size_t i = 0; i < sent_frames; i++)
+      {
+         report.frames_sent[static_cast<size_t>(m_frame_kinds[i])]++;
+         report.malformed_sent += m_frame_malformed[i]? 1 : 0;
+      }
+      report.frames_dropped += m_frame_ends.size() - sent_frames;
+      report.bytes_sent += written;
+   }
+   return result;
+}
+bool LoadGenerator::completeWrite(int socket_fd, const uint8_t* data, size_t size)
+{
+   bool result = true;
+   while (result && size > 0)
+   {
+      struct pollfd fd = {socket_fd, POLLOUT, 0};
+      const int ready = poll(&fd, 1, LOADGEN_WRITE_TIMEOUT_MS);
+      ssize_t written = 0;
+      if (ready <= 0)
+      {
+         /* client stopped reading */
+         result = (ready < 0 && errno == EINTR);
+      }
+      else if ((written = send(socket_fd, data, size, MSG_DONTWAIT | MSG_NOSIGNAL)) < 0)
+      {
+         result = (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+      }
+      else
+      {
+         data += written;
+         size -= written;
+      }
+   }
+   return result;
+}
+bool LoadGenerator::isPeerClosed(int socket_fd)
+{
+   /* client requests are not answered, they are only drained */
+   uint8_t buffer [256];
+   ssize_t received = 0;
+   while ((received = recv(socket_fd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+   {
+   }
+   return received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+}
+void LoadGenerator::updateAcknowledged(int socket_fd, LoadReport& report)
+{
+   int unacknowledged = 0;
+   if (ioctl(socket_fd, SIOCOUTQ, &unacknowledged) == 0)
+   {
+      report.bytes_acknowledged = report.bytes_sent - std::min<uint64_t>(unacknowledged, report.bytes_sent);
+   }
+}
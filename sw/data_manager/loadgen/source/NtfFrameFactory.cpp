@@ -0,0 +1,77 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "NtfFrameFactory.h"
+#include "Cobs.h"
+#include "inputs_types.h"
+#include "env_types.h"
+#include "fan_types.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+
+NtfFrameFactory::NtfFrameFactory(FramingMode mode, char delimiter, uint32_t seed) :
+m_mode(mode),
+m_delimiter(delimiter),
+m_random(seed),
+m_next(NtfFrameKind::INPUTS_STATE)
+{
+}
+NtfFrameKind NtfFrameFactory::append(bool malformed, std::vector<uint8_t>& buffer)
+{
+   const NtfFrameKind result = m_next;
+   m_frame.assign(NTF_HEADER_SIZE, 0);
+   m_frame[NTF_REQ_TYPE_OFFSET] = NTF_NTF;
+   switch (result)
+   {
+   case NtfFrameKind::INPUTS_STATE:
+      m_frame[NTF_ID_OFFSET] = NTF_INPUTS_STATE;
+      m_frame.push_back(random(INPUT_WARDROBE_AC, INPUT_SOCKETS));
+      m_frame.push_back(random(INPUT_STATE_INACTIVE, INPUT_STATE_ACTIVE));
+      m_next = NtfFrameKind::ENV_SENSOR_DATA;
+      break;
+   case NtfFrameKind::ENV_SENSOR_DATA:
+      m_frame[NTF_ID_OFFSET] = NTF_ENV_SENSOR_DATA;
+      m_frame.push_back(random(ENV_OUTSIDE, ENV_STAIRS));
+      m_frame.push_back(0);
+      /* humidity and temperature, integer and decimal part */
+      m_frame.push_back(random(20, 99));
+      m_frame.push_back(random(0, 9));
+      m_frame.push_back(static_cast<uint8_t>(static_cast<int8_t>(random(0, 60) - 20)));
+      m_frame.push_back(random(0, 9));
+      m_next = NtfFrameKind::FAN_STATE;
+      break;
+   default:
+      m_frame[NTF_ID_OFFSET] = NTF_FAN_STATE;
+      m_frame.push_back(random(FAN_STATE_OFF, FAN_STATE_SUSPEND));
+      m_next = NtfFrameKind::INPUTS_STATE;
+      break;
+   }
+   if (m_mode != FramingMode::COBS)
+   {
+      /* delimiter inside payload would split the frame */
+      for (size_t i = NTF_HEADER_SIZE; i < m_frame.size(); i++)
+      {
+         m_frame[i] += (m_frame[i] == m_delimiter)? 1 : 0;
+      }
+   }
+   m_frame[NTF_BYTES_COUNT_OFFSET] = m_frame.size() - NTF_HEADER_SIZE + (malformed? 1 : 0);
+
+   if (m_mode == FramingMode::COBS)
+   {
+      m_encoded.resize(m_frame.size() + COBS_MAX_OVERHEAD(m_frame.size()));
+      const size_t size = cobs::encode(m_frame.data(), m_frame.size(), m_encoded.data());
+      buffer.insert(buffer.end(), m_encoded.begin(), m_encoded.begin() + size);
+      buffer.push_back(COBS_DELIMITER);
+   }
+   else
+   {
+      buffer.insert(buffer.end(), m_frame.begin(), m_frame.end());
+      buffer.push_back(m_delimiter);
+   }
+   return result;
+}
+uint8_t NtfFrameFactory::random(uint8_t min, uint8_t max)
+{
+   return min + m_random() % (max - min + 1);
+}
@@ -0,0 +1,170 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "LoadGenerator.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <algorithm>
+/* ============================= */
+/**
+ * @file main.cpp
+ *
+ * @brief CoreApplication emulator - waits for smarthome_rpi connection and sends NTF notifications with configured load.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+namespace
+{
+const uint16_t LOADGEN_DEFAULT_PORT = 2222;
+LoadGenerator* g_generator = nullptr;
+
+void on_signal(int)
+{
+   if (g_generator)
+   {
+      g_generator->stop();
+   }
+}
+void print_usage(const char* name)
+{
+   printf("usage: %s [options]\n"
+          "  -p, --port N           listening port (default %u)\n"
+          "  -r, --rate N           frames per second, 0 - as fast as possible (default 100)\n"
+          "  -b, --burst N          frames sent back to back (default 1)\n"
+          "  -m, --malformed N      percent of malformed frames (default 0)\n"
+          "  -d, --duration N       test time in seconds (default 10)\n"
+          "  -f, --framing MODE     delimiter, length or cobs (default delimiter)\n"
+          "  -s, --seed N           seed of generated data (default 1)\n",
+          name, LOADGEN_DEFAULT_PORT);
+}
+void print_report(const LoadReport& report)
+{
+   const uint64_t total = report.totalSent();
+   const double seconds = std::max<double>(report.elapsed.count(), 1) / 1000.0;
+   printf("%6.1fs sent %llu (inputs %llu, env %llu, fan %llu, malformed %llu), dropped %llu, %.0f frames/s, "
+          "bytes sent %llu, acknowledged %llu\n",
+          seconds, (unsigned long long)total,
+          (unsigned long long)report.frames_sent[static_cast<size_t>(NtfFrameKind::INPUTS_STATE)],
+          (unsigned long long)report.frames_sent[static_cast<size_t>(NtfFrameKind::ENV_SENSOR_DATA)],
+          (unsigned long long)report.frames_sent[static_cast<size_t>(NtfFrameKind::FAN_STATE)],
+          (unsigned long long)report.malformed_sent, (unsigned long long)report.frames_dropped, total / seconds,
+          (unsigned long long)report.bytes_sent, (unsigned long long)report.bytes_acknowledged);
+   fflush(stdout);
+}
+int accept_client(uint16_t port)
+{
+   int result = -1;
+   int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+   do
+   {
+      int reuse = 1;
+      struct sockaddr_in address = {};
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl(INADDR_ANY);
+      address.sin_port = htons(port);
+      if (listen_fd < 0 || setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0 ||
+          bind(listen_fd, (struct sockaddr*)&address, sizeof(address)) < 0 || listen(listen_fd, 1) < 0)
+      {
+         fprintf(stderr, "cannot listen on port %u: %s\n", port, strerror(errno));
+         break;
+      }
+      printf("waiting for client on port %u\n", port);
+      result = accept(listen_fd, nullptr, nullptr);
+      if (result < 0)
+      {
+         fprintf(stderr, "accept failed: %s\n", strerror(errno));
+      }
+   } while(0);
+   if (listen_fd >= 0)
+   {
+      close(listen_fd);
+   }
+   return result;
+}
+}
+
+int main(int argc, char* argv[])
+{
+   LoadProfile profile = {100, 1, 0, std::chrono::seconds(10), FramingMode::DELIMITER, '\n', 1};
+   uint16_t port = LOADGEN_DEFAULT_PORT;
+   const struct option options[] = {
+      {"port", required_argument, nullptr, 'p'},
+      {"rate", required_argument, nullptr, 'r'},
+      {"burst", required_argument, nullptr, 'b'},
+      {"malformed", required_argument, nullptr, 'm'},
+      {"duration", required_argument, nullptr, 'd'},
+      {"framing", required_argument, nullptr, 'f'},
+      {"seed", required_argument, nullptr, 's'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, 0, nullptr, 0},
+   };
+   int option = 0;
+   while ((option = getopt_long(argc, argv, "p:r:b:m:d:f:s:h", options, nullptr)) != -1)
+   {
+      switch (option)
+      {
+      case 'p':
+         port = atoi(optarg);
+         break;
+      case 'r':
+         profile.rate = strtoul(optarg, nullptr, 10);
+         break;
+      case 'b':
+         profile.burst_size = strtoul(optarg, nullptr, 10);
+         break;
+      case 'm':
+         profile.malformed_percent = std::min<unsigned long>(strtoul(optarg, nullptr, 10), 100);
+         break;
+      case 'd':
+         profile.duration = std::chrono::seconds(strtoul(optarg, nullptr, 10));
+         break;
+      case 'f':
+         if (strcmp(optarg, "length") == 0)
+         {
+            profile.framing = FramingMode::LENGTH_PREFIXED;
+         }
+         else if (strcmp(optarg, "cobs") == 0)
+         {
+            profile.framing = FramingMode::COBS;
+         }
+         break;
+      case 's':
+         profile.seed = strtoul(optarg, nullptr, 10);
+         break;
+      default:
+         print_usage(argv[0]);
+         return option == 'h'? 0 : 1;
+      }
+   }
+
+   int client_fd = accept_client(port);
+   if (client_fd < 0)
+   {
+      return 1;
+   }
+   LoadGenerator generator (profile);
+   g_generator = &generator;
+   signal(SIGINT, on_signal);
+   signal(SIGTERM, on_signal);
+   printf("client connected, rate %u frames/s, burst %u, malformed %u%%\n", profile.rate, profile.burst_size, profile.malformed_percent);
+   LoadReport report = generator.run(client_fd, print_report);
+   g_generator = nullptr;
+   printf("finished%s\n", report.peer_closed? ", client disconnected" : "");
+   print_report(report);
+   close(client_fd);
+   return 0;
+}
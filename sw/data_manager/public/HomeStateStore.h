@@ -0,0 +1,105 @@
+#ifndef _HOME_STATE_STORE_H_
+#define _HOME_STATE_STORE_H_
+
+/**
+ * @file HomeStateStore.h
+ *
+ * @brief
+ *    Current state of the home (env sensors, inputs, fan) which can be read from any thread.
+ *
+ * @details
+ *    State is kept as structure of arrays indexed by SmartHomeTypes IDs, so the whole state takes few cache lines.
+ *    Single writer (thread parsing notifications) updates it under seqlock - readers do not take any lock and
+ *    never delay the writer, read() is repeated only if it overlapped with an update, so every snapshot is consistent.
+ *    Items which were not received yet are marked as not valid.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <atomic>
+#include <stdint.h>
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "env_types.h"
+#include "inputs_types.h"
+#include "fan_types.h"
+#include "ItemCounts.h"
+
+/**
+ * @brief Consistent snapshot of the home state, arrays are indexed by ENV_ITEM_ID and INPUT_ID.
+ */
+struct HomeState
+{
+   int8_t temp_h [ENV_ITEMS_COUNT];      /**< Decimal part of temperature */
+   int8_t temp_l [ENV_ITEMS_COUNT];      /**< Fraction part of temperature */
+   uint8_t hum_h [ENV_ITEMS_COUNT];      /**< Decimal part of humidity */
+   uint8_t hum_l [ENV_ITEMS_COUNT];      /**< Fraction part of humidity */
+   bool env_valid [ENV_ITEMS_COUNT];     /**< Env sensor state received */
+   uint8_t inputs [INPUT_ITEMS_COUNT];  /**< INPUT_STATE of input */
+   bool inputs_valid [INPUT_ITEMS_COUNT]; /**< Input state received */
+   uint8_t fan;                               /**< FAN_STATE */
+   bool fan_valid;                            /**< Fan state received */
+   uint32_t version;                          /**< Number of changes since start */
+};
+
+class HomeStateStore
+{
+public:
+   HomeStateStore();
+   /**
+    * @brief Updates env sensor state, shall be called only by the writer thread.
+    * @param[in] id - sensor ID, IDs not smaller than ENV_ITEMS_COUNT are ignored.
+    * @param[in] temp_h - decimal part of temperature.
+    * @param[in] temp_l - fraction part of temperature.
+    * @param[in] hum_h - decimal part of humidity.
+    * @param[in] hum_l - fraction part of humidity.
+    * @return None.
+    */
+   void setEnv(uint8_t id, int8_t temp_h, int8_t temp_l, uint8_t hum_h, uint8_t hum_l);
+   /**
+    * @brief Updates input state, shall be called only by the writer thread.
+    * @param[in] id - input ID, IDs not smaller than INPUT_ITEMS_COUNT are ignored.
+    * @param[in] state - input state.
+    * @return None.
+    */
+   void setInput(uint8_t id, uint8_t state);
+   /**
+    * @brief Updates fan state, shall be called only by the writer thread.
+    * @param[in] state - fan state.
+    * @return None.
+    */
+   void setFan(uint8_t state);
+   /**
+    * @brief Reads consistent snapshot of the state, can be called from any thread.
+    * @param[out] snapshot - current state.
+    * @return None.
+    */
+   void read(HomeState& snapshot) const;
+   /**
+    * @brief Returns number of changes, allows to check for changes without reading the snapshot.
+    * @return Changes count.
+    */
+   uint32_t version() const;
+private:
+   void beginWrite();
+   void endWrite();
+
+   /* odd while update is in progress */
+   std::atomic<uint32_t> m_sequence;
+   std::atomic<int8_t> m_temp_h [ENV_ITEMS_COUNT];
+   std::atomic<int8_t> m_temp_l [ENV_ITEMS_COUNT];
+   std::atomic<uint8_t> m_hum_h [ENV_ITEMS_COUNT];
+   std::atomic<uint8_t> m_hum_l [ENV_ITEMS_COUNT];
+   std::atomic<bool> m_env_valid [ENV_ITEMS_COUNT];
+   std::atomic<uint8_t> m_inputs [INPUT_ITEMS_COUNT];
+   std::atomic<bool> m_inputs_valid [INPUT_ITEMS_COUNT];
+   std::atomic<uint8_t> m_fan;
+   std::atomic<bool> m_fan_valid;
+};
+
+#endif
@@ -10,6 +10,16 @@
  * @details
  *    Module is parsing the recevied messages from socket using SmartHomeTypes which are common for both applications (sender and receiver).
  *    After calling run() method, module keeps connecting to server since it is available.
+ *    When several servers are given, connection is kept with the first available one. When it is lost, remaining servers
+ *    are tried first, without waiting for retry period.
+ *    Link which stays silent for configured time is treated as dead and reconnected (see setLinkTimeout()).
+ *    Notifications are dispatched by table indexed with command ID - handlers of new notification types can be added
+ *    by registerHandler(), notifications without handler are counted (see getUnknownCount()).
+ *    Last known state of env sensors, inputs and fan is cached - values which did not change are not passed
+ *    to the main window (see setEnvHysteresis() and getSuppressedCount()).
+ *    Every received state is also stored in HomeStateStore, which can be read by any component from any thread.
+ *    After every connection state of all items is requested from the server at once (see getPopulateTime()), so GUI
+ *    does not show default values until each item reports its state.
  *    The MainWindowControl have to be passed during construction, to allow updating GUI.
  *
  * @author Jacek Skowronek
@@ -21,6 +31,21 @@
  *   Includes of common headers
  * =============================*/
 #include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ISocketDriver.h"
+#include "HomeStateStore.h"
+
+/**
+ * @brief Handler of received notification, called from the thread receiving data.
+ * @param[in] data - whole frame, starting with notification header.
+ * @param[in] size - size of the frame, payload size is already validated.
+ */
+typedef std::function<void(const uint8_t* data, size_t size)> NotificationHandler;
 
 class IDataProvider
 {
@@ -34,6 +59,73 @@ public:
     * @return True if connected successfully, otherwise false.
     */
    virtual bool run (const std::string& ip_address, uint16_t port, char c) = 0;
+   /**
+    * @brief Starts execution of DataProvider with redundant servers.
+    * @param[in] endpoints - servers ordered by priority.
+    * @param[in] c - message delimiter char.
+    * @return True if started successfully, otherwise false.
+    */
+   virtual bool run (const std::vector<SocketEndpoint>& endpoints, char c) = 0;
+   /**
+    * @brief Set framing mode used by the driver - shall be called before run().
+    * @details In FramingMode::LENGTH_PREFIXED frames are cut using length from notification header,
+    *          delimiter is still expected after each frame. In FramingMode::COBS delimiter is not used.
+    * @param[in] mode - framing mode, FramingMode::DELIMITER by default.
+    * @return None.
+    */
+   virtual void setFraming(FramingMode mode) = 0;
+   /**
+    * @brief Enables detection of silently dead link - shall be called before run().
+    * @details When ping is enabled and nothing is received for ping_period, NTF_SYSTEM_TIME request is sent,
+    *          so idle but alive server answers before the timeout expires.
+    * @param[in] timeout - link is dropped and reconnected when no frame is received for this time, 0 disables detection.
+    * @param[in] ping_period - silence after which ping is sent, 0 disables ping.
+    * @return None.
+    */
+   virtual void setLinkTimeout(std::chrono::milliseconds timeout, std::chrono::milliseconds ping_period) = 0;
+   /**
+    * @brief Sets handler of notification - shall be called before run().
+    * @details Replaces existing handler, also the built-in one (NTF_INPUTS_STATE, NTF_ENV_SENSOR_DATA, NTF_FAN_STATE).
+    * @param[in] id - command ID (NTF_CMD_ID or ID of new notification type).
+    * @param[in] handler - handler to call, nullptr removes the handler.
+    * @param[in] min_payload - frames with shorter payload are dropped without calling the handler.
+    * @return None.
+    */
+   virtual void registerHandler(uint8_t id, NotificationHandler handler, size_t min_payload = 0) = 0;
+   /**
+    * @brief Returns number of received notifications without handler.
+    * @return Notifications count.
+    */
+   virtual uint64_t getUnknownCount() = 0;
+   /**
+    * @brief Sets hysteresis of env sensor values - shall be called before run().
+    * @param[in] temperature - smallest temperature change passed to main window, in tenths of degree.
+    * @param[in] humidity - smallest humidity change passed to main window, in tenths of percent.
+    * @return None.
+    */
+   virtual void setEnvHysteresis(uint8_t temperature, uint8_t humidity) = 0;
+   /**
+    * @brief Returns number of received updates not passed to main window because the state did not change.
+    * @param[in] ntf_id - NTF_ENV_SENSOR_DATA, NTF_INPUTS_STATE or NTF_FAN_STATE.
+    * @param[in] item_id - ENV_ITEM_ID or INPUT_ID, ignored for fan.
+    * @return Updates count, 0 for other notifications.
+    */
+   virtual uint32_t getSuppressedCount(uint8_t ntf_id, uint8_t item_id) = 0;
+   /**
+    * @brief Returns current state of the home, updated with every received notification.
+    * @return Store which can be read from any thread, valid as long as the provider exists.
+    */
+   virtual const HomeStateStore& getHomeState() = 0;
+   /**
+    * @brief Returns time from the last connection until responses to all state requests were received.
+    * @return Time, negative while responses are still expected.
+    */
+   virtual std::chrono::microseconds getPopulateTime() = 0;
+   /**
+    * @brief Returns number of state requests sent after the last connection which were not answered yet.
+    * @return Requests count.
+    */
+   virtual size_t getPendingStateRequests() = 0;
    /**
     * @brief Stops execution of DataProvider.
     * @return None.
@@ -0,0 +1,105 @@
+#ifndef _IEVENTLOOP_H_
+#define _IEVENTLOOP_H_
+
+/**
+ * @file IEventLoop.h
+ *
+ * @brief
+ *    Interface of single threaded event loop - it is multiplexing file descriptors and timers.
+ *
+ * @details
+ *    All registered callbacks are called from the event loop thread, so modules using the same loop
+ *    do not need additional threads to wait for data or to wait for timeout.
+ *    After removeFd() or cancelTimer() returns, the related callback is not called anymore (also when
+ *    it was requested from other thread than event loop thread).
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include "stdint.h"
+#include <chrono>
+#include <functional>
+/* =============================
+ *           Defines
+ * =============================*/
+#define EVLOOP_INVALID_TIMER 0
+
+enum EventLoopFlag
+{
+   EVLOOP_READ  = 0x01, /**< File descriptor is ready to read */
+   EVLOOP_WRITE = 0x02, /**< File descriptor is ready to write */
+   EVLOOP_ERROR = 0x04, /**< Error or hang-up on file descriptor */
+};
+
+class IEventLoop
+{
+public:
+   typedef std::function<void(uint32_t events)> FdCallback;
+   typedef std::function<void()> TimerCallback;
+   typedef uint32_t TimerId;
+
+   /**
+    * @brief Starts event loop thread.
+    * @return True if started successfully, otherwise false.
+    */
+   virtual bool start() = 0;
+   /**
+    * @brief Stops event loop thread - waits until thread is finished.
+    * @return None.
+    */
+   virtual void stop() = 0;
+   /**
+    * @brief Returns current status.
+    * @return True if event loop is running, otherwise false.
+    */
+   virtual bool isRunning() = 0;
+   /**
+    * @brief Checks if method is called from event loop thread.
+    * @return True if called from event loop thread, otherwise false.
+    */
+   virtual bool isLoopThread() = 0;
+   /**
+    * @brief Adds file descriptor to observe.
+    * @param[in] fd - file descriptor.
+    * @param[in] events - mask of EventLoopFlag to observe.
+    * @param[in] callback - function called when one of events appears.
+    * @return True if added successfully, otherwise false.
+    */
+   virtual bool addFd(int fd, uint32_t events, FdCallback callback) = 0;
+   /**
+    * @brief Changes observed events of already added file descriptor.
+    * @param[in] fd - file descriptor.
+    * @param[in] events - mask of EventLoopFlag to observe.
+    * @return True if changed successfully, otherwise false.
+    */
+   virtual bool modifyFd(int fd, uint32_t events) = 0;
+   /**
+    * @brief Removes file descriptor - it shall be called before file descriptor is closed.
+    * @param[in] fd - file descriptor.
+    * @return None.
+    */
+   virtual void removeFd(int fd) = 0;
+   /**
+    * @brief Adds one-shot timer.
+    * @param[in] delay - time after which callback is called.
+    * @param[in] callback - function to call.
+    * @return Id of the timer, EVLOOP_INVALID_TIMER on error.
+    */
+   virtual TimerId addTimer(std::chrono::milliseconds delay, TimerCallback callback) = 0;
+   /**
+    * @brief Cancels timer - nothing happens if timer already expired.
+    * @param[in] id - id of the timer.
+    * @return None.
+    */
+   virtual void cancelTimer(TimerId id) = 0;
+
+   virtual ~IEventLoop(){};
+};
+
+
+#endif
@@ -9,7 +9,7 @@
  *
  * @details
  *    Data can be write to socket using write() method. Received data is provided through registered listeners.
- *    IP address cannot be empty. It is possible to provide either raw IP address and hostname. Port should be different than 0.
+ *    IP address cannot be empty. It is possible to provide either raw IPv4 or IPv6 address and hostname. Port should be different than 0.
  *
  * @author Jacek Skowronek
  * @date   05/02/2021
@@ -31,6 +31,58 @@ enum class DriverEvent
    DRIVER_DATA_RECV,    /**< New data received by driver */
 };
 
+enum class FramingMode
+{
+   DELIMITER,        /**< Frame ends with delimiter char (see setDelimiter()) */
+   LENGTH_PREFIXED,  /**< Frame length is taken from frame header (see setFrameLayout()) */
+   COBS,             /**< Frames are COBS encoded and end with 0x00, payload may contain any byte - also written data is encoded */
+};
+
+/**
+ * @brief Layout of the frame used in FramingMode::LENGTH_PREFIXED.
+ */
+struct FrameLayout
+{
+   size_t header_size;    /**< Number of bytes in frame header */
+   size_t length_offset;  /**< Offset of the payload length byte in header */
+   size_t trailer_size;   /**< Number of bytes sent after payload, they have to be equal to delimiter and are not part of the frame */
+   size_t max_payload;    /**< Frames with bigger payload are dropped as soon as header is received */
+};
+
+/**
+ * @brief Server address used in ISocketDriver::connectAny().
+ */
+struct SocketEndpoint
+{
+   std::string address;  /**< Address of the server, the same as in ISocketDriver::connect() */
+   uint16_t port;        /**< Connection port */
+};
+
+/**
+ * @brief Snapshot of driver statistics, counters are not reset on reconnection.
+ */
+struct SocketDriverStats
+{
+   uint64_t bytes_received;        /**< Bytes read from socket */
+   uint64_t bytes_sent;            /**< Bytes written to socket, including framing overhead */
+   uint64_t frames_delivered;      /**< Frames passed to listeners */
+   uint64_t frames_dropped;        /**< Frames dropped because of size, buffer overflow or lost synchronization */
+   uint64_t reconnects;            /**< Connections established after the first one */
+   uint64_t connected_time_ms;     /**< Duration of current connection, 0 when not connected */
+   size_t recv_buffer_high_water;  /**< Biggest number of bytes kept in receive buffer */
+   size_t write_queue_bytes;       /**< Bytes waiting in write queue */
+   size_t write_queue_frames;      /**< Frames waiting in write queue */
+};
+
+/**
+ * @brief Non-owning view of received frame - it is valid only during listener callback.
+ */
+struct FrameView
+{
+   const uint8_t* data; /**< First byte of the frame */
+   size_t size;         /**< Number of bytes in frame */
+};
+
 class SocketListener
 {
 public:
@@ -42,19 +94,91 @@ public:
     * @return None.
     */
    virtual void onSocketEvent(DriverEvent ev, const std::vector<uint8_t>& data, size_t size) = 0;
+   /**
+    * @brief Callback called with all complete frames extracted from single read.
+    * @details Default implementation calls onSocketEvent() with DRIVER_DATA_RECV for each frame.
+    * @param[in] frames - received frames.
+    * @param[in] count - number of frames.
+    * @return None.
+    */
+   virtual void onSocketBatch(const std::vector<std::vector<uint8_t>>& frames, size_t count)
+   {
+      for (size_t i = 0; i < count; i++)
+      {
+         onSocketEvent(DriverEvent::DRIVER_DATA_RECV, frames[i], frames[i].size());
+      }
+   }
+   /**
+    * @brief Callback called with all complete frames extracted from single read, without copying the data.
+    * @details Default implementation copies frames and calls onSocketBatch() - listener should override it to avoid allocations.
+    * @param[in] frames - array of frame views, pointing to driver receive buffer.
+    * @param[in] count - number of frames.
+    * @return None.
+    */
+   virtual void onSocketFrames(const FrameView* frames, size_t count)
+   {
+      std::vector<std::vector<uint8_t>> batch;
+      batch.reserve(count);
+      for (size_t i = 0; i < count; i++)
+      {
+         batch.emplace_back(frames[i].data, frames[i].data + frames[i].size);
+      }
+      onSocketBatch(batch, count);
+   }
 };
 
 class ISocketDriver
 {
 public:
+   /**
+    * @brief Callback called when data passed to writeAsync() was written (true) or dropped (false).
+    */
+   typedef std::function<void(bool)> WriteCallback;
+   /**
+    * @brief Callback called with index of connected endpoint passed to connectAsync(), -1 if none is available.
+    */
+   typedef std::function<void(int)> ConnectCallback;
 
    /**
     * @brief Connect to server.
+    * @details Caller waits for the result, so connectAsync() shall be used from event loop thread.
     * @param[in] ip_address - Address of the server (see @details).
     * @param[in] port - connection port (see @details).
     * @return True if connected successfully, otherwise false.
     */
    virtual bool connect(const std::string& ip_address, uint16_t port) = 0;
+   /**
+    * @brief Connect to the first available server from the list (hedged connect).
+    * @details Endpoints are ordered by priority. Attempt to the next endpoint is started when previous attempts failed
+    *          or did not succeed within hedge delay, without cancelling them - first established connection is kept,
+    *          remaining attempts are abandoned.
+    * @param[in] endpoints - servers to connect.
+    * @return Index of connected endpoint, -1 if none is available.
+    */
+   virtual int connectAny(const std::vector<SocketEndpoint>& endpoints) = 0;
+   /**
+    * @brief Connect to the first available server from the list without waiting for the result.
+    * @details The same as connect() for single endpoint and connectAny() for many, but the result is passed to the callback.
+    *          Driver working in event loop mode waits for the connection in the loop, the callback is called from loop thread.
+    *          Default implementation connects synchronously and calls the callback before return.
+    *          Connection in progress is abandoned by disconnect() or by next connectAsync() - the callback is not called then.
+    * @param[in] endpoints - servers to connect.
+    * @param[in] callback - called with index of connected endpoint, -1 if none is available.
+    * @return None.
+    */
+   virtual void connectAsync(const std::vector<SocketEndpoint>& endpoints, ConnectCallback callback)
+   {
+      int result = -1;
+      if (endpoints.size() == 1)
+      {
+         result = connect(endpoints[0].address, endpoints[0].port)? 0 : -1;
+      }
+      else
+      {
+         result = connectAny(endpoints);
+      }
+      callback(result);
+   }
    /**
     * @brief Disconnect from server.
     * @return True if disconnected successfully, otherwise false.
@@ -72,6 +196,7 @@ public:
    virtual void addListener(SocketListener* callback) = 0;
    /**
     * @brief Removes listener.
+    * @details Listener is not called after return, unless it is removed from its own callback.
     * @return None.
     */
    virtual void removeListener(SocketListener* callback) = 0;
@@ -79,13 +204,49 @@ public:
     * @brief Writes data to socket.
     * @param[in] data - bytes to write.
     * @param[in] size - number of bytes to write - if not provided, data.size() bytes will be written.
+    * @details Data is sent from caller thread. Frames queued before by writeAsync() are sent first to keep the order,
+    *          caller waits until they are written.
+    * @return True if all bytes were written, false if not connected or on write error.
     */
    virtual bool write(const std::vector<uint8_t>& data, size_t size = 0) = 0;
+   /**
+    * @brief Queues data to write without blocking the caller.
+    * @details Queued frames are written in batches (single sendmsg() for many frames) from driver thread.
+    *          Data is rejected when connection is not established or when queue would exceed the high water mark.
+    *          Frames not written before disconnection are dropped.
+    * @param[in] data - bytes to write.
+    * @param[in] callback - optional, called from driver thread when data is written or dropped.
+    * @return True if data was queued, otherwise false.
+    */
+   virtual bool writeAsync(const std::vector<uint8_t>& data, WriteCallback callback = nullptr) = 0;
+   /**
+    * @brief Set limit of bytes waiting in write queue.
+    * @param[in] bytes - limit in bytes.
+    */
+   virtual void setWriteHighWaterMark(size_t bytes) = 0;
    /**
     * @brief Set data delimiter.
     * @param[in] c - delimiter char.
     */
    virtual void setDelimiter(char c) = 0;
+   /**
+    * @brief Set the way how received stream is cut into frames.
+    * @param[in] mode - framing mode, FramingMode::DELIMITER by default.
+    */
+   virtual void setFraming(FramingMode mode) = 0;
+   /**
+    * @brief Set frame layout used in FramingMode::LENGTH_PREFIXED.
+    * @details Layout without length byte in header is rejected. Until valid layout is set, data received in
+    *          FramingMode::LENGTH_PREFIXED is dropped.
+    * @param[in] layout - frame layout.
+    */
+   virtual void setFrameLayout(const FrameLayout& layout) = 0;
+   /**
+    * @brief Returns driver statistics.
+    * @details Counters are read without locking, so it can be called often from any thread.
+    * @return Statistics snapshot.
+    */
+   virtual SocketDriverStats getStats() = 0;
    virtual ~ISocketDriver(){};
 };
 
@@ -0,0 +1,243 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "CaptureFile.h"
+#include "Logger.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <algorithm>
+
+namespace
+{
+CaptureHeader* header_of(uint8_t* mapping)
+{
+   return reinterpret_cast<CaptureHeader*>(mapping);
+}
+CaptureChunk* chunks_of(uint8_t* mapping)
+{
+   return reinterpret_cast<CaptureChunk*>(mapping + sizeof(CaptureHeader));
+}
+}
+
+CaptureWriter::CaptureWriter() :
+m_fd(-1),
+m_mapping(nullptr),
+m_mapping_size(0)
+{
+}
+bool CaptureWriter::create(const std::string& path, size_t index_capacity)
+{
+   bool result = false;
+   do
+   {
+      if (m_fd >= 0)
+      {
+         logger_send(LOG_ERROR, __func__, "already open");
+         break;
+      }
+      m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+      if (m_fd < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot create %s, err: %s", path.c_str(), strerror(errno));
+         break;
+      }
+      /* data region is page aligned */
+      const size_t page_size = sysconf(_SC_PAGESIZE);
+      const size_t data_offset = (sizeof(CaptureHeader) + index_capacity * sizeof(CaptureChunk) + page_size - 1) / page_size * page_size;
+      if (!grow(data_offset + CAPTURE_INITIAL_DATA_SIZE))
+      {
+         break;
+      }
+      CaptureHeader* header = header_of(m_mapping);
+      memcpy(header->magic, CAPTURE_MAGIC, sizeof(header->magic));
+      header->index_capacity = index_capacity;
+      header->data_offset = data_offset;
+      result = true;
+   } while(0);
+   if (!result)
+   {
+      close();
+   }
+   return result;
+}
+bool CaptureWriter::grow(size_t size)
+{
+   bool result = false;
+   do
+   {
+      if (ftruncate(m_fd, size) < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot resize file, err: %s", strerror(errno));
+         break;
+      }
+      void* mapping = m_mapping? mremap(m_mapping, m_mapping_size, size, MREMAP_MAYMOVE) :
+                                 mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+      if (mapping == MAP_FAILED)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot map file, err: %s", strerror(errno));
+         break;
+      }
+      m_mapping = static_cast<uint8_t*>(mapping);
+      m_mapping_size = size;
+      result = true;
+   } while(0);
+   return result;
+}
+bool CaptureWriter::append(const uint8_t* data, size_t size, uint64_t timestamp_ns)
+{
+   bool result = false;
+   do
+   {
+      if (!m_mapping)
+      {
+         break;
+      }
+      CaptureHeader* header = header_of(m_mapping);
+      if (header->chunks_count == header->index_capacity)
+      {
+         logger_send(LOG_ERROR, __func__, "capture index full");
+         break;
+      }
+      const size_t end = header->data_offset + header->data_size + size;
+      if (end > m_mapping_size && !grow(std::max(end, m_mapping_size * 2)))
+      {
+         break;
+      }
+      header = header_of(m_mapping);
+      memcpy(m_mapping + header->data_offset + header->data_size, data, size);
+      CaptureChunk& chunk = chunks_of(m_mapping)[header->chunks_count];
+      chunk.timestamp_ns = timestamp_ns;
+      chunk.end = header->data_size + size;
+      header->data_size += size;
+      /* chunk is visible for readers of unfinished file only when its data is complete */
+      __atomic_store_n(&header->chunks_count, header->chunks_count + 1, __ATOMIC_RELEASE);
+      result = true;
+   } while(0);
+   return result;
+}
+void CaptureWriter::close()
+{
+   size_t used_size = 0;
+   if (m_mapping)
+   {
+      used_size = header_of(m_mapping)->data_offset + header_of(m_mapping)->data_size;
+      munmap(m_mapping, m_mapping_size);
+      m_mapping = nullptr;
+      m_mapping_size = 0;
+   }
+   if (m_fd >= 0)
+   {
+      if (used_size > 0 && ftruncate(m_fd, used_size) < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot truncate file, err: %s", strerror(errno));
+      }
+      ::close(m_fd);
+      m_fd = -1;
+   }
+}
+bool CaptureWriter::isOpen() const
+{
+   return m_mapping != nullptr;
+}
+CaptureWriter::~CaptureWriter()
+{
+   close();
+}
+
+CaptureReader::CaptureReader() :
+m_mapping(nullptr),
+m_mapping_size(0),
+m_chunks(nullptr),
+m_chunks_count(0)
+{
+}
+bool CaptureReader::open(const std::string& path)
+{
+   bool result = false;
+   int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+   do
+   {
+      struct stat file_stat = {};
+      if (fd < 0 || fstat(fd, &file_stat) < 0 || static_cast<size_t>(file_stat.st_size) < sizeof(CaptureHeader))
+      {
+         logger_send(LOG_ERROR, __func__, "cannot open %s", path.c_str());
+         break;
+      }
+      close();
+      /* private mapping - data can be decoded in place without modifying the file */
+      void* mapping = mmap(nullptr, file_stat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot map file, err: %s", strerror(errno));
+         break;
+      }
+      m_mapping = static_cast<uint8_t*>(mapping);
+      m_mapping_size = file_stat.st_size;
+      const CaptureHeader* header = header_of(m_mapping);
+      const uint64_t chunks_count = __atomic_load_n(&header->chunks_count, __ATOMIC_ACQUIRE);
+      /* index size is checked before multiplication, as corrupted capacity can overflow it */
+      if (memcmp(header->magic, CAPTURE_MAGIC, sizeof(header->magic)) != 0 || chunks_count > header->index_capacity ||
+          header->index_capacity > (m_mapping_size - sizeof(CaptureHeader)) / sizeof(CaptureChunk) ||
+          header->data_offset < sizeof(CaptureHeader) + header->index_capacity * sizeof(CaptureChunk) ||
+          header->data_offset > m_mapping_size)
+      {
+         logger_send(LOG_ERROR, __func__, "invalid capture file %s", path.c_str());
+         break;
+      }
+      m_chunks = chunks_of(m_mapping);
+      /* chunks have to be ordered and placed in the file */
+      const size_t data_size = m_mapping_size - header->data_offset;
+      m_chunks_count = 0;
+      while (m_chunks_count < chunks_count && m_chunks[m_chunks_count].end <= data_size &&
+             (m_chunks_count == 0 || (m_chunks[m_chunks_count].end >= m_chunks[m_chunks_count - 1].end &&
+                                      m_chunks[m_chunks_count].timestamp_ns >= m_chunks[m_chunks_count - 1].timestamp_ns)))
+      {
+         m_chunks_count++;
+      }
+      logger_send_if(m_chunks_count != chunks_count, LOG_ERROR, __func__, "only %zu of %zu chunks valid", m_chunks_count, (size_t)chunks_count);
+      result = true;
+   } while(0);
+   if (fd >= 0)
+   {
+      ::close(fd);
+   }
+   if (!result)
+   {
+      close();
+   }
+   return result;
+}
+void CaptureReader::close()
+{
+   if (m_mapping)
+   {
+      munmap(m_mapping, m_mapping_size);
+      m_mapping = nullptr;
+      m_mapping_size = 0;
+   }
+   m_chunks = nullptr;
+   m_chunks_count = 0;
+}
+size_t CaptureReader::chunks() const
+{
+   return m_chunks_count;
+}
+const CaptureChunk& CaptureReader::chunk(size_t index) const
+{
+   return m_chunks[index];
+}
+uint8_t* CaptureReader::data()
+{
+   return m_mapping? m_mapping + header_of(m_mapping)->data_offset : nullptr;
+}
+CaptureReader::~CaptureReader()
+{
+   close();
+}
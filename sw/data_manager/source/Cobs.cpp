@@ -0,0 +1,67 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "Cobs.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <string.h>
+#include <algorithm>
+
+/* longest block of non-zero bytes described by single code byte */
+const size_t COBS_MAX_BLOCK = 254;
+const uint8_t COBS_FULL_BLOCK_CODE = 0xFF;
+
+namespace cobs
+{
+size_t encode(const uint8_t* src, size_t size, uint8_t* dst)
+{
+   size_t in = 0;
+   size_t out = 0;
+   while(true)
+   {
+      const size_t chunk = std::min(size - in, COBS_MAX_BLOCK);
+      const uint8_t* zero = static_cast<const uint8_t*>(memchr(src + in, COBS_DELIMITER, chunk));
+      const size_t block = zero? (zero - (src + in)) : chunk;
+      /* block is moved before writing the code byte - it allows src to overlap dst */
+      memmove(dst + out + 1, src + in, block);
+      dst[out] = static_cast<uint8_t>(block + 1);
+      out += block + 1;
+      in += block;
+      if (zero)
+      {
+         /* zero byte is replaced by the code byte, after the last one empty block is still needed */
+         in++;
+      }
+      else if (block < COBS_MAX_BLOCK || in == size)
+      {
+         break;
+      }
+   }
+   return out;
+}
+bool decode(uint8_t* data, size_t size, size_t& decoded_size)
+{
+   bool result = true;
+   size_t in = 0;
+   size_t out = 0;
+   while (in < size)
+   {
+      const uint8_t code = data[in];
+      if (code == COBS_DELIMITER || (in + code) > size)
+      {
+         result = false;
+         break;
+      }
+      memmove(data + out, data + in + 1, code - 1);
+      out += code - 1;
+      in += code;
+      if (code != COBS_FULL_BLOCK_CODE && in < size)
+      {
+         data[out++] = COBS_DELIMITER;
+      }
+   }
+   decoded_size = out;
+   return result;
+}
+}
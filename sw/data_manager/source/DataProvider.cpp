@@ -9,67 +9,423 @@
 /* =============================
  *   Includes of common headers
  * =============================*/
+#include <algorithm>
 
-/* period between next connection attempts */
+/* delay after first failed connection attempt, doubled after each next failure */
+const uint16_t DRV_CONN_FIRST_RETRY = 100;
+/* maximum period between next connection attempts, also period of status check when connected */
 const uint16_t DRV_CONN_RETRY_PERIOD = 5000;
+/* delays are randomly shortened by up to this value */
+const uint8_t DRV_CONN_RETRY_JITTER_PERCENT = 20;
+
+/* notifications handled by provider itself, other ones can be added by registerHandler() */
+const DataProvider::BuiltinHandler DataProvider::BUILTIN_HANDLERS[] =
+{
+   {NTF_SYSTEM_TIME, &DataProvider::parse_time_event, 0},
+   {NTF_INPUTS_STATE, &DataProvider::parse_input_event, DATA_PROV_INPUT_ITEM_SIZE},
+   {NTF_ENV_SENSOR_DATA, &DataProvider::parse_env_event, DATA_PROV_ENV_ITEM_SIZE},
+   {NTF_FAN_STATE, &DataProvider::parse_fan_event, 1},
+   /* items are parsed up to the payload end, empty list is valid */
+   {NTF_INPUTS_STATE_ALL, &DataProvider::parse_inputs_all_event, 0},
+   {NTF_ENV_SENSOR_DATA_ALL, &DataProvider::parse_env_all_event, 0},
+};
+/* state of every item is requested after connection, requests are sent at once without waiting for responses */
+const uint8_t DataProvider::STATE_REQUESTS[] =
+{
+   NTF_INPUTS_STATE_ALL,
+   NTF_ENV_SENSOR_DATA_ALL,
+   NTF_FAN_STATE,
+};
 
 namespace thread
 {
-__attribute__((weak)) void sleep (std::chrono::milliseconds ms)
+__attribute__((weak)) bool wait_for (WakeupEvent& event, std::chrono::milliseconds ms)
 {
-   std::this_thread::sleep_for(ms);
+   return event.waitFor(ms);
+}
+/* time used for link supervision, replaced in tests to check timing without real waiting */
+__attribute__((weak)) std::chrono::steady_clock::time_point now()
+{
+   return std::chrono::steady_clock::now();
 }
 }
 DataProvider::DataProvider(IMainWindowWrapper& main_window, ISocketDriver& driver) :
 m_main_window(main_window),
-m_port(0),
+m_endpoints(1, SocketEndpoint{"", 0}),
+m_active_endpoint(-1),
+m_first_endpoint(0),
 m_delimiter('\n'),
+m_framing(FramingMode::DELIMITER),
 m_driver(driver),
-m_thread_running(false)
+m_thread_running(false),
+m_loop(nullptr),
+m_timer(EVLOOP_INVALID_TIMER),
+m_relink_timer(EVLOOP_INVALID_TIMER),
+m_reconnect_policy(std::chrono::milliseconds(DRV_CONN_FIRST_RETRY), std::chrono::milliseconds(DRV_CONN_RETRY_PERIOD),
+                   DRV_CONN_RETRY_JITTER_PERCENT, std::random_device()()),
+m_link_timeout(0),
+m_ping_period(0),
+m_last_frame(0),
+m_unknown_count(0),
+m_pending_requests(0),
+m_connected_at(0),
+m_populate_time(-1)
+{
+   for (const BuiltinHandler& builtin : BUILTIN_HANDLERS)
+   {
+      const auto parse = builtin.parse;
+      m_handlers[builtin.id].handler = [this, parse](const uint8_t* data, size_t size){ (this->*parse)(data, size); };
+      m_handlers[builtin.id].min_payload = builtin.min_payload;
+   }
+}
+DataProvider::DataProvider(IMainWindowWrapper& main_window, ISocketDriver& driver, IEventLoop& loop) :
+DataProvider(main_window, driver)
 {
+   m_loop = &loop;
 }
 
 bool DataProvider::run(const std::string& ip_address, uint16_t port, char c)
+{
+   return run(std::vector<SocketEndpoint>{{ip_address, port}}, c);
+}
+bool DataProvider::run(const std::vector<SocketEndpoint>& endpoints, char c)
 {
    bool result = false;
 
-   if (!m_thread_running)
+   if (!m_thread_running && !endpoints.empty())
    {
-      logger_send(LOG_DATAPROV, __func__, "starting");
-      m_server_address = ip_address;
-      m_port = port;
+      logger_send(LOG_DATAPROV, __func__, "starting, %u endpoints", (uint32_t)endpoints.size());
+      m_endpoints = endpoints;
+      m_active_endpoint = -1;
+      m_first_endpoint = 0;
       m_delimiter = c;
       m_driver.setDelimiter(c);
+      if (m_framing == FramingMode::LENGTH_PREFIXED)
+      {
+         /* CoreApplication terminates every frame with delimiter, it is checked by driver as a trailer */
+         m_driver.setFrameLayout({NTF_HEADER_SIZE, NTF_BYTES_COUNT_OFFSET, 1, DATA_PROV_MAX_PAYLOAD_SIZE});
+      }
+      m_driver.setFraming(m_framing);
       m_driver.addListener(this);
-      m_thread = std::thread(&DataProvider::executeThread, this);
-      while(!m_thread_running);
+      touchLink();
+      if (m_loop)
+      {
+         std::lock_guard<std::mutex> lock (m_mtx);
+         m_thread_running = true;
+         m_timer = m_loop->addTimer(std::chrono::milliseconds(0), [this](){ onReconnectTimer(); });
+      }
+      else
+      {
+         m_thread_running = true;
+         m_thread = std::thread(&DataProvider::executeThread, this);
+      }
       result = true;
    }
 
    return result;
 }
 
+void DataProvider::setFraming(FramingMode mode)
+{
+   logger_send(LOG_DATAPROV, __func__, "framing %u", (uint8_t)mode);
+   m_framing = mode;
+}
+void DataProvider::setLinkTimeout(std::chrono::milliseconds timeout, std::chrono::milliseconds ping_period)
+{
+   logger_send(LOG_DATAPROV, __func__, "timeout %u ms, ping %u ms", (uint32_t)timeout.count(), (uint32_t)ping_period.count());
+   m_link_timeout = timeout;
+   m_ping_period = ping_period;
+}
+void DataProvider::registerHandler(uint8_t id, NotificationHandler handler, size_t min_payload)
+{
+   logger_send(LOG_DATAPROV, __func__, "id %u, %s, min payload %u", id, handler? "set" : "removed", (uint32_t)min_payload);
+   m_handlers[id].handler = std::move(handler);
+   m_handlers[id].min_payload = min_payload;
+}
+uint64_t DataProvider::getUnknownCount()
+{
+   return m_unknown_count.load(std::memory_order_relaxed);
+}
+void DataProvider::setEnvHysteresis(uint8_t temperature, uint8_t humidity)
+{
+   logger_send(LOG_DATAPROV, __func__, "temperature %u, humidity %u", temperature, humidity);
+   m_state_cache.setEnvHysteresis(temperature, humidity);
+}
+uint32_t DataProvider::getSuppressedCount(uint8_t ntf_id, uint8_t item_id)
+{
+   uint32_t result = 0;
+   switch (ntf_id)
+   {
+   case NTF_ENV_SENSOR_DATA:
+      result = m_state_cache.envSuppressed(item_id);
+      break;
+   case NTF_INPUTS_STATE:
+      result = m_state_cache.inputSuppressed(item_id);
+      break;
+   case NTF_FAN_STATE:
+      result = m_state_cache.fanSuppressed();
+      break;
+   default:
+      break;
+   }
+   return result;
+}
+const HomeStateStore& DataProvider::getHomeState()
+{
+   return m_home_state;
+}
+std::chrono::microseconds DataProvider::getPopulateTime()
+{
+   return std::chrono::microseconds(m_populate_time.load());
+}
+size_t DataProvider::getPendingStateRequests()
+{
+   size_t result = 0;
+   for (uint32_t pending = m_pending_requests.load(); pending; pending &= pending - 1)
+   {
+      result++;
+   }
+   return result;
+}
 void DataProvider::executeThread()
 {
-   m_thread_running = true;
+   /* first connection attempt is always made, then thread is woken up when link is dropped or thread shall be stopped */
+   do
+   {
+      thread::wait_for(m_wakeup, checkConnection());
+   } while(m_thread_running);
 
-   while(m_thread_running)
+   return;
+}
+void DataProvider::onReconnectTimer()
+{
+   if (m_driver.isConnected())
    {
-      if (!m_driver.isConnected())
+      scheduleCheck(checkLink());
+   }
+   else
+   {
+      /* loop thread is not blocked by connection, next check is scheduled when the result is known */
+      size_t first = 0;
+      const std::vector<SocketEndpoint> endpoints = nextEndpoints(first);
+      m_driver.connectAsync(endpoints, [this, first](int index){ scheduleCheck(onConnectResult(first, index)); });
+   }
+}
+void DataProvider::scheduleCheck(std::chrono::milliseconds delay)
+{
+   std::lock_guard<std::mutex> lock (m_mtx);
+   if (m_thread_running)
+   {
+      m_timer = m_loop->addTimer(delay, [this](){ onReconnectTimer(); });
+   }
+}
+void DataProvider::onRelinkTimer()
+{
+   bool running = false;
+   {
+      std::lock_guard<std::mutex> lock (m_mtx);
+      m_relink_timer = EVLOOP_INVALID_TIMER;
+      running = m_thread_running;
+      if (running)
       {
-         if (m_driver.connect(m_server_address, m_port))
-         {
-            logger_send(LOG_DATAPROV, __func__, "connected");
-         }
-         else
-         {
-            logger_send(LOG_DATAPROV, __func__, "retry");
-         }
+         /* called from loop thread, so it does not wait for callbacks */
+         m_loop->cancelTimer(m_timer);
+         m_timer = EVLOOP_INVALID_TIMER;
       }
-      thread::sleep(std::chrono::milliseconds(DRV_CONN_RETRY_PERIOD));
    }
-
-   return;
+   if (running)
+   {
+      onReconnectTimer();
+   }
+}
+std::chrono::milliseconds DataProvider::checkConnection()
+{
+   std::chrono::milliseconds result (DRV_CONN_RETRY_PERIOD);
+   if (!m_driver.isConnected())
+   {
+      size_t first = 0;
+      const std::vector<SocketEndpoint> endpoints = nextEndpoints(first);
+      int index = -1;
+      if (endpoints.size() == 1)
+      {
+         index = m_driver.connect(endpoints[0].address, endpoints[0].port)? 0 : -1;
+      }
+      else
+      {
+         index = m_driver.connectAny(endpoints);
+      }
+      result = onConnectResult(first, index);
+   }
+   else
+   {
+      result = checkLink();
+   }
+   return result;
+}
+std::vector<SocketEndpoint> DataProvider::nextEndpoints(size_t& first)
+{
+   std::lock_guard<std::mutex> lock (m_mtx);
+   std::vector<SocketEndpoint> result;
+   first = m_first_endpoint;
+   for (size_t i = 0; i < m_endpoints.size(); i++)
+   {
+      result.push_back(m_endpoints[(first + i) % m_endpoints.size()]);
+   }
+   return result;
+}
+std::chrono::milliseconds DataProvider::onConnectResult(size_t first, int index)
+{
+   std::chrono::milliseconds result (DRV_CONN_RETRY_PERIOD);
+   bool is_connected = false;
+   {
+      std::lock_guard<std::mutex> lock (m_mtx);
+      if (index >= 0)
+      {
+         const size_t connected = (first + index) % m_endpoints.size();
+         logger_send(LOG_DATAPROV, __func__, "connected to %s after %u attempts", m_endpoints[connected].address.c_str(),
+                     m_reconnect_policy.failedAttempts() + 1);
+         m_active_endpoint = connected;
+         m_reconnect_policy.reset();
+         touchLink();
+         is_connected = true;
+      }
+      else
+      {
+         result = m_reconnect_policy.nextDelay();
+         logger_send(LOG_DATAPROV, __func__, "retry in %u ms", (uint32_t)result.count());
+      }
+   }
+   if (is_connected)
+   {
+      result = checkLink();
+   }
+   return result;
+}
+std::chrono::milliseconds DataProvider::checkLink()
+{
+   /* link drop is reported by driver event, so connection status is checked rarely */
+   std::chrono::milliseconds result (DRV_CONN_RETRY_PERIOD);
+   if (m_link_timeout.count() > 0)
+   {
+      result = checkLiveness();
+   }
+   return result;
+}
+std::chrono::milliseconds DataProvider::checkLiveness()
+{
+   const std::chrono::steady_clock::time_point now = thread::now();
+   const std::chrono::steady_clock::time_point last_frame {std::chrono::steady_clock::duration(m_last_frame.load())};
+   const std::chrono::milliseconds silence = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_frame);
+   std::chrono::milliseconds result = m_link_timeout - silence;
+   if (silence >= m_link_timeout)
+   {
+      /* peer may be gone without closing the connection - GUI would show stale data until TCP notices it */
+      logger_send(LOG_ERROR, __func__, "nothing received for %u ms, reconnecting", (uint32_t)silence.count());
+      m_driver.disconnect();
+      m_pending_requests = 0;
+      std::lock_guard<std::mutex> lock (m_mtx);
+      releaseActiveEndpoint();
+      result = std::chrono::milliseconds(0);
+   }
+   else if (m_ping_period.count() > 0)
+   {
+      std::chrono::milliseconds ping_silence = std::min(silence, std::chrono::duration_cast<std::chrono::milliseconds>(now - m_last_ping));
+      if (ping_silence >= m_ping_period)
+      {
+         sendPing();
+         m_last_ping = now;
+         ping_silence = std::chrono::milliseconds(0);
+      }
+      result = std::min(result, m_ping_period - ping_silence);
+   }
+   return result;
+}
+void DataProvider::sendPing()
+{
+   /* any response refreshes the link, CoreApplication answers with current time */
+   logger_send_if(!sendRequest(NTF_SYSTEM_TIME), LOG_ERROR, __func__, "cannot send ping");
+}
+bool DataProvider::sendRequest(uint8_t id)
+{
+   /* request has no payload */
+   std::vector<uint8_t> request (NTF_HEADER_SIZE);
+   request[NTF_ID_OFFSET] = id;
+   request[NTF_REQ_TYPE_OFFSET] = NTF_GET;
+   request[NTF_BYTES_COUNT_OFFSET] = 0;
+   if (m_framing != FramingMode::COBS)
+   {
+      request.push_back(m_delimiter);
+   }
+   return m_driver.writeAsync(request);
+}
+void DataProvider::requestState()
+{
+   const uint32_t all_requests = (1u << (sizeof(STATE_REQUESTS) / sizeof(STATE_REQUESTS[0]))) - 1;
+   m_populate_time = -1;
+   m_connected_at = thread::now().time_since_epoch().count();
+   /* pending mask is set before sending, responses may be received before the last request is queued */
+   m_pending_requests = all_requests;
+   for (size_t i = 0; i < sizeof(STATE_REQUESTS) / sizeof(STATE_REQUESTS[0]); i++)
+   {
+      if (!sendRequest(STATE_REQUESTS[i]))
+      {
+         logger_send(LOG_ERROR, __func__, "cannot request state %u", STATE_REQUESTS[i]);
+         m_pending_requests.fetch_and(~(1u << i));
+      }
+   }
+}
+void DataProvider::onStateResponse(uint8_t id)
+{
+   const uint8_t* request = std::find(std::begin(STATE_REQUESTS), std::end(STATE_REQUESTS), id);
+   if (request != std::end(STATE_REQUESTS))
+   {
+      const uint32_t bit = 1u << (request - std::begin(STATE_REQUESTS));
+      const uint32_t pending = m_pending_requests.fetch_and(~bit);
+      if (pending == bit)
+      {
+         const std::chrono::steady_clock::time_point connected_at {std::chrono::steady_clock::duration(m_connected_at.load())};
+         const std::chrono::microseconds time =
+               std::chrono::duration_cast<std::chrono::microseconds>(thread::now() - connected_at);
+         m_populate_time = time.count();
+         logger_send(LOG_DATAPROV, __func__, "state populated in %u us", (uint32_t)time.count());
+      }
+   }
+}
+void DataProvider::touchLink()
+{
+   m_last_frame = thread::now().time_since_epoch().count();
+   m_last_ping = thread::now();
+}
+void DataProvider::onLinkDropped()
+{
+   /* responses to requests sent over dropped link will not arrive, state is requested again after reconnection */
+   m_pending_requests = 0;
+   std::lock_guard<std::mutex> lock (m_mtx);
+   releaseActiveEndpoint();
+   /* reconnect immediately instead of waiting for the status check */
+   if (m_loop && m_thread_running)
+   {
+      /* status check is cancelled from loop thread - cancelTimer() called from driver thread waits for running
+       * callback, which may be waiting for this thread (e.g. driver thread joined by disconnect()) */
+      if (m_relink_timer == EVLOOP_INVALID_TIMER)
+      {
+         m_relink_timer = m_loop->addTimer(std::chrono::milliseconds(0), [this](){ onRelinkTimer(); });
+      }
+   }
+   else
+   {
+      m_wakeup.notify();
+   }
+}
+void DataProvider::releaseActiveEndpoint()
+{
+   m_reconnect_policy.reset();
+   if (m_active_endpoint >= 0)
+   {
+      /* failover - other endpoints are tried before the one which has just dropped */
+      m_first_endpoint = (m_active_endpoint + 1) % m_endpoints.size();
+      m_active_endpoint = -1;
+   }
 }
 void DataProvider::onSocketEvent(DriverEvent ev, const std::vector<uint8_t>& data, size_t size)
 {
@@ -77,33 +433,66 @@ void DataProvider::onSocketEvent(DriverEvent ev, const std::vector<uint8_t>& dat
    switch(ev)
    {
    case DriverEvent::DRIVER_DATA_RECV:
-      parse_message(data, size);
+      m_last_frame = thread::now().time_since_epoch().count();
+      if (data.size() >= size)
+      {
+         parse_message(data.data(), size);
+         flush_gui_updates();
+      }
+      break;
+   case DriverEvent::DRIVER_CONNECTED:
+      requestState();
+      break;
+   case DriverEvent::DRIVER_DISCONNECTED:
+      onLinkDropped();
       break;
    default:
       break;
    }
 }
-void DataProvider::parse_message(const std::vector<uint8_t>& data, size_t size)
+void DataProvider::onSocketBatch(const std::vector<std::vector<uint8_t>>& frames, size_t count)
 {
-   if (data.size() >= size)
+   logger_send(LOG_DATAPROV, __func__, "sockdrv batch %u", (uint32_t)count);
+   m_last_frame = thread::now().time_since_epoch().count();
+   for (size_t i = 0; i < count && i < frames.size(); i++)
+   {
+      parse_message(frames[i].data(), frames[i].size());
+   }
+   flush_gui_updates();
+}
+void DataProvider::onSocketFrames(const FrameView* frames, size_t count)
+{
+   logger_send(LOG_DATAPROV, __func__, "sockdrv frames %u", (uint32_t)count);
+   m_last_frame = thread::now().time_since_epoch().count();
+   for (size_t i = 0; i < count; i++)
+   {
+      parse_message(frames[i].data, frames[i].size);
+   }
+   flush_gui_updates();
+}
+void DataProvider::parse_message(const uint8_t* data, size_t size)
+{
+   if (size >= NTF_HEADER_SIZE)
    {
       const uint8_t exp_payload_size = data[NTF_BYTES_COUNT_OFFSET];
       const uint8_t recv_payload_size = size - NTF_HEADER_SIZE;
-      if (exp_payload_size == recv_payload_size)
+      /* in length-prefixed mode frame size is taken from header by driver */
+      if (m_framing == FramingMode::LENGTH_PREFIXED || exp_payload_size == recv_payload_size)
       {
-         switch ((NTF_CMD_ID)data[NTF_ID_OFFSET])
+         const HandlerEntry& entry = m_handlers[data[NTF_ID_OFFSET]];
+         if (entry.handler && recv_payload_size < entry.min_payload)
          {
-         case NTF_INPUTS_STATE:
-            parse_input_event(data, size);
-            break;
-         case NTF_ENV_SENSOR_DATA:
-            parse_env_event(data, size);
-            break;
-         case NTF_FAN_STATE:
-            parse_fan_event(data, size);
-            break;
-         default:
-            break;
+            logger_send(LOG_ERROR, __func__, "payload too short for %u, e: %u, r: %u", data[NTF_ID_OFFSET],
+                        (uint32_t)entry.min_payload, recv_payload_size);
+         }
+         else if (entry.handler)
+         {
+            entry.handler(data, size);
+         }
+         else
+         {
+            m_unknown_count.fetch_add(1, std::memory_order_relaxed);
+            logger_send(LOG_DATAPROV, __func__, "unknown notification %u", data[NTF_ID_OFFSET]);
          }
       }
       else
@@ -112,50 +501,138 @@ void DataProvider::parse_message(const std::vector<uint8_t>& data, size_t size)
       }
    }
 }
-bool DataProvider::parse_env_event(const std::vector<uint8_t>& data, size_t size)
+bool DataProvider::parse_env_event(const uint8_t* data, size_t size)
 {
    bool result = false;
    logger_send(LOG_DATAPROV, __func__, "got env event");
    if ((NTF_REQ_TYPE)data[NTF_REQ_TYPE_OFFSET] == NTF_NTF)
    {
-      ENV_ITEM_ID id = (ENV_ITEM_ID)data[NTF_HEADER_SIZE];
-      uint8_t hum_h = data[NTF_HEADER_SIZE + 2];
-      uint8_t hum_l = data[NTF_HEADER_SIZE + 3];
-      int8_t temp_h = data[NTF_HEADER_SIZE + 4];
-      int8_t temp_l = data[NTF_HEADER_SIZE + 5];
-      logger_send(LOG_DATAPROV, __func__, "env id %u, t:%u.%u, h %u.%u", (uint8_t)id, temp_h, temp_l, hum_h, hum_l);
-      m_main_window.setEnvState(id, temp_h, temp_l, hum_h, hum_l);
+      apply_env_state(&data[NTF_HEADER_SIZE]);
       result = true;
    }
    return result;
 }
-bool DataProvider::parse_input_event(const std::vector<uint8_t>& data, size_t size)
+bool DataProvider::parse_input_event(const uint8_t* data, size_t size)
 {
    bool result = false;
    logger_send(LOG_DATAPROV, __func__, "got env event");
    if ((NTF_REQ_TYPE)data[NTF_REQ_TYPE_OFFSET] == NTF_NTF)
    {
-      INPUT_ID id = (INPUT_ID) data[NTF_HEADER_SIZE];
-      INPUT_STATE state = (INPUT_STATE) data[NTF_HEADER_SIZE + 1];
-      logger_send(LOG_DATAPROV, __func__, "inp id %u, state %u", id, state);
-      m_main_window.setInputState(id, state);
+      apply_input_state(&data[NTF_HEADER_SIZE]);
       result = true;
    }
    return result;
 }
-bool DataProvider::parse_fan_event(const std::vector<uint8_t>& data, size_t size)
+bool DataProvider::parse_fan_event(const uint8_t* data, size_t size)
 {
    bool result = false;
+   const NTF_REQ_TYPE type = (NTF_REQ_TYPE)data[NTF_REQ_TYPE_OFFSET];
    logger_send(LOG_DATAPROV, __func__, "fan ev recevied");
-   if ((NTF_REQ_TYPE)data[NTF_REQ_TYPE_OFFSET] == NTF_NTF)
+   /* NTF_GET is the response to state request */
+   if (type == NTF_NTF || type == NTF_GET)
+   {
+      apply_fan_state(data[NTF_HEADER_SIZE]);
+      if (type == NTF_GET)
+      {
+         onStateResponse(NTF_FAN_STATE);
+      }
+      result = true;
+   }
+   return result;
+}
+bool DataProvider::parse_env_all_event(const uint8_t* data, size_t size)
+{
+   bool result = false;
+   const NTF_REQ_TYPE type = (NTF_REQ_TYPE)data[NTF_REQ_TYPE_OFFSET];
+   logger_send(LOG_DATAPROV, __func__, "got env states, size %u", (uint32_t)size);
+   if (type == NTF_NTF || type == NTF_GET)
    {
-      FAN_STATE state = (FAN_STATE) data[NTF_HEADER_SIZE];
-      logger_send(LOG_DATAPROV, __func__, "fan state %u", state);
-      m_main_window.setFanState(state);
+      for (size_t offset = NTF_HEADER_SIZE; offset + DATA_PROV_ENV_ITEM_SIZE <= size; offset += DATA_PROV_ENV_ITEM_SIZE)
+      {
+         apply_env_state(&data[offset]);
+      }
+      if (type == NTF_GET)
+      {
+         onStateResponse(NTF_ENV_SENSOR_DATA_ALL);
+      }
+      result = true;
+   }
+   return result;
+}
+bool DataProvider::parse_inputs_all_event(const uint8_t* data, size_t size)
+{
+   bool result = false;
+   const NTF_REQ_TYPE type = (NTF_REQ_TYPE)data[NTF_REQ_TYPE_OFFSET];
+   logger_send(LOG_DATAPROV, __func__, "got inputs states, size %u", (uint32_t)size);
+   if (type == NTF_NTF || type == NTF_GET)
+   {
+      for (size_t offset = NTF_HEADER_SIZE; offset + DATA_PROV_INPUT_ITEM_SIZE <= size; offset += DATA_PROV_INPUT_ITEM_SIZE)
+      {
+         apply_input_state(&data[offset]);
+      }
+      if (type == NTF_GET)
+      {
+         onStateResponse(NTF_INPUTS_STATE_ALL);
+      }
       result = true;
    }
    return result;
 }
+void DataProvider::apply_env_state(const uint8_t* item)
+{
+   ENV_ITEM_ID id = (ENV_ITEM_ID)item[0];
+   uint8_t hum_h = item[2];
+   uint8_t hum_l = item[3];
+   int8_t temp_h = item[4];
+   int8_t temp_l = item[5];
+   logger_send(LOG_DATAPROV, __func__, "env id %u, t:%u.%u, h %u.%u", (uint8_t)id, temp_h, temp_l, hum_h, hum_l);
+   m_home_state.setEnv(id, temp_h, temp_l, hum_h, hum_l);
+   if (m_state_cache.updateEnv(id, temp_h, temp_l, hum_h, hum_l))
+   {
+      if (!m_gui_updates.setEnvState(id, temp_h, temp_l, hum_h, hum_l))
+      {
+         logger_send(LOG_ERROR, __func__, "unknown env id %u", (uint8_t)id);
+      }
+   }
+}
+void DataProvider::apply_input_state(const uint8_t* item)
+{
+   INPUT_ID id = (INPUT_ID) item[0];
+   INPUT_STATE state = (INPUT_STATE) item[1];
+   logger_send(LOG_DATAPROV, __func__, "inp id %u, state %u", id, state);
+   m_home_state.setInput(id, state);
+   if (m_state_cache.updateInput(id, state))
+   {
+      if (!m_gui_updates.setInputState(id, state))
+      {
+         logger_send(LOG_ERROR, __func__, "unknown input id %u", (uint8_t)id);
+      }
+   }
+}
+void DataProvider::apply_fan_state(uint8_t state)
+{
+   logger_send(LOG_DATAPROV, __func__, "fan state %u", state);
+   m_home_state.setFan(state);
+   if (m_state_cache.updateFan(state))
+   {
+      m_gui_updates.setFanState((FAN_STATE)state);
+   }
+}
+bool DataProvider::parse_time_event(const uint8_t* data, size_t size)
+{
+   /* answer to ping - link is refreshed by every received frame */
+   logger_send(LOG_DATAPROV, __func__, "time received");
+   return (NTF_REQ_TYPE)data[NTF_REQ_TYPE_OFFSET] == NTF_NTF;
+}
+void DataProvider::flush_gui_updates()
+{
+   if (!m_gui_updates.empty())
+   {
+      logger_send(LOG_DATAPROV, __func__, "updates %u", (uint32_t)m_gui_updates.updates_count);
+      m_main_window.setStateBatch(m_gui_updates);
+      m_gui_updates.clear();
+   }
+}
 void DataProvider::stop()
 {
    logger_send(LOG_DATAPROV, __func__, "disconnecting");
@@ -170,9 +647,22 @@ DataProvider::~DataProvider()
 {
    if (m_thread_running)
    {
-      m_thread_running = false;
+      IEventLoop::TimerId timer = EVLOOP_INVALID_TIMER;
+      IEventLoop::TimerId relink_timer = EVLOOP_INVALID_TIMER;
+      {
+         std::lock_guard<std::mutex> lock (m_mtx);
+         m_thread_running = false;
+         timer = m_timer;
+         relink_timer = m_relink_timer;
+      }
+      if (m_loop)
+      {
+         m_loop->cancelTimer(timer);
+         m_loop->cancelTimer(relink_timer);
+      }
       if (m_thread.joinable())
       {
+         m_wakeup.notify();
          m_thread.join();
       }
    }
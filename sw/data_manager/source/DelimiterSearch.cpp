@@ -0,0 +1,166 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "DelimiterSearch.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#if defined (__x86_64__) || defined (__i386__)
+#include <immintrin.h>
+#define DELIM_SEARCH_X86
+#endif
+#if defined (DELIM_SEARCH_NEON) && defined (__arm__)
+#include <sys/auxv.h>
+#endif
+
+namespace delimiter_search
+{
+#if defined (DELIM_SEARCH_NEON)
+/* defined in DelimiterSearchNeon.cpp - only that file is compiled with NEON instructions enabled */
+size_t find_neon(const uint8_t* data, size_t size, uint8_t delimiter, std::vector<size_t>& positions);
+#endif
+namespace
+{
+typedef size_t (*FindFunction)(const uint8_t*, size_t, uint8_t, std::vector<size_t>&);
+
+/* scans bytes from begin to size, used also for the tail not filling whole vector */
+inline size_t find_from(const uint8_t* data, size_t begin, size_t size, uint8_t delimiter, std::vector<size_t>& positions)
+{
+   size_t found = 0;
+   for (size_t i = begin; i < size; i++)
+   {
+      if (data[i] == delimiter)
+      {
+         positions.push_back(i);
+         found++;
+      }
+   }
+   return found;
+}
+/* converts comparison bitmask (bit per byte) to positions */
+inline size_t add_positions(uint32_t mask, size_t offset, std::vector<size_t>& positions)
+{
+   size_t found = 0;
+   while (mask)
+   {
+      positions.push_back(offset + __builtin_ctz(mask));
+      mask &= mask - 1;
+      found++;
+   }
+   return found;
+}
+size_t find_scalar(const uint8_t* data, size_t size, uint8_t delimiter, std::vector<size_t>& positions)
+{
+   return find_from(data, 0, size, delimiter, positions);
+}
+#if defined (DELIM_SEARCH_X86)
+__attribute__((target("sse2")))
+size_t find_sse2(const uint8_t* data, size_t size, uint8_t delimiter, std::vector<size_t>& positions)
+{
+   const size_t VECTOR_SIZE = 16;
+   const __m128i pattern = _mm_set1_epi8(static_cast<char>(delimiter));
+   size_t found = 0;
+   size_t i = 0;
+   for (; i + VECTOR_SIZE <= size; i += VECTOR_SIZE)
+   {
+      const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+      found += add_positions(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)), i, positions);
+   }
+   return found + find_from(data, i, size, delimiter, positions);
+}
+__attribute__((target("avx2")))
+size_t find_avx2(const uint8_t* data, size_t size, uint8_t delimiter, std::vector<size_t>& positions)
+{
+   const size_t VECTOR_SIZE = 32;
+   const __m256i pattern = _mm256_set1_epi8(static_cast<char>(delimiter));
+   size_t found = 0;
+   size_t i = 0;
+   for (; i + VECTOR_SIZE <= size; i += VECTOR_SIZE)
+   {
+      const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+      found += add_positions(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)), i, positions);
+   }
+   return found + find_from(data, i, size, delimiter, positions);
+}
+#endif
+FindFunction get_function(Kernel kernel)
+{
+   FindFunction result = find_scalar;
+   if (isSupported(kernel))
+   {
+      switch (kernel)
+      {
+#if defined (DELIM_SEARCH_X86)
+      case Kernel::SSE2:
+         result = find_sse2;
+         break;
+      case Kernel::AVX2:
+         result = find_avx2;
+         break;
+#endif
+#if defined (DELIM_SEARCH_NEON)
+      case Kernel::NEON:
+         result = find_neon;
+         break;
+#endif
+      default:
+         break;
+      }
+   }
+   return result;
+}
+}
+
+bool isSupported(Kernel kernel)
+{
+   bool result = false;
+#if defined (DELIM_SEARCH_X86)
+   __builtin_cpu_init();
+#endif
+   switch (kernel)
+   {
+   case Kernel::SCALAR:
+      result = true;
+      break;
+#if defined (DELIM_SEARCH_X86)
+   case Kernel::SSE2:
+      result = __builtin_cpu_supports("sse2");
+      break;
+   case Kernel::AVX2:
+      result = __builtin_cpu_supports("avx2");
+      break;
+#endif
+#if defined (DELIM_SEARCH_NEON)
+   case Kernel::NEON:
+#if defined (__arm__)
+      /* the same binary runs on boards without NEON (e.g. Raspberry Pi 1) */
+      result = (getauxval(AT_HWCAP) & HWCAP_ARM_NEON) != 0;
+#else
+      /* mandatory on AArch64 */
+      result = true;
+#endif
+      break;
+#endif
+   default:
+      break;
+   }
+   return result;
+}
+Kernel bestKernel()
+{
+   static const Kernel kernel = isSupported(Kernel::AVX2)? Kernel::AVX2 :
+                                isSupported(Kernel::SSE2)? Kernel::SSE2 :
+                                isSupported(Kernel::NEON)? Kernel::NEON : Kernel::SCALAR;
+   return kernel;
+}
+size_t findAll(const uint8_t* data, size_t size, uint8_t delimiter, std::vector<size_t>& positions)
+{
+   static const FindFunction function = get_function(bestKernel());
+   return function(data, size, delimiter, positions);
+}
+size_t findAll(Kernel kernel, const uint8_t* data, size_t size, uint8_t delimiter, std::vector<size_t>& positions)
+{
+   return get_function(kernel)(data, size, delimiter, positions);
+}
+
+}
@@ -0,0 +1,45 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "DelimiterSearch.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <arm_neon.h>
+
+namespace delimiter_search
+{
+
+/* file is compiled with NEON enabled, so it is called only after runtime check of CPU features */
+size_t find_neon(const uint8_t* data, size_t size, uint8_t delimiter, std::vector<size_t>& positions)
+{
+   const size_t VECTOR_SIZE = 16;
+   const uint8x16_t pattern = vdupq_n_u8(delimiter);
+   size_t found = 0;
+   size_t i = 0;
+   for (; i + VECTOR_SIZE <= size; i += VECTOR_SIZE)
+   {
+      const uint8x16_t equal = vceqq_u8(vld1q_u8(data + i), pattern);
+      /* NEON has no movemask - comparison result is narrowed to 4 bits per byte */
+      uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)), 0);
+      while (mask)
+      {
+         const uint32_t bit = __builtin_ctzll(mask);
+         positions.push_back(i + (bit / 4));
+         mask &= ~(0xFULL << bit);
+         found++;
+      }
+   }
+   /* tail not filling whole vector */
+   for (; i < size; i++)
+   {
+      if (data[i] == delimiter)
+      {
+         positions.push_back(i);
+         found++;
+      }
+   }
+   return found;
+}
+
+}
@@ -0,0 +1,85 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "DriverCounters.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <chrono>
+#include <algorithm>
+
+namespace
+{
+int64_t now_ms()
+{
+   return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+DriverCounters::DriverCounters() :
+m_bytes_received(0),
+m_bytes_sent(0),
+m_frames_delivered(0),
+m_frames_dropped(0),
+m_connections(0),
+m_connected_since_ms(0),
+m_recv_buffer_high_water(0),
+m_write_queue_bytes(0),
+m_write_queue_frames(0)
+{
+}
+void DriverCounters::setConnected(bool connected)
+{
+   int64_t since = 0;
+   if (connected)
+   {
+      since = now_ms();
+      m_connections.fetch_add(1, std::memory_order_relaxed);
+   }
+   m_connected_since_ms.store(since, std::memory_order_relaxed);
+}
+void DriverCounters::addReceived(size_t bytes, size_t stored_bytes)
+{
+   if (stored_bytes > m_recv_buffer_high_water.load(std::memory_order_relaxed))
+   {
+      /* only receiving thread writes the value */
+      m_recv_buffer_high_water.store(stored_bytes, std::memory_order_relaxed);
+   }
+   m_bytes_received.fetch_add(bytes, std::memory_order_relaxed);
+}
+void DriverCounters::addDelivered(size_t frames)
+{
+   m_frames_delivered.fetch_add(frames, std::memory_order_relaxed);
+}
+void DriverCounters::setDropped(size_t frames)
+{
+   m_frames_dropped.store(frames, std::memory_order_relaxed);
+}
+void DriverCounters::addSent(size_t bytes)
+{
+   m_bytes_sent.fetch_add(bytes, std::memory_order_relaxed);
+}
+void DriverCounters::setWriteQueue(size_t bytes, size_t frames)
+{
+   m_write_queue_bytes.store(bytes, std::memory_order_relaxed);
+   m_write_queue_frames.store(frames, std::memory_order_relaxed);
+}
+SocketDriverStats DriverCounters::get() const
+{
+   SocketDriverStats result = {};
+   result.bytes_received = m_bytes_received.load(std::memory_order_relaxed);
+   result.bytes_sent = m_bytes_sent.load(std::memory_order_relaxed);
+   result.frames_delivered = m_frames_delivered.load(std::memory_order_relaxed);
+   result.frames_dropped = m_frames_dropped.load(std::memory_order_relaxed);
+   const uint64_t connections = m_connections.load(std::memory_order_relaxed);
+   result.reconnects = connections > 0? connections - 1 : 0;
+   const int64_t connected_since = m_connected_since_ms.load(std::memory_order_relaxed);
+   if (connected_since != 0)
+   {
+      result.connected_time_ms = std::max<int64_t>(now_ms() - connected_since, 0);
+   }
+   result.recv_buffer_high_water = m_recv_buffer_high_water.load(std::memory_order_relaxed);
+   result.write_queue_bytes = m_write_queue_bytes.load(std::memory_order_relaxed);
+   result.write_queue_frames = m_write_queue_frames.load(std::memory_order_relaxed);
+   return result;
+}
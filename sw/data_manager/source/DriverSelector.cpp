@@ -0,0 +1,147 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "DriverSelector.h"
+#include "ShmDriver.h"
+#include "Logger.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <string.h>
+
+namespace
+{
+bool is_shm_address(const std::string& address)
+{
+   return address.compare(0, strlen(SHMDRV_SCHEME), SHMDRV_SCHEME) == 0;
+}
+/* returns end of the group of consecutive endpoints using the same transport */
+size_t group_end(const std::vector<SocketEndpoint>& endpoints, size_t begin)
+{
+   const bool is_shm = is_shm_address(endpoints[begin].address);
+   size_t end = begin + 1;
+   while (end < endpoints.size() && is_shm_address(endpoints[end].address) == is_shm)
+   {
+      end++;
+   }
+   return end;
+}
+}
+
+DriverSelector::DriverSelector(ISocketDriver& socket_driver, ISocketDriver& shm_driver) :
+m_socket_driver(socket_driver),
+m_shm_driver(shm_driver),
+m_active(&socket_driver)
+{
+}
+bool DriverSelector::connect(const std::string& address, uint16_t port)
+{
+   return select(address)->connect(address, port);
+}
+int DriverSelector::connectAny(const std::vector<SocketEndpoint>& endpoints)
+{
+   int result = -1;
+   size_t begin = 0;
+   while (result < 0 && begin < endpoints.size())
+   {
+      const size_t end = group_end(endpoints, begin);
+      const std::vector<SocketEndpoint> group (endpoints.begin() + begin, endpoints.begin() + end);
+      const int index = select(endpoints[begin].address)->connectAny(group);
+      if (index >= 0)
+      {
+         result = begin + index;
+      }
+      begin = end;
+   }
+   return result;
+}
+void DriverSelector::connectAsync(const std::vector<SocketEndpoint>& endpoints, ConnectCallback callback)
+{
+   connectGroup(endpoints, 0, std::move(callback));
+}
+void DriverSelector::connectGroup(const std::vector<SocketEndpoint>& endpoints, size_t begin, ConnectCallback callback)
+{
+   if (begin < endpoints.size())
+   {
+      const size_t end = group_end(endpoints, begin);
+      const std::vector<SocketEndpoint> group (endpoints.begin() + begin, endpoints.begin() + end);
+      /* next group is tried when result of the previous one is known */
+      select(endpoints[begin].address)->connectAsync(group, [this, endpoints, begin, end, callback](int index)
+      {
+         if (index >= 0)
+         {
+            callback(begin + index);
+         }
+         else
+         {
+            connectGroup(endpoints, end, callback);
+         }
+      });
+   }
+   else
+   {
+      callback(-1);
+   }
+}
+ISocketDriver* DriverSelector::select(const std::string& address)
+{
+   const bool is_shm = is_shm_address(address);
+   ISocketDriver* selected = is_shm? &m_shm_driver : &m_socket_driver;
+   if (selected != m_active)
+   {
+      logger_send(LOG_SOCKDRV, __func__, "switching to %s transport", is_shm? "shm" : "socket");
+      m_active.load()->disconnect();
+      m_active = selected;
+   }
+   return selected;
+}
+bool DriverSelector::disconnect()
+{
+   return m_active.load()->disconnect();
+}
+bool DriverSelector::isConnected()
+{
+   return m_active.load()->isConnected();
+}
+void DriverSelector::addListener(SocketListener* callback)
+{
+   m_socket_driver.addListener(callback);
+   m_shm_driver.addListener(callback);
+}
+void DriverSelector::removeListener(SocketListener* callback)
+{
+   m_socket_driver.removeListener(callback);
+   m_shm_driver.removeListener(callback);
+}
+bool DriverSelector::write(const std::vector<uint8_t>& data, size_t size)
+{
+   return m_active.load()->write(data, size);
+}
+bool DriverSelector::writeAsync(const std::vector<uint8_t>& data, WriteCallback callback)
+{
+   return m_active.load()->writeAsync(data, std::move(callback));
+}
+void DriverSelector::setWriteHighWaterMark(size_t bytes)
+{
+   m_socket_driver.setWriteHighWaterMark(bytes);
+   m_shm_driver.setWriteHighWaterMark(bytes);
+}
+void DriverSelector::setDelimiter(char c)
+{
+   m_socket_driver.setDelimiter(c);
+   m_shm_driver.setDelimiter(c);
+}
+void DriverSelector::setFraming(FramingMode mode)
+{
+   m_socket_driver.setFraming(mode);
+   m_shm_driver.setFraming(mode);
+}
+void DriverSelector::setFrameLayout(const FrameLayout& layout)
+{
+   m_socket_driver.setFrameLayout(layout);
+   m_shm_driver.setFrameLayout(layout);
+}
+SocketDriverStats DriverSelector::getStats()
+{
+   return m_active.load()->getStats();
+}
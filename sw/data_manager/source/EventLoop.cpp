@@ -0,0 +1,309 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "EventLoop.h"
+#include "Logger.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+namespace
+{
+uint32_t to_epoll_events(uint32_t events)
+{
+   uint32_t result = 0;
+   result |= (events & EVLOOP_READ)? (uint32_t)EPOLLIN : 0;
+   result |= (events & EVLOOP_WRITE)? (uint32_t)EPOLLOUT : 0;
+   return result;
+}
+uint32_t from_epoll_events(uint32_t epoll_events)
+{
+   uint32_t result = 0;
+   result |= (epoll_events & EPOLLIN)? EVLOOP_READ : 0;
+   result |= (epoll_events & EPOLLOUT)? EVLOOP_WRITE : 0;
+   result |= (epoll_events & (EPOLLERR | EPOLLHUP))? EVLOOP_ERROR : 0;
+   return result;
+}
+}
+
+EventLoop::EventLoop() :
+m_epoll_fd(-1),
+m_wakeup_fd(-1),
+m_running(false),
+m_next_timer_id(EVLOOP_INVALID_TIMER + 1)
+{
+}
+bool EventLoop::start()
+{
+   bool result = false;
+   logger_send(LOG_SOCKDRV, __func__, "");
+   do
+   {
+      if (m_running)
+      {
+         break;
+      }
+      m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+      if (m_epoll_fd < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot create epoll, err: %s", strerror(errno));
+         break;
+      }
+      m_wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      if (m_wakeup_fd < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot create eventfd, err: %s", strerror(errno));
+         break;
+      }
+      struct epoll_event ev = {};
+      ev.events = EPOLLIN;
+      ev.data.fd = m_wakeup_fd;
+      if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_wakeup_fd, &ev) < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot add eventfd, err: %s", strerror(errno));
+         break;
+      }
+      std::lock_guard<std::mutex> lock (m_mutex);
+      m_running = true;
+      m_thread = std::thread(&EventLoop::threadExecute, this);
+      m_thread_id = m_thread.get_id();
+      result = true;
+   }while(0);
+
+   if (!result && !m_running)
+   {
+      stop();
+   }
+   return result;
+}
+void EventLoop::stop()
+{
+   logger_send(LOG_SOCKDRV, __func__, "");
+   m_running = false;
+   if (m_thread.joinable())
+   {
+      if (isLoopThread())
+      {
+         logger_send(LOG_ERROR, __func__, "cannot stop from loop thread");
+         return;
+      }
+      wakeup();
+      m_thread.join();
+      m_thread_id = std::thread::id();
+   }
+   if (m_wakeup_fd >= 0)
+   {
+      close(m_wakeup_fd);
+      m_wakeup_fd = -1;
+   }
+   if (m_epoll_fd >= 0)
+   {
+      close(m_epoll_fd);
+      m_epoll_fd = -1;
+   }
+}
+bool EventLoop::isRunning()
+{
+   return m_running;
+}
+bool EventLoop::isLoopThread()
+{
+   return std::this_thread::get_id() == m_thread_id;
+}
+bool EventLoop::addFd(int fd, uint32_t events, FdCallback callback)
+{
+   bool result = false;
+   std::lock_guard<std::mutex> lock (m_mutex);
+   if (m_epoll_fd >= 0 && fd >= 0 && callback)
+   {
+      struct epoll_event ev = {};
+      ev.events = to_epoll_events(events);
+      ev.data.fd = fd;
+      if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &ev) == 0)
+      {
+         m_fds[fd] = callback;
+         result = true;
+      }
+   }
+   logger_send_if(!result, LOG_ERROR, __func__, "cannot add fd %d", fd);
+   return result;
+}
+bool EventLoop::modifyFd(int fd, uint32_t events)
+{
+   bool result = false;
+   std::lock_guard<std::mutex> lock (m_mutex);
+   if (m_fds.find(fd) != m_fds.end())
+   {
+      struct epoll_event ev = {};
+      ev.events = to_epoll_events(events);
+      ev.data.fd = fd;
+      result = epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, fd, &ev) == 0;
+   }
+   logger_send_if(!result, LOG_ERROR, __func__, "cannot modify fd %d", fd);
+   return result;
+}
+void EventLoop::removeFd(int fd)
+{
+   {
+      std::lock_guard<std::mutex> lock (m_mutex);
+      auto it = m_fds.find(fd);
+      if (it != m_fds.end())
+      {
+         epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+         m_fds.erase(it);
+      }
+   }
+   waitForCallback();
+}
+IEventLoop::TimerId EventLoop::addTimer(std::chrono::milliseconds delay, TimerCallback callback)
+{
+   TimerId result = EVLOOP_INVALID_TIMER;
+   if (callback)
+   {
+      std::lock_guard<std::mutex> lock (m_mutex);
+      result = m_next_timer_id++;
+      if (m_next_timer_id == EVLOOP_INVALID_TIMER)
+      {
+         m_next_timer_id++;
+      }
+      m_timers[result] = callback;
+      m_timers_queue.insert(std::make_pair(std::chrono::steady_clock::now() + delay, result));
+   }
+   if (!isLoopThread())
+   {
+      wakeup();
+   }
+   return result;
+}
+void EventLoop::cancelTimer(TimerId id)
+{
+   {
+      std::lock_guard<std::mutex> lock (m_mutex);
+      m_timers.erase(id);
+   }
+   waitForCallback();
+}
+void EventLoop::wakeup()
+{
+   if (m_wakeup_fd >= 0)
+   {
+      uint64_t value = 1;
+      ssize_t bytes = ::write(m_wakeup_fd, &value, sizeof(value));
+      (void) bytes;
+   }
+}
+void EventLoop::waitForCallback()
+{
+   /* callback could be in progress on loop thread - wait for it, the next one will not find removed item or timer */
+   if (!isLoopThread())
+   {
+      std::lock_guard<std::mutex> lock (m_callback_mutex);
+   }
+}
+int EventLoop::getTimeout()
+{
+   int result = -1;
+   std::lock_guard<std::mutex> lock (m_mutex);
+   while (!m_timers_queue.empty())
+   {
+      auto it = m_timers_queue.begin();
+      if (m_timers.find(it->second) == m_timers.end())
+      {
+         /* timer cancelled */
+         m_timers_queue.erase(it);
+         continue;
+      }
+      auto now = std::chrono::steady_clock::now();
+      result = 0;
+      if (it->first > now)
+      {
+         /* round up, to not wake up before timer expiration */
+         result = std::chrono::duration_cast<std::chrono::milliseconds>(it->first - now + std::chrono::microseconds(999)).count();
+      }
+      break;
+   }
+   return result;
+}
+void EventLoop::processTimers()
+{
+   auto now = std::chrono::steady_clock::now();
+   while (m_running)
+   {
+      std::lock_guard<std::mutex> callback_lock (m_callback_mutex);
+      TimerCallback callback;
+      {
+         std::lock_guard<std::mutex> lock (m_mutex);
+         auto it = m_timers_queue.begin();
+         if (it == m_timers_queue.end() || it->first > now)
+         {
+            break;
+         }
+         auto timer = m_timers.find(it->second);
+         if (timer != m_timers.end())
+         {
+            callback = timer->second;
+            m_timers.erase(timer);
+         }
+         m_timers_queue.erase(it);
+      }
+      if (callback)
+      {
+         callback();
+      }
+   }
+}
+void EventLoop::processFdEvent(int fd, uint32_t epoll_events)
+{
+   std::lock_guard<std::mutex> callback_lock (m_callback_mutex);
+   FdCallback callback;
+   {
+      std::lock_guard<std::mutex> lock (m_mutex);
+      auto it = m_fds.find(fd);
+      if (it != m_fds.end())
+      {
+         callback = it->second;
+      }
+   }
+   if (callback)
+   {
+      callback(from_epoll_events(epoll_events));
+   }
+}
+void EventLoop::threadExecute()
+{
+   struct epoll_event events [EVLOOP_MAX_EVENTS];
+   logger_send(LOG_SOCKDRV, __func__, "starting thread!");
+
+   while(m_running)
+   {
+      int count = epoll_wait(m_epoll_fd, events, EVLOOP_MAX_EVENTS, getTimeout());
+      if (count < 0 && errno != EINTR)
+      {
+         logger_send(LOG_ERROR, __func__, "epoll error: %s", strerror(errno));
+         break;
+      }
+      for (int i = 0; i < count && m_running; i++)
+      {
+         if (events[i].data.fd == m_wakeup_fd)
+         {
+            uint64_t value = 0;
+            ssize_t bytes = ::read(m_wakeup_fd, &value, sizeof(value));
+            (void) bytes;
+         }
+         else
+         {
+            processFdEvent(events[i].data.fd, events[i].events);
+         }
+      }
+      processTimers();
+   }
+}
+EventLoop::~EventLoop()
+{
+   stop();
+}
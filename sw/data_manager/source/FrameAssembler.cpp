@@ -0,0 +1,280 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "FrameAssembler.h"
+#include "Cobs.h"
+#include "DelimiterSearch.h"
+#include "Logger.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <algorithm>
+
+FrameAssembler::FrameAssembler() :
+FrameAssembler(0)
+{
+   m_external = true;
+}
+FrameAssembler::FrameAssembler(size_t capacity) :
+m_storage(capacity, 0),
+m_data(m_storage.data()),
+m_capacity(capacity),
+m_external(false),
+m_read_pos(0),
+m_scan_pos(0),
+m_write_pos(0),
+m_delimiter('\n'),
+m_mode(FramingMode::DELIMITER),
+m_layout({0, 0, 0, 0}),
+m_layout_valid(false),
+m_discard(false),
+m_resync(false),
+m_skip(0),
+m_dropped(0),
+m_frames(capacity),
+m_frames_count(0)
+{
+   /* every byte may be a delimiter (empty frame) - neither search nor frames extraction allocates */
+   m_positions.reserve(capacity);
+}
+void FrameAssembler::attach(uint8_t* data, size_t size)
+{
+   m_data = data;
+   m_capacity = size;
+   m_external = true;
+   m_write_pos = 0;
+   reset();
+}
+void FrameAssembler::setDelimiter(uint8_t delimiter)
+{
+   m_delimiter = delimiter;
+}
+void FrameAssembler::setFraming(FramingMode mode)
+{
+   m_mode = mode;
+   reset();
+}
+bool FrameAssembler::setFrameLayout(const FrameLayout& layout)
+{
+   /* empty header would give zero-size frames, stream would never move forward */
+   const bool result = layout.header_size > 0 && layout.length_offset < layout.header_size;
+   if (result)
+   {
+      m_layout = layout;
+      m_layout_valid = true;
+   }
+   else
+   {
+      logger_send(LOG_ERROR, __func__, "invalid layout, header %u, length offset %u", (uint32_t)layout.header_size,
+                  (uint32_t)layout.length_offset);
+   }
+   reset();
+   return result;
+}
+void FrameAssembler::reset()
+{
+   /* external store is passed through once, buffered data is dropped without moving back */
+   m_read_pos = m_external? m_write_pos : 0;
+   m_scan_pos = m_read_pos;
+   m_write_pos = m_read_pos;
+   m_discard = false;
+   m_resync = false;
+   m_skip = 0;
+   m_frames_count = 0;
+}
+uint8_t* FrameAssembler::writePtr()
+{
+   return m_data + m_write_pos;
+}
+size_t FrameAssembler::writeSpace() const
+{
+   return m_capacity - m_write_pos;
+}
+size_t FrameAssembler::commit(size_t bytes)
+{
+   m_write_pos += std::min(bytes, writeSpace());
+   m_frames_count = 0;
+   if (m_mode == FramingMode::LENGTH_PREFIXED)
+   {
+      extractLengthPrefixed();
+   }
+   else
+   {
+      extractDelimited();
+   }
+   return m_frames_count;
+}
+void FrameAssembler::extractDelimited()
+{
+   /* only new bytes are scanned, beginning of the incomplete frame was checked before */
+   const uint8_t delimiter = (m_mode == FramingMode::COBS)? COBS_DELIMITER : m_delimiter;
+   m_positions.clear();
+   delimiter_search::findAll(m_data + m_scan_pos, m_write_pos - m_scan_pos, delimiter, m_positions);
+   for (size_t offset : m_positions)
+   {
+      size_t pos = m_scan_pos + offset;
+      if (m_discard)
+      {
+         /* end of the dropped frame - next frame starts after delimiter */
+         m_discard = false;
+      }
+      else if (m_mode == FramingMode::COBS)
+      {
+         addEncodedFrame(m_read_pos, pos);
+      }
+      else
+      {
+         addFrame(m_read_pos, pos);
+      }
+      m_read_pos = pos + 1;
+   }
+   m_scan_pos = m_write_pos;
+}
+void FrameAssembler::extractLengthPrefixed()
+{
+   if (!m_layout_valid)
+   {
+      logger_send(LOG_ERROR, __func__, "frame layout not set, dropping %u bytes", (uint32_t)pending());
+      m_read_pos = m_write_pos;
+   }
+   while (m_read_pos < m_write_pos)
+   {
+      if (m_skip > 0)
+      {
+         /* bytes of frame dropped because of its size */
+         size_t bytes = std::min(m_skip, pending());
+         m_read_pos += bytes;
+         m_skip -= bytes;
+         continue;
+      }
+      if (m_discard && !skipToDelimiter())
+      {
+         break;
+      }
+      if (pending() < m_layout.header_size)
+      {
+         break;
+      }
+      const size_t payload = m_data[m_read_pos + m_layout.length_offset];
+      const size_t frame_size = m_layout.header_size + payload;
+      const size_t total_size = frame_size + m_layout.trailer_size;
+      if (m_resync && (payload > m_layout.max_payload || total_size > m_capacity))
+      {
+         /* length of a real header is not trusted until the stream is in sync - next delimiter is tried */
+         m_discard = true;
+         continue;
+      }
+      if (payload > m_layout.max_payload || total_size > m_capacity)
+      {
+         logger_send(LOG_ERROR, __func__, "frame too long, dropping %u bytes", (uint32_t)total_size);
+         m_dropped++;
+         m_skip = total_size;
+         continue;
+      }
+      if (pending() < total_size)
+      {
+         break;
+      }
+      const uint8_t* trailer = m_data + m_read_pos + frame_size;
+      if (static_cast<size_t>(std::count(trailer, trailer + m_layout.trailer_size, m_delimiter)) != m_layout.trailer_size)
+      {
+         /* frame start after each next delimiter is checked, the malformed frame is counted once */
+         logger_send_if(!m_resync, LOG_ERROR, __func__, "invalid trailer, resynchronizing");
+         m_dropped += m_resync? 0 : 1;
+         m_resync = true;
+         m_discard = true;
+         continue;
+      }
+      addFrame(m_read_pos, m_read_pos + frame_size);
+      m_read_pos += total_size;
+      m_resync = false;
+   }
+   m_scan_pos = m_read_pos;
+}
+bool FrameAssembler::skipToDelimiter()
+{
+   const uint8_t* begin = m_data;
+   const uint8_t* end = begin + m_write_pos;
+   const uint8_t* it = std::find(begin + m_read_pos, end, m_delimiter);
+   m_read_pos = (it == end)? m_write_pos : (it - begin) + 1;
+   m_discard = (it == end);
+   return !m_discard;
+}
+const FrameView* FrameAssembler::frames() const
+{
+   return m_frames.data();
+}
+void FrameAssembler::release()
+{
+   m_frames_count = 0;
+   if (m_discard)
+   {
+      /* bytes of dropped frame are not kept */
+      m_read_pos = m_write_pos;
+   }
+   /* data in external store is never moved, positions are its offsets */
+   if (!m_external && m_read_pos == m_write_pos)
+   {
+      m_read_pos = 0;
+      m_scan_pos = 0;
+      m_write_pos = 0;
+   }
+   else if (!m_external && writeSpace() < (m_capacity / 4))
+   {
+      wrap();
+   }
+}
+size_t FrameAssembler::pending() const
+{
+   return m_write_pos - m_read_pos;
+}
+size_t FrameAssembler::dropped() const
+{
+   return m_dropped;
+}
+void FrameAssembler::addFrame(size_t begin, size_t end)
+{
+   if (m_frames_count == m_frames.size())
+   {
+      /* owned store never holds more frames than bytes, only views of external store are added here */
+      m_frames.resize(m_frames.size() * 2 + 1);
+   }
+   m_frames[m_frames_count].data = m_data + begin;
+   m_frames[m_frames_count].size = end - begin;
+   m_frames_count++;
+}
+void FrameAssembler::addEncodedFrame(size_t begin, size_t end)
+{
+   /* empty frames are skipped - sender may put additional delimiters to resynchronize the stream */
+   if (begin != end)
+   {
+      size_t decoded_size = 0;
+      if (cobs::decode(m_data + begin, end - begin, decoded_size))
+      {
+         addFrame(begin, begin + decoded_size);
+      }
+      else
+      {
+         logger_send(LOG_ERROR, __func__, "invalid encoding, dropping %u bytes", (uint32_t)(end - begin));
+         m_dropped++;
+      }
+   }
+}
+void FrameAssembler::wrap()
+{
+   size_t pending_bytes = pending();
+   if (pending_bytes == m_capacity)
+   {
+      logger_send(LOG_ERROR, __func__, "frame too long, dropping %u bytes", (uint32_t)pending_bytes);
+      m_dropped++;
+      reset();
+      m_discard = true;
+   }
+   else if (m_read_pos > 0)
+   {
+      std::copy(m_data + m_read_pos, m_data + m_write_pos, m_data);
+      m_read_pos = 0;
+      m_scan_pos = pending_bytes;
+      m_write_pos = pending_bytes;
+   }
+}
@@ -0,0 +1,54 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "FramePool.h"
+
+FramePool::FramePool(size_t block_size, size_t blocks_count) :
+m_block_size(block_size),
+m_arena(block_size * blocks_count, 0)
+{
+   m_free.reserve(blocks_count);
+   /* blocks are taken from the beginning of the arena first */
+   for (size_t i = blocks_count; i > 0; i--)
+   {
+      m_free.push_back(m_arena.data() + (i - 1) * block_size);
+   }
+}
+uint8_t* FramePool::acquire()
+{
+   uint8_t* result = nullptr;
+   if (!m_free.empty())
+   {
+      result = m_free.back();
+      m_free.pop_back();
+   }
+   return result;
+}
+void FramePool::release(uint8_t* block)
+{
+   if (owns(block) && m_free.size() < capacity())
+   {
+      m_free.push_back(block);
+   }
+}
+bool FramePool::owns(const uint8_t* block) const
+{
+   bool result = false;
+   if (block && m_block_size > 0 && block >= m_arena.data() && block < m_arena.data() + m_arena.size())
+   {
+      result = ((block - m_arena.data()) % m_block_size) == 0;
+   }
+   return result;
+}
+size_t FramePool::blockSize() const
+{
+   return m_block_size;
+}
+size_t FramePool::available() const
+{
+   return m_free.size();
+}
+size_t FramePool::capacity() const
+{
+   return (m_block_size > 0)? m_arena.size() / m_block_size : 0;
+}
@@ -0,0 +1,109 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "HomeStateStore.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <stddef.h>
+
+/* data is accessed by relaxed atomics, ordering is given by the sequence fences (seqlock) */
+HomeStateStore::HomeStateStore() :
+m_sequence(0),
+m_fan(0),
+m_fan_valid(false)
+{
+   for (size_t i = 0; i < ENV_ITEMS_COUNT; i++)
+   {
+      m_temp_h[i].store(0, std::memory_order_relaxed);
+      m_temp_l[i].store(0, std::memory_order_relaxed);
+      m_hum_h[i].store(0, std::memory_order_relaxed);
+      m_hum_l[i].store(0, std::memory_order_relaxed);
+      m_env_valid[i].store(false, std::memory_order_relaxed);
+   }
+   for (size_t i = 0; i < INPUT_ITEMS_COUNT; i++)
+   {
+      m_inputs[i].store(0, std::memory_order_relaxed);
+      m_inputs_valid[i].store(false, std::memory_order_relaxed);
+   }
+}
+void HomeStateStore::setEnv(uint8_t id, int8_t temp_h, int8_t temp_l, uint8_t hum_h, uint8_t hum_l)
+{
+   /* only writer modifies the data, so it can be compared without seqlock */
+   if (id < ENV_ITEMS_COUNT &&
+       (!m_env_valid[id].load(std::memory_order_relaxed) ||
+        m_temp_h[id].load(std::memory_order_relaxed) != temp_h || m_temp_l[id].load(std::memory_order_relaxed) != temp_l ||
+        m_hum_h[id].load(std::memory_order_relaxed) != hum_h || m_hum_l[id].load(std::memory_order_relaxed) != hum_l))
+   {
+      beginWrite();
+      m_temp_h[id].store(temp_h, std::memory_order_relaxed);
+      m_temp_l[id].store(temp_l, std::memory_order_relaxed);
+      m_hum_h[id].store(hum_h, std::memory_order_relaxed);
+      m_hum_l[id].store(hum_l, std::memory_order_relaxed);
+      m_env_valid[id].store(true, std::memory_order_relaxed);
+      endWrite();
+   }
+}
+void HomeStateStore::setInput(uint8_t id, uint8_t state)
+{
+   if (id < INPUT_ITEMS_COUNT &&
+       (!m_inputs_valid[id].load(std::memory_order_relaxed) || m_inputs[id].load(std::memory_order_relaxed) != state))
+   {
+      beginWrite();
+      m_inputs[id].store(state, std::memory_order_relaxed);
+      m_inputs_valid[id].store(true, std::memory_order_relaxed);
+      endWrite();
+   }
+}
+void HomeStateStore::setFan(uint8_t state)
+{
+   if (!m_fan_valid.load(std::memory_order_relaxed) || m_fan.load(std::memory_order_relaxed) != state)
+   {
+      beginWrite();
+      m_fan.store(state, std::memory_order_relaxed);
+      m_fan_valid.store(true, std::memory_order_relaxed);
+      endWrite();
+   }
+}
+void HomeStateStore::beginWrite()
+{
+   m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+   /* data stores cannot be seen before the sequence becomes odd */
+   std::atomic_thread_fence(std::memory_order_release);
+}
+void HomeStateStore::endWrite()
+{
+   m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+void HomeStateStore::read(HomeState& snapshot) const
+{
+   uint32_t begin = 0;
+   uint32_t end = 0;
+   do
+   {
+      begin = m_sequence.load(std::memory_order_acquire);
+      for (size_t i = 0; i < ENV_ITEMS_COUNT; i++)
+      {
+         snapshot.temp_h[i] = m_temp_h[i].load(std::memory_order_relaxed);
+         snapshot.temp_l[i] = m_temp_l[i].load(std::memory_order_relaxed);
+         snapshot.hum_h[i] = m_hum_h[i].load(std::memory_order_relaxed);
+         snapshot.hum_l[i] = m_hum_l[i].load(std::memory_order_relaxed);
+         snapshot.env_valid[i] = m_env_valid[i].load(std::memory_order_relaxed);
+      }
+      for (size_t i = 0; i < INPUT_ITEMS_COUNT; i++)
+      {
+         snapshot.inputs[i] = m_inputs[i].load(std::memory_order_relaxed);
+         snapshot.inputs_valid[i] = m_inputs_valid[i].load(std::memory_order_relaxed);
+      }
+      snapshot.fan = m_fan.load(std::memory_order_relaxed);
+      snapshot.fan_valid = m_fan_valid.load(std::memory_order_relaxed);
+      /* data loads cannot be moved after the second sequence read */
+      std::atomic_thread_fence(std::memory_order_acquire);
+      end = m_sequence.load(std::memory_order_relaxed);
+   } while ((begin & 1) || begin != end);
+   snapshot.version = begin / 2;
+}
+uint32_t HomeStateStore::version() const
+{
+   return m_sequence.load(std::memory_order_acquire) / 2;
+}
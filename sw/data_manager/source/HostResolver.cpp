@@ -0,0 +1,155 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "HostResolver.h"
+#include "Logger.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <netdb.h>
+#include <netinet/in.h>
+#include <string.h>
+
+/* namespace wrapper around system function to allow replace in unit tests */
+namespace system_call
+{
+__attribute__((weak)) int getaddrinfo(const char *node, const char *service, const struct addrinfo *hints, struct addrinfo **res)
+{
+   return ::getaddrinfo(node, service, hints, res);
+}
+}
+
+namespace
+{
+void set_port(struct sockaddr_storage& address, uint16_t port)
+{
+   if (address.ss_family == AF_INET6)
+   {
+      reinterpret_cast<struct sockaddr_in6*>(&address)->sin6_port = htons(port);
+   }
+   else
+   {
+      reinterpret_cast<struct sockaddr_in*>(&address)->sin_port = htons(port);
+   }
+}
+void copy_addresses(const std::vector<HostAddress>& addresses, uint16_t port, std::vector<HostAddress>& result)
+{
+   result = addresses;
+   for (HostAddress& address : result)
+   {
+      set_port(address.address, port);
+   }
+}
+}
+
+HostResolver::HostResolver(std::chrono::milliseconds ttl, std::chrono::milliseconds negative_ttl) :
+m_ttl(ttl),
+m_negative_ttl(negative_ttl),
+m_running(false)
+{
+}
+bool HostResolver::resolve(const std::string& host, uint16_t port, std::chrono::milliseconds timeout, std::vector<HostAddress>& result)
+{
+   std::unique_lock<std::mutex> lock (m_mutex);
+   CacheEntry& entry = request(host);
+   if (entry.pending && entry.addresses.empty())
+   {
+      /* expired addresses are used until refreshed, caller waits only for unknown host */
+      m_cv.wait_for(lock, timeout, [&](){ return !entry.pending; });
+   }
+   logger_send_if(entry.pending && entry.addresses.empty(), LOG_ERROR, __func__, "%s not resolved yet", host.c_str());
+   copy_addresses(entry.addresses, port, result);
+   return !result.empty();
+}
+ResolveState HostResolver::tryResolve(const std::string& host, uint16_t port, std::vector<HostAddress>& result)
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   CacheEntry& entry = request(host);
+   copy_addresses(entry.addresses, port, result);
+   ResolveState state = ResolveState::RESOLVED;
+   if (result.empty())
+   {
+      state = entry.pending? ResolveState::PENDING : ResolveState::FAILED;
+   }
+   return state;
+}
+HostResolver::CacheEntry& HostResolver::request(const std::string& host)
+{
+   const bool is_new = m_cache.find(host) == m_cache.end();
+   CacheEntry& entry = m_cache[host];
+   if (is_new || (!entry.pending && std::chrono::steady_clock::now() >= entry.expiry))
+   {
+      entry.pending = true;
+      m_requests.push_back(host);
+      if (!m_running)
+      {
+         m_running = true;
+         m_thread = std::thread(&HostResolver::threadExecute, this);
+      }
+      m_cv.notify_all();
+   }
+   return entry;
+}
+void HostResolver::threadExecute()
+{
+   std::unique_lock<std::mutex> lock (m_mutex);
+   while (m_running)
+   {
+      if (m_requests.empty())
+      {
+         m_cv.wait(lock);
+         continue;
+      }
+      const std::string host = m_requests.front();
+      m_requests.pop_front();
+      lock.unlock();
+      std::vector<HostAddress> addresses = lookup(host);
+      lock.lock();
+      CacheEntry& entry = m_cache[host];
+      entry.expiry = std::chrono::steady_clock::now() + (addresses.empty()? m_negative_ttl : m_ttl);
+      entry.addresses.swap(addresses);
+      entry.pending = false;
+      m_cv.notify_all();
+   }
+}
+std::vector<HostAddress> HostResolver::lookup(const std::string& host)
+{
+   std::vector<HostAddress> result;
+   struct addrinfo hints = {};
+   struct addrinfo* info = nullptr;
+   hints.ai_family = AF_UNSPEC;
+   hints.ai_socktype = SOCK_STREAM;
+   const int error = system_call::getaddrinfo(host.c_str(), nullptr, &hints, &info);
+   if (error != 0)
+   {
+      logger_send(LOG_ERROR, __func__, "cannot resolve %s: %s", host.c_str(), gai_strerror(error));
+   }
+   for (struct addrinfo* it = info; it; it = it->ai_next)
+   {
+      if ((it->ai_family == AF_INET || it->ai_family == AF_INET6) && it->ai_addrlen <= sizeof(struct sockaddr_storage))
+      {
+         HostAddress address = {};
+         memcpy(&address.address, it->ai_addr, it->ai_addrlen);
+         address.length = it->ai_addrlen;
+         result.push_back(address);
+      }
+   }
+   if (info)
+   {
+      freeaddrinfo(info);
+   }
+   logger_send(LOG_SOCKDRV, __func__, "%s: %zu addresses", host.c_str(), result.size());
+   return result;
+}
+HostResolver::~HostResolver()
+{
+   {
+      std::lock_guard<std::mutex> lock (m_mutex);
+      m_running = false;
+      m_cv.notify_all();
+   }
+   if (m_thread.joinable())
+   {
+      m_thread.join();
+   }
+}
@@ -0,0 +1,98 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ListenerRegistry.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <algorithm>
+#include <thread>
+
+thread_local uint32_t ListenerRegistry::s_depth = 0;
+thread_local const ListenerRegistry* ListenerRegistry::s_notifying[LISTENER_REGISTRY_MAX_NESTING] = {};
+
+ListenerRegistry::ListenerRegistry() :
+m_list(new ListenerList()),
+m_epoch(0)
+{
+   m_readers[0] = 0;
+   m_readers[1] = 0;
+}
+void ListenerRegistry::add(SocketListener* listener)
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   const ListenerList* current = m_list.load();
+   if (std::find(current->begin(), current->end(), listener) == current->end())
+   {
+      ListenerList* list = new ListenerList(*current);
+      list->push_back(listener);
+      /* new listener is not waiting for anything - old list is released on next remove() */
+      publish(list);
+   }
+}
+void ListenerRegistry::remove(SocketListener* listener)
+{
+   std::vector<const ListenerList*> retired;
+   /* callback of this registry would wait for itself, other registries are not affected */
+   const bool wait = !isNotifying();
+   {
+      std::lock_guard<std::mutex> lock (m_mutex);
+      const ListenerList* current = m_list.load();
+      if (std::find(current->begin(), current->end(), listener) != current->end())
+      {
+         ListenerList* list = new ListenerList(*current);
+         list->erase(std::remove(list->begin(), list->end(), listener), list->end());
+         publish(list);
+      }
+      if (wait)
+      {
+         /* lists retired later are released by their own remove() call */
+         retired.swap(m_retired);
+      }
+   }
+   if (wait)
+   {
+      synchronize();
+      for (auto& list : retired)
+      {
+         delete list;
+      }
+   }
+}
+size_t ListenerRegistry::size()
+{
+   return m_list.load()->size();
+}
+void ListenerRegistry::publish(const ListenerList* list)
+{
+   m_retired.push_back(m_list.exchange(list));
+}
+void ListenerRegistry::synchronize()
+{
+   /* reader could take the slot number before previous switch, so both slots have to be drained */
+   for (uint8_t i = 0; i < 2; i++)
+   {
+      const uint32_t slot = m_epoch++ & 1;
+      while (m_readers[slot] != 0)
+      {
+         std::this_thread::yield();
+      }
+   }
+}
+bool ListenerRegistry::isNotifying() const
+{
+   bool result = s_depth > LISTENER_REGISTRY_MAX_NESTING;
+   for (uint32_t i = 0; i < s_depth && i < LISTENER_REGISTRY_MAX_NESTING; i++)
+   {
+      result = result || (s_notifying[i] == this);
+   }
+   return result;
+}
+ListenerRegistry::~ListenerRegistry()
+{
+   for (auto& retired : m_retired)
+   {
+      delete retired;
+   }
+   delete m_list.load();
+}
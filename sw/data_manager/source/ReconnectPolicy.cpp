@@ -0,0 +1,38 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ReconnectPolicy.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <algorithm>
+
+ReconnectPolicy::ReconnectPolicy(std::chrono::milliseconds first_retry, std::chrono::milliseconds max_delay, uint8_t jitter_percent, uint32_t seed) :
+m_first_retry(first_retry),
+m_max_delay(std::max(first_retry, max_delay)),
+m_jitter_percent(std::min<uint8_t>(jitter_percent, 100)),
+m_failed_attempts(0),
+m_generator(seed)
+{
+}
+std::chrono::milliseconds ReconnectPolicy::nextDelay()
+{
+   std::chrono::milliseconds delay = m_first_retry;
+   for (uint32_t i = 0; i < m_failed_attempts && delay < m_max_delay; i++)
+   {
+      delay *= 2;
+   }
+   delay = std::min(delay, m_max_delay);
+   m_failed_attempts++;
+
+   std::uniform_int_distribution<uint32_t> jitter (0, m_jitter_percent);
+   return delay - (delay * jitter(m_generator)) / 100;
+}
+void ReconnectPolicy::reset()
+{
+   m_failed_attempts = 0;
+}
+uint32_t ReconnectPolicy::failedAttempts() const
+{
+   return m_failed_attempts;
+}
@@ -0,0 +1,181 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ReplayDriver.h"
+#include "Logger.h"
+
+ReplayDriver::ReplayDriver(double speed) :
+m_speed(speed),
+m_is_connected(false),
+m_thread_running(false)
+{
+}
+bool ReplayDriver::connect(const std::string& address, uint16_t)
+{
+   bool result = false;
+   logger_send(LOG_SOCKDRV, __func__, "%s", address.c_str());
+   do
+   {
+      if (m_is_connected)
+      {
+         logger_send(LOG_ERROR, __func__, "already connected");
+         break;
+      }
+      if (m_thread.joinable())
+      {
+         /* thread finished when whole capture was replayed */
+         m_thread.join();
+      }
+      /* file is mapped again, so in place decoding of previous replay is dropped */
+      if (!m_capture.open(address))
+      {
+         break;
+      }
+      {
+         std::lock_guard<std::mutex> lock (m_mutex);
+         const size_t size = m_capture.chunks() > 0? m_capture.chunk(m_capture.chunks() - 1).end : 0;
+         m_assembler.attach(m_capture.data(), size);
+      }
+      m_stats.setConnected(true);
+      m_is_connected = true;
+      notify_callbacks(DriverEvent::DRIVER_CONNECTED);
+      m_thread_running = true;
+      m_thread = std::thread(&ReplayDriver::threadExecute, this);
+      result = true;
+   } while(0);
+   return result;
+}
+int ReplayDriver::connectAny(const std::vector<SocketEndpoint>& endpoints)
+{
+   int result = -1;
+   for (size_t i = 0; i < endpoints.size() && result < 0; i++)
+   {
+      if (connect(endpoints[i].address, endpoints[i].port))
+      {
+         result = i;
+      }
+   }
+   return result;
+}
+bool ReplayDriver::disconnect()
+{
+   m_is_connected = false;
+   m_thread_running = false;
+   m_wakeup.notify();
+   if (m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id())
+   {
+      m_thread.join();
+      m_capture.close();
+   }
+   m_stats.setConnected(false);
+   return true;
+}
+bool ReplayDriver::isConnected()
+{
+   return m_is_connected;
+}
+void ReplayDriver::threadExecute()
+{
+   logger_send(LOG_SOCKDRV, __func__, "replaying %zu chunks", m_capture.chunks());
+   const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   const uint64_t first_timestamp = m_capture.chunks() > 0? m_capture.chunk(0).timestamp_ns : 0;
+   for (size_t i = 0; i < m_capture.chunks() && m_thread_running; i++)
+   {
+      const CaptureChunk& chunk = m_capture.chunk(i);
+      if (m_speed > REPLAY_SPEED_MAX)
+      {
+         /* chunks are scheduled from the start, so rounding of single delays does not accumulate */
+         const std::chrono::steady_clock::time_point deadline =
+               start + std::chrono::nanoseconds(static_cast<uint64_t>((chunk.timestamp_ns - first_timestamp) / m_speed));
+         std::chrono::steady_clock::time_point now;
+         while (m_thread_running && (now = std::chrono::steady_clock::now()) < deadline)
+         {
+            m_wakeup.waitFor(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now + std::chrono::microseconds(999)));
+         }
+      }
+      if (m_thread_running)
+      {
+         deliverChunk(i > 0? m_capture.chunk(i - 1).end : 0, chunk.end);
+      }
+   }
+   if (m_thread_running)
+   {
+      logger_send(LOG_SOCKDRV, __func__, "capture finished");
+      m_is_connected = false;
+      m_stats.setConnected(false);
+      notify_callbacks(DriverEvent::DRIVER_DISCONNECTED);
+   }
+}
+void ReplayDriver::deliverChunk(size_t begin, size_t end)
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   const size_t frames_count = m_assembler.commit(end - begin);
+   m_stats.addReceived(end - begin, m_assembler.pending());
+   if (frames_count > 0)
+   {
+      m_stats.addDelivered(frames_count);
+      m_listeners.forEach([&](SocketListener* l){ l->onSocketFrames(m_assembler.frames(), frames_count); });
+   }
+   m_assembler.release();
+   m_stats.setDropped(m_assembler.dropped());
+}
+void ReplayDriver::addListener(SocketListener* callback)
+{
+   m_listeners.add(callback);
+}
+void ReplayDriver::removeListener(SocketListener* callback)
+{
+   m_listeners.remove(callback);
+}
+bool ReplayDriver::write(const std::vector<uint8_t>& data, size_t size)
+{
+   const size_t bytes_to_write = size == 0? data.size() : size;
+   const bool result = m_is_connected && bytes_to_write <= data.size();
+   if (result)
+   {
+      /* there is no server, data is dropped */
+      m_stats.addSent(bytes_to_write);
+   }
+   return result;
+}
+bool ReplayDriver::writeAsync(const std::vector<uint8_t>& data, WriteCallback callback)
+{
+   const bool result = write(data);
+   if (result && callback)
+   {
+      callback(true);
+   }
+   return result;
+}
+void ReplayDriver::setWriteHighWaterMark(size_t)
+{
+}
+void ReplayDriver::setDelimiter(char c)
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   logger_send(LOG_SOCKDRV, __func__, "Setting new delimiter: %x", c);
+   m_assembler.setDelimiter(c);
+}
+void ReplayDriver::setFraming(FramingMode mode)
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   logger_send(LOG_SOCKDRV, __func__, "Setting framing mode: %u", (uint8_t)mode);
+   m_assembler.setFraming(mode);
+}
+void ReplayDriver::setFrameLayout(const FrameLayout& layout)
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   logger_send_if(!m_assembler.setFrameLayout(layout), LOG_ERROR, __func__, "layout rejected");
+}
+SocketDriverStats ReplayDriver::getStats()
+{
+   return m_stats.get();
+}
+void ReplayDriver::notify_callbacks(DriverEvent ev)
+{
+   m_listeners.forEach([&](SocketListener* l){ l->onSocketEvent(ev, {}, 0); });
+}
+ReplayDriver::~ReplayDriver()
+{
+   disconnect();
+}
@@ -0,0 +1,260 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ShmChannel.h"
+#include "Logger.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+#include <string.h>
+#include <algorithm>
+
+static_assert((SHM_CHANNEL_RING_SIZE & (SHM_CHANNEL_RING_SIZE - 1)) == 0, "ring size shall be power of 2");
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "atomics placed in shared memory have to be lock-free");
+
+namespace
+{
+const uint32_t SHM_RING_MASK = SHM_CHANNEL_RING_SIZE - 1;
+
+/* futex is shared between processes, so private futex operations cannot be used */
+void futex_wait(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::milliseconds timeout)
+{
+   struct timespec ts;
+   ts.tv_sec = timeout.count() / 1000;
+   ts.tv_nsec = (timeout.count() % 1000) * 1000000;
+   syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+void notify(std::atomic<uint32_t>& word)
+{
+   word++;
+   syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+}
+bool process_exists(int32_t pid)
+{
+   return pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+void init_ring(ShmRing& ring)
+{
+   ring.head = 0;
+   ring.tail = 0;
+   ring.consumer_wakeups = 0;
+   ring.producer_wakeups = 0;
+   ring.consumer_waiting = 0;
+   ring.producer_waiting = 0;
+}
+}
+
+ShmChannel::ShmChannel() :
+m_segment(nullptr),
+m_rx(nullptr),
+m_tx(nullptr),
+m_own_pid(nullptr),
+m_peer_pid(nullptr),
+m_is_server(false)
+{
+}
+bool ShmChannel::create(const std::string& name)
+{
+   bool result = false;
+   do
+   {
+      if (m_segment)
+      {
+         break;
+      }
+      int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+      if (fd < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot create %s, err: %s", name.c_str(), strerror(errno));
+         break;
+      }
+      if (ftruncate(fd, sizeof(ShmSegment)) < 0 || !map(fd))
+      {
+         logger_send(LOG_ERROR, __func__, "cannot map %s, err: %s", name.c_str(), strerror(errno));
+         ::close(fd);
+         shm_unlink(name.c_str());
+         break;
+      }
+      ::close(fd);
+      init_ring(m_segment->to_client);
+      init_ring(m_segment->to_server);
+      m_segment->client_pid = 0;
+      m_segment->magic = SHM_CHANNEL_MAGIC;
+      m_rx = &m_segment->to_server;
+      m_tx = &m_segment->to_client;
+      m_own_pid = &m_segment->server_pid;
+      m_peer_pid = &m_segment->client_pid;
+      m_is_server = true;
+      m_name = name;
+      m_own_pid->store(getpid());
+      result = true;
+   } while(0);
+   return result;
+}
+bool ShmChannel::open(const std::string& name)
+{
+   bool result = false;
+   do
+   {
+      if (m_segment)
+      {
+         break;
+      }
+      int fd = shm_open(name.c_str(), O_RDWR, 0);
+      if (fd < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot open %s, err: %s", name.c_str(), strerror(errno));
+         break;
+      }
+      struct stat info;
+      if (fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < sizeof(ShmSegment) || !map(fd))
+      {
+         logger_send(LOG_ERROR, __func__, "invalid segment %s", name.c_str());
+         ::close(fd);
+         break;
+      }
+      ::close(fd);
+      int32_t client = m_segment->client_pid.load();
+      if (m_segment->magic != SHM_CHANNEL_MAGIC || !process_exists(m_segment->server_pid) ||
+          process_exists(client) || !m_segment->client_pid.compare_exchange_strong(client, getpid()))
+      {
+         logger_send(LOG_ERROR, __func__, "server not running or other client connected");
+         munmap(m_segment, sizeof(ShmSegment));
+         m_segment = nullptr;
+         break;
+      }
+      m_rx = &m_segment->to_client;
+      m_tx = &m_segment->to_server;
+      m_own_pid = &m_segment->client_pid;
+      m_peer_pid = &m_segment->server_pid;
+      m_is_server = false;
+      m_name = name;
+      /* consumer owns the tail - data sent to previous client is skipped */
+      m_rx->tail.store(m_rx->head.load());
+      result = true;
+   } while(0);
+   return result;
+}
+bool ShmChannel::map(int fd)
+{
+   void* address = mmap(nullptr, sizeof(ShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   m_segment = (address == MAP_FAILED)? nullptr : static_cast<ShmSegment*>(address);
+   return m_segment != nullptr;
+}
+void ShmChannel::close()
+{
+   if (m_segment)
+   {
+      m_own_pid->store(0);
+      wakePeer();
+      munmap(m_segment, sizeof(ShmSegment));
+      if (m_is_server)
+      {
+         shm_unlink(m_name.c_str());
+      }
+      m_segment = nullptr;
+      m_rx = nullptr;
+      m_tx = nullptr;
+   }
+}
+bool ShmChannel::isOpen() const
+{
+   return m_segment != nullptr;
+}
+bool ShmChannel::isPeerAlive() const
+{
+   return m_segment && process_exists(m_peer_pid->load());
+}
+size_t ShmChannel::write(const uint8_t* data, size_t size)
+{
+   const uint32_t head = m_tx->head.load(std::memory_order_relaxed);
+   const uint32_t tail = m_tx->tail.load(std::memory_order_acquire);
+   const size_t bytes = std::min<size_t>(size, SHM_CHANNEL_RING_SIZE - (head - tail));
+   const size_t offset = head & SHM_RING_MASK;
+   const size_t first_part = std::min<size_t>(bytes, SHM_CHANNEL_RING_SIZE - offset);
+   memcpy(m_tx->data + offset, data, first_part);
+   memcpy(m_tx->data, data + first_part, bytes - first_part);
+   m_tx->head.store(head + bytes, std::memory_order_release);
+   /* pairs with the fence in waitReadable() - either consumer sees new head or producer sees the flag */
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (bytes > 0 && m_tx->consumer_waiting.load(std::memory_order_relaxed))
+   {
+      notify(m_tx->consumer_wakeups);
+   }
+   return bytes;
+}
+size_t ShmChannel::read(uint8_t* data, size_t size)
+{
+   const uint32_t tail = m_rx->tail.load(std::memory_order_relaxed);
+   const uint32_t head = m_rx->head.load(std::memory_order_acquire);
+   const size_t bytes = std::min<size_t>(size, head - tail);
+   const size_t offset = tail & SHM_RING_MASK;
+   const size_t first_part = std::min<size_t>(bytes, SHM_CHANNEL_RING_SIZE - offset);
+   memcpy(data, m_rx->data + offset, first_part);
+   memcpy(data + first_part, m_rx->data, bytes - first_part);
+   m_rx->tail.store(tail + bytes, std::memory_order_release);
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (bytes > 0 && m_rx->producer_waiting.load(std::memory_order_relaxed))
+   {
+      notify(m_rx->producer_wakeups);
+   }
+   return bytes;
+}
+size_t ShmChannel::readable() const
+{
+   return m_rx->head.load(std::memory_order_acquire) - m_rx->tail.load(std::memory_order_relaxed);
+}
+size_t ShmChannel::unread() const
+{
+   return m_tx->head.load(std::memory_order_relaxed) - m_tx->tail.load(std::memory_order_acquire);
+}
+bool ShmChannel::waitReadable(std::chrono::milliseconds timeout)
+{
+   const uint32_t wakeups = m_rx->consumer_wakeups.load();
+   m_rx->consumer_waiting.store(1, std::memory_order_relaxed);
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (readable() == 0)
+   {
+      /* returns immediately if woken up after the check */
+      futex_wait(m_rx->consumer_wakeups, wakeups, timeout);
+   }
+   m_rx->consumer_waiting.store(0, std::memory_order_relaxed);
+   return readable() > 0;
+}
+bool ShmChannel::waitWritable(size_t size, std::chrono::milliseconds timeout)
+{
+   const uint32_t wakeups = m_tx->producer_wakeups.load();
+   m_tx->producer_waiting.store(1, std::memory_order_relaxed);
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (SHM_CHANNEL_RING_SIZE - unread() < size)
+   {
+      futex_wait(m_tx->producer_wakeups, wakeups, timeout);
+   }
+   m_tx->producer_waiting.store(0, std::memory_order_relaxed);
+   return SHM_CHANNEL_RING_SIZE - unread() >= size;
+}
+void ShmChannel::wakeup()
+{
+   if (m_segment)
+   {
+      notify(m_rx->consumer_wakeups);
+      notify(m_tx->producer_wakeups);
+   }
+}
+void ShmChannel::wakePeer()
+{
+   notify(m_tx->consumer_wakeups);
+   notify(m_rx->producer_wakeups);
+}
+ShmChannel::~ShmChannel()
+{
+   close();
+}
@@ -0,0 +1,240 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "ShmDriver.h"
+#include "Cobs.h"
+#include "Logger.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <string.h>
+
+ShmDriver::ShmDriver() :
+m_is_connected(false),
+m_recv_buffer(SHMDRV_RECV_BUFFER_SIZE),
+m_framing(FramingMode::DELIMITER),
+m_send_buffer(SHMDRV_MAX_WRITE_SIZE + COBS_MAX_OVERHEAD(SHMDRV_MAX_WRITE_SIZE) + 1, 0),
+m_write_high_water_mark(SHM_CHANNEL_RING_SIZE),
+m_thread_running(false)
+{
+   m_recv_buffer.setDelimiter('\n');
+}
+bool ShmDriver::connect(const std::string& address, uint16_t)
+{
+   bool result = false;
+   logger_send(LOG_SOCKDRV, __func__, "%s", address.c_str());
+   do
+   {
+      if (address.compare(0, strlen(SHMDRV_SCHEME), SHMDRV_SCHEME) != 0 || address.size() == strlen(SHMDRV_SCHEME))
+      {
+         logger_send(LOG_ERROR, __func__, "invalid address %s", address.c_str());
+         break;
+      }
+      if (m_is_connected)
+      {
+         logger_send(LOG_ERROR, __func__, "already connected");
+         break;
+      }
+      if (m_thread.joinable())
+      {
+         /* thread finished when previous connection was lost */
+         m_thread.join();
+      }
+      std::unique_lock<std::mutex> lock (m_write_mutex);
+      m_channel.close();
+      if (!m_channel.open(address.substr(strlen(SHMDRV_SCHEME))))
+      {
+         break;
+      }
+      lock.unlock();
+      m_stats.setConnected(true);
+      m_is_connected = true;
+      notify_callbacks(DriverEvent::DRIVER_CONNECTED);
+      m_thread_running = true;
+      m_thread = std::thread(&ShmDriver::threadExecute, this);
+      result = true;
+      logger_send(LOG_SOCKDRV, __func__, "connected ok!");
+   } while(0);
+   return result;
+}
+int ShmDriver::connectAny(const std::vector<SocketEndpoint>& endpoints)
+{
+   int result = -1;
+   /* opening the channel does not wait for the server, so there is nothing to hedge */
+   for (size_t i = 0; i < endpoints.size() && result < 0; i++)
+   {
+      if (connect(endpoints[i].address, endpoints[i].port))
+      {
+         result = i;
+      }
+   }
+   return result;
+}
+bool ShmDriver::disconnect()
+{
+   m_is_connected = false;
+   m_thread_running = false;
+   /* wakes up receiving thread and writer waiting for space */
+   m_channel.wakeup();
+   if (m_thread.joinable())
+   {
+      m_thread.join();
+   }
+   {
+      std::lock_guard<std::mutex> lock (m_write_mutex);
+      m_channel.close();
+   }
+   m_stats.setConnected(false);
+   return true;
+}
+bool ShmDriver::isConnected()
+{
+   return m_is_connected;
+}
+void ShmDriver::addListener(SocketListener* callback)
+{
+   m_listeners.add(callback);
+}
+void ShmDriver::removeListener(SocketListener* callback)
+{
+   m_listeners.remove(callback);
+}
+void ShmDriver::threadExecute()
+{
+   logger_send(LOG_SOCKDRV, __func__, "starting thread!");
+   m_recv_buffer.reset();
+   while(m_thread_running)
+   {
+      if (!receiveData())
+      {
+         m_thread_running = false;
+      }
+   }
+}
+bool ShmDriver::receiveData()
+{
+   bool result = true;
+   size_t bytes_count = m_channel.read(m_recv_buffer.writePtr(), m_recv_buffer.writeSpace());
+   if (bytes_count > 0)
+   {
+      m_stats.addReceived(bytes_count, m_recv_buffer.pending() + bytes_count);
+      size_t frames_count = m_recv_buffer.commit(bytes_count);
+      if (frames_count > 0)
+      {
+         m_stats.addDelivered(frames_count);
+         m_listeners.forEach([&](SocketListener* l){ l->onSocketFrames(m_recv_buffer.frames(), frames_count); });
+      }
+      m_recv_buffer.release();
+      m_stats.setDropped(m_recv_buffer.dropped());
+   }
+   else if (!m_channel.waitReadable(std::chrono::milliseconds(SHMDRV_PEER_CHECK_PERIOD_MS)) &&
+            m_thread_running && !m_channel.isPeerAlive())
+   {
+      logger_send(LOG_ERROR, __func__, "server closed");
+      m_is_connected = false;
+      m_stats.setConnected(false);
+      notify_callbacks(DriverEvent::DRIVER_DISCONNECTED);
+      /* channel is closed by next connect() or disconnect() */
+      result = false;
+   }
+   return result;
+}
+bool ShmDriver::write(const std::vector<uint8_t>& data, size_t size)
+{
+   bool result = false;
+   size_t bytes_to_write = size == 0? data.size() : size;
+   logger_send(LOG_SOCKDRV, __func__, "writing %u bytes", (uint32_t)bytes_to_write);
+   if (bytes_to_write <= SHMDRV_MAX_WRITE_SIZE && bytes_to_write <= data.size())
+   {
+      std::lock_guard<std::mutex> lock (m_write_mutex);
+      result = writeEncoded(data.data(), bytes_to_write, true);
+   }
+   logger_send_if(!result, LOG_ERROR, __func__, "cannot write %u bytes", (uint32_t)bytes_to_write);
+   return result;
+}
+bool ShmDriver::writeAsync(const std::vector<uint8_t>& data, WriteCallback callback)
+{
+   bool result = false;
+   {
+      std::lock_guard<std::mutex> lock (m_write_mutex);
+      if (data.size() <= SHMDRV_MAX_WRITE_SIZE && m_channel.isOpen() &&
+          m_channel.unread() + data.size() <= m_write_high_water_mark)
+      {
+         result = writeEncoded(data.data(), data.size(), false);
+      }
+   }
+   logger_send_if(!result, LOG_ERROR, __func__, "cannot queue %u bytes", (uint32_t)data.size());
+   if (result && callback)
+   {
+      callback(true);
+   }
+   return result;
+}
+bool ShmDriver::writeEncoded(const uint8_t* data, size_t size, bool wait)
+{
+   bool result = false;
+   do
+   {
+      if (!m_is_connected || !m_channel.isOpen())
+      {
+         break;
+      }
+      if (m_framing == FramingMode::COBS)
+      {
+         size = cobs::encode(data, size, m_send_buffer.data());
+         m_send_buffer[size++] = COBS_DELIMITER;
+         data = m_send_buffer.data();
+      }
+      /* frame is written at once, so server never sees a part of it */
+      bool writable = SHM_CHANNEL_RING_SIZE - m_channel.unread() >= size;
+      while (!writable && wait && m_is_connected && m_channel.isPeerAlive())
+      {
+         writable = m_channel.waitWritable(size, std::chrono::milliseconds(SHMDRV_WRITE_TIMEOUT_MS));
+      }
+      if (!writable)
+      {
+         break;
+      }
+      m_channel.write(data, size);
+      m_stats.addSent(size);
+      m_stats.setWriteQueue(m_channel.unread(), 0);
+      result = true;
+   } while(0);
+   return result;
+}
+void ShmDriver::setWriteHighWaterMark(size_t bytes)
+{
+   std::lock_guard<std::mutex> lock (m_write_mutex);
+   logger_send(LOG_SOCKDRV, __func__, "high water mark %u", (uint32_t)bytes);
+   m_write_high_water_mark = bytes;
+}
+void ShmDriver::setDelimiter(char c)
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   logger_send(LOG_SOCKDRV, __func__, "Setting new delimiter: %x", c);
+   m_recv_buffer.setDelimiter(c);
+}
+void ShmDriver::setFraming(FramingMode mode)
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   logger_send(LOG_SOCKDRV, __func__, "Setting framing mode: %u", (uint8_t)mode);
+   m_framing = mode;
+   m_recv_buffer.setFraming(mode);
+}
+void ShmDriver::setFrameLayout(const FrameLayout& layout)
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   logger_send_if(!m_recv_buffer.setFrameLayout(layout), LOG_ERROR, __func__, "layout rejected");
+}
+SocketDriverStats ShmDriver::getStats()
+{
+   return m_stats.get();
+}
+void ShmDriver::notify_callbacks(DriverEvent ev)
+{
+   m_listeners.forEach([&](SocketListener* l){ l->onSocketEvent(ev, {}, 0); });
+}
+ShmDriver::~ShmDriver()
+{
+   disconnect();
+}
@@ -2,6 +2,7 @@
  *   Includes of project headers
  * =============================*/
 #include "SocketDriver.h"
+#include "Cobs.h"
 #include "Logger.h"
 /* =============================
  *   Includes of common headers
@@ -9,8 +10,13 @@
 #include <iostream>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/un.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <sys/uio.h>
 #include <algorithm>
 #include <string.h>
 
@@ -29,135 +35,1024 @@ __attribute__((weak)) ssize_t send(int socket, const void *message, size_t lengt
 {
    return ::send(socket, message, length, flags);
 }
+__attribute__((weak)) ssize_t sendmsg(int socket, const struct msghdr *message, int flags)
+{
+   return ::sendmsg(socket, message, flags);
+}
+__attribute__((weak)) int poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+   return ::poll(fds, nfds, timeout);
+}
 __attribute__((weak)) int socket(int domain, int type, int protocol)
 {
-   return ::socket(domain, type, protocol);
+   return ::socket(domain, type, protocol);
+}
+__attribute__((weak)) int fcntl(int fd, int cmd, int arg)
+{
+   return ::fcntl(fd, cmd, arg);
+}
+__attribute__((weak)) int getsockopt(int socket, int level, int option_name, void *option_value, socklen_t *option_len)
+{
+   return ::getsockopt(socket, level, option_name, option_value, option_len);
+}
+__attribute__((weak)) int setsockopt(int socket, int level, int option_name, const void *option_value, socklen_t option_len)
+{
+   return ::setsockopt(socket, level, option_name, option_value, option_len);
+}
+__attribute__((weak)) int close (int fd)
+{
+   return ::close(fd);
+}
+__attribute__((weak)) int shutdown(int socket, int how)
+{
+   return ::shutdown(socket, how);
+}
+
+}
+
+#if defined (SOCKDRV_URING)
+namespace
+{
+/* user data of io_uring requests */
+const uint64_t SOCKDRV_URING_RECV = 1;
+const uint64_t SOCKDRV_URING_SEND = 2;
+}
+#endif
+
+SocketDriver::SocketDriver(SocketBackend backend) :
+m_server_address(""),
+m_server_port(0),
+m_is_connected(false),
+m_delimiter('\n'),
+m_recv_buffer(SOCKDRV_RECV_BUFFER_SIZE),
+m_framing(FramingMode::DELIMITER),
+m_send_buffer(SOCKDRV_MAX_RW_SIZE + COBS_MAX_OVERHEAD(SOCKDRV_MAX_RW_SIZE) + 1, 0),
+m_write_pool(SOCKDRV_WRITE_POOL_BLOCK_SIZE, SOCKDRV_WRITE_POOL_BLOCKS),
+m_write_queue(SOCKDRV_WRITE_POOL_BLOCKS),
+m_write_head(0),
+m_write_count(0),
+m_queued_bytes(0),
+m_write_high_water_mark(SOCKDRV_WRITE_HIGH_WATER_MARK),
+m_write_armed(false),
+m_direct_send(false),
+m_writer_running(false),
+m_thread_running(false),
+m_sock_fd(-1),
+m_loop(nullptr),
+m_backend(backend),
+#if defined (SOCKDRV_URING)
+m_uring_msg(),
+m_uring_send_pending(false),
+#endif
+m_capture_enabled(false),
+m_next_endpoint(0),
+m_next_address(0),
+m_connect_timer(EVLOOP_INVALID_TIMER)
+{
+}
+SocketDriver::SocketDriver(IEventLoop& loop, SocketBackend backend) :
+SocketDriver(backend)
+{
+   m_loop = &loop;
+}
+bool SocketDriver::connect(const std::string& ip_address, uint16_t port)
+{
+   bool result = false;
+   logger_send(LOG_SOCKDRV, __func__, "");
+   do
+   {
+      std::vector<HostAddress> addresses;
+      if (makeAddresses({ip_address, port}, true, addresses) != ResolveState::RESOLVED)
+      {
+         break;
+      }
+
+      /* host name may have several addresses, e.g. ::1 and 127.0.0.1 of localhost, server may listen on one of them */
+      bool connected = false;
+      for (size_t i = 0; i < addresses.size() && !connected; i++)
+      {
+         if (i > 0 && m_sock_fd > 0)
+         {
+            system_call::close(m_sock_fd);
+         }
+         m_sock_fd = system_call::socket(addresses[i].address.ss_family, SOCK_STREAM, 0);
+         if (m_sock_fd < 0)
+         {
+            logger_send(LOG_ERROR, __func__, "cannot create socket, err: %s", strerror(errno));
+         }
+         else
+         {
+            connected = connectSocket((struct sockaddr *)&addresses[i].address, addresses[i].length);
+         }
+      }
+
+      if (connected)
+      {
+         result = startConnection(ip_address, port);
+      }
+
+   }while(0);
+
+   if (!result)
+   {
+      logger_send(LOG_ERROR, __func__, "error");
+      disconnect();
+   }
+
+   return result;
+}
+int SocketDriver::connectAny(const std::vector<SocketEndpoint>& endpoints)
+{
+   int result = -1;
+   if (endpoints.size() == 1)
+   {
+      result = connect(endpoints[0].address, endpoints[0].port)? 0 : -1;
+   }
+   else if (!endpoints.empty())
+   {
+      result = raceConnect(endpoints);
+      if (result >= 0 && !startConnection(endpoints[result].address, endpoints[result].port))
+      {
+         result = -1;
+      }
+      if (result < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "none of %zu endpoints available", endpoints.size());
+         disconnect();
+      }
+   }
+   return result;
+}
+void SocketDriver::connectAsync(const std::vector<SocketEndpoint>& endpoints, ConnectCallback callback)
+{
+   if (m_loop)
+   {
+      logger_send(LOG_SOCKDRV, __func__, "%zu endpoints", endpoints.size());
+      cancelConnect();
+      std::lock_guard<std::mutex> lock (m_connect_mutex);
+      m_connect_endpoints = endpoints;
+      m_connect_callback = std::move(callback);
+      m_next_endpoint = 0;
+      m_next_addresses.clear();
+      m_next_address = 0;
+      m_resolve_deadline = std::chrono::steady_clock::time_point();
+      m_next_start = std::chrono::steady_clock::now();
+      /* attempts are started and finished only from loop thread */
+      m_connect_timer = m_loop->addTimer(std::chrono::milliseconds(0), [this](){ onConnectTimer(); });
+   }
+   else
+   {
+      ISocketDriver::connectAsync(endpoints, std::move(callback));
+   }
+}
+void SocketDriver::onConnectTimer()
+{
+   std::unique_lock<std::mutex> lock (m_connect_mutex);
+   const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+   m_connect_timer = EVLOOP_INVALID_TIMER;
+   for (size_t i = m_attempts.size(); i-- > 0;)
+   {
+      if (now >= m_attempts[i].deadline)
+      {
+         logger_send(LOG_ERROR, __func__, "connection timeout");
+         dropAttempt(i);
+      }
+   }
+   continueConnect(lock);
+}
+void SocketDriver::onAttemptReady(int fd)
+{
+   std::unique_lock<std::mutex> lock (m_connect_mutex);
+   auto it = std::find_if(m_attempts.begin(), m_attempts.end(), [fd](const ConnectAttempt& attempt){ return attempt.fd == fd; });
+   if (it != m_attempts.end())
+   {
+      if (finishAttempt(*it))
+      {
+         completeConnect(lock, it - m_attempts.begin());
+      }
+      else
+      {
+         dropAttempt(it - m_attempts.begin());
+         continueConnect(lock);
+      }
+   }
+}
+void SocketDriver::continueConnect(std::unique_lock<std::mutex>& lock)
+{
+   if (m_connect_timer != EVLOOP_INVALID_TIMER)
+   {
+      /* called from loop thread, so it does not wait */
+      m_loop->cancelTimer(m_connect_timer);
+      m_connect_timer = EVLOOP_INVALID_TIMER;
+   }
+   std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+   bool resolving = false;
+   /* next address is tried when previous ones failed or do not respond for hedge delay */
+   while (!resolving && (m_attempts.empty() || now >= m_next_start))
+   {
+      if (m_next_address < m_next_addresses.size())
+      {
+         ConnectAttempt attempt = {};
+         attempt.index = m_next_endpoint - 1;
+         m_next_start = now + std::chrono::milliseconds(SOCKDRV_HEDGE_DELAY_MS);
+         const bool started = startAttempt(m_connect_endpoints[attempt.index], m_next_addresses[m_next_address++], attempt);
+         const int fd = attempt.fd;
+         /* socket becomes writable when connection is established or refused, also when it is connected already */
+         if (started && m_loop->addFd(fd, EVLOOP_WRITE, [this, fd](uint32_t){ onAttemptReady(fd); }))
+         {
+            m_attempts.push_back(attempt);
+         }
+         else
+         {
+            if (attempt.fd >= 0)
+            {
+               system_call::close(attempt.fd);
+            }
+            m_next_start = now;
+         }
+      }
+      else if (m_next_endpoint < m_connect_endpoints.size())
+      {
+         resolving = !nextAddresses(now);
+      }
+      else
+      {
+         break;
+      }
+   }
+   const bool remaining = m_next_address < m_next_addresses.size() || m_next_endpoint < m_connect_endpoints.size();
+   if (m_attempts.empty() && !remaining)
+   {
+      ConnectCallback callback = std::move(m_connect_callback);
+      m_connect_callback = nullptr;
+      m_connect_endpoints.clear();
+      lock.unlock();
+      logger_send(LOG_ERROR, __func__, "none of endpoints available");
+      if (callback)
+      {
+         callback(-1);
+      }
+   }
+   else
+   {
+      /* timer is armed for the next hedged attempt, resolution check or for the earliest deadline */
+      std::chrono::steady_clock::time_point wakeup = resolving? now + std::chrono::milliseconds(SOCKDRV_RESOLVE_POLL_MS) :
+                                                     remaining? m_next_start : m_attempts[0].deadline;
+      now = std::chrono::steady_clock::now();
+      for (const ConnectAttempt& attempt : m_attempts)
+      {
+         wakeup = std::min(wakeup, attempt.deadline);
+      }
+      const int64_t delay = std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(wakeup - now + std::chrono::microseconds(999)).count());
+      m_connect_timer = m_loop->addTimer(std::chrono::milliseconds(delay), [this](){ onConnectTimer(); });
+   }
+}
+bool SocketDriver::nextAddresses(std::chrono::steady_clock::time_point now)
+{
+   bool result = true;
+   if (m_resolve_deadline == std::chrono::steady_clock::time_point())
+   {
+      m_resolve_deadline = now + std::chrono::milliseconds(SOCKDRV_RESOLVE_TIMEOUT_MS);
+   }
+   const SocketEndpoint& endpoint = m_connect_endpoints[m_next_endpoint];
+   const ResolveState state = makeAddresses(endpoint, false, m_next_addresses);
+   if (state == ResolveState::PENDING && now < m_resolve_deadline)
+   {
+      /* checked again by the timer */
+      result = false;
+   }
+   else
+   {
+      /* resolution which does not finish in time is continued in background and cached for the next connection */
+      logger_send_if(state == ResolveState::PENDING, LOG_ERROR, __func__, "%s not resolved in time", endpoint.address.c_str());
+      m_next_endpoint++;
+      m_next_address = 0;
+      m_resolve_deadline = std::chrono::steady_clock::time_point();
+   }
+   return result;
+}
+void SocketDriver::completeConnect(std::unique_lock<std::mutex>& lock, size_t attempt)
+{
+   const ConnectAttempt connected = m_attempts[attempt];
+   m_attempts.erase(m_attempts.begin() + attempt);
+   while (!m_attempts.empty())
+   {
+      /* slower attempts are abandoned */
+      dropAttempt(m_attempts.size() - 1);
+   }
+   if (m_connect_timer != EVLOOP_INVALID_TIMER)
+   {
+      m_loop->cancelTimer(m_connect_timer);
+      m_connect_timer = EVLOOP_INVALID_TIMER;
+   }
+   const SocketEndpoint endpoint = m_connect_endpoints[connected.index];
+   ConnectCallback callback = std::move(m_connect_callback);
+   m_connect_callback = nullptr;
+   m_connect_endpoints.clear();
+   lock.unlock();
+
+   int result = -1;
+   /* socket is observed for reading from now on */
+   m_loop->removeFd(connected.fd);
+   m_sock_fd = connected.fd;
+   if (startConnection(endpoint.address, endpoint.port))
+   {
+      result = connected.index;
+   }
+   else
+   {
+      disconnect();
+   }
+   if (callback)
+   {
+      callback(result);
+   }
+}
+void SocketDriver::dropAttempt(size_t attempt)
+{
+   m_loop->removeFd(m_attempts[attempt].fd);
+   system_call::close(m_attempts[attempt].fd);
+   m_attempts.erase(m_attempts.begin() + attempt);
+   /* next endpoint is tried without waiting for hedge delay */
+   m_next_start = std::chrono::steady_clock::now();
+}
+void SocketDriver::cancelConnect()
+{
+   std::vector<ConnectAttempt> attempts;
+   IEventLoop::TimerId timer = EVLOOP_INVALID_TIMER;
+   {
+      std::lock_guard<std::mutex> lock (m_connect_mutex);
+      attempts.swap(m_attempts);
+      timer = m_connect_timer;
+      m_connect_timer = EVLOOP_INVALID_TIMER;
+      m_connect_callback = nullptr;
+      m_connect_endpoints.clear();
+   }
+   if (timer != EVLOOP_INVALID_TIMER)
+   {
+      /* timer is armed while connection is in progress, attempt callback running on loop thread is awaited */
+      m_loop->cancelTimer(timer);
+   }
+   for (const ConnectAttempt& attempt : attempts)
+   {
+      m_loop->removeFd(attempt.fd);
+      system_call::close(attempt.fd);
+   }
+}
+ResolveState SocketDriver::makeAddresses(const SocketEndpoint& endpoint, bool wait, std::vector<HostAddress>& result)
+{
+   ResolveState state = ResolveState::FAILED;
+   HostAddress address = {};
+   result.clear();
+   do
+   {
+      const bool is_unix = endpoint.address.compare(0, strlen(SOCKDRV_UNIX_SCHEME), SOCKDRV_UNIX_SCHEME) == 0;
+      if (endpoint.address.empty() || (endpoint.port == 0 && !is_unix))
+      {
+         logger_send(LOG_ERROR, __func__, "invalid endpoint %s:%d", endpoint.address.c_str(), endpoint.port);
+         break;
+      }
+      if (is_unix)
+      {
+         /* local server - no TCP/IP stack overhead, port is not used */
+         struct sockaddr_un* unix_addr = reinterpret_cast<struct sockaddr_un*>(&address.address);
+         const std::string path = endpoint.address.substr(strlen(SOCKDRV_UNIX_SCHEME));
+         if (path.empty() || path.size() >= sizeof(unix_addr->sun_path))
+         {
+            logger_send(LOG_ERROR, __func__, "invalid socket path %s", path.c_str());
+            break;
+         }
+         unix_addr->sun_family = AF_UNIX;
+         memcpy(unix_addr->sun_path, path.c_str(), path.size() + 1);
+         address.length = sizeof(struct sockaddr_un);
+         result.push_back(address);
+         state = ResolveState::RESOLVED;
+      }
+      else
+      {
+         struct sockaddr_in* inet_addr = reinterpret_cast<struct sockaddr_in*>(&address.address);
+         struct sockaddr_in6* inet6_addr = reinterpret_cast<struct sockaddr_in6*>(&address.address);
+         if (inet_pton(AF_INET, endpoint.address.c_str(), &inet_addr->sin_addr) > 0)
+         {
+            inet_addr->sin_family = AF_INET;
+            inet_addr->sin_port = htons(endpoint.port);
+            address.length = sizeof(struct sockaddr_in);
+            result.push_back(address);
+            state = ResolveState::RESOLVED;
+         }
+         else if (inet_pton(AF_INET6, endpoint.address.c_str(), &inet6_addr->sin6_addr) > 0)
+         {
+            inet6_addr->sin6_family = AF_INET6;
+            inet6_addr->sin6_port = htons(endpoint.port);
+            address.length = sizeof(struct sockaddr_in6);
+            result.push_back(address);
+            state = ResolveState::RESOLVED;
+         }
+         /* host name - resolved by resolver thread, connection attempt does not wait for slow DNS */
+         else if (wait)
+         {
+            state = m_resolver.resolve(endpoint.address, endpoint.port, std::chrono::milliseconds(SOCKDRV_RESOLVE_TIMEOUT_MS), result)?
+                        ResolveState::RESOLVED : ResolveState::FAILED;
+         }
+         else
+         {
+            state = m_resolver.tryResolve(endpoint.address, endpoint.port, result);
+         }
+      }
+      logger_send_if(state == ResolveState::FAILED, LOG_ERROR, __func__, "cannot resolve %s", endpoint.address.c_str());
+   } while(0);
+   return state;
+}
+bool SocketDriver::startAttempt(const SocketEndpoint& endpoint, const HostAddress& address, ConnectAttempt& attempt)
+{
+   bool result = false;
+   attempt.fd = -1;
+   attempt.connected = false;
+   attempt.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SOCKDRV_CONNECT_TIMEOUT_MS);
+   do
+   {
+      attempt.fd = system_call::socket(address.address.ss_family, SOCK_STREAM, 0);
+      if (attempt.fd < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot create socket, err: %s", strerror(errno));
+         break;
+      }
+      attempt.flags = system_call::fcntl(attempt.fd, F_GETFL, 0);
+      if (attempt.flags < 0 || system_call::fcntl(attempt.fd, F_SETFL, attempt.flags | O_NONBLOCK) < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot set non-blocking mode, err: %s", strerror(errno));
+         break;
+      }
+      if (system_call::connect(attempt.fd, (const struct sockaddr *)&address.address, address.length) >= 0)
+      {
+         attempt.connected = true;
+      }
+      else if (errno != EINPROGRESS)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot connect to %s, err: %s", endpoint.address.c_str(), strerror(errno));
+         break;
+      }
+      result = true;
+   } while(0);
+   if (!result && attempt.fd >= 0)
+   {
+      system_call::close(attempt.fd);
+      attempt.fd = -1;
+   }
+   return result;
+}
+bool SocketDriver::finishAttempt(ConnectAttempt& attempt)
+{
+   int error = 0;
+   socklen_t error_len = sizeof(error);
+   if (!attempt.connected && system_call::getsockopt(attempt.fd, SOL_SOCKET, SO_ERROR, &error, &error_len) < 0)
+   {
+      error = errno;
+   }
+   /* data is received and sent in blocking mode */
+   if (error == 0 && system_call::fcntl(attempt.fd, F_SETFL, attempt.flags) < 0)
+   {
+      error = errno;
+   }
+   logger_send_if(error != 0, LOG_ERROR, __func__, "cannot connect, err: %s", strerror(error));
+   attempt.connected = (error == 0);
+   return attempt.connected;
+}
+int SocketDriver::raceConnect(const std::vector<SocketEndpoint>& endpoints)
+{
+   int result = -1;
+   int result_fd = -1;
+   std::vector<ConnectAttempt> attempts;
+   std::vector<struct pollfd> fds;
+   /* every address of every endpoint is tried, e.g. both ::1 and 127.0.0.1 of localhost */
+   std::vector<std::pair<size_t, HostAddress>> targets;
+   std::vector<HostAddress> addresses;
+   for (size_t i = 0; i < endpoints.size(); i++)
+   {
+      makeAddresses(endpoints[i], true, addresses);
+      for (const HostAddress& address : addresses)
+      {
+         targets.push_back(std::make_pair(i, address));
+      }
+   }
+   size_t next = 0;
+   std::chrono::steady_clock::time_point next_start = std::chrono::steady_clock::now();
+   while (result < 0 && (next < targets.size() || !attempts.empty()))
+   {
+      std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      if (next < targets.size() && (attempts.empty() || now >= next_start))
+      {
+         /* next address is tried when previous ones failed or do not respond for hedge delay */
+         ConnectAttempt attempt = {};
+         attempt.index = targets[next].first;
+         next_start = now + std::chrono::milliseconds(SOCKDRV_HEDGE_DELAY_MS);
+         if (!startAttempt(endpoints[attempt.index], targets[next++].second, attempt))
+         {
+            next_start = now;
+         }
+         else if (!attempt.connected)
+         {
+            logger_send(LOG_SOCKDRV, __func__, "connecting to %s:%d", endpoints[attempt.index].address.c_str(), endpoints[attempt.index].port);
+            attempts.push_back(attempt);
+         }
+         else if (finishAttempt(attempt))
+         {
+            attempts.push_back(attempt);
+            result = attempt.index;
+            result_fd = attempt.fd;
+         }
+         else
+         {
+            system_call::close(attempt.fd);
+            next_start = now;
+         }
+         continue;
+      }
+
+      std::chrono::steady_clock::time_point wakeup = (next < targets.size())? next_start : attempts[0].deadline;
+      fds.clear();
+      for (const ConnectAttempt& attempt : attempts)
+      {
+         fds.push_back({attempt.fd, POLLOUT, 0});
+         wakeup = std::min(wakeup, attempt.deadline);
+      }
+      const int timeout = std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(wakeup - now + std::chrono::microseconds(999)).count());
+      if (system_call::poll(fds.data(), fds.size(), timeout) < 0 && errno != EINTR)
+      {
+         logger_send(LOG_ERROR, __func__, "poll error: %s", strerror(errno));
+         break;
+      }
+      now = std::chrono::steady_clock::now();
+      for (size_t i = attempts.size(); i-- > 0;)
+      {
+         bool failed = false;
+         if (fds[i].revents != 0)
+         {
+            if (finishAttempt(attempts[i]))
+            {
+               result = attempts[i].index;
+               result_fd = attempts[i].fd;
+               break;
+            }
+            failed = true;
+         }
+         else if (now >= attempts[i].deadline)
+         {
+            logger_send(LOG_ERROR, __func__, "connection timeout");
+            failed = true;
+         }
+         if (failed)
+         {
+            system_call::close(attempts[i].fd);
+            attempts.erase(attempts.begin() + i);
+            next_start = now;
+         }
+      }
+   }
+   for (const ConnectAttempt& attempt : attempts)
+   {
+      if (attempt.fd == result_fd)
+      {
+         m_sock_fd = attempt.fd;
+      }
+      else
+      {
+         /* slower attempts are abandoned */
+         system_call::close(attempt.fd);
+      }
+   }
+   return result;
+}
+bool SocketDriver::startConnection(const std::string& ip_address, uint16_t port)
+{
+   bool result = false;
+   do
+   {
+      m_server_address = ip_address;
+      m_server_port = port;
+      if (ip_address.compare(0, strlen(SOCKDRV_UNIX_SCHEME), SOCKDRV_UNIX_SCHEME) != 0)
+      {
+         setKeepalive();
+      }
+      const bool uring = startUring();
+      if (m_loop)
+      {
+         m_recv_buffer.reset();
+         /* ring descriptor is readable when there are completions */
+         if (!(uring? m_loop->addFd(uringFd(), EVLOOP_READ, [this](uint32_t){ processCompletions(); }) :
+                      m_loop->addFd(m_sock_fd, EVLOOP_READ, [this](uint32_t events){ onSocketReady(events); })))
+         {
+            stopUring();
+            break;
+         }
+         setConnected(true);
+         notify_callbacks(DriverEvent::DRIVER_CONNECTED, {}, 0);
+      }
+      else
+      {
+         if (m_thread.joinable())
+         {
+            /* thread finished when previous connection was lost */
+            m_thread.join();
+         }
+         setConnected(true);
+         notify_callbacks(DriverEvent::DRIVER_CONNECTED, {}, 0);
+         m_thread_running = true;
+         m_thread = std::thread(&SocketDriver::threadExecute, this);
+      }
+      result = true;
+      logger_send(LOG_SOCKDRV, __func__, "connected ok!");
+   } while(0);
+   return result;
+}
+void SocketDriver::setKeepalive()
+{
+   const int enable = 1;
+   const int idle = SOCKDRV_KEEPALIVE_IDLE_S;
+   const int interval = SOCKDRV_KEEPALIVE_INTERVAL_S;
+   const int count = SOCKDRV_KEEPALIVE_COUNT;
+   const unsigned int user_timeout = SOCKDRV_USER_TIMEOUT_MS;
+   /* without keepalive silently dead peer is noticed only when kernel gives up retransmissions - after minutes */
+   if (system_call::setsockopt(m_sock_fd, SOL_SOCKET, SO_KEEPALIVE, &enable, sizeof(enable)) < 0 ||
+       system_call::setsockopt(m_sock_fd, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle)) < 0 ||
+       system_call::setsockopt(m_sock_fd, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval)) < 0 ||
+       system_call::setsockopt(m_sock_fd, IPPROTO_TCP, TCP_KEEPCNT, &count, sizeof(count)) < 0 ||
+       system_call::setsockopt(m_sock_fd, IPPROTO_TCP, TCP_USER_TIMEOUT, &user_timeout, sizeof(user_timeout)) < 0)
+   {
+      /* not critical - dead link is still detected by data provider */
+      logger_send(LOG_ERROR, __func__, "cannot set keepalive, err: %s", strerror(errno));
+   }
+}
+bool SocketDriver::connectSocket(const struct sockaddr *address, socklen_t address_len)
+{
+   bool result = false;
+   int flags = system_call::fcntl(m_sock_fd, F_GETFL, 0);
+   do
+   {
+      /* non-blocking connect allows to give up before kernel SYN timeout */
+      if (flags < 0 || system_call::fcntl(m_sock_fd, F_SETFL, flags | O_NONBLOCK) < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot set non-blocking mode, err: %s", strerror(errno));
+         break;
+      }
+      if (system_call::connect(m_sock_fd, address, address_len) >= 0)
+      {
+         result = true;
+      }
+      else if (errno == EINPROGRESS)
+      {
+         struct pollfd fd = {m_sock_fd, POLLOUT, 0};
+         int error = 0;
+         socklen_t error_len = sizeof(error);
+         if (system_call::poll(&fd, 1, SOCKDRV_CONNECT_TIMEOUT_MS) <= 0)
+         {
+            logger_send(LOG_ERROR, __func__, "connection timeout");
+            break;
+         }
+         if (system_call::getsockopt(m_sock_fd, SOL_SOCKET, SO_ERROR, &error, &error_len) < 0 || error != 0)
+         {
+            logger_send(LOG_ERROR, __func__, "cannot connect, err: %s", strerror(error));
+            break;
+         }
+         result = true;
+      }
+      else
+      {
+         logger_send(LOG_ERROR, __func__, "cannot connect, err: %s", strerror(errno));
+      }
+      /* data is received and sent in blocking mode */
+      if (result && system_call::fcntl(m_sock_fd, F_SETFL, flags) < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot restore blocking mode, err: %s", strerror(errno));
+         result = false;
+      }
+   } while(0);
+   return result;
+}
+void SocketDriver::threadExecute()
+{
+   logger_send(LOG_SOCKDRV, __func__, "starting thread!");
+   m_recv_buffer.reset();
+   while(m_thread_running)
+   {
+      if (!(isUringActive()? receiveUring() : receiveData()))
+      {
+         m_thread_running = false;
+      }
+   }
+}
+void SocketDriver::onSocketReady(uint32_t events)
+{
+   /* level triggered - single recv() per event does not block the loop */
+   bool connected = true;
+   if (events & (EVLOOP_READ | EVLOOP_ERROR))
+   {
+      connected = receiveData();
+   }
+   if (connected && (events & EVLOOP_WRITE))
+   {
+      std::unique_lock<std::mutex> lock (m_write_mutex);
+      if (!m_direct_send)
+      {
+         flushQueue(lock);
+      }
+      /* during write() in progress write event is requested again when it finishes */
+      if (m_write_count == 0 || m_direct_send)
+      {
+         m_loop->modifyFd(m_sock_fd, EVLOOP_READ);
+         m_write_armed = false;
+      }
+   }
+}
+bool SocketDriver::receiveData()
+{
+   bool result = true;
+   int bytes_count = system_call::recv(m_sock_fd, m_recv_buffer.writePtr(), m_recv_buffer.writeSpace(), 0);
+   if (bytes_count > 0)
+   {
+      processReceived(bytes_count);
+   }
+   else
+   {
+      /* errno is not set when peer closed the connection */
+      result = handleReceiveError(bytes_count == 0? 0 : errno);
+   }
+   return result;
 }
-__attribute__((weak)) int close (int fd)
+void SocketDriver::processReceived(size_t bytes_count)
 {
-   return ::close(fd);
+   if (m_capture_enabled)
+   {
+      captureReceived(m_recv_buffer.writePtr(), bytes_count);
+   }
+   m_stats.addReceived(bytes_count, m_recv_buffer.pending() + bytes_count);
+   size_t frames_count = m_recv_buffer.commit(bytes_count);
+   if (frames_count > 0)
+   {
+      m_stats.addDelivered(frames_count);
+      notify_frames(m_recv_buffer.frames(), frames_count);
+   }
+   m_recv_buffer.release();
+   /* frame overflowing the buffer is detected on release */
+   m_stats.setDropped(m_recv_buffer.dropped());
 }
-
+void SocketDriver::captureReceived(const uint8_t* data, size_t size)
+{
+   std::lock_guard<std::mutex> lock (m_capture_mutex);
+   const uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+   if (m_capture_enabled && !m_capture.append(data, size, timestamp))
+   {
+      logger_send(LOG_ERROR, __func__, "capture stopped");
+      m_capture.close();
+      m_capture_enabled = false;
+   }
 }
-
-
-SocketDriver::SocketDriver() :
-m_server_address(""),
-m_server_port(0),
-m_is_connected(false),
-m_delimiter('\n'),
-m_recv_buffer(SOCKDRV_RECV_BUFFER_SIZE, 0),
-m_recv_buffer_size(0),
-m_thread_running(false),
-m_sock_fd(0)
+bool SocketDriver::startCapture(const std::string& path)
 {
+   std::lock_guard<std::mutex> lock (m_capture_mutex);
+   logger_send(LOG_SOCKDRV, __func__, "%s", path.c_str());
+   m_capture.close();
+   m_capture_enabled = m_capture.create(path);
+   return m_capture_enabled;
 }
-bool SocketDriver::connect(const std::string& ip_address, uint16_t port)
+void SocketDriver::stopCapture()
+{
+   std::lock_guard<std::mutex> lock (m_capture_mutex);
+   m_capture_enabled = false;
+   m_capture.close();
+}
+bool SocketDriver::handleReceiveError(int error)
+{
+   if (m_loop || m_thread_running)
+   {
+      /* otherwise socket was shut down by disconnect() */
+      if (error == 0)
+      {
+         logger_send(LOG_SOCKDRV, __func__, "connection closed by peer");
+      }
+      else
+      {
+         logger_send(LOG_ERROR, __func__, "socket error: %s", strerror(error));
+      }
+      notify_callbacks(DriverEvent::DRIVER_DISCONNECTED, {}, 0);
+      closeSocket();
+   }
+   return false;
+}
+#if defined (SOCKDRV_URING)
+bool SocketDriver::startUring()
 {
    bool result = false;
-   logger_send(LOG_SOCKDRV, __func__, "");
-   do
+   if (m_backend == SocketBackend::URING)
    {
-      if (ip_address.empty() || port == 0)
+      std::lock_guard<std::mutex> lock (m_write_mutex);
+      result = m_uring.init(SOCKDRV_URING_ENTRIES, SOCKDRV_URING_BUFFER_COUNT, SOCKDRV_URING_BUFFER_SIZE) &&
+               m_uring.recvMultishot(m_sock_fd, SOCKDRV_URING_RECV) && m_uring.submit();
+      if (!result)
       {
-         logger_send(LOG_ERROR, __func__, "invalid data %s:%d", ip_address.c_str(), port);
-         break;
+         logger_send(LOG_ERROR, __func__, "io_uring not available, using system calls");
+         m_uring.deinit();
       }
-      m_sock_fd = system_call::socket(AF_INET, SOCK_STREAM, 0);
-      if (m_sock_fd < 0)
+      m_uring_send_pending = false;
+   }
+   return result;
+}
+void SocketDriver::stopUring()
+{
+   /* kernel cancels pending requests, so queued data is not accessed anymore */
+   std::lock_guard<std::mutex> lock (m_write_mutex);
+   m_uring.deinit();
+   m_uring_send_pending = false;
+}
+bool SocketDriver::isUringActive() const
+{
+   return m_uring.isActive();
+}
+int SocketDriver::uringFd() const
+{
+   return m_uring.fd();
+}
+bool SocketDriver::receiveUring()
+{
+   m_uring.wait();
+   return processCompletions();
+}
+bool SocketDriver::processCompletions()
+{
+   bool result = true;
+   UringCompletion completions [SOCKDRV_URING_MAX_COMPLETIONS];
+   size_t count = m_uring.reap(completions, SOCKDRV_URING_MAX_COMPLETIONS);
+   for (size_t i = 0; i < count && result; i++)
+   {
+      if (completions[i].user_data == SOCKDRV_URING_SEND)
       {
-         logger_send(LOG_ERROR, __func__, "cannot create socket, err: %s", strerror(errno));
-         break;
+         onUringSent(completions[i].result);
       }
-
-      struct sockaddr_in serv_addr;
-      serv_addr.sin_family = AF_INET;
-      serv_addr.sin_port = htons(port);
-
-      if(inet_pton(AF_INET, ip_address.c_str(), &serv_addr.sin_addr)<=0)
+      else
       {
-         logger_send(LOG_ERROR, __func__, "cannot convert %s", ip_address.c_str());
-         break;
+         result = onUringReceived(completions[i]);
       }
-
-      if(system_call::connect(m_sock_fd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) >= 0)
+   }
+   return result;
+}
+bool SocketDriver::onUringReceived(const UringCompletion& completion)
+{
+   bool result = true;
+   if (completion.result > 0 && completion.hasBuffer())
+   {
+      const uint8_t* data = m_uring.buffer(completion.bufferId());
+      size_t offset = 0;
+      while (offset < static_cast<size_t>(completion.result) && m_recv_buffer.writeSpace() > 0)
       {
-
-         m_server_address = ip_address;
-         m_server_port = port;
-         m_thread = std::thread(&SocketDriver::threadExecute, this);
-         m_is_connected = true;
-         notify_callbacks(DriverEvent::DRIVER_CONNECTED, {}, 0);
-         while(!m_thread_running);
-         result = true;
-         logger_send(LOG_SOCKDRV, __func__, "connected ok!");
+         size_t bytes = std::min<size_t>(m_recv_buffer.writeSpace(), completion.result - offset);
+         memcpy(m_recv_buffer.writePtr(), data + offset, bytes);
+         processReceived(bytes);
+         offset += bytes;
       }
-
-   }while(0);
-
+      m_uring.recycle(completion.bufferId());
+   }
+   /* multishot request ends when all buffers are in use */
+   if (completion.result == -ENOBUFS || (completion.result > 0 && !completion.hasMore()))
+   {
+      std::lock_guard<std::mutex> lock (m_write_mutex);
+      result = m_uring.recvMultishot(m_sock_fd, SOCKDRV_URING_RECV) && m_uring.submit();
+   }
+   else if (completion.result <= 0)
+   {
+      result = false;
+   }
    if (!result)
    {
-      logger_send(LOG_ERROR, __func__, "error");
-      disconnect();
+      /* result 0 means connection closed by peer, errno is set only when request was not resubmitted */
+      result = handleReceiveError(completion.result < 0? -completion.result : completion.result == 0? 0 : errno);
    }
-
    return result;
 }
-
-void SocketDriver::threadExecute()
+void SocketDriver::onUringSent(int32_t result)
 {
-   m_recv_buffer_size = 0;
-   int bytes_count = 0;
-   m_thread_running = true;
-   logger_send(LOG_SOCKDRV, __func__, "starting thread!");
-   while(m_thread_running)
+   std::vector<WriteCallback> completed;
+   std::unique_lock<std::mutex> lock (m_write_mutex);
+   m_uring_send_pending = false;
+   m_write_cv.notify_all();
+   if (result > 0)
    {
-      bytes_count = system_call::recv(m_sock_fd, &m_recv_buffer[0] + m_recv_buffer_size, SOCKDRV_RECV_BUFFER_SIZE, 0);
-      if (bytes_count > 0)
-      {
-         m_recv_buffer_size += bytes_count;
-         auto it = std::find(m_recv_buffer.begin(), (m_recv_buffer.begin() + m_recv_buffer_size), (uint8_t)m_delimiter);
-         if (it != (m_recv_buffer.begin() + m_recv_buffer_size))
-         {
-            notify_callbacks(DriverEvent::DRIVER_DATA_RECV, std::vector<uint8_t>(m_recv_buffer.begin(), it), std::distance(m_recv_buffer.begin(), it));
-            std::copy(it + 1, m_recv_buffer.begin() + m_recv_buffer_size, m_recv_buffer.begin());
-            m_recv_buffer_size = std::distance(it + 1, m_recv_buffer.begin() + m_recv_buffer_size);
-         }
-      }
-      else
+      advanceQueue(result, completed);
+      submitUringSend();
+      lock.unlock();
+      for (auto& callback : completed)
       {
-         logger_send(LOG_ERROR, __func__, "socket error: %s", strerror(errno));
-         notify_callbacks(DriverEvent::DRIVER_DISCONNECTED, {}, 0);
-         m_thread_running = false;
-         system_call::close(m_sock_fd);
-         m_is_connected = false;
+         callback(true);
       }
    }
+   else
+   {
+      logger_send(LOG_ERROR, __func__, "cannot write, dropping %u bytes: %s", (uint32_t)m_queued_bytes, strerror(-result));
+      lock.unlock();
+      failPendingWrites();
+   }
 }
-void SocketDriver::notify_callbacks(DriverEvent ev, const std::vector<uint8_t>& data, size_t count)
+void SocketDriver::submitUringSend()
 {
-   std::lock_guard<std::mutex> lock (m_mutex);
-   for (auto& l : m_listeners)
+   if (!m_uring_send_pending && !m_direct_send && m_write_count > 0)
    {
-      l->onSocketEvent(ev, data, count);
+      /* queued frames stay in place until completion, so they are sent without copying */
+      m_uring_msg = {};
+      m_uring_msg.msg_iov = m_uring_iov;
+      m_uring_msg.msg_iovlen = fillIovecs(m_uring_iov);
+      m_uring_send_pending = m_uring.sendmsg(m_sock_fd, &m_uring_msg, SOCKDRV_URING_SEND) && m_uring.submit();
+      logger_send_if(!m_uring_send_pending, LOG_ERROR, __func__, "cannot submit %u bytes", (uint32_t)m_queued_bytes);
    }
 }
+#else
+/* io_uring backend not built, ring is never active */
+bool SocketDriver::startUring()
+{
+   logger_send_if(m_backend == SocketBackend::URING, LOG_ERROR, __func__, "io_uring not built, using system calls");
+   return false;
+}
+void SocketDriver::stopUring()
+{
+}
+bool SocketDriver::isUringActive() const
+{
+   return false;
+}
+int SocketDriver::uringFd() const
+{
+   return -1;
+}
+bool SocketDriver::receiveUring()
+{
+   return false;
+}
+bool SocketDriver::processCompletions()
+{
+   return false;
+}
+void SocketDriver::submitUringSend()
+{
+}
+#endif
+void SocketDriver::notify_callbacks(DriverEvent ev, const std::vector<uint8_t>& data, size_t count)
+{
+   m_listeners.forEach([&](SocketListener* l){ l->onSocketEvent(ev, data, count); });
+}
+void SocketDriver::notify_frames(const FrameView* frames, size_t count)
+{
+   m_listeners.forEach([&](SocketListener* l){ l->onSocketFrames(frames, count); });
+}
 bool SocketDriver::disconnect()
 {
    logger_send(LOG_ERROR, __func__, "");
    bool result = false;
+   cancelConnect();
    if (m_thread.joinable())
    {
       m_thread_running = false;
+      {
+         /* receiving thread may have already closed the socket */
+         std::lock_guard<std::mutex> lock (m_write_mutex);
+         if (m_sock_fd > 0)
+         {
+            /* unblocks recv() in receiving thread */
+            system_call::shutdown(m_sock_fd, SHUT_RDWR);
+         }
+      }
       m_thread.join();
    }
-   if (m_sock_fd > 0)
+   closeSocket();
+   setConnected(false);
+   return result;
+}
+void SocketDriver::closeSocket()
+{
+   int fd = -1;
+   {
+      std::unique_lock<std::mutex> lock (m_write_mutex);
+      /* receive error in loop or receiving thread may race with disconnect() - socket is taken by single caller,
+       * so it is never closed twice nor shut down after its number was reused by another descriptor */
+      std::swap(fd, m_sock_fd);
+      if (fd > 0)
+      {
+         /* from now on queue is not flushed and write() does not send, the one in progress is finished first */
+         setConnected(false);
+         if (m_direct_send)
+         {
+            system_call::shutdown(fd, SHUT_RDWR);
+         }
+         m_write_cv.wait(lock, [&](){ return !m_direct_send; });
+      }
+   }
+   if (fd > 0)
    {
-      system_call::close(m_sock_fd);
-      m_sock_fd = 0;
+      if (m_loop)
+      {
+         m_loop->removeFd(isUringActive()? uringFd() : fd);
+      }
+      stopUring();
+      failPendingWrites();
+      system_call::close(fd);
    }
-   m_is_connected = false;
-   return result;
 }
 bool SocketDriver::isConnected()
 {
@@ -165,50 +1060,343 @@ bool SocketDriver::isConnected()
 }
 void SocketDriver::addListener(SocketListener* callback)
 {
-   std::lock_guard<std::mutex> lock (m_mutex);
-   m_listeners.push_back(callback);
+   m_listeners.add(callback);
 }
 void SocketDriver::removeListener(SocketListener* callback)
 {
-   std::lock_guard<std::mutex> lock (m_mutex);
-   std::remove_if(m_listeners.begin(), m_listeners.end(), [&](SocketListener* list){ return list == callback;});
+   m_listeners.remove(callback);
 }
 bool SocketDriver::write(const std::vector<uint8_t>& data, size_t size)
 {
    bool result = false;
    ssize_t bytes_to_write = size == 0? data.size() : size;
    logger_send(LOG_SOCKDRV, __func__, "writing %u bytes", size);
-   if (bytes_to_write <= SOCKDRV_MAX_RW_SIZE)
+   std::unique_lock<std::mutex> lock (m_write_mutex);
+   if (bytes_to_write <= SOCKDRV_MAX_RW_SIZE && waitQueueSent(lock))
    {
       ssize_t bytes_written = 0;
       ssize_t current_write = 0;
+      const uint8_t* buffer = data.data();
+      const int fd = m_sock_fd;
+      if (m_framing == FramingMode::COBS)
+      {
+         bytes_to_write = cobs::encode(buffer, bytes_to_write, m_send_buffer.data());
+         m_send_buffer[bytes_to_write++] = COBS_DELIMITER;
+         buffer = m_send_buffer.data();
+      }
+      /* blocking send without the lock, writeAsync() callers only queue frames behind this data */
+      m_direct_send = true;
+      lock.unlock();
       result = true;
       while (bytes_to_write > 0)
       {
-         //TODO prepare for error here (send not succeeds)
-         current_write = system_call::send(m_sock_fd, data.data() + bytes_written, bytes_to_write, 0);
+         current_write = system_call::send(fd, buffer + bytes_written, bytes_to_write, MSG_NOSIGNAL);
          if (current_write > 0)
          {
             bytes_written += current_write;
+            m_stats.addSent(current_write);
          }
          else
          {
             result = false;
             break;
          }
-         bytes_to_write -= bytes_written;
+         bytes_to_write -= current_write;
+      }
+      lock.lock();
+      m_direct_send = false;
+      m_write_cv.notify_all();
+      if (m_write_count > 0 && m_is_connected)
+      {
+         requestFlush();
       }
    }
    logger_send_if(!result, LOG_ERROR, __func__, "cannot write %u bytes", size);
    return result;
 }
+bool SocketDriver::waitQueueSent(std::unique_lock<std::mutex>& lock)
+{
+   bool result = true;
+   /* data of write() cannot be sent before frames queued by writeAsync() or in the middle of other write() */
+   while (result && m_is_connected && (m_direct_send || m_write_count > 0))
+   {
+      if (m_direct_send)
+      {
+         m_write_cv.wait(lock);
+      }
+      else if (isUringActive())
+      {
+         /* queued frames are owned by io_uring until completion */
+         result = m_write_cv.wait_for(lock, std::chrono::milliseconds(SOCKDRV_WRITE_POLL_TIMEOUT_MS)) == std::cv_status::no_timeout;
+      }
+      else
+      {
+         flushQueue(lock);
+         if (m_write_count > 0 && m_is_connected)
+         {
+            struct pollfd fd = {m_sock_fd, POLLOUT, 0};
+            lock.unlock();
+            result = system_call::poll(&fd, 1, SOCKDRV_WRITE_POLL_TIMEOUT_MS) > 0;
+            lock.lock();
+         }
+      }
+   }
+   logger_send_if(!result, LOG_ERROR, __func__, "queued frames not written");
+   logger_send_if(!m_is_connected, LOG_ERROR, __func__, "not connected");
+   return result && m_is_connected && m_sock_fd > 0;
+}
+bool SocketDriver::writeAsync(const std::vector<uint8_t>& data, WriteCallback callback)
+{
+   bool result = false;
+   std::lock_guard<std::mutex> lock (m_write_mutex);
+   do
+   {
+      if (!m_is_connected)
+      {
+         logger_send(LOG_ERROR, __func__, "not connected");
+         break;
+      }
+      if (m_queued_bytes + data.size() > m_write_high_water_mark || m_write_count == m_write_queue.size())
+      {
+         logger_send(LOG_ERROR, __func__, "queue full, queued %u, new %u", (uint32_t)m_queued_bytes, (uint32_t)data.size());
+         break;
+      }
+      enqueueWrite(data.data(), data.size(), std::move(callback));
+      requestFlush();
+      result = true;
+   } while(0);
+   return result;
+}
+void SocketDriver::setWriteHighWaterMark(size_t bytes)
+{
+   std::lock_guard<std::mutex> lock (m_write_mutex);
+   logger_send(LOG_SOCKDRV, __func__, "high water mark %u", (uint32_t)bytes);
+   m_write_high_water_mark = bytes;
+}
+void SocketDriver::enqueueWrite(const uint8_t* data, size_t size, WriteCallback callback)
+{
+   PendingWrite& item = queuedWrite(m_write_count++);
+   const bool encode = (m_framing == FramingMode::COBS);
+   const size_t max_size = encode? size + COBS_MAX_OVERHEAD(size) + 1 : size;
+   item.data = (max_size <= m_write_pool.blockSize())? m_write_pool.acquire() : nullptr;
+   if (!item.data)
+   {
+      logger_send(LOG_SOCKDRV, __func__, "%u bytes stored on heap", (uint32_t)max_size);
+      item.overflow.resize(max_size);
+      item.data = item.overflow.data();
+   }
+   if (encode)
+   {
+      item.size = cobs::encode(data, size, item.data);
+      item.data[item.size++] = COBS_DELIMITER;
+   }
+   else
+   {
+      std::copy(data, data + size, item.data);
+      item.size = size;
+   }
+   item.offset = 0;
+   item.callback = std::move(callback);
+   m_queued_bytes += item.size;
+   updateQueueStats();
+}
+SocketDriver::PendingWrite& SocketDriver::queuedWrite(size_t index)
+{
+   return m_write_queue[(m_write_head + index) % m_write_queue.size()];
+}
+void SocketDriver::popWrite()
+{
+   PendingWrite& item = queuedWrite(0);
+   m_write_pool.release(item.data);
+   /* frame stored on heap is released immediately, pool blocks are reused */
+   std::vector<uint8_t>().swap(item.overflow);
+   item.data = nullptr;
+   item.callback = nullptr;
+   m_write_head = (m_write_head + 1) % m_write_queue.size();
+   m_write_count--;
+}
+void SocketDriver::requestFlush()
+{
+   if (isUringActive())
+   {
+      submitUringSend();
+   }
+   else if (m_loop)
+   {
+      /* queue is flushed from loop thread when socket is writable */
+      if (!m_write_armed)
+      {
+         m_write_armed = m_loop->modifyFd(m_sock_fd, EVLOOP_READ | EVLOOP_WRITE);
+      }
+   }
+   else
+   {
+      if (!m_writer_running)
+      {
+         if (m_writer_thread.joinable())
+         {
+            m_writer_thread.join();
+         }
+         m_writer_running = true;
+         m_writer_thread = std::thread(&SocketDriver::writerExecute, this);
+      }
+      m_write_cv.notify_all();
+   }
+}
+void SocketDriver::writerExecute()
+{
+   std::unique_lock<std::mutex> lock (m_write_mutex);
+   while (m_writer_running)
+   {
+      m_write_cv.wait(lock, [&](){ return (m_write_count > 0 && !m_direct_send && m_is_connected) || !m_writer_running; });
+      if (m_writer_running)
+      {
+         flushQueue(lock);
+      }
+      if (m_writer_running && m_write_count > 0 && !m_direct_send && m_is_connected)
+      {
+         /* socket buffer is full - waiting without lock, so new data can be queued */
+         struct pollfd fd = {m_sock_fd, POLLOUT, 0};
+         lock.unlock();
+         system_call::poll(&fd, 1, SOCKDRV_WRITE_POLL_TIMEOUT_MS);
+         lock.lock();
+      }
+   }
+}
+void SocketDriver::flushQueue(std::unique_lock<std::mutex>& lock)
+{
+   std::vector<WriteCallback> completed;
+   struct iovec iov [SOCKDRV_MAX_IOV_COUNT];
+   /* socket is closed only after m_is_connected is cleared under the lock */
+   while (m_write_count > 0 && m_is_connected && m_sock_fd > 0)
+   {
+      struct msghdr msg = {};
+      msg.msg_iov = iov;
+      msg.msg_iovlen = fillIovecs(iov);
+      ssize_t bytes_written = system_call::sendmsg(m_sock_fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+      if (bytes_written <= 0)
+      {
+         if (bytes_written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+         {
+            break;
+         }
+         logger_send(LOG_ERROR, __func__, "cannot write, dropping %u bytes: %s", (uint32_t)m_queued_bytes, strerror(errno));
+         lock.unlock();
+         failPendingWrites();
+         lock.lock();
+         break;
+      }
+      advanceQueue(bytes_written, completed);
+   }
+   if (!completed.empty())
+   {
+      lock.unlock();
+      for (auto& callback : completed)
+      {
+         callback(true);
+      }
+      lock.lock();
+   }
+}
+size_t SocketDriver::fillIovecs(struct iovec* iov)
+{
+   size_t iov_count = 0;
+   for (; iov_count < m_write_count && iov_count < SOCKDRV_MAX_IOV_COUNT; iov_count++)
+   {
+      PendingWrite& item = queuedWrite(iov_count);
+      iov[iov_count].iov_base = item.data + item.offset;
+      iov[iov_count].iov_len = item.size - item.offset;
+   }
+   return iov_count;
+}
+void SocketDriver::advanceQueue(size_t bytes_written, std::vector<WriteCallback>& completed)
+{
+   m_queued_bytes -= bytes_written;
+   m_stats.addSent(bytes_written);
+   while (bytes_written > 0)
+   {
+      PendingWrite& front = queuedWrite(0);
+      size_t bytes = std::min<size_t>(bytes_written, front.size - front.offset);
+      front.offset += bytes;
+      bytes_written -= bytes;
+      if (front.offset == front.size)
+      {
+         if (front.callback)
+         {
+            completed.push_back(std::move(front.callback));
+         }
+         popWrite();
+      }
+   }
+   updateQueueStats();
+}
+void SocketDriver::failPendingWrites()
+{
+   std::vector<WriteCallback> dropped;
+   {
+      std::lock_guard<std::mutex> lock (m_write_mutex);
+      while (m_write_count > 0)
+      {
+         if (queuedWrite(0).callback)
+         {
+            dropped.push_back(std::move(queuedWrite(0).callback));
+         }
+         popWrite();
+      }
+      m_queued_bytes = 0;
+      m_write_armed = false;
+      updateQueueStats();
+      m_write_cv.notify_all();
+   }
+   for (auto& callback : dropped)
+   {
+      callback(false);
+   }
+}
 void SocketDriver::setDelimiter(char c)
 {
    std::lock_guard<std::mutex> lock (m_mutex);
    logger_send(LOG_SOCKDRV, __func__, "Setting new delimiter: %x", c);
    m_delimiter = c;
+   m_recv_buffer.setDelimiter(c);
+}
+void SocketDriver::setFraming(FramingMode mode)
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   logger_send(LOG_SOCKDRV, __func__, "Setting framing mode: %u", (uint8_t)mode);
+   m_framing = mode;
+   m_recv_buffer.setFraming(mode);
+}
+void SocketDriver::setFrameLayout(const FrameLayout& layout)
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   logger_send(LOG_SOCKDRV, __func__, "Setting frame layout: h %u, off %u, t %u, max %u",
+               (uint32_t)layout.header_size, (uint32_t)layout.length_offset, (uint32_t)layout.trailer_size, (uint32_t)layout.max_payload);
+   logger_send_if(!m_recv_buffer.setFrameLayout(layout), LOG_ERROR, __func__, "layout rejected");
+}
+void SocketDriver::updateQueueStats()
+{
+   m_stats.setWriteQueue(m_queued_bytes, m_write_count);
+}
+void SocketDriver::setConnected(bool connected)
+{
+   m_stats.setConnected(connected);
+   m_is_connected = connected;
+}
+SocketDriverStats SocketDriver::getStats()
+{
+   return m_stats.get();
 }
 SocketDriver::~SocketDriver()
 {
    disconnect();
+   {
+      std::lock_guard<std::mutex> lock (m_write_mutex);
+      m_writer_running = false;
+      m_write_cv.notify_all();
+   }
+   if (m_writer_thread.joinable())
+   {
+      m_writer_thread.join();
+   }
 }
@@ -0,0 +1,92 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "StateCache.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <stdlib.h>
+#include <algorithm>
+
+namespace
+{
+/* value in tenths, fraction part has the sign of decimal part */
+int32_t to_tenths(int32_t high, int32_t low)
+{
+   return high * 10 + (high < 0? -low : low);
+}
+}
+
+StateCache::StateCache() :
+m_temp_hysteresis(0),
+m_hum_hysteresis(0),
+m_env(),
+m_inputs(),
+m_fan(),
+m_fan_suppressed(0)
+{
+   for (size_t i = 0; i < STATE_CACHE_IDS_COUNT; i++)
+   {
+      m_env_suppressed[i] = 0;
+      m_inputs_suppressed[i] = 0;
+   }
+}
+void StateCache::setEnvHysteresis(uint8_t temperature, uint8_t humidity)
+{
+   m_temp_hysteresis = temperature;
+   m_hum_hysteresis = humidity;
+}
+bool StateCache::updateEnv(uint8_t id, int8_t temp_h, int8_t temp_l, uint8_t hum_h, uint8_t hum_l)
+{
+   bool result = true;
+   EnvEntry& entry = m_env[id];
+   if (entry.valid)
+   {
+      /* every change is bigger than 0 tenths, so zero hysteresis forwards all changes */
+      const int32_t temp_diff = abs(to_tenths(temp_h, temp_l) - to_tenths(entry.temp_h, entry.temp_l));
+      const int32_t hum_diff = abs(to_tenths(hum_h, hum_l) - to_tenths(entry.hum_h, entry.hum_l));
+      result = temp_diff >= std::max<int32_t>(m_temp_hysteresis, 1) || hum_diff >= std::max<int32_t>(m_hum_hysteresis, 1);
+   }
+   if (result)
+   {
+      entry = {temp_h, temp_l, hum_h, hum_l, true};
+   }
+   else
+   {
+      m_env_suppressed[id].fetch_add(1, std::memory_order_relaxed);
+   }
+   return result;
+}
+bool StateCache::updateInput(uint8_t id, uint8_t state)
+{
+   return updateState(m_inputs[id], m_inputs_suppressed[id], state);
+}
+bool StateCache::updateFan(uint8_t state)
+{
+   return updateState(m_fan, m_fan_suppressed, state);
+}
+bool StateCache::updateState(StateEntry& entry, std::atomic<uint32_t>& suppressed, uint8_t state)
+{
+   bool result = !entry.valid || entry.state != state;
+   if (result)
+   {
+      entry = {state, true};
+   }
+   else
+   {
+      suppressed.fetch_add(1, std::memory_order_relaxed);
+   }
+   return result;
+}
+uint32_t StateCache::envSuppressed(uint8_t id) const
+{
+   return m_env_suppressed[id].load(std::memory_order_relaxed);
+}
+uint32_t StateCache::inputSuppressed(uint8_t id) const
+{
+   return m_inputs_suppressed[id].load(std::memory_order_relaxed);
+}
+uint32_t StateCache::fanSuppressed() const
+{
+   return m_fan_suppressed.load(std::memory_order_relaxed);
+}
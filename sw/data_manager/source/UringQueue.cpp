@@ -0,0 +1,315 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "UringQueue.h"
+#include "Logger.h"
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <algorithm>
+
+/* namespace wrapper around system function to allow replace in unit tests */
+namespace system_call
+{
+__attribute__((weak)) int io_uring_setup(uint32_t entries, struct io_uring_params* params)
+{
+   return syscall(__NR_io_uring_setup, entries, params);
+}
+__attribute__((weak)) int io_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags)
+{
+   return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+}
+__attribute__((weak)) int io_uring_register(int fd, uint32_t opcode, void* arg, uint32_t nr_args)
+{
+   return syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+}
+
+namespace
+{
+const uint16_t URING_BUFFER_GROUP = 0;
+/* multishot receive was added in the same release as zero-copy send, which can be probed */
+const uint8_t URING_REQUIRED_OPS[] = {IORING_OP_RECV, IORING_OP_SENDMSG, IORING_OP_SEND_ZC};
+
+uint32_t load_acquire(const uint32_t* value)
+{
+   return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+void store_release(uint32_t* value, uint32_t new_value)
+{
+   __atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+}
+}
+
+UringQueue::UringQueue() :
+m_fd(-1),
+m_ring(MAP_FAILED),
+m_ring_size(0),
+m_sqes(nullptr),
+m_sqes_size(0),
+m_sq_head(nullptr),
+m_sq_tail(nullptr),
+m_sq_mask(0),
+m_sq_entries(0),
+m_sq_local_tail(0),
+m_sq_submitted(0),
+m_cq_head(nullptr),
+m_cq_tail(nullptr),
+m_cq_mask(0),
+m_cqes(nullptr),
+m_buf_ring(nullptr),
+m_buf_ring_size(0),
+m_buf_mask(0),
+m_buf_tail(0),
+m_buffer_size(0)
+{
+}
+bool UringQueue::init(uint32_t entries, uint32_t buffer_count, uint32_t buffer_size)
+{
+   bool result = false;
+   do
+   {
+      if (m_fd >= 0)
+      {
+         break;
+      }
+      struct io_uring_params params = {};
+      m_fd = system_call::io_uring_setup(entries, &params);
+      if (m_fd < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "io_uring not available, err: %s", strerror(errno));
+         break;
+      }
+      if (!(params.features & IORING_FEAT_SINGLE_MMAP))
+      {
+         logger_send(LOG_ERROR, __func__, "kernel too old");
+         break;
+      }
+      /* submission and completion rings are mapped together */
+      m_ring_size = std::max<size_t>(params.sq_off.array + params.sq_entries * sizeof(uint32_t),
+                                     params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe));
+      m_ring = mmap(nullptr, m_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+      m_sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+      void* sqes = mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+      if (m_ring == MAP_FAILED || sqes == MAP_FAILED)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot map ring, err: %s", strerror(errno));
+         m_sqes = (sqes == MAP_FAILED)? nullptr : static_cast<struct io_uring_sqe*>(sqes);
+         break;
+      }
+      uint8_t* ring = static_cast<uint8_t*>(m_ring);
+      m_sqes = static_cast<struct io_uring_sqe*>(sqes);
+      m_sq_head = reinterpret_cast<uint32_t*>(ring + params.sq_off.head);
+      m_sq_tail = reinterpret_cast<uint32_t*>(ring + params.sq_off.tail);
+      m_sq_mask = *reinterpret_cast<uint32_t*>(ring + params.sq_off.ring_mask);
+      m_sq_entries = params.sq_entries;
+      m_cq_head = reinterpret_cast<uint32_t*>(ring + params.cq_off.head);
+      m_cq_tail = reinterpret_cast<uint32_t*>(ring + params.cq_off.tail);
+      m_cq_mask = *reinterpret_cast<uint32_t*>(ring + params.cq_off.ring_mask);
+      m_cqes = reinterpret_cast<struct io_uring_cqe*>(ring + params.cq_off.cqes);
+      /* submission queue entries are used in order, so index array is filled once */
+      uint32_t* sq_array = reinterpret_cast<uint32_t*>(ring + params.sq_off.array);
+      for (uint32_t i = 0; i < m_sq_entries; i++)
+      {
+         sq_array[i] = i;
+      }
+      m_sq_local_tail = *m_sq_tail;
+      m_sq_submitted = m_sq_local_tail;
+      if (!probe() || !registerBuffers(buffer_count, buffer_size))
+      {
+         break;
+      }
+      result = true;
+   } while(0);
+   if (!result)
+   {
+      deinit();
+   }
+   return result;
+}
+bool UringQueue::probe()
+{
+   const size_t ops_count = 256;
+   std::vector<uint8_t> buffer (sizeof(struct io_uring_probe) + ops_count * sizeof(struct io_uring_probe_op), 0);
+   struct io_uring_probe* info = reinterpret_cast<struct io_uring_probe*>(buffer.data());
+   bool result = system_call::io_uring_register(m_fd, IORING_REGISTER_PROBE, info, ops_count) >= 0;
+   for (uint8_t op : URING_REQUIRED_OPS)
+   {
+      result = result && op <= info->last_op && (info->ops[op].flags & IO_URING_OP_SUPPORTED);
+   }
+   logger_send_if(!result, LOG_ERROR, __func__, "required operations not supported");
+   return result;
+}
+bool UringQueue::registerBuffers(uint32_t buffer_count, uint32_t buffer_size)
+{
+   bool result = false;
+   do
+   {
+      if (buffer_count == 0 || (buffer_count & (buffer_count - 1)) != 0)
+      {
+         logger_send(LOG_ERROR, __func__, "invalid buffer count %u", buffer_count);
+         break;
+      }
+      /* buffer ring is shared with kernel, so it has to be page aligned */
+      m_buf_ring_size = buffer_count * sizeof(struct io_uring_buf);
+      void* buf_ring = mmap(nullptr, m_buf_ring_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (buf_ring == MAP_FAILED)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot allocate buffer ring");
+         break;
+      }
+      m_buf_ring = static_cast<struct io_uring_buf_ring*>(buf_ring);
+      struct io_uring_buf_reg reg = {};
+      reg.ring_addr = reinterpret_cast<uint64_t>(m_buf_ring);
+      reg.ring_entries = buffer_count;
+      reg.bgid = URING_BUFFER_GROUP;
+      if (system_call::io_uring_register(m_fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot register buffers, err: %s", strerror(errno));
+         break;
+      }
+      m_buffers.assign(buffer_count * buffer_size, 0);
+      m_buffer_size = buffer_size;
+      m_buf_mask = buffer_count - 1;
+      m_buf_tail = 0;
+      for (uint32_t i = 0; i < buffer_count; i++)
+      {
+         recycle(i);
+      }
+      result = true;
+   } while(0);
+   return result;
+}
+void UringQueue::deinit()
+{
+   if (m_fd >= 0)
+   {
+      ::close(m_fd);
+      m_fd = -1;
+   }
+   if (m_ring != MAP_FAILED)
+   {
+      munmap(m_ring, m_ring_size);
+      m_ring = MAP_FAILED;
+   }
+   if (m_sqes)
+   {
+      munmap(m_sqes, m_sqes_size);
+      m_sqes = nullptr;
+   }
+   if (m_buf_ring)
+   {
+      munmap(m_buf_ring, m_buf_ring_size);
+      m_buf_ring = nullptr;
+   }
+   m_buffers.clear();
+}
+bool UringQueue::isActive() const
+{
+   return m_fd >= 0;
+}
+int UringQueue::fd() const
+{
+   return m_fd;
+}
+struct io_uring_sqe* UringQueue::nextSqe()
+{
+   struct io_uring_sqe* result = nullptr;
+   if (m_sq_local_tail - load_acquire(m_sq_head) < m_sq_entries)
+   {
+      result = &m_sqes[m_sq_local_tail & m_sq_mask];
+      memset(result, 0, sizeof(*result));
+      m_sq_local_tail++;
+   }
+   return result;
+}
+bool UringQueue::recvMultishot(int socket, uint64_t user_data)
+{
+   struct io_uring_sqe* sqe = nextSqe();
+   if (sqe)
+   {
+      sqe->opcode = IORING_OP_RECV;
+      sqe->fd = socket;
+      sqe->ioprio = IORING_RECV_MULTISHOT;
+      sqe->flags = IOSQE_BUFFER_SELECT;
+      sqe->buf_group = URING_BUFFER_GROUP;
+      sqe->user_data = user_data;
+   }
+   return sqe != nullptr;
+}
+bool UringQueue::sendmsg(int socket, const struct msghdr* message, uint64_t user_data)
+{
+   struct io_uring_sqe* sqe = nextSqe();
+   if (sqe)
+   {
+      sqe->opcode = IORING_OP_SENDMSG;
+      sqe->fd = socket;
+      sqe->addr = reinterpret_cast<uint64_t>(message);
+      sqe->len = 1;
+      sqe->msg_flags = MSG_NOSIGNAL;
+      sqe->user_data = user_data;
+   }
+   return sqe != nullptr;
+}
+bool UringQueue::submit()
+{
+   bool result = true;
+   store_release(m_sq_tail, m_sq_local_tail);
+   while (m_sq_submitted != m_sq_local_tail)
+   {
+      int submitted = system_call::io_uring_enter(m_fd, m_sq_local_tail - m_sq_submitted, 0, 0);
+      if (submitted < 0 && errno == EINTR)
+      {
+         continue;
+      }
+      if (submitted <= 0)
+      {
+         logger_send(LOG_ERROR, __func__, "cannot submit, err: %s", strerror(errno));
+         result = false;
+         break;
+      }
+      m_sq_submitted += submitted;
+   }
+   return result;
+}
+bool UringQueue::wait()
+{
+   return system_call::io_uring_enter(m_fd, 0, 1, IORING_ENTER_GETEVENTS) >= 0;
+}
+size_t UringQueue::reap(UringCompletion* completions, size_t max)
+{
+   const uint32_t head = *m_cq_head;
+   const uint32_t count = std::min<uint32_t>(load_acquire(m_cq_tail) - head, max);
+   for (uint32_t i = 0; i < count; i++)
+   {
+      const struct io_uring_cqe& cqe = m_cqes[(head + i) & m_cq_mask];
+      completions[i].user_data = cqe.user_data;
+      completions[i].result = cqe.res;
+      completions[i].flags = cqe.flags;
+   }
+   store_release(m_cq_head, head + count);
+   return count;
+}
+const uint8_t* UringQueue::buffer(uint16_t id) const
+{
+   return m_buffers.data() + id * m_buffer_size;
+}
+void UringQueue::recycle(uint16_t id)
+{
+   /* bufs member cannot be used - its empty struct wrapper takes space in C++, so array would be shifted */
+   struct io_uring_buf& buf = reinterpret_cast<struct io_uring_buf*>(m_buf_ring)[m_buf_tail & m_buf_mask];
+   buf.addr = reinterpret_cast<uint64_t>(m_buffers.data() + id * m_buffer_size);
+   buf.len = m_buffer_size;
+   buf.bid = id;
+   m_buf_tail++;
+   __atomic_store_n(&m_buf_ring->tail, m_buf_tail, __ATOMIC_RELEASE);
+}
+UringQueue::~UringQueue()
+{
+   deinit();
+}
@@ -0,0 +1,22 @@
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "WakeupEvent.h"
+
+WakeupEvent::WakeupEvent() :
+m_notified(false)
+{
+}
+void WakeupEvent::notify()
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   m_notified = true;
+   m_cv.notify_all();
+}
+bool WakeupEvent::waitFor(std::chrono::milliseconds timeout)
+{
+   std::unique_lock<std::mutex> lock (m_mutex);
+   bool result = m_cv.wait_for(lock, timeout, [&](){ return m_notified; });
+   m_notified = false;
+   return result;
+}
@@ -0,0 +1,24 @@
+#ifndef _EVENT_LOOP_MOCK_H_
+#define _EVENT_LOOP_MOCK_H_
+
+#include "gmock/gmock.h"
+#include "IEventLoop.h"
+
+
+class EventLoopMock : public IEventLoop
+{
+public:
+   MOCK_METHOD0(start, bool());
+   MOCK_METHOD0(stop, void());
+   MOCK_METHOD0(isRunning, bool());
+   MOCK_METHOD0(isLoopThread, bool());
+   MOCK_METHOD3(addFd, bool(int, uint32_t, FdCallback));
+   MOCK_METHOD2(modifyFd, bool(int, uint32_t));
+   MOCK_METHOD1(removeFd, void(int));
+   MOCK_METHOD2(addTimer, TimerId(std::chrono::milliseconds, TimerCallback));
+   MOCK_METHOD1(cancelTimer, void(TimerId));
+
+};
+
+
+#endif
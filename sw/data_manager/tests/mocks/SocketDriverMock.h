@@ -8,13 +8,29 @@
 class SocketDriverMock : public ISocketDriver
 {
 public:
+   SocketDriverMock()
+   {
+      /* connects synchronously by connect() or connectAny() unless test expects otherwise */
+      ON_CALL(*this, connectAsync(testing::_, testing::_)).WillByDefault(testing::Invoke(
+            [this](const std::vector<SocketEndpoint>& endpoints, ConnectCallback callback)
+            {
+               ISocketDriver::connectAsync(endpoints, callback);
+            }));
+   }
    MOCK_METHOD2(connect, bool(const std::string&, uint16_t));
+   MOCK_METHOD1(connectAny, int(const std::vector<SocketEndpoint>&));
+   MOCK_METHOD2(connectAsync, void(const std::vector<SocketEndpoint>&, ConnectCallback));
    MOCK_METHOD0(disconnect, bool());
    MOCK_METHOD0(isConnected, bool());
    MOCK_METHOD1(addListener, void(SocketListener*));
    MOCK_METHOD1(setDelimiter, void(char c));
    MOCK_METHOD1(removeListener, void(SocketListener*));
    MOCK_METHOD2(write, bool(const std::vector<uint8_t>&, size_t));
+   MOCK_METHOD2(writeAsync, bool(const std::vector<uint8_t>&, WriteCallback));
+   MOCK_METHOD1(setWriteHighWaterMark, void(size_t));
+   MOCK_METHOD1(setFraming, void(FramingMode));
+   MOCK_METHOD1(setFrameLayout, void(const FrameLayout&));
+   MOCK_METHOD0(getStats, SocketDriverStats());
 
 };
 
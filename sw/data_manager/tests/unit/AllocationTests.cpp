@@ -0,0 +1,256 @@
+#include "gtest/gtest.h"
+
+#include "SocketDriver.h"
+#include "DataProvider.h"
+#include "Logger.h"
+#include "notification_types.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <thread>
+/* ============================= */
+/**
+ * @file AllocationTests.cpp
+ *
+ * @brief Tests verifying that connected SocketDriver and DataProvider do not allocate memory per frame.
+ *
+ * @details Global operator new is replaced by counting one, so allocations made by any thread are visible.
+ *          Real driver is connected over TCP loopback to the server socket owned by the test. Real logger
+ *          is linked with all groups enabled, so log lines written on the measured paths are counted too.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+std::atomic<size_t> allocations_count {0};
+
+void* operator new(size_t size)
+{
+   allocations_count++;
+   void* result = malloc(size? size : 1);
+   if (!result)
+   {
+      abort();
+   }
+   return result;
+}
+void operator delete(void* ptr) noexcept
+{
+   free(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept
+{
+   free(ptr);
+}
+
+/* every env sensor and every input except INPUT_SOCKETS, which ID is equal to delimiter */
+const size_t FRAMES_IN_BURST = ENV_STAIRS + INPUT_STAIRS_SENSOR;
+const size_t BURSTS_COUNT = 20;
+
+struct CountingWindow : public IMainWindowWrapper
+{
+   void setEnvState(ENV_ITEM_ID, int8_t, int8_t, uint8_t, uint8_t) override
+   {
+      m_updates++;
+   }
+   void setInputState(INPUT_ID, INPUT_STATE) override
+   {
+      m_updates++;
+   }
+   void setFanState(FAN_STATE) override
+   {
+      m_updates++;
+   }
+   void setStateBatch(const StateUpdateBatch& batch) override
+   {
+      m_updates += batch.updates_count;
+   }
+   std::atomic<size_t> m_updates {0};
+};
+
+/* appends NTF_NTF frame terminated by delimiter, item ID is the first payload byte */
+void add_ntf_frame(std::vector<uint8_t>& stream, NTF_CMD_ID id, uint8_t item_id, uint8_t payload_size)
+{
+   stream.push_back(id);
+   stream.push_back(NTF_NTF);
+   stream.push_back(payload_size);
+   stream.push_back(item_id);
+   stream.insert(stream.end(), payload_size - 1, 0);
+   stream.push_back('\n');
+}
+
+struct AllocationFixture : public testing::Test
+{
+   void SetUp()
+   {
+      logger_initialize();
+      struct sockaddr_in addr = {};
+      socklen_t len = sizeof(addr);
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      m_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+      ASSERT_EQ(bind(m_listen_fd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+      ASSERT_EQ(getsockname(m_listen_fd, (struct sockaddr*)&addr, &len), 0);
+      ASSERT_EQ(listen(m_listen_fd, 1), 0);
+      m_port = ntohs(addr.sin_port);
+      /* item IDs are distinct, so updates are not merged in main window batch */
+      for (uint8_t id = ENV_OUTSIDE; id <= ENV_STAIRS; id++)
+      {
+         add_ntf_frame(m_burst, NTF_ENV_SENSOR_DATA, id, 6);
+      }
+      for (uint8_t id = INPUT_WARDROBE_AC; id <= INPUT_STAIRS_SENSOR; id++)
+      {
+         add_ntf_frame(m_burst, NTF_INPUTS_STATE, id, 2);
+      }
+   }
+   void TearDown()
+   {
+      close(m_listen_fd);
+      logger_deinitialize();
+   }
+   bool sendBurst(int fd)
+   {
+      /* unchanged states are not passed to main window, last byte of every payload (state, temperature) is toggled */
+      for (size_t i = 0; i < m_burst.size(); i++)
+      {
+         if (m_burst[i] == '\n')
+         {
+            m_burst[i - 1] ^= 1;
+         }
+      }
+      size_t sent = 0;
+      while (sent < m_burst.size())
+      {
+         ssize_t result = send(fd, m_burst.data() + sent, m_burst.size() - sent, MSG_NOSIGNAL);
+         if (result <= 0)
+         {
+            return false;
+         }
+         sent += result;
+      }
+      return true;
+   }
+   bool receiveBytes(int fd, size_t bytes)
+   {
+      uint8_t buffer [256];
+      while (bytes > 0)
+      {
+         ssize_t result = recv(fd, buffer, std::min(bytes, sizeof(buffer)), 0);
+         if (result <= 0)
+         {
+            return false;
+         }
+         bytes -= result;
+      }
+      return true;
+   }
+   bool waitForUpdates(const CountingWindow& window, size_t expected)
+   {
+      std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (window.m_updates < expected && std::chrono::steady_clock::now() < deadline)
+      {
+         std::this_thread::yield();
+      }
+      return window.m_updates == expected;
+   }
+   /* returns number of allocations made while connected provider receives bursts of frames */
+   size_t countReceiveAllocations(SocketBackend backend)
+   {
+      size_t result = SIZE_MAX;
+      CountingWindow window;
+      SocketDriver driver (backend);
+      std::unique_ptr<IDataProvider> provider (new DataProvider(window, driver));
+      EXPECT_TRUE(provider->run("127.0.0.1", m_port, '\n'));
+      int server_fd = accept(m_listen_fd, nullptr, nullptr);
+      /* first burst may initialize lazily allocated state */
+      if (server_fd >= 0 && sendBurst(server_fd) && waitForUpdates(window, FRAMES_IN_BURST))
+      {
+         const size_t allocations_before = allocations_count;
+         bool delivered = true;
+         for (size_t i = 0; i < BURSTS_COUNT && delivered; i++)
+         {
+            delivered = sendBurst(server_fd) && waitForUpdates(window, (i + 2) * FRAMES_IN_BURST);
+         }
+         result = allocations_count - allocations_before;
+         EXPECT_TRUE(delivered);
+      }
+      provider.reset();
+      close(server_fd);
+      return result;
+   }
+   /* returns number of allocations made while connected driver sends small frames */
+   size_t countWriteAllocations(SocketBackend backend)
+   {
+      size_t result = SIZE_MAX;
+      const std::vector<uint8_t> frame = {NTF_SYSTEM_TIME, NTF_GET, 0, '\n'};
+      SocketDriver driver (backend);
+      ISocketDriver& drv = driver;
+      int server_fd = -1;
+      if (drv.connect("127.0.0.1", m_port))
+      {
+         server_fd = accept(m_listen_fd, nullptr, nullptr);
+      }
+      /* first write may start writer thread */
+      if (server_fd >= 0 && drv.writeAsync(frame) && receiveBytes(server_fd, frame.size()))
+      {
+         const size_t allocations_before = allocations_count;
+         bool sent = true;
+         for (size_t i = 0; i < BURSTS_COUNT && sent; i++)
+         {
+            sent = drv.writeAsync(frame) && drv.writeAsync(frame) && receiveBytes(server_fd, 2 * frame.size());
+         }
+         result = allocations_count - allocations_before;
+         EXPECT_TRUE(sent);
+      }
+      drv.disconnect();
+      close(server_fd);
+      return result;
+   }
+
+   int m_listen_fd;
+   uint16_t m_port;
+   std::vector<uint8_t> m_burst;
+};
+
+/**
+ * @test Tests of memory allocations on receive path
+ */
+TEST_F(AllocationFixture, receive_steady_state_tests)
+{
+   /**
+    * <b>scenario</b>: Connected provider receives bursts of notifications with system call backend.<br>
+    * <b>expected</b>: Every frame passed to main window, no memory allocated.<br>
+    * ************************************************
+    */
+   EXPECT_EQ(countReceiveAllocations(SocketBackend::SYSCALL), 0);
+
+   /**
+    * <b>scenario</b>: Connected provider receives bursts of notifications with io_uring backend.<br>
+    * <b>expected</b>: Every frame passed to main window, no memory allocated.<br>
+    * ************************************************
+    */
+   EXPECT_EQ(countReceiveAllocations(SocketBackend::URING), 0);
+}
+
+/**
+ * @test Tests of memory allocations on write path
+ */
+TEST_F(AllocationFixture, write_steady_state_tests)
+{
+   /**
+    * <b>scenario</b>: Connected driver sends small frames with system call backend.<br>
+    * <b>expected</b>: Frames stored in pool, no memory allocated.<br>
+    * ************************************************
+    */
+   EXPECT_EQ(countWriteAllocations(SocketBackend::SYSCALL), 0);
+
+   /**
+    * <b>scenario</b>: Connected driver sends small frames with io_uring backend.<br>
+    * <b>expected</b>: Frames stored in pool, no memory allocated.<br>
+    * ************************************************
+    */
+   EXPECT_EQ(countWriteAllocations(SocketBackend::URING), 0);
+}
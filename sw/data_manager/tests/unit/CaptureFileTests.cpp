@@ -0,0 +1,191 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "CaptureFile.h"
+#include "logger_mock.hpp"
+#include <fstream>
+#include <unistd.h>
+#include <string.h>
+/* ============================= */
+/**
+ * @file CaptureFileTests.cpp
+ *
+ * @brief Unit tests to verify behavior of CaptureWriter and CaptureReader.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+struct CaptureFileFixture : public testing::Test
+{
+   void SetUp()
+   {
+      mock_logger_init();
+      m_path = "/tmp/smarthome_capture_test_" + std::to_string(getpid());
+   }
+   void TearDown()
+   {
+      unlink(m_path.c_str());
+      mock_logger_deinit();
+   }
+   std::string m_path;
+};
+
+/**
+ * @test Tests of writing and reading the capture
+ */
+TEST_F(CaptureFileFixture, write_read_tests)
+{
+   CaptureWriter writer;
+   CaptureReader reader;
+   /**
+    * <b>scenario</b>: Data appended when file is not created.<br>
+    * <b>expected</b>: Data rejected.<br>
+    * ************************************************
+    */
+   const uint8_t first [] = {'a', 'b', 'c'};
+   const uint8_t second [] = {'d', 'e'};
+   EXPECT_FALSE(writer.isOpen());
+   EXPECT_FALSE(writer.append(first, sizeof(first), 100));
+
+   /**
+    * <b>scenario</b>: Two chunks written.<br>
+    * <b>expected</b>: Reader sees both chunks with timestamps, data placed one after another.<br>
+    * ************************************************
+    */
+   ASSERT_TRUE(writer.create(m_path));
+   EXPECT_TRUE(writer.isOpen());
+   EXPECT_TRUE(writer.append(first, sizeof(first), 100));
+   EXPECT_TRUE(writer.append(second, sizeof(second), 250));
+   ASSERT_TRUE(reader.open(m_path));
+   ASSERT_EQ(reader.chunks(), 2);
+   EXPECT_EQ(reader.chunk(0).timestamp_ns, 100);
+   EXPECT_EQ(reader.chunk(0).end, 3);
+   EXPECT_EQ(reader.chunk(1).timestamp_ns, 250);
+   EXPECT_EQ(reader.chunk(1).end, 5);
+   EXPECT_EQ(std::string((const char*)reader.data(), 5), "abcde");
+
+   /**
+    * <b>scenario</b>: Writer closed.<br>
+    * <b>expected</b>: Chunks still readable from truncated file.<br>
+    * ************************************************
+    */
+   writer.close();
+   EXPECT_FALSE(writer.isOpen());
+   ASSERT_TRUE(reader.open(m_path));
+   ASSERT_EQ(reader.chunks(), 2);
+   EXPECT_EQ(std::string((const char*)reader.data(), 5), "abcde");
+
+   /**
+    * <b>scenario</b>: Data modified in reader mapping.<br>
+    * <b>expected</b>: File not changed.<br>
+    * ************************************************
+    */
+   reader.data()[0] = 'x';
+   ASSERT_TRUE(reader.open(m_path));
+   EXPECT_EQ(reader.data()[0], 'a');
+   reader.close();
+   EXPECT_EQ(reader.chunks(), 0);
+}
+
+/**
+ * @test Tests of capture file growing and index limit
+ */
+TEST_F(CaptureFileFixture, growth_tests)
+{
+   CaptureWriter writer;
+   CaptureReader reader;
+   /**
+    * <b>scenario</b>: More data written than initial file size.<br>
+    * <b>expected</b>: File extended, all data readable.<br>
+    * ************************************************
+    */
+   const size_t CHUNK_SIZE = 64 * 1024;
+   const size_t CHUNKS = CAPTURE_INITIAL_DATA_SIZE / CHUNK_SIZE * 3;
+   std::vector<uint8_t> chunk (CHUNK_SIZE);
+   ASSERT_TRUE(writer.create(m_path, CHUNKS));
+   for (size_t i = 0; i < CHUNKS; i++)
+   {
+      memset(chunk.data(), i, chunk.size());
+      ASSERT_TRUE(writer.append(chunk.data(), chunk.size(), i));
+   }
+
+   /**
+    * <b>scenario</b>: Index full.<br>
+    * <b>expected</b>: Next chunk rejected.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(writer.append(chunk.data(), chunk.size(), CHUNKS));
+   writer.close();
+   ASSERT_TRUE(reader.open(m_path));
+   ASSERT_EQ(reader.chunks(), CHUNKS);
+   for (size_t i = 0; i < CHUNKS; i++)
+   {
+      EXPECT_EQ(reader.chunk(i).end, (i + 1) * CHUNK_SIZE);
+      EXPECT_EQ(reader.data()[i * CHUNK_SIZE], (uint8_t)i);
+      EXPECT_EQ(reader.data()[(i + 1) * CHUNK_SIZE - 1], (uint8_t)i);
+   }
+}
+
+/**
+ * @test Tests of opening invalid files
+ */
+TEST_F(CaptureFileFixture, invalid_file_tests)
+{
+   CaptureReader reader;
+   /**
+    * <b>scenario</b>: File does not exist.<br>
+    * <b>expected</b>: File not opened.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(reader.open(m_path));
+
+   /**
+    * <b>scenario</b>: File is not a capture.<br>
+    * <b>expected</b>: File not opened.<br>
+    * ************************************************
+    */
+   {
+      std::ofstream file (m_path);
+      file << std::string(sizeof(CaptureHeader) * 2, 'x');
+   }
+   EXPECT_FALSE(reader.open(m_path));
+   EXPECT_EQ(reader.chunks(), 0);
+
+   /**
+    * <b>scenario</b>: Capture cut in the middle of data, e.g. by application crash.<br>
+    * <b>expected</b>: Only chunks placed in the file are available.<br>
+    * ************************************************
+    */
+   CaptureWriter writer;
+   const uint8_t data [16] = {};
+   ASSERT_TRUE(writer.create(m_path, 8));
+   EXPECT_TRUE(writer.append(data, sizeof(data), 1));
+   EXPECT_TRUE(writer.append(data, sizeof(data), 2));
+   writer.close();
+   ASSERT_TRUE(reader.open(m_path));
+   ASSERT_EQ(reader.chunks(), 2);
+   reader.close();
+   CaptureHeader header = {};
+   std::ifstream(m_path).read(reinterpret_cast<char*>(&header), sizeof(header));
+   ASSERT_EQ(truncate(m_path.c_str(), header.data_offset + sizeof(data) + 4), 0);
+   ASSERT_TRUE(reader.open(m_path));
+   EXPECT_EQ(reader.chunks(), 1);
+   reader.close();
+
+   /**
+    * <b>scenario</b>: Index capacity corrupted, so that index size overflows to zero.<br>
+    * <b>expected</b>: File not opened.<br>
+    * ************************************************
+    */
+   header.index_capacity = (UINT64_MAX / sizeof(CaptureChunk)) + 1;
+   {
+      std::fstream file (m_path, std::ios::in | std::ios::out | std::ios::binary);
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+   }
+   EXPECT_FALSE(reader.open(m_path));
+   EXPECT_EQ(reader.chunks(), 0);
+}
@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "Cobs.h"
+#include <random>
+/* ============================= */
+/**
+ * @file CobsTests.cpp
+ *
+ * @brief Unit tests to verify behavior of COBS codec.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+struct CobsFixture : public testing::Test
+{
+   std::vector<uint8_t> encode(const std::vector<uint8_t>& data)
+   {
+      std::vector<uint8_t> result (data.size() + COBS_MAX_OVERHEAD(data.size()), 0xEE);
+      result.resize(cobs::encode(data.data(), data.size(), result.data()));
+      return result;
+   }
+   std::vector<uint8_t> decode(std::vector<uint8_t> data)
+   {
+      size_t decoded_size = 0;
+      EXPECT_TRUE(cobs::decode(data.data(), data.size(), decoded_size));
+      data.resize(decoded_size);
+      return data;
+   }
+   /* creates sequence first, first + 1, ... (without zero when first > 0) */
+   std::vector<uint8_t> sequence(uint8_t first, size_t count)
+   {
+      std::vector<uint8_t> result;
+      for (size_t i = 0; i < count; i++)
+      {
+         result.push_back(first + i);
+      }
+      return result;
+   }
+};
+
+/**
+ * @test Tests of encoding and decoding reference data
+ */
+TEST_F(CobsFixture, reference_data_tests)
+{
+   /**
+    * <b>scenario</b>: Short data with zeros encoded.<br>
+    * <b>expected</b>: Zeros replaced by distance to next zero.<br>
+    * ************************************************
+    */
+   EXPECT_THAT(encode({}), ElementsAre(1));
+   EXPECT_THAT(encode({0}), ElementsAre(1, 1));
+   EXPECT_THAT(encode({0, 0}), ElementsAre(1, 1, 1));
+   EXPECT_THAT(encode({0, 0x11, 0}), ElementsAre(1, 2, 0x11, 1));
+   EXPECT_THAT(encode({0x11, 0x22, 0, 0x33}), ElementsAre(3, 0x11, 0x22, 2, 0x33));
+   EXPECT_THAT(encode({0x11, 0x22, 0x33, 0x44}), ElementsAre(5, 0x11, 0x22, 0x33, 0x44));
+   EXPECT_THAT(encode({0x11, 0, 0, 0}), ElementsAre(2, 0x11, 1, 1, 1));
+
+   /**
+    * <b>scenario</b>: Data with 254 and more non-zero bytes encoded.<br>
+    * <b>expected</b>: Data split into blocks of 254 bytes.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> expected = sequence(1, 254);
+   expected.insert(expected.begin(), 0xFF);
+   EXPECT_EQ(encode(sequence(1, 254)), expected);
+
+   expected = sequence(0, 255);
+   expected[0] = 0xFF;
+   expected.insert(expected.begin(), 1);
+   EXPECT_EQ(encode(sequence(0, 255)), expected);
+
+   std::vector<uint8_t> data = sequence(1, 255);
+   expected = sequence(1, 254);
+   expected.insert(expected.begin(), 0xFF);
+   expected.push_back(2);
+   expected.push_back(0xFF);
+   EXPECT_EQ(encode(data), expected);
+
+   data = sequence(2, 255);
+   data[254] = 0;
+   expected = sequence(2, 254);
+   expected.insert(expected.begin(), 0xFF);
+   expected.push_back(1);
+   expected.push_back(1);
+   EXPECT_EQ(encode(data), expected);
+
+   /**
+    * <b>scenario</b>: Reference data decoded.<br>
+    * <b>expected</b>: Original data restored.<br>
+    * ************************************************
+    */
+   EXPECT_THAT(decode({1}), ElementsAre());
+   EXPECT_THAT(decode({1, 2, 0x11, 1}), ElementsAre(0, 0x11, 0));
+   EXPECT_THAT(decode({2, 0x11, 1, 1, 1}), ElementsAre(0x11, 0, 0, 0));
+   EXPECT_EQ(decode(expected), data);
+}
+
+/**
+ * @test Tests of encoding in place and random data
+ */
+TEST_F(CobsFixture, in_place_tests)
+{
+   std::mt19937 rng (1234);
+   std::uniform_int_distribution<int> byte (0, 255);
+   std::uniform_int_distribution<int> zero_ratio (0, 8);
+   for (size_t size = 0; size < 1200; size += 7)
+   {
+      /**
+       * <b>scenario</b>: Random data placed after headroom is encoded in place, then decoded.<br>
+       * <b>expected</b>: Same result as encoding to other buffer, original data restored.<br>
+       * ************************************************
+       */
+      const int ratio = zero_ratio(rng);
+      std::vector<uint8_t> data (size);
+      for (auto& b : data)
+      {
+         b = (ratio == 0 || (byte(rng) % ratio) == 0)? 0 : byte(rng) | 1;
+      }
+      const size_t headroom = COBS_MAX_OVERHEAD(size);
+      std::vector<uint8_t> buffer (headroom, 0xEE);
+      buffer.insert(buffer.end(), data.begin(), data.end());
+      size_t encoded_size = cobs::encode(buffer.data() + headroom, size, buffer.data());
+      buffer.resize(encoded_size);
+
+      EXPECT_EQ(buffer, encode(data)) << "size " << size;
+      EXPECT_EQ(std::count(buffer.begin(), buffer.end(), COBS_DELIMITER), 0);
+      EXPECT_EQ(decode(buffer), data) << "size " << size;
+   }
+}
+
+/**
+ * @test Tests of decoding invalid data
+ */
+TEST_F(CobsFixture, invalid_data_tests)
+{
+   size_t decoded_size = 0;
+   /**
+    * <b>scenario</b>: Data with code byte pointing behind the data decoded.<br>
+    * <b>expected</b>: False returned.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> data = {3, 0x11};
+   EXPECT_FALSE(cobs::decode(data.data(), data.size(), decoded_size));
+
+   /**
+    * <b>scenario</b>: Data with zero code byte decoded.<br>
+    * <b>expected</b>: False returned.<br>
+    * ************************************************
+    */
+   data = {2, 0x11, 0, 0x22};
+   EXPECT_FALSE(cobs::decode(data.data(), data.size(), decoded_size));
+}
@@ -3,13 +3,20 @@
 
 #define DATA_PROVIDER_FRIEND_TESTS \
    FRIEND_TEST(DataProviderFixture, thread_execution_tests);\
+   FRIEND_TEST(DataProviderFixture, reconnect_policy_tests);\
+   FRIEND_TEST(DataProviderFixture, failover_tests);\
+   FRIEND_TEST(DataProviderFixture, link_timeout_tests);\
    friend class DataProviderFixture;
 
 #include "DataProvider.h"
 #include "logger_mock.hpp"
 #include "MainWindowWrapperMock.h"
 #include "SocketDriverMock.h"
+#include "EventLoopMock.h"
+#include "ReplayDriver.h"
 #include "notification_types.h"
+#include <condition_variable>
+#include <unistd.h>
 /* ============================= */
 /**
  * @file DataProviderTests.cpp
@@ -26,16 +33,48 @@ using namespace testing;
 struct SleepMock
 {
    MOCK_METHOD1(sleep, void(std::chrono::milliseconds));
+   /* when set, thread really waits for the event */
+   std::atomic<bool> real_wait {false};
+   /* number of waits finished by the event instead of timeout */
+   std::atomic<int> woken {0};
+   /* when set, provider sees time advanced only by the test */
+   std::atomic<bool> fake_clock {false};
+   std::atomic<std::chrono::steady_clock::rep> fake_now {0};
 };
 
 std::unique_ptr<SleepMock> sleep_mock;
 
 namespace thread
 {
-   __attribute__((weak)) void sleep (std::chrono::milliseconds ms)
+   __attribute__((weak)) bool wait_for (WakeupEvent& event, std::chrono::milliseconds ms)
    {
       sleep_mock->sleep(ms);
+      const bool result = sleep_mock->real_wait? event.waitFor(ms) : false;
+      if (result)
+      {
+         sleep_mock->woken++;
+      }
+      return result;
    }
+   __attribute__((weak)) std::chrono::steady_clock::time_point now()
+   {
+      if (sleep_mock && sleep_mock->fake_clock)
+      {
+         return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(sleep_mock->fake_now.load()));
+      }
+      return std::chrono::steady_clock::now();
+   }
+}
+
+/* creates NTF_NTF frame without delimiter */
+std::vector<uint8_t> make_ntf_frame(NTF_CMD_ID id, const std::vector<uint8_t>& payload)
+{
+   std::vector<uint8_t> result (NTF_HEADER_SIZE, 0);
+   result[NTF_ID_OFFSET] = id;
+   result[NTF_REQ_TYPE_OFFSET] = NTF_NTF;
+   result[NTF_BYTES_COUNT_OFFSET] = payload.size();
+   result.insert(result.end(), payload.begin(), payload.end());
+   return result;
 }
 
 struct DataProviderFixture : public testing::Test
@@ -90,6 +129,8 @@ TEST_F(DataProviderFixture, run_module_tests)
     */
    EXPECT_CALL(m_driver_mock, addListener(_));
    EXPECT_CALL(m_driver_mock, setDelimiter('\n'));
+   EXPECT_CALL(m_driver_mock, setFraming(FramingMode::DELIMITER));
+   EXPECT_CALL(m_driver_mock, setFrameLayout(_)).Times(0);
    EXPECT_CALL(m_driver_mock, isConnected()).WillRepeatedly(Return(true));
    EXPECT_CALL(*sleep_mock, sleep(_)).Times(AtLeast(1));
    EXPECT_TRUE(m_test_subject->run("", 2222, '\n'));
@@ -118,7 +159,8 @@ TEST_F(DataProviderFixture, thread_execution_tests)
             m_test->m_thread_running = false;
             return true;
          }));
-   static_cast<DataProvider*>(m_test_subject.get())->executeThread();
+   m_test->m_thread_running = true;
+   m_test->executeThread();
    /**
     * <b>scenario</b>: Connection with driver established.<br>
     * <b>expected</b>: No further connections requested.<br>
@@ -131,7 +173,8 @@ TEST_F(DataProviderFixture, thread_execution_tests)
             m_test->m_thread_running = false;
             return true;
          }));
-   static_cast<DataProvider*>(m_test_subject.get())->executeThread();
+   m_test->m_thread_running = true;
+   m_test->executeThread();
 
    /**
     * <b>scenario</b>: Connection cannot be established. <br>
@@ -151,8 +194,224 @@ TEST_F(DataProviderFixture, thread_execution_tests)
      .WillOnce(Return(false))
      .WillOnce(Return(false));
 
+   m_test->m_thread_running = true;
+   m_test->executeThread();
+
+}
+
+TEST_F(DataProviderFixture, reconnect_policy_tests)
+{
+   DataProvider* m_test = static_cast<DataProvider*>(m_test_subject.get());
+   std::vector<std::chrono::milliseconds> delays;
+   /**
+    * <b>scenario</b>: Connection cannot be established three times, then connected.<br>
+    * <b>expected</b>: Quick first retry, then delays doubled with up to 20% jitter, status checked rarely when connected.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sleep_mock, sleep(_)).WillRepeatedly(Invoke([&](std::chrono::milliseconds ms){ delays.push_back(ms); }));
+   EXPECT_CALL(m_driver_mock, connect(_,_)).WillOnce(Return(false))
+                                           .WillOnce(Return(false))
+                                           .WillOnce(Return(false))
+                                           .WillOnce(Return(true));
+   EXPECT_CALL(m_driver_mock, isConnected()).WillOnce(Return(false))
+                                            .WillOnce(Return(false))
+                                            .WillOnce(Return(false))
+                                            .WillOnce(Return(false))
+                                            .WillOnce(Invoke([&]() -> bool
+                                            {
+                                               m_test->m_thread_running = false;
+                                               return true;
+                                            }));
+   m_test->m_thread_running = true;
+   m_test->executeThread();
+   ASSERT_EQ(delays.size(), 5);
+   EXPECT_THAT(delays[0].count(), AllOf(Ge(80), Le(100)));
+   EXPECT_THAT(delays[1].count(), AllOf(Ge(160), Le(200)));
+   EXPECT_THAT(delays[2].count(), AllOf(Ge(320), Le(400)));
+   EXPECT_EQ(delays[3], std::chrono::milliseconds(5000));
+   EXPECT_EQ(delays[4], std::chrono::milliseconds(5000));
+
+   /**
+    * <b>scenario</b>: Link dropped, connection cannot be established.<br>
+    * <b>expected</b>: Backoff started again from quick retry.<br>
+    * ************************************************
+    */
+   delays.clear();
+   dynamic_cast<SocketListener*>(m_test)->onSocketEvent(DriverEvent::DRIVER_DISCONNECTED, {}, 0);
+   EXPECT_CALL(m_driver_mock, connect(_,_)).WillOnce(Return(false));
+   EXPECT_CALL(m_driver_mock, isConnected()).WillOnce(Invoke([&]() -> bool
+                                            {
+                                               m_test->m_thread_running = false;
+                                               return false;
+                                            }));
+   m_test->m_thread_running = true;
    m_test->executeThread();
+   ASSERT_EQ(delays.size(), 1);
+   EXPECT_THAT(delays[0].count(), AllOf(Ge(80), Le(100)));
+}
+
+
+/* returns addresses of the endpoints in the same order */
+std::vector<std::string> get_addresses(const std::vector<SocketEndpoint>& endpoints)
+{
+   std::vector<std::string> result;
+   for (const SocketEndpoint& endpoint : endpoints)
+   {
+      result.push_back(endpoint.address);
+   }
+   return result;
+}
+
+TEST_F(DataProviderFixture, failover_tests)
+{
+   DataProvider* m_test = static_cast<DataProvider*>(m_test_subject.get());
+   std::vector<std::chrono::milliseconds> delays;
+   m_test->m_endpoints = {{"10.0.0.1", 2222}, {"10.0.0.2", 2222}, {"10.0.0.3", 2222}};
+   EXPECT_CALL(*sleep_mock, sleep(_)).WillRepeatedly(Invoke([&](std::chrono::milliseconds ms){ delays.push_back(ms); }));
+   EXPECT_CALL(m_driver_mock, connect(_,_)).Times(0);
+   /**
+    * <b>scenario</b>: Several endpoints configured, first one not available.<br>
+    * <b>expected</b>: All endpoints passed to driver in order of priority, connection kept with the second one.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_driver_mock, connectAny(_)).WillOnce(Invoke([&](const std::vector<SocketEndpoint>& endpoints) -> int
+         {
+            EXPECT_THAT(get_addresses(endpoints), ElementsAre("10.0.0.1", "10.0.0.2", "10.0.0.3"));
+            return 1;
+         }));
+   EXPECT_CALL(m_driver_mock, isConnected()).WillOnce(Return(false))
+                                            .WillOnce(Invoke([&]() -> bool
+                                            {
+                                               m_test->m_thread_running = false;
+                                               return true;
+                                            }));
+   m_test->m_thread_running = true;
+   m_test->executeThread();
+   EXPECT_EQ(m_test->m_active_endpoint, 1);
+   EXPECT_THAT(delays, Each(std::chrono::milliseconds(5000)));
+
+   /**
+    * <b>scenario</b>: Active link dropped.<br>
+    * <b>expected</b>: Reconnection without retry delay, endpoint which dropped is tried as the last one.<br>
+    * ************************************************
+    */
+   delays.clear();
+   dynamic_cast<SocketListener*>(m_test)->onSocketEvent(DriverEvent::DRIVER_DISCONNECTED, {}, 0);
+   EXPECT_CALL(m_driver_mock, connectAny(_)).WillOnce(Invoke([&](const std::vector<SocketEndpoint>& endpoints) -> int
+         {
+            EXPECT_THAT(get_addresses(endpoints), ElementsAre("10.0.0.3", "10.0.0.1", "10.0.0.2"));
+            return 1;
+         }));
+   EXPECT_CALL(m_driver_mock, isConnected()).WillOnce(Invoke([&]() -> bool
+                                            {
+                                               m_test->m_thread_running = false;
+                                               return false;
+                                            }));
+   m_test->m_thread_running = true;
+   m_test->executeThread();
+   EXPECT_EQ(m_test->m_active_endpoint, 0);
+   ASSERT_EQ(delays.size(), 1);
+   EXPECT_EQ(delays[0], std::chrono::milliseconds(5000));
+
+   /**
+    * <b>scenario</b>: Link dropped, none of the endpoints available.<br>
+    * <b>expected</b>: Backoff started, next attempt starts from endpoint after the dropped one.<br>
+    * ************************************************
+    */
+   delays.clear();
+   dynamic_cast<SocketListener*>(m_test)->onSocketEvent(DriverEvent::DRIVER_DISCONNECTED, {}, 0);
+   EXPECT_CALL(m_driver_mock, connectAny(_)).WillOnce(Invoke([&](const std::vector<SocketEndpoint>& endpoints) -> int
+         {
+            EXPECT_THAT(get_addresses(endpoints), ElementsAre("10.0.0.2", "10.0.0.3", "10.0.0.1"));
+            return -1;
+         }));
+   EXPECT_CALL(m_driver_mock, isConnected()).WillOnce(Invoke([&]() -> bool
+                                            {
+                                               m_test->m_thread_running = false;
+                                               return false;
+                                            }));
+   m_test->m_thread_running = true;
+   m_test->executeThread();
+   EXPECT_EQ(m_test->m_active_endpoint, -1);
+   ASSERT_EQ(delays.size(), 1);
+   EXPECT_THAT(delays[0].count(), AllOf(Ge(80), Le(100)));
+}
+
+/**
+ * @test Tests of dead link detection
+ */
+TEST_F(DataProviderFixture, link_timeout_tests)
+{
+   DataProvider* m_test = static_cast<DataProvider*>(m_test_subject.get());
+   SocketListener* listener = m_test;
+   m_test->m_endpoints = {{"10.0.0.1", 2222}, {"10.0.0.2", 2222}};
+   m_test->m_active_endpoint = 0;
+   m_test->m_delimiter = '\n';
+   m_test_subject->setLinkTimeout(std::chrono::milliseconds(1000), std::chrono::milliseconds(300));
+   auto set_silence = [&](std::chrono::milliseconds silence)
+   {
+      m_test->m_last_frame = (std::chrono::steady_clock::now() - silence).time_since_epoch().count();
+      m_test->m_last_ping = std::chrono::steady_clock::now() - silence;
+   };
+   EXPECT_CALL(m_driver_mock, isConnected()).WillRepeatedly(Return(true));
+   /**
+    * <b>scenario</b>: Frame received recently.<br>
+    * <b>expected</b>: No ping sent, next check when ping period expires.<br>
+    * ************************************************
+    */
+   set_silence(std::chrono::milliseconds(1000));
+   listener->onSocketEvent(DriverEvent::DRIVER_DATA_RECV, {}, 0);
+   EXPECT_CALL(m_driver_mock, writeAsync(_,_)).Times(0);
+   EXPECT_THAT(m_test->checkConnection().count(), AllOf(Gt(250), Le(300)));
+   Mock::VerifyAndClearExpectations(&m_driver_mock);
+   EXPECT_CALL(m_driver_mock, isConnected()).WillRepeatedly(Return(true));
+
+   /**
+    * <b>scenario</b>: Link silent for longer than ping period.<br>
+    * <b>expected</b>: Ping frame sent, next ping scheduled.<br>
+    * ************************************************
+    */
+   set_silence(std::chrono::milliseconds(400));
+   EXPECT_CALL(m_driver_mock, writeAsync(ElementsAre(NTF_SYSTEM_TIME, NTF_GET, 0, '\n'), _)).WillOnce(Return(true));
+   EXPECT_THAT(m_test->checkConnection().count(), AllOf(Gt(250), Le(300)));
+   EXPECT_EQ(m_test->m_active_endpoint, 0);
+
+   /**
+    * <b>scenario</b>: Ping already sent, link still silent.<br>
+    * <b>expected</b>: Ping not repeated before ping period, next check not later than link timeout.<br>
+    * ************************************************
+    */
+   m_test->m_last_frame = (std::chrono::steady_clock::now() - std::chrono::milliseconds(900)).time_since_epoch().count();
+   m_test->m_last_ping = std::chrono::steady_clock::now() - std::chrono::milliseconds(100);
+   EXPECT_CALL(m_driver_mock, writeAsync(_,_)).Times(0);
+   EXPECT_THAT(m_test->checkConnection().count(), AllOf(Gt(50), Le(100)));
+   Mock::VerifyAndClearExpectations(&m_driver_mock);
 
+   /**
+    * <b>scenario</b>: Link silent for longer than timeout.<br>
+    * <b>expected</b>: Driver disconnected, reconnection to other endpoint requested immediately, state responses
+    *                  not expected anymore.<br>
+    * ************************************************
+    */
+   set_silence(std::chrono::milliseconds(1001));
+   m_test->m_pending_requests = 1;
+   EXPECT_CALL(m_driver_mock, isConnected()).WillOnce(Return(true));
+   EXPECT_CALL(m_driver_mock, disconnect());
+   EXPECT_EQ(m_test->checkConnection(), std::chrono::milliseconds(0));
+   EXPECT_EQ(m_test->m_active_endpoint, -1);
+   EXPECT_EQ(m_test->m_first_endpoint, 1);
+   EXPECT_EQ(m_test->getPendingStateRequests(), 0);
+
+   /**
+    * <b>scenario</b>: Connection established again.<br>
+    * <b>expected</b>: Silence counted from the connection.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_driver_mock, isConnected()).WillOnce(Return(false));
+   EXPECT_CALL(m_driver_mock, connectAny(_)).WillOnce(Return(0));
+   EXPECT_CALL(m_driver_mock, writeAsync(_,_)).Times(0);
+   EXPECT_THAT(m_test->checkConnection().count(), AllOf(Gt(250), Le(300)));
+   EXPECT_EQ(m_test->m_active_endpoint, 1);
 }
 
 TEST_F(DataProviderSocketListenerFixture, messasge_integrity_check_tests)
@@ -282,14 +541,605 @@ TEST_F(DataProviderSocketListenerFixture, env_events_handling_tests)
    m_test_subject->onSocketEvent(DriverEvent::DRIVER_DATA_RECV, test_bytes, DEFAULT_MESSAGE_SIZE);
 }
 
+TEST_F(DataProviderSocketListenerFixture, batch_handling_tests)
+{
+   std::vector<std::vector<uint8_t>> frames(3);
+   frames[0] = make_ntf_frame(NTF_FAN_STATE, {FAN_STATE_ON});
+   frames[1] = make_ntf_frame(NTF_INPUTS_STATE, {INPUT_KITCHEN_AC, INPUT_STATE_ACTIVE});
+   frames[2] = make_ntf_frame(NTF_FAN_STATE, {FAN_STATE_OFF});
+
+   /**
+    * <b>scenario</b>: Batch with two frames received, third vector item is not valid. <br>
+    * <b>expected</b>: Both valid frames sent to main window in single call.<br>
+    * ************************************************
+    */
+   StateUpdateBatch batch;
+   EXPECT_CALL(m_window_mock, setStateBatch(_)).WillOnce(SaveArg<0>(&batch));
+   m_test_subject->onSocketBatch(frames, 2);
+   EXPECT_EQ(batch.updates_count, 2);
+   EXPECT_TRUE(batch.fan_set);
+   EXPECT_EQ(batch.fan_value, FAN_STATE_ON);
+   EXPECT_TRUE(batch.input_set[INPUT_KITCHEN_AC]);
+   EXPECT_EQ(batch.input_values[INPUT_KITCHEN_AC], INPUT_STATE_ACTIVE);
+}
+
+TEST_F(DataProviderSocketListenerFixture, frames_handling_tests)
+{
+   std::vector<uint8_t> buffer = make_ntf_frame(NTF_INPUTS_STATE, {INPUT_STAIRS_AC, INPUT_STATE_ACTIVE});
+   std::vector<uint8_t> fan = make_ntf_frame(NTF_FAN_STATE, {FAN_STATE_SUSPEND});
+   size_t input_size = buffer.size();
+   buffer.push_back('\n');
+   buffer.insert(buffer.end(), fan.begin(), fan.end());
+   FrameView frames [] = {{buffer.data(), input_size}, {buffer.data() + input_size + 1, fan.size()}, {buffer.data(), 1}};
+
+   /**
+    * <b>scenario</b>: Frames views pointing to the receive buffer, one of them too short. <br>
+    * <b>expected</b>: Valid frames sent to main window in single call, short frame ignored.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_window_mock, setStateBatch(_));
+   EXPECT_CALL(m_window_mock, setInputState(INPUT_STAIRS_AC, INPUT_STATE_ACTIVE));
+   EXPECT_CALL(m_window_mock, setFanState(FAN_STATE_SUSPEND));
+   m_test_subject->onSocketFrames(frames, 3);
+
+   /**
+    * <b>scenario</b>: Frames with many updates of the same items. <br>
+    * <b>expected</b>: Main window called once with the last state of every item.<br>
+    * ************************************************
+    */
+   std::vector<FrameView> views;
+   std::vector<std::vector<uint8_t>> updates;
+   updates.push_back(make_ntf_frame(NTF_FAN_STATE, {FAN_STATE_ON}));
+   updates.push_back(make_ntf_frame(NTF_INPUTS_STATE, {INPUT_STAIRS_AC, INPUT_STATE_INACTIVE}));
+   updates.push_back(make_ntf_frame(NTF_FAN_STATE, {FAN_STATE_OFF}));
+   updates.push_back(make_ntf_frame(NTF_INPUTS_STATE, {INPUT_STAIRS_AC, INPUT_STATE_ACTIVE}));
+   updates.push_back(make_ntf_frame(NTF_INPUTS_STATE, {INPUT_STAIRS_AC, INPUT_STATE_INACTIVE}));
+   for (const std::vector<uint8_t>& frame : updates)
+   {
+      views.push_back({frame.data(), frame.size()});
+   }
+   StateUpdateBatch batch;
+   EXPECT_CALL(m_window_mock, setStateBatch(_)).WillOnce(SaveArg<0>(&batch));
+   m_test_subject->onSocketFrames(views.data(), views.size());
+   EXPECT_EQ(batch.updates_count, 2);
+   EXPECT_EQ(batch.fan_value, FAN_STATE_OFF);
+   EXPECT_EQ(batch.input_values[INPUT_STAIRS_AC], INPUT_STATE_INACTIVE);
+
+   /**
+    * <b>scenario</b>: Frames without state changes. <br>
+    * <b>expected</b>: Main window not called.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_window_mock, setStateBatch(_)).Times(0);
+   m_test_subject->onSocketFrames(views.data() + 2, 1);
+}
+
+TEST_F(DataProviderFixture, notification_dispatch_tests)
+{
+   SocketListener* listener = dynamic_cast<SocketListener*>(m_test_subject.get());
+   std::vector<uint8_t> relays = make_ntf_frame(NTF_RELAYS_STATE, {1, 1});
+   std::vector<uint8_t> fan = make_ntf_frame(NTF_FAN_STATE, {FAN_STATE_ON});
+   std::vector<uint8_t> time = make_ntf_frame(NTF_SYSTEM_TIME, {1, 2, 3});
+   std::vector<uint8_t> handled;
+   FrameView relays_view = {relays.data(), relays.size()};
+   FrameView fan_view = {fan.data(), fan.size()};
+   FrameView time_view = {time.data(), time.size()};
+   /**
+    * <b>scenario</b>: Notification without handler received. <br>
+    * <b>expected</b>: Notification counted as unknown.<br>
+    * ************************************************
+    */
+   EXPECT_EQ(m_test_subject->getUnknownCount(), 0);
+   listener->onSocketFrames(&relays_view, 1);
+   EXPECT_EQ(m_test_subject->getUnknownCount(), 1);
+
+   /**
+    * <b>scenario</b>: Handler registered for new notification type. <br>
+    * <b>expected</b>: Whole frame passed to handler, notification not counted as unknown.<br>
+    * ************************************************
+    */
+   m_test_subject->registerHandler(NTF_RELAYS_STATE, [&](const uint8_t* data, size_t size)
+   {
+      handled.assign(data, data + size);
+   });
+   listener->onSocketFrames(&relays_view, 1);
+   EXPECT_EQ(handled, relays);
+   EXPECT_EQ(m_test_subject->getUnknownCount(), 1);
+
+   /**
+    * <b>scenario</b>: Answer to ping received. <br>
+    * <b>expected</b>: Handled by built-in handler, not counted as unknown.<br>
+    * ************************************************
+    */
+   listener->onSocketFrames(&time_view, 1);
+   EXPECT_EQ(m_test_subject->getUnknownCount(), 1);
+
+   /**
+    * <b>scenario</b>: Built-in handler replaced. <br>
+    * <b>expected</b>: New handler called instead of main window update.<br>
+    * ************************************************
+    */
+   handled.clear();
+   EXPECT_CALL(m_window_mock, setFanState(_)).Times(0);
+   m_test_subject->registerHandler(NTF_FAN_STATE, [&](const uint8_t* data, size_t size)
+   {
+      handled.assign(data, data + size);
+   });
+   listener->onSocketFrames(&fan_view, 1);
+   EXPECT_EQ(handled, fan);
+
+   /**
+    * <b>scenario</b>: Handler removed. <br>
+    * <b>expected</b>: Notification counted as unknown.<br>
+    * ************************************************
+    */
+   m_test_subject->registerHandler(NTF_FAN_STATE, nullptr);
+   listener->onSocketFrames(&fan_view, 1);
+   EXPECT_EQ(m_test_subject->getUnknownCount(), 2);
+
+   /**
+    * <b>scenario</b>: Frames shorter than required by built-in handlers received. <br>
+    * <b>expected</b>: Frames dropped before dispatch, main window not called, not counted as unknown.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> short_env = make_ntf_frame(NTF_ENV_SENSOR_DATA, {ENV_KITCHEN, 0, 45});
+   std::vector<uint8_t> short_input = make_ntf_frame(NTF_INPUTS_STATE, {INPUT_KITCHEN_AC});
+   FrameView short_views [] = {{short_env.data(), short_env.size()}, {short_input.data(), short_input.size()}};
+   EXPECT_CALL(m_window_mock, setEnvState(_,_,_,_,_)).Times(0);
+   EXPECT_CALL(m_window_mock, setInputState(_,_)).Times(0);
+   EXPECT_CALL(m_window_mock, setStateBatch(_)).Times(0);
+   listener->onSocketFrames(short_views, 2);
+   EXPECT_EQ(m_test_subject->getUnknownCount(), 2);
+
+   /**
+    * <b>scenario</b>: Handler registered with minimum payload size, shorter and long enough frames received. <br>
+    * <b>expected</b>: Handler called only for the frame long enough.<br>
+    * ************************************************
+    */
+   handled.clear();
+   m_test_subject->registerHandler(NTF_RELAYS_STATE, [&](const uint8_t* data, size_t size)
+   {
+      handled.assign(data, data + size);
+   }, 3);
+   listener->onSocketFrames(&relays_view, 1);
+   EXPECT_TRUE(handled.empty());
+   std::vector<uint8_t> relays_long = make_ntf_frame(NTF_RELAYS_STATE, {1, 1, 0});
+   FrameView relays_long_view = {relays_long.data(), relays_long.size()};
+   listener->onSocketFrames(&relays_long_view, 1);
+   EXPECT_EQ(handled, relays_long);
+}
+
+TEST_F(DataProviderFixture, unchanged_state_tests)
+{
+   SocketListener* listener = dynamic_cast<SocketListener*>(m_test_subject.get());
+   std::vector<uint8_t> input = make_ntf_frame(NTF_INPUTS_STATE, {INPUT_KITCHEN_AC, INPUT_STATE_ACTIVE});
+   std::vector<uint8_t> fan = make_ntf_frame(NTF_FAN_STATE, {FAN_STATE_ON});
+   std::vector<uint8_t> env = make_ntf_frame(NTF_ENV_SENSOR_DATA, {ENV_KITCHEN, 0, 45, 0, 22, 1});
+   std::vector<uint8_t> env_small_change = make_ntf_frame(NTF_ENV_SENSOR_DATA, {ENV_KITCHEN, 0, 45, 0, 22, 3});
+   std::vector<uint8_t> env_big_change = make_ntf_frame(NTF_ENV_SENSOR_DATA, {ENV_KITCHEN, 0, 45, 0, 22, 6});
+   FrameView frames [] = {{input.data(), input.size()}, {fan.data(), fan.size()}, {env.data(), env.size()}};
+   FrameView small_change = {env_small_change.data(), env_small_change.size()};
+   FrameView big_change = {env_big_change.data(), env_big_change.size()};
+   m_test_subject->setEnvHysteresis(5, 5);
+   /**
+    * <b>scenario</b>: States received for the first time. <br>
+    * <b>expected</b>: States sent to main window.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_window_mock, setInputState(INPUT_KITCHEN_AC, INPUT_STATE_ACTIVE));
+   EXPECT_CALL(m_window_mock, setFanState(FAN_STATE_ON));
+   EXPECT_CALL(m_window_mock, setEnvState(ENV_KITCHEN, 22, 1, 45, 0));
+   listener->onSocketFrames(frames, 3);
+   Mock::VerifyAndClearExpectations(&m_window_mock);
+
+   /**
+    * <b>scenario</b>: Same states resent by server, env change smaller than hysteresis. <br>
+    * <b>expected</b>: Main window not updated, suppressed updates counted per ID.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_window_mock, setInputState(_,_)).Times(0);
+   EXPECT_CALL(m_window_mock, setFanState(_)).Times(0);
+   EXPECT_CALL(m_window_mock, setEnvState(_,_,_,_,_)).Times(0);
+   listener->onSocketFrames(frames, 3);
+   listener->onSocketFrames(&small_change, 1);
+   EXPECT_EQ(m_test_subject->getSuppressedCount(NTF_INPUTS_STATE, INPUT_KITCHEN_AC), 1);
+   EXPECT_EQ(m_test_subject->getSuppressedCount(NTF_INPUTS_STATE, INPUT_BEDROOM_AC), 0);
+   EXPECT_EQ(m_test_subject->getSuppressedCount(NTF_FAN_STATE, 0), 1);
+   EXPECT_EQ(m_test_subject->getSuppressedCount(NTF_ENV_SENSOR_DATA, ENV_KITCHEN), 2);
+   EXPECT_EQ(m_test_subject->getSuppressedCount(NTF_SYSTEM_TIME, 0), 0);
+   Mock::VerifyAndClearExpectations(&m_window_mock);
+
+   /**
+    * <b>scenario</b>: Home state read. <br>
+    * <b>expected</b>: Received values stored, including the change within hysteresis.<br>
+    * ************************************************
+    */
+   HomeState state;
+   m_test_subject->getHomeState().read(state);
+   EXPECT_EQ(state.version, 4);
+   EXPECT_TRUE(state.inputs_valid[INPUT_KITCHEN_AC]);
+   EXPECT_EQ(state.inputs[INPUT_KITCHEN_AC], INPUT_STATE_ACTIVE);
+   EXPECT_FALSE(state.inputs_valid[INPUT_BEDROOM_AC]);
+   EXPECT_EQ(state.fan, FAN_STATE_ON);
+   EXPECT_EQ(state.temp_h[ENV_KITCHEN], 22);
+   EXPECT_EQ(state.temp_l[ENV_KITCHEN], 3);
+   EXPECT_EQ(state.hum_h[ENV_KITCHEN], 45);
+
+   /**
+    * <b>scenario</b>: Env value changed by hysteresis. <br>
+    * <b>expected</b>: State sent to main window.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_window_mock, setEnvState(ENV_KITCHEN, 22, 6, 45, 0));
+   listener->onSocketFrames(&big_change, 1);
+}
+
+TEST_F(DataProviderFixture, length_prefixed_framing_tests)
+{
+   /**
+    * <b>scenario</b>: Length-prefixed framing requested, module started.<br>
+    * <b>expected</b>: Driver configured to cut frames using notification header.<br>
+    * ************************************************
+    */
+   m_test_subject->setFraming(FramingMode::LENGTH_PREFIXED);
+   EXPECT_CALL(m_driver_mock, addListener(_));
+   EXPECT_CALL(m_driver_mock, setDelimiter('\n'));
+   EXPECT_CALL(m_driver_mock, setFrameLayout(AllOf(Field(&FrameLayout::header_size, NTF_HEADER_SIZE),
+                                                   Field(&FrameLayout::length_offset, NTF_BYTES_COUNT_OFFSET),
+                                                   Field(&FrameLayout::trailer_size, 1),
+                                                   Field(&FrameLayout::max_payload, DATA_PROV_MAX_PAYLOAD_SIZE))));
+   EXPECT_CALL(m_driver_mock, setFraming(FramingMode::LENGTH_PREFIXED));
+   EXPECT_CALL(m_driver_mock, isConnected()).WillRepeatedly(Return(true));
+   EXPECT_CALL(*sleep_mock, sleep(_)).Times(AtLeast(1));
+   EXPECT_TRUE(m_test_subject->run("", 2222, '\n'));
+
+   /**
+    * <b>scenario</b>: Frame received, it is not checked against size from header.<br>
+    * <b>expected</b>: Data sent to main window.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> frame = make_ntf_frame(NTF_FAN_STATE, {FAN_STATE_ON});
+   frame[NTF_BYTES_COUNT_OFFSET] = 0;
+   FrameView view = {frame.data(), frame.size()};
+   EXPECT_CALL(m_window_mock, setFanState(FAN_STATE_ON));
+   dynamic_cast<SocketListener*>(m_test_subject.get())->onSocketFrames(&view, 1);
+}
+
+TEST_F(DataProviderSocketListenerFixture, idle_wakeups_tests)
+{
+   std::mutex mtx;
+   std::condition_variable cv;
+   std::vector<std::chrono::milliseconds> waits;
+   int connections = 0;
+   std::atomic<bool> connected (true);
+   sleep_mock->real_wait = true;
+   std::unique_ptr<IDataProvider> provider (new DataProvider(m_window_mock, m_driver_mock));
+   EXPECT_CALL(m_driver_mock, addListener(_));
+   EXPECT_CALL(m_driver_mock, setDelimiter(_));
+   EXPECT_CALL(m_driver_mock, setFraming(_));
+   EXPECT_CALL(*sleep_mock, sleep(_)).WillRepeatedly(Invoke([&](std::chrono::milliseconds ms)
+         {
+            std::lock_guard<std::mutex> lock (mtx);
+            waits.push_back(ms);
+            cv.notify_all();
+         }));
+   auto wait_for_waits = [&](size_t count)
+   {
+      std::unique_lock<std::mutex> lock (mtx);
+      return cv.wait_for(lock, std::chrono::seconds(1), [&](){ return waits.size() >= count; });
+   };
+   /**
+    * <b>scenario</b>: Module running, connection established, nothing happens.<br>
+    * <b>expected</b>: Thread waits for the event with status check period, not shorter.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_driver_mock, isConnected()).WillRepeatedly(Invoke([&](){ return connected.load(); }));
+   EXPECT_TRUE(provider->run("127.0.0.1", 2222, '\n'));
+   ASSERT_TRUE(wait_for_waits(1));
+   {
+      std::lock_guard<std::mutex> lock (mtx);
+      EXPECT_EQ(waits.size(), 1);
+      EXPECT_EQ(waits[0], std::chrono::milliseconds(5000));
+   }
+   EXPECT_EQ(sleep_mock->woken, 0);
+
+   /**
+    * <b>scenario</b>: Link dropped.<br>
+    * <b>expected</b>: Thread woken up by the event, connection requested without waiting for status check.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_driver_mock, connect(_,_)).WillOnce(Invoke([&](const std::string&, uint16_t)->bool
+         {
+            std::lock_guard<std::mutex> lock (mtx);
+            connections++;
+            connected = true;
+            return true;
+         }));
+   connected = false;
+   dynamic_cast<SocketListener*>(provider.get())->onSocketEvent(DriverEvent::DRIVER_DISCONNECTED, {}, 0);
+   ASSERT_TRUE(wait_for_waits(2));
+   {
+      std::lock_guard<std::mutex> lock (mtx);
+      EXPECT_EQ(connections, 1);
+      EXPECT_EQ(waits[1], std::chrono::milliseconds(5000));
+   }
+   EXPECT_EQ(sleep_mock->woken, 1);
+
+   /**
+    * <b>scenario</b>: Module destroyed while thread is waiting for next status check.<br>
+    * <b>expected</b>: Thread woken up by the event and stopped.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_driver_mock, disconnect());
+   EXPECT_CALL(m_driver_mock, removeListener(_));
+   provider.reset(nullptr);
+   EXPECT_EQ(sleep_mock->woken, 2);
+}
+
+TEST_F(DataProviderSocketListenerFixture, event_loop_mode_tests)
+{
+   EventLoopMock loop_mock;
+   IEventLoop::TimerCallback timer_callback;
+   const IEventLoop::TimerId TIMER_ID = 5;
+   std::unique_ptr<IDataProvider> provider (new DataProvider(m_window_mock, m_driver_mock, loop_mock));
+
+   /**
+    * <b>scenario</b>: Module started in event loop mode.<br>
+    * <b>expected</b>: No thread started, reconnection timer scheduled immediately.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_driver_mock, addListener(_));
+   EXPECT_CALL(m_driver_mock, setDelimiter('\n'));
+   EXPECT_CALL(m_driver_mock, setFraming(FramingMode::DELIMITER));
+   EXPECT_CALL(*sleep_mock, sleep(_)).Times(0);
+   EXPECT_CALL(loop_mock, addTimer(std::chrono::milliseconds(0), _)).WillOnce(DoAll(SaveArg<1>(&timer_callback), Return(TIMER_ID)));
+   EXPECT_TRUE(provider->run("127.0.0.1", 2222, '\n'));
+   EXPECT_FALSE(provider->run("127.0.0.1", 2222, '\n'));
+   ASSERT_TRUE(!!timer_callback);
+
+   /**
+    * <b>scenario</b>: Timer expired, driver not connected.<br>
+    * <b>expected</b>: Connection requested, timer scheduled again with backoff delay.<br>
+    * ************************************************
+    */
+   IEventLoop::TimerCallback callback = timer_callback;
+   EXPECT_CALL(m_driver_mock, isConnected()).WillOnce(Return(false));
+   EXPECT_CALL(m_driver_mock, connect("127.0.0.1", 2222)).WillOnce(Return(false));
+   EXPECT_CALL(loop_mock, addTimer(Gt(std::chrono::milliseconds(0)), _)).WillOnce(DoAll(SaveArg<1>(&timer_callback), Return(TIMER_ID + 1)));
+   callback();
 
+   /**
+    * <b>scenario</b>: Timer expired, driver connected.<br>
+    * <b>expected</b>: No connection requested, timer scheduled again.<br>
+    * ************************************************
+    */
+   callback = timer_callback;
+   EXPECT_CALL(m_driver_mock, isConnected()).WillOnce(Return(true));
+   EXPECT_CALL(m_driver_mock, connect(_,_)).Times(0);
+   EXPECT_CALL(loop_mock, addTimer(_, _)).WillOnce(Return(TIMER_ID + 2));
+   callback();
 
+   /**
+    * <b>scenario</b>: Link dropped, reported twice from driver thread.<br>
+    * <b>expected</b>: Timer not cancelled from driver thread, single reconnection scheduled immediately.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(loop_mock, cancelTimer(_)).Times(0);
+   EXPECT_CALL(loop_mock, addTimer(std::chrono::milliseconds(0), _)).WillOnce(DoAll(SaveArg<1>(&timer_callback), Return(TIMER_ID + 3)));
+   dynamic_cast<SocketListener*>(provider.get())->onSocketEvent(DriverEvent::DRIVER_DISCONNECTED, {}, 0);
+   dynamic_cast<SocketListener*>(provider.get())->onSocketEvent(DriverEvent::DRIVER_DISCONNECTED, {}, 0);
+   Mock::VerifyAndClearExpectations(&loop_mock);
 
+   /**
+    * <b>scenario</b>: Reconnection timer expired on loop thread.<br>
+    * <b>expected</b>: Status check cancelled, connection requested, timer scheduled again.<br>
+    * ************************************************
+    */
+   callback = timer_callback;
+   EXPECT_CALL(loop_mock, cancelTimer(TIMER_ID + 2));
+   EXPECT_CALL(m_driver_mock, isConnected()).WillOnce(Return(false));
+   EXPECT_CALL(m_driver_mock, connect("127.0.0.1", 2222)).WillOnce(Return(false));
+   EXPECT_CALL(loop_mock, addTimer(Gt(std::chrono::milliseconds(0)), _)).WillOnce(Return(TIMER_ID + 4));
+   callback();
 
+   /**
+    * <b>scenario</b>: Link dropped again, module destroyed before reconnection.<br>
+    * <b>expected</b>: Pending timers cancelled.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(loop_mock, addTimer(std::chrono::milliseconds(0), _)).WillOnce(Return(TIMER_ID + 5));
+   dynamic_cast<SocketListener*>(provider.get())->onSocketEvent(DriverEvent::DRIVER_DISCONNECTED, {}, 0);
+   EXPECT_CALL(loop_mock, cancelTimer(TIMER_ID + 4));
+   EXPECT_CALL(loop_mock, cancelTimer(TIMER_ID + 5));
+   EXPECT_CALL(m_driver_mock, disconnect());
+   EXPECT_CALL(m_driver_mock, removeListener(_));
+   provider.reset(nullptr);
+}
 
+TEST_F(DataProviderSocketListenerFixture, event_loop_async_connect_tests)
+{
+   EventLoopMock loop_mock;
+   IEventLoop::TimerCallback timer_callback;
+   ISocketDriver::ConnectCallback connect_callback;
+   const IEventLoop::TimerId TIMER_ID = 5;
+   std::unique_ptr<IDataProvider> provider (new DataProvider(m_window_mock, m_driver_mock, loop_mock));
+   EXPECT_CALL(m_driver_mock, addListener(_));
+   EXPECT_CALL(m_driver_mock, setDelimiter('\n'));
+   EXPECT_CALL(m_driver_mock, setFraming(FramingMode::DELIMITER));
+   EXPECT_CALL(loop_mock, addTimer(std::chrono::milliseconds(0), _)).WillOnce(DoAll(SaveArg<1>(&timer_callback), Return(TIMER_ID)));
+   EXPECT_TRUE(provider->run(std::vector<SocketEndpoint>{{"10.0.0.1", 2222}, {"10.0.0.2", 2222}}, '\n'));
+   ASSERT_TRUE(!!timer_callback);
 
+   /**
+    * <b>scenario</b>: Timer expired, driver not connected, connection result not known yet.<br>
+    * <b>expected</b>: All endpoints passed to the driver, next check not scheduled.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_driver_mock, isConnected()).WillOnce(Return(false));
+   EXPECT_CALL(m_driver_mock, connectAsync(SizeIs(2), _)).WillOnce(SaveArg<1>(&connect_callback));
+   EXPECT_CALL(m_driver_mock, connect(_,_)).Times(0);
+   EXPECT_CALL(m_driver_mock, connectAny(_)).Times(0);
+   EXPECT_CALL(loop_mock, addTimer(_, _)).Times(0);
+   timer_callback();
+   ASSERT_TRUE(!!connect_callback);
+   Mock::VerifyAndClearExpectations(&loop_mock);
 
+   /**
+    * <b>scenario</b>: Driver reports connection to the second endpoint.<br>
+    * <b>expected</b>: Status check scheduled with retry period.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(loop_mock, addTimer(std::chrono::milliseconds(5000), _)).WillOnce(Return(TIMER_ID + 1));
+   connect_callback(1);
+   Mock::VerifyAndClearExpectations(&loop_mock);
 
+   /**
+    * <b>scenario</b>: Link dropped, next connection failed.<br>
+    * <b>expected</b>: Endpoint after the dropped one tried first, next attempt scheduled with backoff delay.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(loop_mock, addTimer(std::chrono::milliseconds(0), _)).WillOnce(DoAll(SaveArg<1>(&timer_callback), Return(TIMER_ID + 2)));
+   dynamic_cast<SocketListener*>(provider.get())->onSocketEvent(DriverEvent::DRIVER_DISCONNECTED, {}, 0);
+   EXPECT_CALL(loop_mock, cancelTimer(TIMER_ID + 1));
+   EXPECT_CALL(m_driver_mock, isConnected()).WillOnce(Return(false));
+   EXPECT_CALL(m_driver_mock, connectAsync(_, _)).WillOnce(Invoke([&](const std::vector<SocketEndpoint>& endpoints, ISocketDriver::ConnectCallback callback)
+         {
+            connect_callback = callback;
+            ASSERT_EQ(endpoints.size(), 2);
+            EXPECT_EQ(endpoints[0].address, "10.0.0.1");
+         }));
+   timer_callback();
+   EXPECT_CALL(loop_mock, addTimer(AllOf(Gt(std::chrono::milliseconds(0)), Le(std::chrono::milliseconds(100))), _)).WillOnce(Return(TIMER_ID + 3));
+   connect_callback(-1);
+   Mock::VerifyAndClearExpectations(&loop_mock);
+
+   EXPECT_CALL(loop_mock, cancelTimer(_)).Times(AnyNumber());
+   EXPECT_CALL(m_driver_mock, disconnect());
+   EXPECT_CALL(m_driver_mock, removeListener(_));
+   provider.reset(nullptr);
+}
 
+TEST_F(DataProviderSocketListenerFixture, silent_link_replay_tests)
+{
+   const std::string path = "/tmp/smarthome_silent_link_" + std::to_string(getpid());
+   {
+      /* server sends single frame and stops responding */
+      CaptureWriter writer;
+      ASSERT_TRUE(writer.create(path));
+      ASSERT_TRUE(writer.append((const uint8_t*)"a\n", 2, 0));
+      ASSERT_TRUE(writer.append((const uint8_t*)"b\n", 2, 60ULL * 1000 * 1000 * 1000));
+   }
+   std::chrono::milliseconds reconnected_at (-1);
+   ReplayDriver driver;
+   ISocketDriver& replay = driver;
+   sleep_mock->fake_clock = true;
+   EXPECT_CALL(*sleep_mock, sleep(_)).WillRepeatedly(Invoke([&](std::chrono::milliseconds ms)
+         {
+            if (replay.getStats().reconnects > 0)
+            {
+               /* clock is not advanced anymore, thread just waits to be stopped */
+               if (reconnected_at.count() < 0)
+               {
+                  reconnected_at = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::duration(sleep_mock->fake_now.load()));
+               }
+               sleep_mock->real_wait = true;
+               return;
+            }
+            /* frame is delivered by replay thread, time is not advanced until it arrives */
+            for (int i = 0; i < 1000 && replay.getStats().bytes_received == 0; i++)
+            {
+               std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            sleep_mock->fake_now += std::chrono::duration_cast<std::chrono::steady_clock::duration>(ms).count();
+         }));
+   std::unique_ptr<IDataProvider> provider (new DataProvider(m_window_mock, replay));
+   /**
+    * <b>scenario</b>: Connected server stops sending data without closing the connection.<br>
+    * <b>expected</b>: Pings sent, link reconnected exactly after the timeout.<br>
+    * ************************************************
+    */
+   provider->setLinkTimeout(std::chrono::milliseconds(200), std::chrono::milliseconds(50));
+   EXPECT_TRUE(provider->run(path, 0, '\n'));
+   for (int i = 0; i < 5000 && !sleep_mock->real_wait; i++)
+   {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+   provider.reset(nullptr);
+   EXPECT_EQ(replay.getStats().reconnects, 1);
+   EXPECT_EQ(reconnected_at, std::chrono::milliseconds(200));
+   EXPECT_GE(replay.getStats().bytes_sent, 4);
+   unlink(path.c_str());
+}
 
+TEST_F(DataProviderFixture, state_request_tests)
+{
+   SocketListener* listener = dynamic_cast<SocketListener*>(m_test_subject.get());
+   EXPECT_LT(m_test_subject->getPopulateTime().count(), 0);
+   /**
+    * <b>scenario</b>: Driver connected.<br>
+    * <b>expected</b>: State of all items requested at once, responses expected.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_driver_mock, writeAsync(ElementsAre(NTF_INPUTS_STATE_ALL, NTF_GET, 0, '\n'), _)).WillOnce(Return(true));
+   EXPECT_CALL(m_driver_mock, writeAsync(ElementsAre(NTF_ENV_SENSOR_DATA_ALL, NTF_GET, 0, '\n'), _)).WillOnce(Return(true));
+   EXPECT_CALL(m_driver_mock, writeAsync(ElementsAre(NTF_FAN_STATE, NTF_GET, 0, '\n'), _)).WillOnce(Return(true));
+   listener->onSocketEvent(DriverEvent::DRIVER_CONNECTED, {}, 0);
+   EXPECT_EQ(m_test_subject->getPendingStateRequests(), 3);
+   EXPECT_LT(m_test_subject->getPopulateTime().count(), 0);
 
+   /**
+    * <b>scenario</b>: Responses with states of all inputs and env sensors received in one read.<br>
+    * <b>expected</b>: All states passed to main window in single call, fan response still expected.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> inputs = make_ntf_frame(NTF_INPUTS_STATE_ALL, {INPUT_BEDROOM_AC, INPUT_STATE_ACTIVE, INPUT_SOCKETS, INPUT_STATE_INACTIVE});
+   std::vector<uint8_t> env = make_ntf_frame(NTF_ENV_SENSOR_DATA_ALL, {ENV_OUTSIDE, 0, 80, 1, (uint8_t)-5, 2,
+                                                                        ENV_KITCHEN, 0, 40, 0, 21, 7});
+   inputs[NTF_REQ_TYPE_OFFSET] = NTF_GET;
+   env[NTF_REQ_TYPE_OFFSET] = NTF_GET;
+   FrameView responses [] = {{inputs.data(), inputs.size()}, {env.data(), env.size()}};
+   EXPECT_CALL(m_window_mock, setStateBatch(_));
+   EXPECT_CALL(m_window_mock, setInputState(INPUT_BEDROOM_AC, INPUT_STATE_ACTIVE));
+   EXPECT_CALL(m_window_mock, setInputState(INPUT_SOCKETS, INPUT_STATE_INACTIVE));
+   EXPECT_CALL(m_window_mock, setEnvState(ENV_OUTSIDE, -5, 2, 80, 1));
+   EXPECT_CALL(m_window_mock, setEnvState(ENV_KITCHEN, 21, 7, 40, 0));
+   listener->onSocketFrames(responses, 2);
+   EXPECT_EQ(m_test_subject->getPendingStateRequests(), 1);
+   EXPECT_LT(m_test_subject->getPopulateTime().count(), 0);
+
+   /**
+    * <b>scenario</b>: Response with fan state received.<br>
+    * <b>expected</b>: State passed to main window, time to populate all items measured.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> fan = make_ntf_frame(NTF_FAN_STATE, {FAN_STATE_ON});
+   fan[NTF_REQ_TYPE_OFFSET] = NTF_GET;
+   FrameView fan_view = {fan.data(), fan.size()};
+   EXPECT_CALL(m_window_mock, setStateBatch(_));
+   EXPECT_CALL(m_window_mock, setFanState(FAN_STATE_ON));
+   listener->onSocketFrames(&fan_view, 1);
+   EXPECT_EQ(m_test_subject->getPendingStateRequests(), 0);
+   EXPECT_GE(m_test_subject->getPopulateTime().count(), 0);
+
+   /**
+    * <b>scenario</b>: Reconnected, one of requests cannot be sent.<br>
+    * <b>expected</b>: Measurement restarted, response not expected for failed request.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_driver_mock, writeAsync(ElementsAre(NTF_INPUTS_STATE_ALL, NTF_GET, 0, '\n'), _)).WillOnce(Return(true));
+   EXPECT_CALL(m_driver_mock, writeAsync(ElementsAre(NTF_ENV_SENSOR_DATA_ALL, NTF_GET, 0, '\n'), _)).WillOnce(Return(false));
+   EXPECT_CALL(m_driver_mock, writeAsync(ElementsAre(NTF_FAN_STATE, NTF_GET, 0, '\n'), _)).WillOnce(Return(true));
+   listener->onSocketEvent(DriverEvent::DRIVER_CONNECTED, {}, 0);
+   EXPECT_EQ(m_test_subject->getPendingStateRequests(), 2);
+   EXPECT_LT(m_test_subject->getPopulateTime().count(), 0);
+
+   /**
+    * <b>scenario</b>: Link dropped before responses received.<br>
+    * <b>expected</b>: Responses not expected anymore, populate time not measured.<br>
+    * ************************************************
+    */
+   listener->onSocketEvent(DriverEvent::DRIVER_DISCONNECTED, {}, 0);
+   EXPECT_EQ(m_test_subject->getPendingStateRequests(), 0);
+   EXPECT_LT(m_test_subject->getPopulateTime().count(), 0);
+}
@@ -0,0 +1,148 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "DelimiterSearch.h"
+#include <algorithm>
+#include <random>
+/* ============================= */
+/**
+ * @file DelimiterSearchTests.cpp
+ *
+ * @brief Unit tests to verify behavior of delimiter search kernels.
+ *
+ * @details Each kernel supported by CPU running the tests is compared with std::find() results.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+using namespace delimiter_search;
+
+struct DelimiterSearchFixture : public testing::TestWithParam<Kernel>
+{
+   /* reference implementation - search restarted after each found delimiter */
+   std::vector<size_t> find_reference(const uint8_t* data, size_t size, uint8_t delimiter)
+   {
+      std::vector<size_t> result;
+      const uint8_t* end = data + size;
+      const uint8_t* it = std::find(data, end, delimiter);
+      while (it != end)
+      {
+         result.push_back(it - data);
+         it = std::find(it + 1, end, delimiter);
+      }
+      return result;
+   }
+   std::vector<size_t> find(const uint8_t* data, size_t size, uint8_t delimiter)
+   {
+      std::vector<size_t> result;
+      size_t found = findAll(GetParam(), data, size, delimiter, result);
+      EXPECT_EQ(found, result.size());
+      return result;
+   }
+};
+
+/**
+ * @test Tests of simple buffers
+ */
+TEST_P(DelimiterSearchFixture, simple_buffer_tests)
+{
+   if (!isSupported(GetParam()))
+   {
+      return;
+   }
+   /**
+    * <b>scenario</b>: Empty buffer and buffer without delimiters searched.<br>
+    * <b>expected</b>: Nothing found.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> data (100, 0xAA);
+   EXPECT_THAT(find(data.data(), 0, '\n'), ElementsAre());
+   EXPECT_THAT(find(data.data(), data.size(), '\n'), ElementsAre());
+
+   /**
+    * <b>scenario</b>: Delimiters placed at vector boundaries and in the tail.<br>
+    * <b>expected</b>: All positions found in ascending order.<br>
+    * ************************************************
+    */
+   for (size_t pos : {0, 15, 16, 31, 32, 63, 64, 99})
+   {
+      data[pos] = '\n';
+   }
+   EXPECT_THAT(find(data.data(), data.size(), '\n'), ElementsAre(0, 15, 16, 31, 32, 63, 64, 99));
+
+   /**
+    * <b>scenario</b>: Buffer containing only delimiters searched, positions vector not empty.<br>
+    * <b>expected</b>: Every position appended.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> delimiters (70, 0x00);
+   std::vector<size_t> positions = {1234};
+   EXPECT_EQ(findAll(GetParam(), delimiters.data(), delimiters.size(), 0x00, positions), 70);
+   ASSERT_EQ(positions.size(), 71);
+   EXPECT_EQ(positions[0], 1234);
+   EXPECT_EQ(positions[70], 69);
+}
+
+/**
+ * @test Differential tests with random data
+ */
+TEST_P(DelimiterSearchFixture, random_buffer_tests)
+{
+   if (!isSupported(GetParam()))
+   {
+      return;
+   }
+   /**
+    * <b>scenario</b>: Random buffers of different sizes, alignment and delimiter density searched.<br>
+    * <b>expected</b>: Positions equal to std::find() results.<br>
+    * ************************************************
+    */
+   std::mt19937 rng (4321);
+   std::uniform_int_distribution<int> byte (0, 255);
+   std::vector<uint8_t> buffer (4096 + 64);
+   for (size_t density : {1, 2, 16, 256})
+   {
+      for (auto& b : buffer)
+      {
+         b = (byte(rng) % density == 0)? '\n' : byte(rng);
+      }
+      for (size_t offset = 0; offset < 33; offset += 5)
+      {
+         for (size_t size : {1, 15, 17, 33, 100, 1000, 4096})
+         {
+            EXPECT_EQ(find(buffer.data() + offset, size, '\n'), find_reference(buffer.data() + offset, size, '\n'))
+                  << "density " << density << " offset " << offset << " size " << size;
+         }
+      }
+   }
+}
+
+/**
+ * @test Tests of kernel selection
+ */
+TEST(DelimiterSearchSelection, kernel_selection_tests)
+{
+   /**
+    * <b>scenario</b>: Default kernel requested.<br>
+    * <b>expected</b>: Selected kernel is supported, scalar is always supported.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(isSupported(Kernel::SCALAR));
+   EXPECT_TRUE(isSupported(bestKernel()));
+
+   /**
+    * <b>scenario</b>: Default search used.<br>
+    * <b>expected</b>: Same result as selected kernel.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> data = {'\n', 1, 2, '\n', 3, '\n'};
+   std::vector<size_t> positions;
+   EXPECT_EQ(findAll(data.data(), data.size(), '\n', positions), 3);
+   EXPECT_THAT(positions, ElementsAre(0, 3, 5));
+}
+
+INSTANTIATE_TEST_CASE_P(Kernels, DelimiterSearchFixture,
+                        Values(Kernel::SCALAR, Kernel::SSE2, Kernel::AVX2, Kernel::NEON));
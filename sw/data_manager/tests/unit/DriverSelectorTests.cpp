@@ -0,0 +1,219 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "DriverSelector.h"
+#include "ShmDriver.h"
+#include "SocketDriverMock.h"
+#include "logger_mock.hpp"
+/* ============================= */
+/**
+ * @file DriverSelectorTests.cpp
+ *
+ * @brief Unit tests to verify selection of transport by address.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+struct ListenerMock : public SocketListener
+{
+   MOCK_METHOD3(onSocketEvent, void(DriverEvent, const std::vector<uint8_t>&, size_t));
+};
+
+struct DriverSelectorFixture : public testing::Test
+{
+   void SetUp()
+   {
+      mock_logger_init();
+      m_test_subject.reset(new DriverSelector(m_socket_driver, m_shm_driver));
+   }
+   void TearDown()
+   {
+      m_test_subject.reset(nullptr);
+      mock_logger_deinit();
+   }
+   ListenerMock listener_mock;
+   StrictMock<SocketDriverMock> m_socket_driver;
+   StrictMock<SocketDriverMock> m_shm_driver;
+   std::unique_ptr<ISocketDriver> m_test_subject;
+};
+
+/**
+ * @test Tests of passing settings to drivers
+ */
+TEST_F(DriverSelectorFixture, settings_tests)
+{
+   /**
+    * <b>scenario</b>: Listener and settings changed.<br>
+    * <b>expected</b>: Both drivers configured.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_socket_driver, addListener(&listener_mock));
+   EXPECT_CALL(m_shm_driver, addListener(&listener_mock));
+   EXPECT_CALL(m_socket_driver, setDelimiter('\n'));
+   EXPECT_CALL(m_shm_driver, setDelimiter('\n'));
+   EXPECT_CALL(m_socket_driver, setFraming(FramingMode::COBS));
+   EXPECT_CALL(m_shm_driver, setFraming(FramingMode::COBS));
+   EXPECT_CALL(m_socket_driver, setFrameLayout(_));
+   EXPECT_CALL(m_shm_driver, setFrameLayout(_));
+   EXPECT_CALL(m_socket_driver, setWriteHighWaterMark(100));
+   EXPECT_CALL(m_shm_driver, setWriteHighWaterMark(100));
+   EXPECT_CALL(m_socket_driver, removeListener(&listener_mock));
+   EXPECT_CALL(m_shm_driver, removeListener(&listener_mock));
+   m_test_subject->addListener(&listener_mock);
+   m_test_subject->setDelimiter('\n');
+   m_test_subject->setFraming(FramingMode::COBS);
+   m_test_subject->setFrameLayout({1, 0, 1, 10});
+   m_test_subject->setWriteHighWaterMark(100);
+   m_test_subject->removeListener(&listener_mock);
+}
+
+/**
+ * @test Tests of selecting driver by address
+ */
+TEST_F(DriverSelectorFixture, select_tests)
+{
+   SocketDriverStats stats = {};
+   stats.bytes_received = 10;
+   /**
+    * <b>scenario</b>: TCP address provided.<br>
+    * <b>expected</b>: Socket driver used.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_socket_driver, connect("127.0.0.1", 2222)).WillOnce(Return(true));
+   EXPECT_CALL(m_socket_driver, isConnected()).WillOnce(Return(true));
+   EXPECT_CALL(m_socket_driver, write(ElementsAre(1), 0)).WillOnce(Return(true));
+   EXPECT_CALL(m_socket_driver, writeAsync(ElementsAre(2), _)).WillOnce(Return(true));
+   EXPECT_CALL(m_socket_driver, getStats()).WillOnce(Return(stats));
+   EXPECT_TRUE(m_test_subject->connect("127.0.0.1", 2222));
+   EXPECT_TRUE(m_test_subject->isConnected());
+   EXPECT_TRUE(m_test_subject->write({1}));
+   EXPECT_TRUE(m_test_subject->writeAsync({2}));
+   EXPECT_EQ(m_test_subject->getStats().bytes_received, 10);
+   Mock::VerifyAndClearExpectations(&m_socket_driver);
+
+   /**
+    * <b>scenario</b>: Unix socket address provided.<br>
+    * <b>expected</b>: Socket driver used.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_socket_driver, connect("unix:/run/smarthome.sock", 0)).WillOnce(Return(true));
+   EXPECT_TRUE(m_test_subject->connect("unix:/run/smarthome.sock", 0));
+   Mock::VerifyAndClearExpectations(&m_socket_driver);
+
+   /**
+    * <b>scenario</b>: Shared memory address provided.<br>
+    * <b>expected</b>: Socket driver disconnected, shared memory driver used.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_socket_driver, disconnect()).WillOnce(Return(true));
+   EXPECT_CALL(m_shm_driver, connect(SHMDRV_SCHEME "/smarthome", 0)).WillOnce(Return(false));
+   EXPECT_CALL(m_shm_driver, isConnected()).WillOnce(Return(false));
+   EXPECT_CALL(m_shm_driver, disconnect()).WillOnce(Return(true));
+   EXPECT_FALSE(m_test_subject->connect(SHMDRV_SCHEME "/smarthome", 0));
+   EXPECT_FALSE(m_test_subject->isConnected());
+   EXPECT_TRUE(m_test_subject->disconnect());
+}
+
+/**
+ * @test Tests of connecting to one of several endpoints
+ */
+TEST_F(DriverSelectorFixture, connect_any_tests)
+{
+   auto addresses = [](const std::vector<SocketEndpoint>& endpoints)
+   {
+      std::vector<std::string> result;
+      for (const SocketEndpoint& endpoint : endpoints)
+      {
+         result.push_back(endpoint.address);
+      }
+      return result;
+   };
+   /**
+    * <b>scenario</b>: Two TCP endpoints, then shared memory endpoint, TCP servers not available.<br>
+    * <b>expected</b>: TCP endpoints passed to socket driver together, then shared memory driver used, index in whole list returned.<br>
+    * ************************************************
+    */
+   {
+      InSequence seq;
+      EXPECT_CALL(m_socket_driver, connectAny(_)).WillOnce(Invoke([&](const std::vector<SocketEndpoint>& endpoints) -> int
+            {
+               EXPECT_THAT(addresses(endpoints), ElementsAre("10.0.0.1", "10.0.0.2"));
+               return -1;
+            }));
+      EXPECT_CALL(m_socket_driver, disconnect()).WillOnce(Return(true));
+      EXPECT_CALL(m_shm_driver, connectAny(_)).WillOnce(Invoke([&](const std::vector<SocketEndpoint>& endpoints) -> int
+            {
+               EXPECT_THAT(addresses(endpoints), ElementsAre(SHMDRV_SCHEME "/smarthome"));
+               return 0;
+            }));
+   }
+   EXPECT_EQ(m_test_subject->connectAny({{"10.0.0.1", 2222}, {"10.0.0.2", 2222}, {SHMDRV_SCHEME "/smarthome", 0}}), 2);
+   Mock::VerifyAndClearExpectations(&m_socket_driver);
+   Mock::VerifyAndClearExpectations(&m_shm_driver);
+
+   /**
+    * <b>scenario</b>: First endpoint available.<br>
+    * <b>expected</b>: Remaining groups not tried.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_shm_driver, disconnect()).WillOnce(Return(true));
+   EXPECT_CALL(m_socket_driver, connectAny(SizeIs(1))).WillOnce(Return(0));
+   EXPECT_EQ(m_test_subject->connectAny({{"unix:/run/smarthome.sock", 0}, {SHMDRV_SCHEME "/smarthome", 0}}), 0);
+   Mock::VerifyAndClearExpectations(&m_shm_driver);
+
+   /**
+    * <b>scenario</b>: Empty list.<br>
+    * <b>expected</b>: No driver used.<br>
+    * ************************************************
+    */
+   EXPECT_EQ(m_test_subject->connectAny({}), -1);
+}
+
+/**
+ * @test Tests of connecting to one of several endpoints without blocking
+ */
+TEST_F(DriverSelectorFixture, connect_async_tests)
+{
+   ISocketDriver::ConnectCallback socket_callback;
+   ISocketDriver::ConnectCallback shm_callback;
+   std::vector<int> results;
+   /**
+    * <b>scenario</b>: Two TCP endpoints, then shared memory endpoint, socket driver did not report result yet.<br>
+    * <b>expected</b>: TCP endpoints passed to socket driver, shared memory driver not used, result not reported.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_socket_driver, connectAsync(SizeIs(2), _)).WillOnce(SaveArg<1>(&socket_callback));
+   m_test_subject->connectAsync({{"10.0.0.1", 2222}, {"10.0.0.2", 2222}, {SHMDRV_SCHEME "/smarthome", 0}},
+                                [&](int index){ results.push_back(index); });
+   ASSERT_TRUE(!!socket_callback);
+   EXPECT_TRUE(results.empty());
+   Mock::VerifyAndClearExpectations(&m_socket_driver);
+
+   /**
+    * <b>scenario</b>: TCP servers not available, then shared memory server available.<br>
+    * <b>expected</b>: Shared memory driver used after socket driver failed, index in whole list reported.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_socket_driver, disconnect()).WillOnce(Return(true));
+   EXPECT_CALL(m_shm_driver, connectAsync(SizeIs(1), _)).WillOnce(SaveArg<1>(&shm_callback));
+   socket_callback(-1);
+   ASSERT_TRUE(!!shm_callback);
+   EXPECT_TRUE(results.empty());
+   shm_callback(0);
+   EXPECT_THAT(results, ElementsAre(2));
+   results.clear();
+
+   /**
+    * <b>scenario</b>: No endpoint available.<br>
+    * <b>expected</b>: Failure reported once.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(m_shm_driver, disconnect()).WillOnce(Return(true));
+   EXPECT_CALL(m_socket_driver, connectAsync(SizeIs(1), _)).WillOnce(InvokeArgument<1>(-1));
+   m_test_subject->connectAsync({{"10.0.0.1", 2222}}, [&](int index){ results.push_back(index); });
+   EXPECT_THAT(results, ElementsAre(-1));
+}
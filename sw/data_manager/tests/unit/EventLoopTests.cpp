@@ -0,0 +1,203 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "EventLoop.h"
+#include "logger_mock.hpp"
+#include <unistd.h>
+#include <condition_variable>
+/* ============================= */
+/**
+ * @file EventLoopTests.cpp
+ *
+ * @brief Unit tests to verify behavior of EventLoop.
+ *
+ * @details Tests are using real pipes and timers, because EventLoop is a thin layer on epoll.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+struct EventLoopFixture : public testing::Test
+{
+   void SetUp()
+   {
+      mock_logger_init();
+      ASSERT_EQ(pipe(m_pipe), 0);
+      m_test_subject.reset(new EventLoop());
+      ASSERT_TRUE(m_test_subject->start());
+   }
+   void TearDown()
+   {
+      m_test_subject.reset(nullptr);
+      close(m_pipe[0]);
+      close(m_pipe[1]);
+      mock_logger_deinit();
+   }
+   /* waits until predicate is true or timeout expires */
+   template<typename Pred>
+   bool waitFor(Pred pred, std::chrono::milliseconds timeout = std::chrono::milliseconds(1000))
+   {
+      std::unique_lock<std::mutex> lock(m_mtx);
+      return m_cv.wait_for(lock, timeout, pred);
+   }
+   /* modifies the data checked by waitFor() predicate */
+   void notify(std::function<void()> update = nullptr)
+   {
+      std::lock_guard<std::mutex> lock(m_mtx);
+      if (update)
+      {
+         update();
+      }
+      m_cv.notify_all();
+   }
+   int m_pipe[2];
+   std::mutex m_mtx;
+   std::condition_variable m_cv;
+   std::unique_ptr<IEventLoop> m_test_subject;
+};
+
+/**
+ * @test Tests of observing file descriptors
+ */
+TEST_F(EventLoopFixture, file_descriptor_tests)
+{
+   std::atomic<int> read_events (0);
+   uint8_t byte = 0xAA;
+   /**
+    * <b>scenario</b>: File descriptor becomes readable.<br>
+    * <b>expected</b>: Callback called from loop thread.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(m_test_subject->addFd(m_pipe[0], EVLOOP_READ, [&](uint32_t events)
+   {
+      EXPECT_TRUE(m_test_subject->isLoopThread());
+      EXPECT_TRUE(events & EVLOOP_READ);
+      uint8_t data = 0;
+      EXPECT_EQ(read(m_pipe[0], &data, 1), 1);
+      EXPECT_EQ(data, 0xAA);
+      read_events++;
+      notify();
+   }));
+   EXPECT_FALSE(m_test_subject->isLoopThread());
+   EXPECT_EQ(write(m_pipe[1], &byte, 1), 1);
+   EXPECT_TRUE(waitFor([&](){ return read_events == 1;}));
+
+   /**
+    * <b>scenario</b>: File descriptor added again.<br>
+    * <b>expected</b>: False returned.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(m_test_subject->addFd(m_pipe[0], EVLOOP_READ, [&](uint32_t){}));
+
+   /**
+    * <b>scenario</b>: File descriptor removed, then data written.<br>
+    * <b>expected</b>: Callback not called.<br>
+    * ************************************************
+    */
+   m_test_subject->removeFd(m_pipe[0]);
+   EXPECT_EQ(write(m_pipe[1], &byte, 1), 1);
+   EXPECT_FALSE(waitFor([&](){ return read_events != 1;}, std::chrono::milliseconds(50)));
+
+   /**
+    * <b>scenario</b>: Observed events changed to write.<br>
+    * <b>expected</b>: Callback called with write event.<br>
+    * ************************************************
+    */
+   std::atomic<int> write_events (0);
+   EXPECT_FALSE(m_test_subject->modifyFd(m_pipe[1], EVLOOP_WRITE));
+   EXPECT_TRUE(m_test_subject->addFd(m_pipe[1], 0, [&](uint32_t events)
+   {
+      EXPECT_TRUE(events & EVLOOP_WRITE);
+      m_test_subject->modifyFd(m_pipe[1], 0);
+      write_events++;
+      notify();
+   }));
+   EXPECT_FALSE(waitFor([&](){ return write_events != 0;}, std::chrono::milliseconds(50)));
+   EXPECT_TRUE(m_test_subject->modifyFd(m_pipe[1], EVLOOP_WRITE));
+   EXPECT_TRUE(waitFor([&](){ return write_events == 1;}));
+   m_test_subject->removeFd(m_pipe[1]);
+}
+
+/**
+ * @test Tests of timers
+ */
+TEST_F(EventLoopFixture, timer_tests)
+{
+   std::vector<int> order;
+   /**
+    * <b>scenario</b>: Two timers added in reversed order.<br>
+    * <b>expected</b>: Callbacks called in order of expiration.<br>
+    * ************************************************
+    */
+   auto start = std::chrono::steady_clock::now();
+   EXPECT_NE(m_test_subject->addTimer(std::chrono::milliseconds(40), [&](){ notify([&](){ order.push_back(2); }); }), EVLOOP_INVALID_TIMER);
+   EXPECT_NE(m_test_subject->addTimer(std::chrono::milliseconds(20), [&](){ notify([&](){ order.push_back(1); }); }), EVLOOP_INVALID_TIMER);
+   EXPECT_TRUE(waitFor([&](){ return order.size() == 2;}));
+   EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(40));
+   EXPECT_THAT(order, ElementsAre(1, 2));
+
+   /**
+    * <b>scenario</b>: Timer cancelled before expiration.<br>
+    * <b>expected</b>: Callback not called.<br>
+    * ************************************************
+    */
+   bool called = false;
+   IEventLoop::TimerId id = m_test_subject->addTimer(std::chrono::milliseconds(20), [&](){ notify([&](){ called = true; }); });
+   m_test_subject->cancelTimer(id);
+   EXPECT_FALSE(waitFor([&](){ return called;}, std::chrono::milliseconds(60)));
+
+   /**
+    * <b>scenario</b>: Timer re-armed from its own callback.<br>
+    * <b>expected</b>: Callback called periodically.<br>
+    * ************************************************
+    */
+   int counter = 0;
+   std::function<void()> periodic = [&]()
+   {
+      if (counter < 2)
+      {
+         m_test_subject->addTimer(std::chrono::milliseconds(1), periodic);
+      }
+      notify([&](){ counter++; });
+   };
+   m_test_subject->addTimer(std::chrono::milliseconds(0), periodic);
+   EXPECT_TRUE(waitFor([&](){ return counter == 3;}));
+
+   /**
+    * <b>scenario</b>: Timer without callback added.<br>
+    * <b>expected</b>: Invalid id returned.<br>
+    * ************************************************
+    */
+   EXPECT_EQ(m_test_subject->addTimer(std::chrono::milliseconds(0), nullptr), EVLOOP_INVALID_TIMER);
+}
+
+/**
+ * @test Tests of stopping the loop
+ */
+TEST_F(EventLoopFixture, start_stop_tests)
+{
+   /**
+    * <b>scenario</b>: Loop is waiting without any timer, stop requested.<br>
+    * <b>expected</b>: Loop woken up and stopped immediately.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(m_test_subject->isRunning());
+   EXPECT_FALSE(m_test_subject->start());
+   auto start = std::chrono::steady_clock::now();
+   m_test_subject->stop();
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+   EXPECT_FALSE(m_test_subject->isRunning());
+
+   /**
+    * <b>scenario</b>: Loop started again.<br>
+    * <b>expected</b>: Timers are working.<br>
+    * ************************************************
+    */
+   bool called = false;
+   EXPECT_TRUE(m_test_subject->start());
+   m_test_subject->addTimer(std::chrono::milliseconds(0), [&](){ notify([&](){ called = true; }); });
+   EXPECT_TRUE(waitFor([&](){ return called;}));
+}
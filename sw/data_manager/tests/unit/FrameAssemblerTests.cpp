@@ -0,0 +1,324 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "FrameAssembler.h"
+#include "logger_mock.hpp"
+#include <string.h>
+/* ============================= */
+/**
+ * @file FrameAssemblerTests.cpp
+ *
+ * @brief Unit tests to verify behavior of FrameAssembler.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+struct FrameAssemblerFixture : public testing::Test
+{
+   const size_t CAPACITY = 32;
+   void SetUp()
+   {
+      mock_logger_init();
+      m_test_subject.reset(new FrameAssembler(CAPACITY));
+   }
+   void TearDown()
+   {
+      m_test_subject.reset(nullptr);
+      mock_logger_deinit();
+   }
+   /* simulates recv() - writes data to the store and returns extracted frames count */
+   size_t receive(const std::vector<uint8_t>& data)
+   {
+      EXPECT_LE(data.size(), m_test_subject->writeSpace());
+      memcpy(m_test_subject->writePtr(), data.data(), data.size());
+      return m_test_subject->commit(data.size());
+   }
+   std::vector<uint8_t> frame(size_t idx)
+   {
+      const FrameView& view = m_test_subject->frames()[idx];
+      return std::vector<uint8_t>(view.data, view.data + view.size);
+   }
+   std::unique_ptr<FrameAssembler> m_test_subject;
+};
+
+/**
+ * @test Tests of frames extraction
+ */
+TEST_F(FrameAssemblerFixture, frames_extraction_tests)
+{
+   /**
+    * <b>scenario</b>: Two frames and part of the third received.<br>
+    * <b>expected</b>: Two views pointing to the store returned.<br>
+    * ************************************************
+    */
+   const uint8_t* store = m_test_subject->writePtr();
+   ASSERT_EQ(receive({1, 2, '\n', 3, '\n', 4}), 2);
+   EXPECT_THAT(frame(0), ElementsAre(1, 2));
+   EXPECT_THAT(frame(1), ElementsAre(3));
+   EXPECT_EQ(m_test_subject->frames()[0].data, store);
+   EXPECT_EQ(m_test_subject->frames()[1].data, store + 3);
+   m_test_subject->release();
+   EXPECT_EQ(m_test_subject->pending(), 1);
+
+   /**
+    * <b>scenario</b>: Rest of the third frame received.<br>
+    * <b>expected</b>: Frame merged without copying.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(receive({5, '\n'}), 1);
+   EXPECT_THAT(frame(0), ElementsAre(4, 5));
+   EXPECT_EQ(m_test_subject->frames()[0].data, store + 5);
+   m_test_subject->release();
+
+   /**
+    * <b>scenario</b>: All data consumed.<br>
+    * <b>expected</b>: Whole store available for next data.<br>
+    * ************************************************
+    */
+   EXPECT_EQ(m_test_subject->pending(), 0);
+   EXPECT_EQ(m_test_subject->writeSpace(), CAPACITY);
+
+   /**
+    * <b>scenario</b>: Empty frame and frame with changed delimiter received.<br>
+    * <b>expected</b>: Empty frame reported, frames cut on new delimiter.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(receive({'\n'}), 1);
+   EXPECT_EQ(m_test_subject->frames()[0].size, 0);
+   m_test_subject->release();
+   m_test_subject->setDelimiter(0xFF);
+   ASSERT_EQ(receive({'\n', 0xFF}), 1);
+   EXPECT_THAT(frame(0), ElementsAre('\n'));
+   m_test_subject->release();
+}
+
+/**
+ * @test Tests of store wrapping
+ */
+TEST_F(FrameAssemblerFixture, wrap_tests)
+{
+   /**
+    * <b>scenario</b>: Incomplete frame placed at the end of the store.<br>
+    * <b>expected</b>: Incomplete frame moved to beginning of the store after release.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> data (CAPACITY - 2, 0xAA);
+   data[CAPACITY - 5] = '\n';
+   ASSERT_EQ(receive(data), 1);
+   EXPECT_EQ(frame(0).size(), CAPACITY - 5);
+   m_test_subject->release();
+   EXPECT_EQ(m_test_subject->pending(), 2);
+   EXPECT_EQ(m_test_subject->writeSpace(), CAPACITY - 2);
+
+   /**
+    * <b>scenario</b>: Rest of the frame received.<br>
+    * <b>expected</b>: Frame is complete.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(receive({0xBB, '\n'}), 1);
+   EXPECT_THAT(frame(0), ElementsAre(0xAA, 0xAA, 0xBB));
+   m_test_subject->release();
+
+   /**
+    * <b>scenario</b>: Many frames received in single chunk.<br>
+    * <b>expected</b>: All frames reported.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> burst;
+   for (uint8_t i = 0; i < CAPACITY / 2; i++)
+   {
+      burst.push_back(0x20 + i);
+      burst.push_back('\n');
+   }
+   ASSERT_EQ(receive(burst), CAPACITY / 2);
+   EXPECT_THAT(frame(CAPACITY / 2 - 1), ElementsAre(0x20 + CAPACITY / 2 - 1));
+   m_test_subject->release();
+}
+
+/**
+ * @test Tests of too long frames
+ */
+TEST_F(FrameAssemblerFixture, overflow_tests)
+{
+   /**
+    * <b>scenario</b>: Frame longer than the store received.<br>
+    * <b>expected</b>: Frame dropped.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> data (CAPACITY, 0xAA);
+   ASSERT_EQ(receive(data), 0);
+   m_test_subject->release();
+   EXPECT_EQ(m_test_subject->dropped(), 1);
+   EXPECT_EQ(m_test_subject->writeSpace(), CAPACITY);
+
+   /**
+    * <b>scenario</b>: Rest of the dropped frame and next frame received.<br>
+    * <b>expected</b>: Only next frame reported.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(receive({0xAA, 0xAA}), 0);
+   m_test_subject->release();
+   ASSERT_EQ(receive({0xAA, '\n', 1, '\n'}), 1);
+   EXPECT_THAT(frame(0), ElementsAre(1));
+   m_test_subject->release();
+
+   /**
+    * <b>scenario</b>: Reset requested.<br>
+    * <b>expected</b>: Pending data dropped.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(receive({1, 2}), 0);
+   m_test_subject->release();
+   m_test_subject->reset();
+   EXPECT_EQ(m_test_subject->pending(), 0);
+   EXPECT_EQ(m_test_subject->dropped(), 1);
+}
+
+/**
+ * @test Tests of length-prefixed framing
+ */
+TEST_F(FrameAssemblerFixture, length_prefixed_tests)
+{
+   /* header: [id, length], payload, trailer: delimiter */
+   m_test_subject->setFrameLayout({2, 1, 1, 8});
+   m_test_subject->setFraming(FramingMode::LENGTH_PREFIXED);
+
+   /**
+    * <b>scenario</b>: Two frames received, payload contains delimiter byte, third frame header incomplete.<br>
+    * <b>expected</b>: Frames cut using length from header, trailer not part of the frame.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(receive({0x10, 2, '\n', 0xAA, '\n', 0x11, 0, '\n', 0x12}), 2);
+   EXPECT_THAT(frame(0), ElementsAre(0x10, 2, '\n', 0xAA));
+   EXPECT_THAT(frame(1), ElementsAre(0x11, 0));
+   m_test_subject->release();
+   EXPECT_EQ(m_test_subject->pending(), 1);
+
+   /**
+    * <b>scenario</b>: Header completed, payload received in next chunk.<br>
+    * <b>expected</b>: Frame reported when complete.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(receive({1}), 0);
+   m_test_subject->release();
+   ASSERT_EQ(receive({0xBB, '\n'}), 1);
+   EXPECT_THAT(frame(0), ElementsAre(0x12, 1, 0xBB));
+   m_test_subject->release();
+
+   /**
+    * <b>scenario</b>: Frame with payload bigger than allowed received.<br>
+    * <b>expected</b>: Frame dropped as soon as header is received, its bytes skipped.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(receive({0x13, 9, 1, 2, 3}), 0);
+   m_test_subject->release();
+   EXPECT_EQ(m_test_subject->dropped(), 1);
+   EXPECT_EQ(m_test_subject->pending(), 0);
+   ASSERT_EQ(receive({4, 5, 6, 7, 8, 9, '\n', 0x14, 0, '\n'}), 1);
+   EXPECT_THAT(frame(0), ElementsAre(0x14, 0));
+   m_test_subject->release();
+
+   /**
+    * <b>scenario</b>: Frame with invalid trailer received.<br>
+    * <b>expected</b>: Frame dropped, next frame found after delimiter.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(receive({0x15, 1, 0xCC, 0xDD, 0xEE, '\n', 0x16, 1, 0xFF, '\n'}), 1);
+   EXPECT_THAT(frame(0), ElementsAre(0x16, 1, 0xFF));
+   EXPECT_EQ(m_test_subject->dropped(), 2);
+   m_test_subject->release();
+
+   /**
+    * <b>scenario</b>: Frame with invalid trailer received, its payload contains delimiter followed by byte looking like
+    *                  length of too long frame.<br>
+    * <b>expected</b>: Malformed frame dropped, bytes after inner delimiter not treated as header, next frame found.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(receive({0x17, 3, '\n', 0x20, '\n', 0x18, 1, 0xAB, '\n', 0x19, 0, '\n'}), 2);
+   EXPECT_THAT(frame(0), ElementsAre(0x18, 1, 0xAB));
+   EXPECT_THAT(frame(1), ElementsAre(0x19, 0));
+   EXPECT_EQ(m_test_subject->dropped(), 3);
+   m_test_subject->release();
+
+   /**
+    * <b>scenario</b>: Framing switched back to delimiter mode.<br>
+    * <b>expected</b>: Frames cut on delimiter.<br>
+    * ************************************************
+    */
+   m_test_subject->setFraming(FramingMode::DELIMITER);
+   ASSERT_EQ(receive({0x10, 2, '\n'}), 1);
+   EXPECT_THAT(frame(0), ElementsAre(0x10, 2));
+   m_test_subject->release();
+}
+
+/**
+ * @test Tests of length prefixed framing without valid layout
+ */
+TEST_F(FrameAssemblerFixture, length_prefixed_layout_tests)
+{
+   m_test_subject->setFraming(FramingMode::LENGTH_PREFIXED);
+   /**
+    * <b>scenario</b>: Data received in length prefixed mode with default layout, length byte equal to 0.<br>
+    * <b>expected</b>: Data dropped, no frames reported.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(receive({0x01, 0x00, 0x00, '\n'}), 0);
+   m_test_subject->release();
+   EXPECT_EQ(m_test_subject->pending(), 0);
+
+   /**
+    * <b>scenario</b>: Layouts with zero-length header and length byte outside of header set.<br>
+    * <b>expected</b>: Layouts rejected, data still dropped.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(m_test_subject->setFrameLayout({0, 0, 1, 8}));
+   EXPECT_FALSE(m_test_subject->setFrameLayout({2, 2, 1, 8}));
+   ASSERT_EQ(receive({0x01, 0x00, 0x00, '\n'}), 0);
+   m_test_subject->release();
+   EXPECT_EQ(m_test_subject->pending(), 0);
+
+   /**
+    * <b>scenario</b>: Valid layout set, then invalid one.<br>
+    * <b>expected</b>: Frames cut using valid layout, invalid layout does not replace it.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(m_test_subject->setFrameLayout({2, 1, 1, 8}));
+   EXPECT_FALSE(m_test_subject->setFrameLayout({0, 0, 0, 0}));
+   ASSERT_EQ(receive({0x01, 0x00, '\n', 0x02, 0x01, 0xAA, '\n'}), 2);
+   EXPECT_THAT(frame(0), ElementsAre(0x01, 0x00));
+   EXPECT_THAT(frame(1), ElementsAre(0x02, 0x01, 0xAA));
+   m_test_subject->release();
+}
+
+/**
+ * @test Tests of COBS framing
+ */
+TEST_F(FrameAssemblerFixture, cobs_tests)
+{
+   m_test_subject->setFraming(FramingMode::COBS);
+   /**
+    * <b>scenario</b>: Two encoded frames received, payload contains zero and delimiter bytes.<br>
+    * <b>expected</b>: Frames decoded in place.<br>
+    * ************************************************
+    */
+   const uint8_t* store = m_test_subject->writePtr();
+   ASSERT_EQ(receive({3, 0x10, '\n', 2, 0xAA, 0, 2, '\n', 0}), 2);
+   EXPECT_THAT(frame(0), ElementsAre(0x10, '\n', 0, 0xAA));
+   EXPECT_THAT(frame(1), ElementsAre('\n'));
+   EXPECT_EQ(m_test_subject->frames()[0].data, store);
+   m_test_subject->release();
+
+   /**
+    * <b>scenario</b>: Empty frames between data and frame with invalid code received.<br>
+    * <b>expected</b>: Empty frames skipped, invalid frame dropped.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(receive({0, 0, 5, 1, 0, 2, 0x30, 0}), 1);
+   EXPECT_THAT(frame(0), ElementsAre(0x30));
+   EXPECT_EQ(m_test_subject->dropped(), 1);
+   m_test_subject->release();
+}
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "FramePool.h"
+#include <set>
+/* ============================= */
+/**
+ * @file FramePoolTests.cpp
+ *
+ * @brief Unit tests to verify behavior of FramePool.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+/**
+ * @test Tests of taking and returning blocks
+ */
+TEST(FramePoolTests, acquire_release_tests)
+{
+   FramePool pool (16, 4);
+   std::set<uint8_t*> blocks;
+   /**
+    * <b>scenario</b>: All blocks taken.<br>
+    * <b>expected</b>: Distinct, non-overlapping blocks returned, then pool is exhausted.<br>
+    * ************************************************
+    */
+   EXPECT_EQ(pool.capacity(), 4);
+   EXPECT_EQ(pool.blockSize(), 16);
+   for (size_t i = 0; i < 4; i++)
+   {
+      uint8_t* block = pool.acquire();
+      ASSERT_NE(block, nullptr);
+      EXPECT_TRUE(pool.owns(block));
+      for (uint8_t* other : blocks)
+      {
+         EXPECT_GE(std::abs(block - other), 16);
+      }
+      blocks.insert(block);
+   }
+   EXPECT_EQ(pool.available(), 0);
+   EXPECT_EQ(pool.acquire(), nullptr);
+
+   /**
+    * <b>scenario</b>: Block returned to exhausted pool.<br>
+    * <b>expected</b>: Same block taken again.<br>
+    * ************************************************
+    */
+   uint8_t* block = *blocks.begin();
+   pool.release(block);
+   EXPECT_EQ(pool.available(), 1);
+   EXPECT_EQ(pool.acquire(), block);
+   EXPECT_EQ(pool.acquire(), nullptr);
+
+   /**
+    * <b>scenario</b>: All blocks returned.<br>
+    * <b>expected</b>: Whole capacity available.<br>
+    * ************************************************
+    */
+   for (uint8_t* taken : blocks)
+   {
+      pool.release(taken);
+   }
+   EXPECT_EQ(pool.available(), 4);
+}
+
+/**
+ * @test Tests of releasing invalid pointers
+ */
+TEST(FramePoolTests, foreign_block_tests)
+{
+   FramePool pool (16, 2);
+   uint8_t other [16];
+   uint8_t* block = pool.acquire();
+   ASSERT_NE(block, nullptr);
+   /**
+    * <b>scenario</b>: Pointer not owned by the pool, pointer into the middle of block and nullptr released.<br>
+    * <b>expected</b>: Pointers ignored.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(pool.owns(other));
+   EXPECT_FALSE(pool.owns(block + 1));
+   EXPECT_FALSE(pool.owns(nullptr));
+   pool.release(other);
+   pool.release(block + 1);
+   pool.release(nullptr);
+   EXPECT_EQ(pool.available(), 1);
+
+   /**
+    * <b>scenario</b>: Block released twice.<br>
+    * <b>expected</b>: Free list never exceeds capacity.<br>
+    * ************************************************
+    */
+   pool.release(block);
+   pool.release(block);
+   EXPECT_EQ(pool.available(), 2);
+}
@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "HomeStateStore.h"
+#include <thread>
+/* ============================= */
+/**
+ * @file HomeStateStoreTests.cpp
+ *
+ * @brief Unit tests to verify behavior of HomeStateStore.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+/**
+ * @test Tests of storing and reading the state
+ */
+TEST(HomeStateStoreTests, update_tests)
+{
+   HomeStateStore store;
+   HomeState state;
+   /**
+    * <b>scenario</b>: Nothing received yet.<br>
+    * <b>expected</b>: All items not valid.<br>
+    * ************************************************
+    */
+   store.read(state);
+   EXPECT_EQ(state.version, 0);
+   EXPECT_THAT(state.env_valid, Each(false));
+   EXPECT_THAT(state.inputs_valid, Each(false));
+   EXPECT_FALSE(state.fan_valid);
+
+   /**
+    * <b>scenario</b>: States of env sensor, input and fan stored.<br>
+    * <b>expected</b>: States read, other items still not valid, version counts changes.<br>
+    * ************************************************
+    */
+   store.setEnv(ENV_KITCHEN, -3, 5, 60, 1);
+   store.setInput(INPUT_SOCKETS, INPUT_STATE_ACTIVE);
+   store.setFan(FAN_STATE_SUSPEND);
+   store.read(state);
+   EXPECT_EQ(state.version, 3);
+   EXPECT_EQ(store.version(), 3);
+   EXPECT_TRUE(state.env_valid[ENV_KITCHEN]);
+   EXPECT_FALSE(state.env_valid[ENV_BEDROOM]);
+   EXPECT_EQ(state.temp_h[ENV_KITCHEN], -3);
+   EXPECT_EQ(state.temp_l[ENV_KITCHEN], 5);
+   EXPECT_EQ(state.hum_h[ENV_KITCHEN], 60);
+   EXPECT_EQ(state.hum_l[ENV_KITCHEN], 1);
+   EXPECT_TRUE(state.inputs_valid[INPUT_SOCKETS]);
+   EXPECT_EQ(state.inputs[INPUT_SOCKETS], INPUT_STATE_ACTIVE);
+   EXPECT_TRUE(state.fan_valid);
+   EXPECT_EQ(state.fan, FAN_STATE_SUSPEND);
+
+   /**
+    * <b>scenario</b>: Same states stored again.<br>
+    * <b>expected</b>: Version not changed.<br>
+    * ************************************************
+    */
+   store.setEnv(ENV_KITCHEN, -3, 5, 60, 1);
+   store.setInput(INPUT_SOCKETS, INPUT_STATE_ACTIVE);
+   store.setFan(FAN_STATE_SUSPEND);
+   EXPECT_EQ(store.version(), 3);
+
+   /**
+    * <b>scenario</b>: IDs out of range stored.<br>
+    * <b>expected</b>: States ignored.<br>
+    * ************************************************
+    */
+   store.setEnv(ENV_ITEMS_COUNT, 1, 1, 1, 1);
+   store.setInput(INPUT_ITEMS_COUNT, INPUT_STATE_ACTIVE);
+   EXPECT_EQ(store.version(), 3);
+}
+
+/**
+ * @test Tests of reading while the state is updated
+ */
+TEST(HomeStateStoreTests, concurrent_read_tests)
+{
+   HomeStateStore store;
+   std::atomic<bool> done {false};
+   /**
+    * <b>scenario</b>: Writer keeps updating env sensors, all values of single update are equal.<br>
+    * <b>expected</b>: Readers never see partially updated state.<br>
+    * ************************************************
+    */
+   std::thread writer ([&]()
+   {
+      for (int value = 0; value < 20000; value++)
+      {
+         store.setEnv(ENV_BEDROOM, value, value, value, value);
+         store.setEnv(ENV_KITCHEN, value, value, value, value);
+      }
+      done = true;
+   });
+   size_t torn = 0;
+   size_t reads = 0;
+   HomeState state;
+   while (!done || reads == 0)
+   {
+      store.read(state);
+      reads++;
+      for (uint8_t id : {ENV_BEDROOM, ENV_KITCHEN})
+      {
+         if (state.temp_l[id] != state.temp_h[id] || state.hum_h[id] != (uint8_t)state.temp_h[id] ||
+             state.hum_l[id] != (uint8_t)state.temp_h[id])
+         {
+            torn++;
+         }
+      }
+      /* kitchen is updated after bedroom - it has the same or previous value */
+      const int8_t difference = state.temp_h[ENV_BEDROOM] - state.temp_h[ENV_KITCHEN];
+      if (state.env_valid[ENV_KITCHEN] && difference != 0 && difference != 1)
+      {
+         torn++;
+      }
+   }
+   writer.join();
+   EXPECT_EQ(torn, 0);
+   store.read(state);
+   EXPECT_EQ(state.temp_h[ENV_KITCHEN], (int8_t)19999);
+}
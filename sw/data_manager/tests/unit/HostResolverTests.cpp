@@ -0,0 +1,274 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "HostResolver.h"
+#include "logger_mock.hpp"
+#include <netdb.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <thread>
+#include <condition_variable>
+/* ============================= */
+/**
+ * @file HostResolverTests.cpp
+ *
+ * @brief Unit tests to verify behavior of HostResolver.
+ *
+ * @details Names are resolved by system resolver using local /etc/hosts entries.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+/* mock for system functions */
+struct ResolverCallMock
+{
+   MOCK_METHOD4(getaddrinfo, int(const char*, const char*, const struct addrinfo*, struct addrinfo**));
+};
+ResolverCallMock* resolver_call_mock;
+
+/* system calls to replace with mocked on linking stage */
+namespace system_call
+{
+__attribute__((weak)) int getaddrinfo(const char *node, const char *service, const struct addrinfo *hints, struct addrinfo **res)
+{
+   return resolver_call_mock->getaddrinfo(node, service, hints, res);
+}
+}
+
+/* returns text form of the address and its port */
+std::string to_string(const HostAddress& address)
+{
+   char buffer [INET6_ADDRSTRLEN] = {};
+   uint16_t port = 0;
+   if (address.address.ss_family == AF_INET6)
+   {
+      const struct sockaddr_in6* inet6_addr = reinterpret_cast<const struct sockaddr_in6*>(&address.address);
+      inet_ntop(AF_INET6, &inet6_addr->sin6_addr, buffer, sizeof(buffer));
+      port = ntohs(inet6_addr->sin6_port);
+   }
+   else
+   {
+      const struct sockaddr_in* inet_addr = reinterpret_cast<const struct sockaddr_in*>(&address.address);
+      inet_ntop(AF_INET, &inet_addr->sin_addr, buffer, sizeof(buffer));
+      port = ntohs(inet_addr->sin_port);
+   }
+   return std::string(buffer) + ":" + std::to_string(port);
+}
+
+struct HostResolverFixture : public testing::Test
+{
+   void SetUp()
+   {
+      mock_logger_init();
+      resolver_call_mock = new NiceMock<ResolverCallMock>;
+      ON_CALL(*resolver_call_mock, getaddrinfo(_,_,_,_)).WillByDefault(Invoke(&::getaddrinfo));
+   }
+   void TearDown()
+   {
+      delete resolver_call_mock;
+      mock_logger_deinit();
+   }
+};
+
+/**
+ * @test Tests of resolving and caching addresses
+ */
+TEST_F(HostResolverFixture, cache_tests)
+{
+   HostResolver resolver (std::chrono::milliseconds(200), std::chrono::milliseconds(100));
+   std::vector<HostAddress> addresses;
+   /**
+    * <b>scenario</b>: Host from /etc/hosts resolved.<br>
+    * <b>expected</b>: Loopback address returned with requested port.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*resolver_call_mock, getaddrinfo(StrEq("localhost"),_,_,_));
+   ASSERT_TRUE(resolver.resolve("localhost", 2222, std::chrono::seconds(5), addresses));
+   ASSERT_FALSE(addresses.empty());
+   EXPECT_THAT(to_string(addresses[0]), AnyOf("127.0.0.1:2222", "::1:2222"));
+   Mock::VerifyAndClearExpectations(resolver_call_mock);
+
+   /**
+    * <b>scenario</b>: Same host resolved again with other port.<br>
+    * <b>expected</b>: Cached address returned, system resolver not called.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*resolver_call_mock, getaddrinfo(_,_,_,_)).Times(0);
+   ASSERT_TRUE(resolver.resolve("localhost", 1111, std::chrono::milliseconds(0), addresses));
+   EXPECT_THAT(to_string(addresses[0]), AnyOf("127.0.0.1:1111", "::1:1111"));
+   Mock::VerifyAndClearExpectations(resolver_call_mock);
+
+   /**
+    * <b>scenario</b>: Cached address expired.<br>
+    * <b>expected</b>: Expired address returned immediately, address refreshed in background.<br>
+    * ************************************************
+    */
+   std::mutex mtx;
+   std::condition_variable cv;
+   bool refreshed = false;
+   EXPECT_CALL(*resolver_call_mock, getaddrinfo(StrEq("localhost"),_,_,_))
+         .WillOnce(Invoke([&](const char* node, const char* service, const struct addrinfo* hints, struct addrinfo** res)->int
+         {
+            int result = ::getaddrinfo(node, service, hints, res);
+            std::lock_guard<std::mutex> lock (mtx);
+            refreshed = true;
+            cv.notify_all();
+            return result;
+         }));
+   std::this_thread::sleep_for(std::chrono::milliseconds(250));
+   EXPECT_TRUE(resolver.resolve("localhost", 2222, std::chrono::milliseconds(0), addresses));
+   {
+      std::unique_lock<std::mutex> lock (mtx);
+      EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&](){ return refreshed; }));
+   }
+   Mock::VerifyAndClearExpectations(resolver_call_mock);
+
+   /**
+    * <b>scenario</b>: IPv6 address resolved.<br>
+    * <b>expected</b>: AF_INET6 address returned.<br>
+    * ************************************************
+    */
+   ASSERT_TRUE(resolver.resolve("::1", 2222, std::chrono::seconds(5), addresses));
+   EXPECT_EQ(addresses[0].address.ss_family, AF_INET6);
+   EXPECT_EQ(addresses[0].length, sizeof(struct sockaddr_in6));
+   EXPECT_EQ(to_string(addresses[0]), "::1:2222");
+}
+
+/**
+ * @test Tests of caching resolution failures
+ */
+TEST_F(HostResolverFixture, negative_cache_tests)
+{
+   HostResolver resolver (std::chrono::milliseconds(1000), std::chrono::milliseconds(100));
+   std::vector<HostAddress> addresses;
+   /**
+    * <b>scenario</b>: Host cannot be resolved.<br>
+    * <b>expected</b>: No addresses returned.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*resolver_call_mock, getaddrinfo(StrEq("unknown.host"),_,_,_)).WillOnce(Return(EAI_NONAME));
+   EXPECT_FALSE(resolver.resolve("unknown.host", 2222, std::chrono::seconds(5), addresses));
+   EXPECT_TRUE(addresses.empty());
+   Mock::VerifyAndClearExpectations(resolver_call_mock);
+
+   /**
+    * <b>scenario</b>: Same host requested again before negative TTL expires.<br>
+    * <b>expected</b>: Failure returned immediately, system resolver not called.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*resolver_call_mock, getaddrinfo(_,_,_,_)).Times(0);
+   EXPECT_FALSE(resolver.resolve("unknown.host", 2222, std::chrono::seconds(5), addresses));
+   Mock::VerifyAndClearExpectations(resolver_call_mock);
+
+   /**
+    * <b>scenario</b>: Negative TTL expired.<br>
+    * <b>expected</b>: Resolution repeated.<br>
+    * ************************************************
+    */
+   std::this_thread::sleep_for(std::chrono::milliseconds(150));
+   EXPECT_CALL(*resolver_call_mock, getaddrinfo(StrEq("unknown.host"),_,_,_)).WillOnce(Return(EAI_AGAIN));
+   EXPECT_FALSE(resolver.resolve("unknown.host", 2222, std::chrono::seconds(5), addresses));
+}
+
+/**
+ * @test Tests of slow name resolution
+ */
+TEST_F(HostResolverFixture, slow_dns_tests)
+{
+   HostResolver resolver;
+   std::vector<HostAddress> addresses;
+   std::mutex mtx;
+   std::condition_variable cv;
+   bool resolved = false;
+   /**
+    * <b>scenario</b>: DNS server does not answer within timeout.<br>
+    * <b>expected</b>: Caller not blocked longer than timeout.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*resolver_call_mock, getaddrinfo(StrEq("localhost"),_,_,_))
+         .WillOnce(Invoke([&](const char* node, const char* service, const struct addrinfo* hints, struct addrinfo** res)->int
+         {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            int result = ::getaddrinfo(node, service, hints, res);
+            std::lock_guard<std::mutex> lock (mtx);
+            resolved = true;
+            cv.notify_all();
+            return result;
+         }));
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   EXPECT_FALSE(resolver.resolve("localhost", 2222, std::chrono::milliseconds(20), addresses));
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(200));
+
+   /**
+    * <b>scenario</b>: Host requested again while resolution is in progress.<br>
+    * <b>expected</b>: Resolution not repeated.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(resolver.resolve("localhost", 2222, std::chrono::milliseconds(0), addresses));
+
+   /**
+    * <b>scenario</b>: Resolution finished in background.<br>
+    * <b>expected</b>: Next request served from cache immediately.<br>
+    * ************************************************
+    */
+   {
+      std::unique_lock<std::mutex> lock (mtx);
+      ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&](){ return resolved; }));
+   }
+   EXPECT_TRUE(resolver.resolve("localhost", 2222, std::chrono::seconds(5), addresses));
+}
+
+/**
+ * @test Tests of resolution without waiting
+ */
+TEST_F(HostResolverFixture, try_resolve_tests)
+{
+   HostResolver resolver;
+   std::vector<HostAddress> addresses;
+   std::mutex mtx;
+   std::condition_variable cv;
+   bool dns_answered = false;
+   /**
+    * <b>scenario</b>: Unknown host requested, DNS server does not answer yet.<br>
+    * <b>expected</b>: Resolution pending, caller not blocked.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*resolver_call_mock, getaddrinfo(StrEq("localhost"),_,_,_))
+         .WillOnce(Invoke([&](const char* node, const char* service, const struct addrinfo* hints, struct addrinfo** res)->int
+         {
+            std::unique_lock<std::mutex> lock (mtx);
+            cv.wait_for(lock, std::chrono::seconds(5), [&](){ return dns_answered; });
+            return ::getaddrinfo(node, service, hints, res);
+         }));
+   EXPECT_EQ(resolver.tryResolve("localhost", 2222, addresses), ResolveState::PENDING);
+   EXPECT_TRUE(addresses.empty());
+
+   /**
+    * <b>scenario</b>: DNS server answered.<br>
+    * <b>expected</b>: Addresses returned with requested port.<br>
+    * ************************************************
+    */
+   {
+      std::lock_guard<std::mutex> lock (mtx);
+      dns_answered = true;
+      cv.notify_all();
+   }
+   EXPECT_TRUE(resolver.resolve("localhost", 2222, std::chrono::seconds(5), addresses));
+   EXPECT_EQ(resolver.tryResolve("localhost", 1111, addresses), ResolveState::RESOLVED);
+   ASSERT_FALSE(addresses.empty());
+   EXPECT_THAT(to_string(addresses[0]), AnyOf("127.0.0.1:1111", "::1:1111"));
+
+   /**
+    * <b>scenario</b>: Host cannot be resolved.<br>
+    * <b>expected</b>: Failure reported after resolution.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*resolver_call_mock, getaddrinfo(StrEq("www.test.pl"),_,_,_)).WillOnce(Return(EAI_NONAME));
+   EXPECT_FALSE(resolver.resolve("www.test.pl", 2222, std::chrono::seconds(5), addresses));
+   EXPECT_EQ(resolver.tryResolve("www.test.pl", 2222, addresses), ResolveState::FAILED);
+   EXPECT_TRUE(addresses.empty());
+}
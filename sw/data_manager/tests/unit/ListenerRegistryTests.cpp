@@ -0,0 +1,245 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "ListenerRegistry.h"
+#include <thread>
+#include <condition_variable>
+/* ============================= */
+/**
+ * @file ListenerRegistryTests.cpp
+ *
+ * @brief Unit tests to verify behavior of ListenerRegistry.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+struct ListenerMock : public SocketListener
+{
+   MOCK_METHOD3(onSocketEvent, void(DriverEvent, const std::vector<uint8_t>&, size_t));
+};
+
+/* counts notifications, reports calls after removal */
+struct CountingListener : public SocketListener
+{
+   CountingListener() : calls(0), removed(false), calls_after_removal(0) {}
+   void onSocketEvent(DriverEvent, const std::vector<uint8_t>&, size_t) override
+   {
+      calls++;
+      if (removed)
+      {
+         calls_after_removal++;
+      }
+   }
+   std::atomic<uint32_t> calls;
+   std::atomic<bool> removed;
+   std::atomic<uint32_t> calls_after_removal;
+};
+
+void notify(ListenerRegistry& registry, DriverEvent ev)
+{
+   registry.forEach([&](SocketListener* l){ l->onSocketEvent(ev, {}, 0); });
+}
+
+/**
+ * @test Tests of adding and removing listeners
+ */
+TEST(ListenerRegistryTests, add_remove_tests)
+{
+   ListenerRegistry registry;
+   ListenerMock first;
+   ListenerMock second;
+   /**
+    * <b>scenario</b>: Two listeners added, one of them twice.<br>
+    * <b>expected</b>: Each listener notified once.<br>
+    * ************************************************
+    */
+   registry.add(&first);
+   registry.add(&second);
+   registry.add(&first);
+   EXPECT_EQ(registry.size(), 2);
+   EXPECT_CALL(first, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   EXPECT_CALL(second, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   notify(registry, DriverEvent::DRIVER_CONNECTED);
+
+   /**
+    * <b>scenario</b>: Listener removed.<br>
+    * <b>expected</b>: Only remaining listener notified.<br>
+    * ************************************************
+    */
+   registry.remove(&first);
+   EXPECT_EQ(registry.size(), 1);
+   EXPECT_CALL(first, onSocketEvent(_,_,_)).Times(0);
+   EXPECT_CALL(second, onSocketEvent(DriverEvent::DRIVER_DISCONNECTED,_,_));
+   notify(registry, DriverEvent::DRIVER_DISCONNECTED);
+
+   /**
+    * <b>scenario</b>: Not registered listener removed.<br>
+    * <b>expected</b>: List not changed.<br>
+    * ************************************************
+    */
+   registry.remove(&first);
+   EXPECT_EQ(registry.size(), 1);
+}
+
+/**
+ * @test Tests of changing listeners from listener callback
+ */
+TEST(ListenerRegistryTests, modify_from_callback_tests)
+{
+   ListenerRegistry registry;
+   ListenerMock first;
+   ListenerMock second;
+   registry.add(&first);
+   /**
+    * <b>scenario</b>: Listener removes itself and adds other listener during notification.<br>
+    * <b>expected</b>: No deadlock, notification in progress not affected, changes visible in next notification.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(first, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_)).WillOnce(Invoke([&](DriverEvent, const std::vector<uint8_t>&, size_t)
+         {
+            registry.remove(&first);
+            registry.add(&second);
+         }));
+   EXPECT_CALL(second, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_)).Times(0);
+   notify(registry, DriverEvent::DRIVER_CONNECTED);
+
+   EXPECT_CALL(second, onSocketEvent(DriverEvent::DRIVER_DISCONNECTED,_,_));
+   notify(registry, DriverEvent::DRIVER_DISCONNECTED);
+}
+
+/**
+ * @test Tests of waiting for notifications in progress
+ */
+TEST(ListenerRegistryTests, remove_wait_tests)
+{
+   ListenerRegistry registry;
+   ListenerRegistry other_registry;
+   ListenerMock first;
+   ListenerMock second;
+   ListenerMock other;
+   std::mutex mtx;
+   std::condition_variable cv;
+   bool notifying = false;
+   bool released = false;
+   std::atomic<bool> notified (false);
+   auto slow_callback = [&](DriverEvent, const std::vector<uint8_t>&, size_t)
+   {
+      std::unique_lock<std::mutex> lock (mtx);
+      notifying = true;
+      cv.notify_all();
+      cv.wait(lock, [&](){ return released; });
+      notified = true;
+   };
+   auto wait_notifying = [&]()
+   {
+      std::unique_lock<std::mutex> lock (mtx);
+      return cv.wait_for(lock, std::chrono::seconds(1), [&](){ return notifying; });
+   };
+   auto release = [&]()
+   {
+      std::lock_guard<std::mutex> lock (mtx);
+      released = true;
+      cv.notify_all();
+   };
+   registry.add(&first);
+   /**
+    * <b>scenario</b>: Listener removed during slow notification, other listener added meanwhile.<br>
+    * <b>expected</b>: Removal waits for the notification, adding listener is not blocked by it.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(first, onSocketEvent(_,_,_)).WillOnce(Invoke(slow_callback));
+   std::thread notifier ([&](){ notify(registry, DriverEvent::DRIVER_DATA_RECV); });
+   ASSERT_TRUE(wait_notifying());
+   std::atomic<bool> removed (false);
+   std::thread remover ([&](){ registry.remove(&first); removed = true; });
+   std::this_thread::sleep_for(std::chrono::milliseconds(20));
+   registry.add(&second);
+   EXPECT_EQ(registry.size(), 1);
+   EXPECT_FALSE(removed);
+   release();
+   remover.join();
+   notifier.join();
+   EXPECT_TRUE(removed);
+   EXPECT_TRUE(notified);
+
+   /**
+    * <b>scenario</b>: Listener of other registry removed from listener callback during its slow notification.<br>
+    * <b>expected</b>: Removal waits for the notification of other registry.<br>
+    * ************************************************
+    */
+   notifying = false;
+   released = false;
+   notified = false;
+   other_registry.add(&other);
+   EXPECT_CALL(other, onSocketEvent(_,_,_)).WillOnce(Invoke(slow_callback));
+   notifier = std::thread([&](){ notify(other_registry, DriverEvent::DRIVER_DATA_RECV); });
+   ASSERT_TRUE(wait_notifying());
+   std::thread releaser ([&](){ std::this_thread::sleep_for(std::chrono::milliseconds(20)); release(); });
+   EXPECT_CALL(second, onSocketEvent(_,_,_)).WillOnce(Invoke([&](DriverEvent, const std::vector<uint8_t>&, size_t)
+         {
+            other_registry.remove(&other);
+            EXPECT_TRUE(notified);
+         }));
+   notify(registry, DriverEvent::DRIVER_DATA_RECV);
+   releaser.join();
+   notifier.join();
+   EXPECT_EQ(other_registry.size(), 0);
+}
+
+/**
+ * @test Tests of changing listeners during notifications from other thread
+ */
+TEST(ListenerRegistryTests, concurrent_modification_tests)
+{
+   const uint32_t ITERATIONS = 200;
+   const uint8_t LISTENERS_COUNT = 4;
+   ListenerRegistry registry;
+   CountingListener permanent;
+   std::atomic<bool> running (true);
+   registry.add(&permanent);
+   /**
+    * <b>scenario</b>: Notifications sent in loop, other threads keep adding and removing own listeners.<br>
+    * <b>expected</b>: Listener never called after removal, permanent listener receives all notifications.<br>
+    * ************************************************
+    */
+   uint32_t notifications = 0;
+   std::thread notifier ([&]()
+         {
+            while (running)
+            {
+               notify(registry, DriverEvent::DRIVER_DATA_RECV);
+               notifications++;
+            }
+         });
+   std::vector<std::thread> modifiers;
+   std::atomic<uint32_t> errors (0);
+   for (uint8_t i = 0; i < LISTENERS_COUNT; i++)
+   {
+      modifiers.emplace_back([&]()
+            {
+               for (uint32_t j = 0; j < ITERATIONS; j++)
+               {
+                  CountingListener listener;
+                  registry.add(&listener);
+                  std::this_thread::yield();
+                  registry.remove(&listener);
+                  listener.removed = true;
+                  std::this_thread::yield();
+                  errors += listener.calls_after_removal;
+               }
+            });
+   }
+   for (auto& modifier : modifiers)
+   {
+      modifier.join();
+   }
+   running = false;
+   notifier.join();
+   EXPECT_EQ(errors, 0);
+   EXPECT_EQ(registry.size(), 1);
+   EXPECT_EQ(permanent.calls, notifications);
+}
@@ -0,0 +1,165 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "LoadGenerator.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <thread>
+/* ============================= */
+/**
+ * @file LoadGeneratorTests.cpp
+ *
+ * @brief Unit tests to verify behavior of LoadGenerator.
+ *
+ * @details Tests are using real TCP connection over loopback, client side is read by the test.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+struct LoadGeneratorFixture : public testing::Test
+{
+   void SetUp()
+   {
+      ASSERT_TRUE(connectLoopback(m_sockets));
+   }
+   /* creates connected TCP sockets, acknowledged bytes are reported only by TCP */
+   bool connectLoopback(int* sockets, int buffer_size = 0)
+   {
+      struct sockaddr_in address = {};
+      socklen_t address_len = sizeof(address);
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+      bool result = bind(listen_fd, (struct sockaddr*)&address, sizeof(address)) == 0 && listen(listen_fd, 1) == 0 &&
+                    getsockname(listen_fd, (struct sockaddr*)&address, &address_len) == 0;
+      sockets[1] = socket(AF_INET, SOCK_STREAM, 0);
+      if (buffer_size)
+      {
+         /* receive window is negotiated on connection */
+         setsockopt(sockets[1], SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+      }
+      result = result && connect(sockets[1], (struct sockaddr*)&address, sizeof(address)) == 0;
+      sockets[0] = result? accept(listen_fd, nullptr, nullptr) : -1;
+      if (buffer_size && sockets[0] >= 0)
+      {
+         setsockopt(sockets[0], SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+      }
+      close(listen_fd);
+      return result && sockets[0] >= 0;
+   }
+   void TearDown()
+   {
+      close(m_sockets[0]);
+      if (m_sockets[1] >= 0)
+      {
+         close(m_sockets[1]);
+      }
+   }
+   /* reads all data available on client side */
+   std::vector<uint8_t> readClient()
+   {
+      std::vector<uint8_t> result;
+      uint8_t buffer [4096];
+      ssize_t received = 0;
+      while ((received = recv(m_sockets[1], buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+      {
+         result.insert(result.end(), buffer, buffer + received);
+      }
+      return result;
+   }
+   int m_sockets[2];
+};
+
+/**
+ * @test Tests of sending frames with configured rate
+ */
+TEST_F(LoadGeneratorFixture, rate_tests)
+{
+   /**
+    * <b>scenario</b>: 200 frames per second in bursts of 4 for 100 ms, quarter of frames malformed.<br>
+    * <b>expected</b>: About 20 frames sent and received by client, all frame types used, nothing dropped.<br>
+    * ************************************************
+    */
+   LoadGenerator generator ({200, 4, 25, std::chrono::milliseconds(100), FramingMode::DELIMITER, '\n', 1});
+   std::vector<uint64_t> progress;
+   LoadReport report = generator.run(m_sockets[0], [&](const LoadReport& r){ progress.push_back(r.totalSent()); });
+   std::vector<uint8_t> received = readClient();
+
+   EXPECT_FALSE(report.peer_closed);
+   EXPECT_THAT(report.totalSent(), AllOf(Ge(8), Le(24)));
+   EXPECT_EQ(report.totalSent() % 4, 0);
+   EXPECT_GT(report.frames_sent[static_cast<size_t>(NtfFrameKind::INPUTS_STATE)], 0);
+   EXPECT_GT(report.frames_sent[static_cast<size_t>(NtfFrameKind::ENV_SENSOR_DATA)], 0);
+   EXPECT_GT(report.frames_sent[static_cast<size_t>(NtfFrameKind::FAN_STATE)], 0);
+   EXPECT_THAT(report.malformed_sent, AllOf(Gt(0), Lt(report.totalSent())));
+   EXPECT_EQ(report.frames_dropped, 0);
+   EXPECT_EQ(report.bytes_sent, received.size());
+   EXPECT_EQ(report.bytes_acknowledged, report.bytes_sent);
+   EXPECT_EQ((uint64_t)std::count(received.begin(), received.end(), '\n'), report.totalSent());
+   EXPECT_TRUE(progress.empty());
+}
+
+/**
+ * @test Tests of client which does not keep up
+ */
+TEST_F(LoadGeneratorFixture, saturation_tests)
+{
+   /**
+    * <b>scenario</b>: Frames sent as fast as possible, client does not read.<br>
+    * <b>expected</b>: Frames dropped when socket buffer is full, only complete frames written.<br>
+    * ************************************************
+    */
+   close(m_sockets[0]);
+   close(m_sockets[1]);
+   ASSERT_TRUE(connectLoopback(m_sockets, 4096));
+   LoadGenerator generator ({0, 16, 0, std::chrono::milliseconds(50), FramingMode::DELIMITER, '\n', 1});
+   LoadReport report = generator.run(m_sockets[0]);
+   EXPECT_GT(report.frames_dropped, 0);
+   EXPECT_LT(report.bytes_acknowledged, report.bytes_sent);
+   std::vector<uint8_t> received = readClient();
+   EXPECT_EQ(report.bytes_sent, received.size());
+   ASSERT_FALSE(received.empty());
+   EXPECT_EQ(received.back(), '\n');
+   EXPECT_EQ((uint64_t)std::count(received.begin(), received.end(), '\n'), report.totalSent());
+}
+
+/**
+ * @test Tests of finishing the test before its time
+ */
+TEST_F(LoadGeneratorFixture, stop_tests)
+{
+   /**
+    * <b>scenario</b>: Client closed the connection.<br>
+    * <b>expected</b>: Test finished immediately, reported in results.<br>
+    * ************************************************
+    */
+   LoadGenerator generator ({100, 1, 0, std::chrono::seconds(30), FramingMode::DELIMITER, '\n', 1});
+   close(m_sockets[1]);
+   m_sockets[1] = -1;
+   auto start = std::chrono::steady_clock::now();
+   LoadReport report = generator.run(m_sockets[0]);
+   EXPECT_TRUE(report.peer_closed);
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+
+   /**
+    * <b>scenario</b>: Stop requested from other thread.<br>
+    * <b>expected</b>: Test finished before its time.<br>
+    * ************************************************
+    */
+   int sockets[2];
+   ASSERT_TRUE(connectLoopback(sockets));
+   start = std::chrono::steady_clock::now();
+   std::thread stopper ([&](){ std::this_thread::sleep_for(std::chrono::milliseconds(20)); generator.stop(); });
+   report = generator.run(sockets[0]);
+   stopper.join();
+   EXPECT_FALSE(report.peer_closed);
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+   close(sockets[0]);
+   close(sockets[1]);
+}
@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "NtfFrameFactory.h"
+#include "Cobs.h"
+/* ============================= */
+/**
+ * @file NtfFrameFactoryTests.cpp
+ *
+ * @brief Unit tests to verify frames generated by NtfFrameFactory.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+/**
+ * @test Tests of frames with delimiter
+ */
+TEST(NtfFrameFactoryTests, delimiter_framing_tests)
+{
+   NtfFrameFactory factory (FramingMode::DELIMITER, '\n', 1);
+   std::vector<uint8_t> buffer;
+   /**
+    * <b>scenario</b>: Three valid frames generated.<br>
+    * <b>expected</b>: Inputs, env and fan notifications, byte count equal to payload size, delimiter appended.<br>
+    * ************************************************
+    */
+   EXPECT_EQ(factory.append(false, buffer), NtfFrameKind::INPUTS_STATE);
+   ASSERT_EQ(buffer.size(), NTF_HEADER_SIZE + NTF_INPUTS_STATE_PAYLOAD_SIZE + 1);
+   EXPECT_EQ(buffer[NTF_ID_OFFSET], NTF_INPUTS_STATE);
+   EXPECT_EQ(buffer[NTF_REQ_TYPE_OFFSET], NTF_NTF);
+   EXPECT_EQ(buffer[NTF_BYTES_COUNT_OFFSET], NTF_INPUTS_STATE_PAYLOAD_SIZE);
+   EXPECT_EQ(buffer.back(), '\n');
+   buffer.clear();
+
+   EXPECT_EQ(factory.append(false, buffer), NtfFrameKind::ENV_SENSOR_DATA);
+   ASSERT_EQ(buffer.size(), NTF_HEADER_SIZE + NTF_ENV_SENSOR_DATA_PAYLOAD_SIZE + 1);
+   EXPECT_EQ(buffer[NTF_ID_OFFSET], NTF_ENV_SENSOR_DATA);
+   EXPECT_EQ(buffer[NTF_BYTES_COUNT_OFFSET], NTF_ENV_SENSOR_DATA_PAYLOAD_SIZE);
+   buffer.clear();
+
+   EXPECT_EQ(factory.append(false, buffer), NtfFrameKind::FAN_STATE);
+   ASSERT_EQ(buffer.size(), NTF_HEADER_SIZE + NTF_FAN_STATE_PAYLOAD_SIZE + 1);
+   EXPECT_EQ(buffer[NTF_ID_OFFSET], NTF_FAN_STATE);
+   EXPECT_EQ(buffer[NTF_BYTES_COUNT_OFFSET], NTF_FAN_STATE_PAYLOAD_SIZE);
+   buffer.clear();
+
+   /**
+    * <b>scenario</b>: Malformed frame generated.<br>
+    * <b>expected</b>: Byte count in header does not match the payload.<br>
+    * ************************************************
+    */
+   EXPECT_EQ(factory.append(true, buffer), NtfFrameKind::INPUTS_STATE);
+   ASSERT_EQ(buffer.size(), NTF_HEADER_SIZE + NTF_INPUTS_STATE_PAYLOAD_SIZE + 1);
+   EXPECT_EQ(buffer[NTF_BYTES_COUNT_OFFSET], NTF_INPUTS_STATE_PAYLOAD_SIZE + 1);
+   buffer.clear();
+
+   /**
+    * <b>scenario</b>: Many frames generated.<br>
+    * <b>expected</b>: Delimiter appears only at the end of each frame.<br>
+    * ************************************************
+    */
+   size_t frames = 0;
+   for (size_t i = 0; i < 3000; i++)
+   {
+      factory.append(false, buffer);
+   }
+   for (size_t i = 0; i < buffer.size(); i += NTF_HEADER_SIZE + buffer[i + NTF_BYTES_COUNT_OFFSET] + 1)
+   {
+      const size_t end = i + NTF_HEADER_SIZE + buffer[i + NTF_BYTES_COUNT_OFFSET];
+      ASSERT_LT(end, buffer.size());
+      EXPECT_EQ(std::find(buffer.begin() + i, buffer.begin() + end, '\n'), buffer.begin() + end);
+      EXPECT_EQ(buffer[end], '\n');
+      frames++;
+   }
+   EXPECT_EQ(frames, 3000);
+}
+
+/**
+ * @test Tests of COBS encoded frames
+ */
+TEST(NtfFrameFactoryTests, cobs_framing_tests)
+{
+   NtfFrameFactory factory (FramingMode::COBS, '\n', 1);
+   NtfFrameFactory reference (FramingMode::DELIMITER, '\n', 1);
+   /**
+    * <b>scenario</b>: Frame generated with the same seed in COBS and delimiter mode.<br>
+    * <b>expected</b>: COBS frame terminated by zero byte, decoded frame contains the same header.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> buffer;
+   std::vector<uint8_t> reference_buffer;
+   factory.append(false, buffer);
+   reference.append(false, reference_buffer);
+   ASSERT_FALSE(buffer.empty());
+   EXPECT_EQ(buffer.back(), COBS_DELIMITER);
+   EXPECT_EQ(std::count(buffer.begin(), buffer.end(), COBS_DELIMITER), 1);
+   size_t decoded_size = 0;
+   ASSERT_TRUE(cobs::decode(buffer.data(), buffer.size() - 1, decoded_size));
+   ASSERT_EQ(decoded_size, NTF_HEADER_SIZE + NTF_INPUTS_STATE_PAYLOAD_SIZE);
+   EXPECT_THAT(std::vector<uint8_t>(buffer.begin(), buffer.begin() + NTF_HEADER_SIZE),
+               ElementsAreArray(reference_buffer.data(), NTF_HEADER_SIZE));
+}
@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "ReconnectPolicy.h"
+/* ============================= */
+/**
+ * @file ReconnectPolicyTests.cpp
+ *
+ * @brief Unit tests to verify behavior of ReconnectPolicy.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+using std::chrono::milliseconds;
+
+/**
+ * @test Tests of delays without jitter
+ */
+TEST(ReconnectPolicyTests, backoff_tests)
+{
+   ReconnectPolicy policy (milliseconds(100), milliseconds(1000), 0, 1);
+   /**
+    * <b>scenario</b>: Next attempts failed.<br>
+    * <b>expected</b>: Delay starts from first retry, it is doubled up to the limit.<br>
+    * ************************************************
+    */
+   EXPECT_EQ(policy.nextDelay(), milliseconds(100));
+   EXPECT_EQ(policy.nextDelay(), milliseconds(200));
+   EXPECT_EQ(policy.nextDelay(), milliseconds(400));
+   EXPECT_EQ(policy.nextDelay(), milliseconds(800));
+   EXPECT_EQ(policy.nextDelay(), milliseconds(1000));
+   EXPECT_EQ(policy.nextDelay(), milliseconds(1000));
+   EXPECT_EQ(policy.failedAttempts(), 6);
+
+   /**
+    * <b>scenario</b>: Connection established, then next attempt failed.<br>
+    * <b>expected</b>: Sequence started again.<br>
+    * ************************************************
+    */
+   policy.reset();
+   EXPECT_EQ(policy.failedAttempts(), 0);
+   EXPECT_EQ(policy.nextDelay(), milliseconds(100));
+
+   /**
+    * <b>scenario</b>: Many attempts failed.<br>
+    * <b>expected</b>: Delay does not overflow.<br>
+    * ************************************************
+    */
+   for (int i = 0; i < 1000; i++)
+   {
+      EXPECT_LE(policy.nextDelay(), milliseconds(1000));
+   }
+}
+
+/**
+ * @test Tests of jitter
+ */
+TEST(ReconnectPolicyTests, jitter_tests)
+{
+   /**
+    * <b>scenario</b>: Delays calculated with 20% jitter.<br>
+    * <b>expected</b>: Each delay shortened by up to 20%, not all delays equal.<br>
+    * ************************************************
+    */
+   ReconnectPolicy policy (milliseconds(100), milliseconds(5000), 20, 1234);
+   std::vector<milliseconds> delays;
+   for (int i = 0; i < 50; i++)
+   {
+      policy.reset();
+      delays.push_back(policy.nextDelay());
+      EXPECT_GE(delays.back(), milliseconds(80));
+      EXPECT_LE(delays.back(), milliseconds(100));
+   }
+   EXPECT_NE(std::count(delays.begin(), delays.end(), delays[0]), delays.size());
+
+   /**
+    * <b>scenario</b>: Two policies created with the same seed.<br>
+    * <b>expected</b>: Same delays returned.<br>
+    * ************************************************
+    */
+   ReconnectPolicy first (milliseconds(100), milliseconds(5000), 20, 42);
+   ReconnectPolicy second (milliseconds(100), milliseconds(5000), 20, 42);
+   for (int i = 0; i < 10; i++)
+   {
+      EXPECT_EQ(first.nextDelay(), second.nextDelay());
+   }
+}
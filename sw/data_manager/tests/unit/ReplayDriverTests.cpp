@@ -0,0 +1,303 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "ReplayDriver.h"
+#include "Cobs.h"
+#include "logger_mock.hpp"
+#include <condition_variable>
+#include <unistd.h>
+/* ============================= */
+/**
+ * @file ReplayDriverTests.cpp
+ *
+ * @brief Unit tests to verify behavior of capture replay driver.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+struct ListenerMock : public SocketListener
+{
+   MOCK_METHOD3(onSocketEvent, void(DriverEvent, const std::vector<uint8_t>&, size_t));
+};
+
+/* collects replayed frames */
+struct FrameCollector : public NiceMock<ListenerMock>
+{
+   void onSocketFrames(const FrameView* frames, size_t count) override
+   {
+      std::lock_guard<std::mutex> lock (m_mutex);
+      for (size_t i = 0; i < count; i++)
+      {
+         m_frames.push_back(std::string((const char*)frames[i].data, frames[i].size));
+      }
+   }
+   std::mutex m_mutex;
+   std::vector<std::string> m_frames;
+};
+
+struct ReplayDriverFixture : public testing::Test
+{
+   void SetUp()
+   {
+      mock_logger_init();
+      m_path = "/tmp/smarthome_replay_test_" + std::to_string(getpid());
+      ON_CALL(listener, onSocketEvent(DriverEvent::DRIVER_DISCONNECTED, _, _)).WillByDefault(Invoke([&](DriverEvent, const std::vector<uint8_t>&, size_t)
+            {
+               std::lock_guard<std::mutex> lock (m_mutex);
+               m_finished = true;
+               m_cv.notify_all();
+            }));
+   }
+   void TearDown()
+   {
+      unlink(m_path.c_str());
+      mock_logger_deinit();
+   }
+   /* writes capture with given chunks, chunks are captured with given interval */
+   void writeCapture(const std::vector<std::string>& chunks, uint64_t interval_ns = 1000)
+   {
+      CaptureWriter writer;
+      ASSERT_TRUE(writer.create(m_path));
+      for (size_t i = 0; i < chunks.size(); i++)
+      {
+         ASSERT_TRUE(writer.append((const uint8_t*)chunks[i].data(), chunks[i].size(), 5000 + i * interval_ns));
+      }
+   }
+   /* starts replay and waits until whole capture is delivered */
+   bool replay(ISocketDriver& driver)
+   {
+      driver.addListener(&listener);
+      m_finished = false;
+      bool result = driver.connect(m_path, 0);
+      std::unique_lock<std::mutex> lock (m_mutex);
+      result = result && m_cv.wait_for(lock, std::chrono::seconds(5), [&](){ return m_finished; });
+      driver.removeListener(&listener);
+      return result;
+   }
+   std::string m_path;
+   std::mutex m_mutex;
+   std::condition_variable m_cv;
+   bool m_finished = false;
+   FrameCollector listener;
+};
+
+/**
+ * @test Tests of connection to capture file
+ */
+TEST_F(ReplayDriverFixture, connect_tests)
+{
+   ReplayDriver driver (REPLAY_SPEED_MAX);
+   ISocketDriver& test_subject = driver;
+   /**
+    * <b>scenario</b>: Capture file does not exist.<br>
+    * <b>expected</b>: Driver not connected.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(test_subject.connect(m_path, 0));
+   EXPECT_FALSE(test_subject.isConnected());
+   EXPECT_EQ(test_subject.connectAny({{m_path, 0}}), -1);
+
+   /**
+    * <b>scenario</b>: Capture replayed to the end.<br>
+    * <b>expected</b>: Connected and disconnected events reported, data written to driver is dropped.<br>
+    * ************************************************
+    */
+   writeCapture({"a\n"});
+   EXPECT_CALL(listener, onSocketEvent(DriverEvent::DRIVER_CONNECTED, _, _));
+   EXPECT_CALL(listener, onSocketEvent(DriverEvent::DRIVER_DISCONNECTED, _, _));
+   EXPECT_TRUE(replay(test_subject));
+   EXPECT_FALSE(test_subject.isConnected());
+   EXPECT_FALSE(test_subject.write({'x'}));
+   Mock::VerifyAndClearExpectations(&listener);
+
+   /**
+    * <b>scenario</b>: Capture replayed again using connectAny.<br>
+    * <b>expected</b>: Replay started from the beginning.<br>
+    * ************************************************
+    */
+   test_subject.addListener(&listener);
+   EXPECT_EQ(test_subject.connectAny({{"/not/existing", 0}, {m_path, 0}}), 1);
+   EXPECT_TRUE(test_subject.write({'x'}));
+   EXPECT_TRUE(test_subject.disconnect());
+   EXPECT_FALSE(test_subject.isConnected());
+   test_subject.removeListener(&listener);
+   SocketDriverStats stats = test_subject.getStats();
+   EXPECT_EQ(stats.bytes_sent, 1);
+   EXPECT_EQ(stats.reconnects, 1);
+}
+
+/**
+ * @test Tests of replaying stream with delimited frames
+ */
+TEST_F(ReplayDriverFixture, delimiter_tests)
+{
+   ReplayDriver driver (REPLAY_SPEED_MAX);
+   ISocketDriver& test_subject = driver;
+   /**
+    * <b>scenario</b>: Frames split between captured chunks, delimiter changed.<br>
+    * <b>expected</b>: Frames delivered as received by SocketDriver.<br>
+    * ************************************************
+    */
+   test_subject.setDelimiter(';');
+   writeCapture({"first;sec", "ond;", "third;fo"});
+   ASSERT_TRUE(replay(test_subject));
+   EXPECT_THAT(listener.m_frames, ElementsAre("first", "second", "third"));
+   SocketDriverStats stats = test_subject.getStats();
+   EXPECT_EQ(stats.bytes_received, 21);
+   EXPECT_EQ(stats.frames_delivered, 3);
+
+   /**
+    * <b>scenario</b>: Frames encoded with COBS.<br>
+    * <b>expected</b>: Frames decoded, payload with delimiter bytes delivered.<br>
+    * ************************************************
+    */
+   const std::vector<uint8_t> payload = {0x01, 0x00, 0x0A, 0x00};
+   std::vector<uint8_t> encoded (payload.size() + COBS_MAX_OVERHEAD(payload.size()));
+   encoded.resize(cobs::encode(payload.data(), payload.size(), encoded.data()));
+   encoded.push_back(COBS_DELIMITER);
+   const std::string frame (encoded.begin(), encoded.end());
+   listener.m_frames.clear();
+   test_subject.setFraming(FramingMode::COBS);
+   writeCapture({frame.substr(0, 2), frame.substr(2) + frame});
+   ASSERT_TRUE(replay(test_subject));
+   const std::string expected (payload.begin(), payload.end());
+   EXPECT_THAT(listener.m_frames, ElementsAre(expected, expected));
+}
+
+/**
+ * @test Tests of replaying stream with length prefixed frames
+ */
+TEST_F(ReplayDriverFixture, length_prefixed_tests)
+{
+   ReplayDriver driver (REPLAY_SPEED_MAX);
+   ISocketDriver& test_subject = driver;
+   test_subject.setDelimiter('\n');
+   test_subject.setFraming(FramingMode::LENGTH_PREFIXED);
+   test_subject.setFrameLayout({2, 1, 1, 8});
+   /**
+    * <b>scenario</b>: Valid frames, too long frame and frame with invalid trailer captured.<br>
+    * <b>expected</b>: Valid frames delivered, invalid dropped.<br>
+    * ************************************************
+    */
+   const std::string first ("\x01\x02" "ab" "\n", 5);
+   const std::string invalid ("\x01\x01" "a" "x" "\n", 5);
+   const std::string too_long ("\x01\x09" "123456789" "\n", 12);
+   const std::string last ("\x01\x01" "z" "\n", 4);
+   writeCapture({first.substr(0, 3), first.substr(3) + too_long, invalid + last});
+   ASSERT_TRUE(replay(test_subject));
+   EXPECT_THAT(listener.m_frames, ElementsAre(std::string("\x01\x02" "ab", 4), std::string("\x01\x01" "z", 3)));
+   EXPECT_EQ(test_subject.getStats().frames_dropped, 2);
+}
+
+/**
+ * @test Tests of length prefixed replay without valid frame layout
+ */
+TEST_F(ReplayDriverFixture, length_prefixed_layout_tests)
+{
+   ReplayDriver driver (REPLAY_SPEED_MAX);
+   ISocketDriver& test_subject = driver;
+   test_subject.setDelimiter('\n');
+   test_subject.setFraming(FramingMode::LENGTH_PREFIXED);
+   /**
+    * <b>scenario</b>: Capture with zero length byte replayed with default layout.<br>
+    * <b>expected</b>: Replay finishes, no frames delivered.<br>
+    * ************************************************
+    */
+   writeCapture({std::string("\x01\x00\x00" "\n", 4)});
+   ASSERT_TRUE(replay(test_subject));
+   EXPECT_TRUE(listener.m_frames.empty());
+
+   /**
+    * <b>scenario</b>: Layout with length byte outside of header set before replay.<br>
+    * <b>expected</b>: Layout rejected, no frames delivered.<br>
+    * ************************************************
+    */
+   test_subject.setFrameLayout({2, 2, 1, 8});
+   ASSERT_TRUE(replay(test_subject));
+   EXPECT_TRUE(listener.m_frames.empty());
+}
+
+/**
+ * @test Tests of replay speed
+ */
+TEST_F(ReplayDriverFixture, speed_tests)
+{
+   const uint64_t INTERVAL_NS = 100 * 1000 * 1000;
+   writeCapture({"a\n", "b\n", "c\n"}, INTERVAL_NS);
+   /**
+    * <b>scenario</b>: Capture replayed with original timing.<br>
+    * <b>expected</b>: Replay lasts as long as capture.<br>
+    * ************************************************
+    */
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   {
+      ReplayDriver driver (1.0);
+      ASSERT_TRUE(replay(driver));
+   }
+   EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::nanoseconds(2 * INTERVAL_NS));
+
+   /**
+    * <b>scenario</b>: Capture replayed twice as fast.<br>
+    * <b>expected</b>: Replay lasts half of capture time.<br>
+    * ************************************************
+    */
+   start = std::chrono::steady_clock::now();
+   {
+      ReplayDriver driver (2.0);
+      ASSERT_TRUE(replay(driver));
+   }
+   EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::nanoseconds(INTERVAL_NS));
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::nanoseconds(2 * INTERVAL_NS));
+
+   /**
+    * <b>scenario</b>: Capture replayed without delays.<br>
+    * <b>expected</b>: All frames delivered immediately.<br>
+    * ************************************************
+    */
+   listener.m_frames.clear();
+   start = std::chrono::steady_clock::now();
+   {
+      ReplayDriver driver (REPLAY_SPEED_MAX);
+      ASSERT_TRUE(replay(driver));
+   }
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::nanoseconds(INTERVAL_NS));
+   EXPECT_THAT(listener.m_frames, ElementsAre("a", "b", "c"));
+}
+
+/**
+ * @test Tests of stopping replay in progress
+ */
+TEST_F(ReplayDriverFixture, disconnect_tests)
+{
+   /**
+    * <b>scenario</b>: Driver disconnected while waiting for next chunk.<br>
+    * <b>expected</b>: Replay stopped immediately, disconnected event not reported.<br>
+    * ************************************************
+    */
+   writeCapture({"a\n", "b\n"}, 10ULL * 1000 * 1000 * 1000);
+   ReplayDriver driver (1.0);
+   ISocketDriver& test_subject = driver;
+   test_subject.addListener(&listener);
+   EXPECT_CALL(listener, onSocketEvent(DriverEvent::DRIVER_CONNECTED, _, _));
+   EXPECT_CALL(listener, onSocketEvent(DriverEvent::DRIVER_DISCONNECTED, _, _)).Times(0);
+   ASSERT_TRUE(test_subject.connect(m_path, 0));
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   auto first_delivered = [&]()
+   {
+      std::lock_guard<std::mutex> lock (listener.m_mutex);
+      return !listener.m_frames.empty();
+   };
+   while (!first_delivered() && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+   {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+   EXPECT_TRUE(test_subject.disconnect());
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+   EXPECT_FALSE(test_subject.isConnected());
+   EXPECT_THAT(listener.m_frames, ElementsAre("a"));
+   test_subject.removeListener(&listener);
+}
@@ -0,0 +1,203 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "ShmChannel.h"
+#include "logger_mock.hpp"
+#include <thread>
+#include <unistd.h>
+/* ============================= */
+/**
+ * @file ShmChannelTests.cpp
+ *
+ * @brief Unit tests to verify behavior of ShmChannel.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+struct ShmChannelFixture : public testing::Test
+{
+   void SetUp()
+   {
+      mock_logger_init();
+      m_name = "/smarthome_test_" + std::to_string(getpid());
+   }
+   void TearDown()
+   {
+      mock_logger_deinit();
+   }
+   std::string m_name;
+};
+
+/**
+ * @test Tests of opening the channel
+ */
+TEST_F(ShmChannelFixture, open_close_tests)
+{
+   ShmChannel server;
+   ShmChannel client;
+   ShmChannel other_client;
+   /**
+    * <b>scenario</b>: Server not started.<br>
+    * <b>expected</b>: Client cannot open the channel.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(client.open(m_name));
+   EXPECT_FALSE(client.isOpen());
+
+   /**
+    * <b>scenario</b>: Server started, two clients try to connect.<br>
+    * <b>expected</b>: Only first client connected.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(server.create(m_name));
+   EXPECT_FALSE(server.isPeerAlive());
+   EXPECT_TRUE(client.open(m_name));
+   EXPECT_TRUE(client.isOpen());
+   EXPECT_TRUE(client.isPeerAlive());
+   EXPECT_TRUE(server.isPeerAlive());
+   EXPECT_FALSE(other_client.open(m_name));
+
+   /**
+    * <b>scenario</b>: Client closed.<br>
+    * <b>expected</b>: Server notices it, next client can connect.<br>
+    * ************************************************
+    */
+   client.close();
+   EXPECT_FALSE(client.isOpen());
+   EXPECT_FALSE(server.isPeerAlive());
+   EXPECT_TRUE(other_client.open(m_name));
+
+   /**
+    * <b>scenario</b>: Server closed.<br>
+    * <b>expected</b>: Client notices it, segment removed.<br>
+    * ************************************************
+    */
+   server.close();
+   EXPECT_FALSE(other_client.isPeerAlive());
+   EXPECT_FALSE(client.open(m_name));
+}
+
+/**
+ * @test Tests of passing data in both directions
+ */
+TEST_F(ShmChannelFixture, read_write_tests)
+{
+   ShmChannel server;
+   ShmChannel client;
+   ASSERT_TRUE(server.create(m_name));
+   ASSERT_TRUE(client.open(m_name));
+   /**
+    * <b>scenario</b>: Data written by both sides.<br>
+    * <b>expected</b>: Each side reads data written by the other one.<br>
+    * ************************************************
+    */
+   const uint8_t request[] = {1, 2, 3};
+   const uint8_t response[] = {4, 5};
+   uint8_t buffer[SHM_CHANNEL_RING_SIZE];
+   EXPECT_EQ(client.write(request, sizeof(request)), sizeof(request));
+   EXPECT_EQ(server.write(response, sizeof(response)), sizeof(response));
+   EXPECT_EQ(client.unread(), 3);
+   EXPECT_EQ(server.readable(), 3);
+   EXPECT_EQ(server.read(buffer, sizeof(buffer)), 3);
+   EXPECT_THAT(std::vector<uint8_t>(buffer, buffer + 3), ElementsAre(1, 2, 3));
+   EXPECT_EQ(client.unread(), 0);
+   EXPECT_EQ(client.read(buffer, 1), 1);
+   EXPECT_EQ(client.read(buffer + 1, sizeof(buffer)), 1);
+   EXPECT_THAT(std::vector<uint8_t>(buffer, buffer + 2), ElementsAre(4, 5));
+   EXPECT_EQ(client.read(buffer, sizeof(buffer)), 0);
+
+   /**
+    * <b>scenario</b>: Ring filled up, then data wraps around the end of the ring.<br>
+    * <b>expected</b>: Only free space is written, data read in the same order.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> data (SHM_CHANNEL_RING_SIZE + 10);
+   for (size_t i = 0; i < data.size(); i++)
+   {
+      data[i] = static_cast<uint8_t>(i);
+   }
+   std::vector<uint8_t> received (data.size());
+   EXPECT_EQ(server.write(data.data(), data.size()), SHM_CHANNEL_RING_SIZE);
+   EXPECT_EQ(server.write(data.data(), 1), 0);
+   EXPECT_EQ(client.read(received.data(), 100), 100);
+   EXPECT_EQ(server.write(data.data() + SHM_CHANNEL_RING_SIZE, 10), 10);
+   EXPECT_EQ(client.read(received.data() + 100, received.size()), SHM_CHANNEL_RING_SIZE - 100 + 10);
+   EXPECT_EQ(received, data);
+}
+
+/**
+ * @test Tests of waiting for data
+ */
+TEST_F(ShmChannelFixture, wait_tests)
+{
+   ShmChannel server;
+   ShmChannel client;
+   ASSERT_TRUE(server.create(m_name));
+   ASSERT_TRUE(client.open(m_name));
+   const uint8_t data[] = {1, 2, 3};
+   /**
+    * <b>scenario</b>: Nothing written.<br>
+    * <b>expected</b>: False returned after timeout.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(client.waitReadable(std::chrono::milliseconds(10)));
+
+   /**
+    * <b>scenario</b>: Data written by other thread during wait.<br>
+    * <b>expected</b>: Waiting thread woken up.<br>
+    * ************************************************
+    */
+   auto start = std::chrono::steady_clock::now();
+   std::thread writer ([&](){ std::this_thread::sleep_for(std::chrono::milliseconds(10)); server.write(data, sizeof(data)); });
+   EXPECT_TRUE(client.waitReadable(std::chrono::seconds(10)));
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+   writer.join();
+
+   /**
+    * <b>scenario</b>: Data already available.<br>
+    * <b>expected</b>: Returned immediately.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(client.waitReadable(std::chrono::seconds(10)));
+
+   /**
+    * <b>scenario</b>: Local wakeup requested during wait for data.<br>
+    * <b>expected</b>: Waiting thread woken up, no data reported.<br>
+    * ************************************************
+    */
+   start = std::chrono::steady_clock::now();
+   std::thread waker ([&](){ std::this_thread::sleep_for(std::chrono::milliseconds(10)); server.wakeup(); });
+   EXPECT_FALSE(server.waitReadable(std::chrono::seconds(10)));
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+   waker.join();
+
+   /**
+    * <b>scenario</b>: Ring full, peer reads data during wait for space.<br>
+    * <b>expected</b>: Waiting thread woken up.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> big (SHM_CHANNEL_RING_SIZE);
+   uint8_t buffer[SHM_CHANNEL_RING_SIZE];
+   client.read(buffer, sizeof(buffer));
+   EXPECT_EQ(client.write(big.data(), big.size()), SHM_CHANNEL_RING_SIZE);
+   EXPECT_FALSE(client.waitWritable(1, std::chrono::milliseconds(10)));
+   std::thread reader ([&](){ std::this_thread::sleep_for(std::chrono::milliseconds(10)); server.read(buffer, 10); });
+   EXPECT_TRUE(client.waitWritable(10, std::chrono::seconds(10)));
+   reader.join();
+
+   /**
+    * <b>scenario</b>: Server closed during wait for data.<br>
+    * <b>expected</b>: Client woken up.<br>
+    * ************************************************
+    */
+   start = std::chrono::steady_clock::now();
+   std::thread closer ([&](){ std::this_thread::sleep_for(std::chrono::milliseconds(10)); server.close(); });
+   EXPECT_FALSE(client.waitReadable(std::chrono::seconds(10)));
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+   EXPECT_FALSE(client.isPeerAlive());
+   closer.join();
+}
@@ -0,0 +1,211 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "ShmDriver.h"
+#include "Cobs.h"
+#include "logger_mock.hpp"
+#include <condition_variable>
+#include <unistd.h>
+/* ============================= */
+/**
+ * @file ShmDriverTests.cpp
+ *
+ * @brief Unit tests to verify behavior of shared memory driver.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+struct ListenerMock : public SocketListener
+{
+   MOCK_METHOD3(onSocketEvent, void(DriverEvent, const std::vector<uint8_t>&, size_t));
+};
+
+struct ShmDriverFixture : public testing::Test
+{
+   void SetUp()
+   {
+      mock_logger_init();
+      m_name = "/smarthome_drv_test_" + std::to_string(getpid());
+      m_address = SHMDRV_SCHEME + m_name;
+      m_test_subject.reset(new ShmDriver());
+      m_test_subject->addListener(&listener_mock);
+   }
+   void TearDown()
+   {
+      m_test_subject->removeListener(&listener_mock);
+      m_test_subject.reset(nullptr);
+      mock_logger_deinit();
+   }
+   /* waits until listener is called expected number of times */
+   bool waitForEvents(uint32_t count)
+   {
+      std::unique_lock<std::mutex> lock (m_mutex);
+      return m_cv.wait_for(lock, std::chrono::seconds(5), [&](){ return m_events >= count; });
+   }
+   void countEvent()
+   {
+      std::lock_guard<std::mutex> lock (m_mutex);
+      m_events++;
+      m_cv.notify_all();
+   }
+   /* reads all data written by driver */
+   std::vector<uint8_t> readAll(ShmChannel& server)
+   {
+      std::vector<uint8_t> result (server.readable());
+      server.read(result.data(), result.size());
+      return result;
+   }
+   std::string m_name;
+   std::string m_address;
+   std::mutex m_mutex;
+   std::condition_variable m_cv;
+   uint32_t m_events = 0;
+   NiceMock<ListenerMock> listener_mock;
+   std::unique_ptr<ISocketDriver> m_test_subject;
+};
+
+/**
+ * @test Tests of connection and disconnection
+ */
+TEST_F(ShmDriverFixture, connect_disconnect_tests)
+{
+   ShmChannel server;
+   /**
+    * <b>scenario</b>: Address without shared memory scheme.<br>
+    * <b>expected</b>: Connection not started.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(listener_mock, onSocketEvent(_,_,_)).Times(0);
+   EXPECT_FALSE(m_test_subject->connect("127.0.0.1", 2222));
+   EXPECT_FALSE(m_test_subject->connect(SHMDRV_SCHEME, 0));
+
+   /**
+    * <b>scenario</b>: Server not running.<br>
+    * <b>expected</b>: Connection not started.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(m_test_subject->connect(m_address, 0));
+   EXPECT_FALSE(m_test_subject->isConnected());
+   Mock::VerifyAndClearExpectations(&listener_mock);
+
+   /**
+    * <b>scenario</b>: Server running.<br>
+    * <b>expected</b>: Connected, listener notified.<br>
+    * ************************************************
+    */
+   ASSERT_TRUE(server.create(m_name));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   EXPECT_TRUE(m_test_subject->connect(m_address, 0));
+   EXPECT_TRUE(m_test_subject->isConnected());
+   EXPECT_TRUE(server.isPeerAlive());
+   Mock::VerifyAndClearExpectations(&listener_mock);
+
+   /**
+    * <b>scenario</b>: Disconnect requested while receiving thread waits for data.<br>
+    * <b>expected</b>: Thread stopped immediately, server notices disconnection, event not reported.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(listener_mock, onSocketEvent(_,_,_)).Times(0);
+   auto start = std::chrono::steady_clock::now();
+   EXPECT_TRUE(m_test_subject->disconnect());
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(SHMDRV_PEER_CHECK_PERIOD_MS / 2));
+   EXPECT_FALSE(m_test_subject->isConnected());
+   EXPECT_FALSE(server.isPeerAlive());
+   Mock::VerifyAndClearExpectations(&listener_mock);
+
+   /**
+    * <b>scenario</b>: Connected again, then server closed.<br>
+    * <b>expected</b>: Disconnection reported.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   EXPECT_TRUE(m_test_subject->connect(m_address, 0));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DISCONNECTED,_,_)).WillOnce(InvokeWithoutArgs([&](){ countEvent(); }));
+   server.close();
+   EXPECT_TRUE(waitForEvents(1));
+   EXPECT_FALSE(m_test_subject->isConnected());
+   EXPECT_EQ(m_test_subject->getStats().reconnects, 1);
+}
+
+/**
+ * @test Tests of receiving data
+ */
+TEST_F(ShmDriverFixture, read_tests)
+{
+   ShmChannel server;
+   ASSERT_TRUE(server.create(m_name));
+   ASSERT_TRUE(m_test_subject->connect(m_address, 0));
+   /**
+    * <b>scenario</b>: Two frames and beginning of the third written, then rest of the third frame.<br>
+    * <b>expected</b>: All frames delivered, statistics updated.<br>
+    * ************************************************
+    */
+   InSequence seq;
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre(1, 2), 2)).WillOnce(InvokeWithoutArgs([&](){ countEvent(); }));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre(3), 1)).WillOnce(InvokeWithoutArgs([&](){ countEvent(); }));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre(4, 5), 2)).WillOnce(InvokeWithoutArgs([&](){ countEvent(); }));
+   const std::vector<uint8_t> first = {1, 2, '\n', 3, '\n', 4};
+   const std::vector<uint8_t> second = {5, '\n'};
+   server.write(first.data(), first.size());
+   EXPECT_TRUE(waitForEvents(2));
+   server.write(second.data(), second.size());
+   EXPECT_TRUE(waitForEvents(3));
+   SocketDriverStats stats = m_test_subject->getStats();
+   EXPECT_EQ(stats.bytes_received, 8);
+   EXPECT_EQ(stats.frames_delivered, 3);
+   EXPECT_TRUE(m_test_subject->disconnect());
+}
+
+/**
+ * @test Tests of writing data
+ */
+TEST_F(ShmDriverFixture, write_tests)
+{
+   ShmChannel server;
+   std::vector<bool> results;
+   /**
+    * <b>scenario</b>: Write requested when not connected.<br>
+    * <b>expected</b>: Data rejected.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(m_test_subject->write({1, 2}));
+   EXPECT_FALSE(m_test_subject->writeAsync({1, 2}));
+
+   /**
+    * <b>scenario</b>: Synchronous and asynchronous write when connected.<br>
+    * <b>expected</b>: Data passed to server in the same order, callback called.<br>
+    * ************************************************
+    */
+   ASSERT_TRUE(server.create(m_name));
+   ASSERT_TRUE(m_test_subject->connect(m_address, 0));
+   EXPECT_TRUE(m_test_subject->write({1, 2, 3}, 2));
+   EXPECT_TRUE(m_test_subject->writeAsync({4}, [&](bool result){ results.push_back(result); }));
+   EXPECT_THAT(results, ElementsAre(true));
+   EXPECT_EQ(m_test_subject->getStats().write_queue_bytes, 3);
+   EXPECT_THAT(readAll(server), ElementsAre(1, 2, 4));
+   EXPECT_EQ(m_test_subject->getStats().bytes_sent, 3);
+
+   /**
+    * <b>scenario</b>: Asynchronous write exceeding high water mark.<br>
+    * <b>expected</b>: Data rejected.<br>
+    * ************************************************
+    */
+   m_test_subject->setWriteHighWaterMark(4);
+   EXPECT_TRUE(m_test_subject->writeAsync({1, 2, 3}));
+   EXPECT_FALSE(m_test_subject->writeAsync({4, 5}));
+   EXPECT_THAT(readAll(server), ElementsAre(1, 2, 3));
+
+   /**
+    * <b>scenario</b>: Write in COBS framing mode.<br>
+    * <b>expected</b>: Data encoded and terminated with delimiter.<br>
+    * ************************************************
+    */
+   m_test_subject->setFraming(FramingMode::COBS);
+   EXPECT_TRUE(m_test_subject->write({0x11, 0x00, 0x22}));
+   EXPECT_THAT(readAll(server), ElementsAre(0x02, 0x11, 0x02, 0x22, COBS_DELIMITER));
+   EXPECT_TRUE(m_test_subject->disconnect());
+}
@@ -2,12 +2,30 @@
 #include "gmock/gmock.h"
 
 #define SOCKDRV_FRIEND_TESTS \
+   FRIEND_TEST(SocketDriverFixture, socket_write_tests);\
    FRIEND_TEST(SocketDriverFixture, socket_read_tests);\
+   FRIEND_TEST(SocketDriverFixture, socket_read_batch_tests);\
+   FRIEND_TEST(SocketDriverFixture, socket_read_zero_copy_tests);\
+   FRIEND_TEST(SocketDriverFixture, socket_read_length_prefixed_tests);\
+   FRIEND_TEST(SocketDriverFixture, socket_cobs_framing_tests);\
+   FRIEND_TEST(SocketDriverFixture, socket_capture_tests);\
+   FRIEND_TEST(SocketDriverFixture, write_queue_thread_tests);\
    friend class SocketDriverFixture;
 
 #include "SocketDriver.h"
 #include "logger_mock.hpp"
+#include "EventLoopMock.h"
 #include <sys/socket.h>
+#include <sys/un.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <condition_variable>
+#include <map>
+#include <unistd.h>
 /* ============================= */
 /**
  * @file SocketDriverTests.cpp
@@ -27,8 +45,18 @@ struct SystemCallMock
    MOCK_METHOD3(connect, int(int, const struct sockaddr *, socklen_t));
    MOCK_METHOD4(recv, ssize_t(int, void *, size_t, int));
    MOCK_METHOD4(send, ssize_t(int, const void *, size_t, int));
+   MOCK_METHOD3(sendmsg, ssize_t(int, const struct msghdr *, int));
+   MOCK_METHOD3(poll, int(struct pollfd *, nfds_t, int));
+   MOCK_METHOD3(fcntl, int(int, int, int));
+   MOCK_METHOD5(getsockopt, int(int, int, int, void *, socklen_t *));
+   MOCK_METHOD5(setsockopt, int(int, int, int, const void *, socklen_t));
+   MOCK_METHOD4(getaddrinfo, int(const char*, const char*, const struct addrinfo*, struct addrinfo**));
    MOCK_METHOD3(socket, int(int, int, int));
    MOCK_METHOD1(close, int(int));
+   MOCK_METHOD2(shutdown, int(int, int));
+   MOCK_METHOD2(io_uring_setup, int(uint32_t, struct io_uring_params*));
+   MOCK_METHOD4(io_uring_enter, int(int, uint32_t, uint32_t, uint32_t));
+   MOCK_METHOD4(io_uring_register, int(int, uint32_t, void*, uint32_t));
 
 };
 SystemCallMock* sys_call_mock;
@@ -38,12 +66,54 @@ struct ListenerMock : public SocketListener
    MOCK_METHOD3(onSocketEvent, void(DriverEvent, const std::vector<uint8_t>&, size_t));
 };
 
+struct BatchListenerMock : public SocketListener
+{
+   MOCK_METHOD3(onSocketEvent, void(DriverEvent, const std::vector<uint8_t>&, size_t));
+   MOCK_METHOD2(onSocketBatch, void(const std::vector<std::vector<uint8_t>>&, size_t));
+};
+
+/* returns buffers passed to sendmsg() */
+std::vector<std::vector<uint8_t>> get_iovecs(const struct msghdr* msg)
+{
+   std::vector<std::vector<uint8_t>> result;
+   for (size_t i = 0; i < msg->msg_iovlen; i++)
+   {
+      const uint8_t* data = static_cast<const uint8_t*>(msg->msg_iov[i].iov_base);
+      result.emplace_back(data, data + msg->msg_iov[i].iov_len);
+   }
+   return result;
+}
+
 struct SocketDriverFixture : public testing::Test
 {
+#if defined (SOCKDRV_URING)
+   /* io_uring used on real socket pair, other socket functions stay mocked */
+   void useRealUring()
+   {
+      ON_CALL(*sys_call_mock, io_uring_setup(_,_)).WillByDefault(Invoke([](uint32_t entries, struct io_uring_params* params)->int
+            {
+               return syscall(__NR_io_uring_setup, entries, params);
+            }));
+      ON_CALL(*sys_call_mock, io_uring_enter(_,_,_,_)).WillByDefault(Invoke([](int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags)->int
+            {
+               return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+            }));
+      ON_CALL(*sys_call_mock, io_uring_register(_,_,_,_)).WillByDefault(Invoke([](int fd, uint32_t opcode, void* arg, uint32_t nr_args)->int
+            {
+               return syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+            }));
+   }
+   /* checks if kernel allows to use io_uring */
+   bool isUringSupported()
+   {
+      UringQueue queue;
+      return queue.init(SOCKDRV_URING_ENTRIES, SOCKDRV_URING_BUFFER_COUNT, SOCKDRV_URING_BUFFER_SIZE);
+   }
+#endif
    void SetUp()
    {
       mock_logger_init();
-      sys_call_mock = new SystemCallMock;
+      sys_call_mock = new NiceMock<SystemCallMock>;
       m_test_subject.reset(new SocketDriver());
    }
    void TearDown()
@@ -71,17 +141,75 @@ __attribute__((weak)) ssize_t send(int socket, const void *message, size_t lengt
 {
    return sys_call_mock->send(socket, message, length, flags);
 }
+__attribute__((weak)) ssize_t sendmsg(int socket, const struct msghdr *message, int flags)
+{
+   return sys_call_mock->sendmsg(socket, message, flags);
+}
+__attribute__((weak)) int poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+   return sys_call_mock->poll(fds, nfds, timeout);
+}
 __attribute__((weak)) int socket(int domain, int type, int protocol)
 {
    return sys_call_mock->socket(domain, type, protocol);
 }
+__attribute__((weak)) int fcntl(int fd, int cmd, int arg)
+{
+   return sys_call_mock->fcntl(fd, cmd, arg);
+}
+__attribute__((weak)) int getsockopt(int socket, int level, int option_name, void *option_value, socklen_t *option_len)
+{
+   return sys_call_mock->getsockopt(socket, level, option_name, option_value, option_len);
+}
+__attribute__((weak)) int setsockopt(int socket, int level, int option_name, const void *option_value, socklen_t option_len)
+{
+   return sys_call_mock->setsockopt(socket, level, option_name, option_value, option_len);
+}
+__attribute__((weak)) int getaddrinfo(const char *node, const char *service, const struct addrinfo *hints, struct addrinfo **res)
+{
+   return sys_call_mock->getaddrinfo(node, service, hints, res);
+}
 __attribute__((weak)) int close (int fd)
 {
    return sys_call_mock->close(fd);
 }
+__attribute__((weak)) int shutdown(int socket, int how)
+{
+   return sys_call_mock->shutdown(socket, how);
+}
+__attribute__((weak)) int io_uring_setup(uint32_t entries, struct io_uring_params* params)
+{
+   return sys_call_mock->io_uring_setup(entries, params);
+}
+__attribute__((weak)) int io_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags)
+{
+   return sys_call_mock->io_uring_enter(fd, to_submit, min_complete, flags);
+}
+__attribute__((weak)) int io_uring_register(int fd, uint32_t opcode, void* arg, uint32_t nr_args)
+{
+   return sys_call_mock->io_uring_register(fd, opcode, arg, nr_args);
+}
 
 }
 
+/* resolves any host to IPv6 and IPv4 loopback addresses, in this order */
+int resolve_dual_stack(const char*, const char*, const struct addrinfo* hints, struct addrinfo** res)
+{
+   struct addrinfo* inet_info = nullptr;
+   int result = ::getaddrinfo("::1", nullptr, hints, res);
+   if (result == 0)
+   {
+      result = ::getaddrinfo("127.0.0.1", nullptr, hints, &inet_info);
+      struct addrinfo* last = *res;
+      while (last->ai_next)
+      {
+         last = last->ai_next;
+      }
+      last->ai_next = inet_info;
+   }
+   return result;
+}
+
 /**
  * @test Tests of connection and disconnection
  */
@@ -109,16 +237,27 @@ TEST_F(SocketDriverFixture, connect_disconnect_tests)
     * ************************************************
     */
    EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(-1));
+   EXPECT_FALSE(m_test_subject->connect("192.168.100.100", 1111));
+
+   /**
+    * <b>scenario</b>: Host name cannot be resolved.<br>
+    * <b>expected</b>: Connection not started, socket not created.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, getaddrinfo(StrEq("www.test.pl"),_,_,_)).WillOnce(Return(EAI_NONAME));
+   EXPECT_CALL(*sys_call_mock, socket(_,_,_)).Times(0);
    EXPECT_FALSE(m_test_subject->connect("www.test.pl", 1111));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
 
    /**
-    * <b>scenario</b>: Invalid form of IP address.<br>
-    * <b>expected</b>: Connection not started.<br>
+    * <b>scenario</b>: Connection to the same host requested again.<br>
+    * <b>expected</b>: Failure taken from cache, host name not resolved again.<br>
     * ************************************************
     */
-   EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(SOCK_FD));
-   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, getaddrinfo(_,_,_,_)).Times(0);
+   EXPECT_CALL(*sys_call_mock, socket(_,_,_)).Times(0);
    EXPECT_FALSE(m_test_subject->connect("www.test.pl", 1111));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
 
    /**
     * <b>scenario</b>: Cannot connect to server.<br>
@@ -132,11 +271,25 @@ TEST_F(SocketDriverFixture, connect_disconnect_tests)
 
    /**
     * <b>scenario</b>: Correct connection sequence.<br>
-    * <b>expected</b>: Connection started.<br>
+    * <b>expected</b>: Connection started, keepalive and user timeout set, so dead peer is detected within seconds.<br>
     * ************************************************
     */
+   auto int_option = [](int expected)
+   {
+      return Invoke([expected](int, int, int, const void* value, socklen_t size)->int
+            {
+               EXPECT_EQ(size, sizeof(int));
+               EXPECT_EQ(*static_cast<const int*>(value), expected);
+               return 0;
+            });
+   };
    EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(SOCK_FD));
    EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, _)).WillOnce(Return(1));
+   EXPECT_CALL(*sys_call_mock, setsockopt(SOCK_FD, SOL_SOCKET, SO_KEEPALIVE, _, _)).WillOnce(int_option(1));
+   EXPECT_CALL(*sys_call_mock, setsockopt(SOCK_FD, IPPROTO_TCP, TCP_KEEPIDLE, _, _)).WillOnce(int_option(SOCKDRV_KEEPALIVE_IDLE_S));
+   EXPECT_CALL(*sys_call_mock, setsockopt(SOCK_FD, IPPROTO_TCP, TCP_KEEPINTVL, _, _)).WillOnce(int_option(SOCKDRV_KEEPALIVE_INTERVAL_S));
+   EXPECT_CALL(*sys_call_mock, setsockopt(SOCK_FD, IPPROTO_TCP, TCP_KEEPCNT, _, _)).WillOnce(int_option(SOCKDRV_KEEPALIVE_COUNT));
+   EXPECT_CALL(*sys_call_mock, setsockopt(SOCK_FD, IPPROTO_TCP, TCP_USER_TIMEOUT, _, _)).WillOnce(int_option(SOCKDRV_USER_TIMEOUT_MS));
    EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
    EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).WillRepeatedly(Return(1));
    EXPECT_CALL(*sys_call_mock, close(SOCK_FD)).Times(1);
@@ -147,13 +300,493 @@ TEST_F(SocketDriverFixture, connect_disconnect_tests)
    m_test_subject->removeListener(&listener_mock);
 }
 
+/**
+ * @test Tests of connection to IPv6 address and host name
+ */
+TEST_F(SocketDriverFixture, ipv6_host_name_connect_tests)
+{
+   int SOCK_FD = 1;
+   /**
+    * <b>scenario</b>: IPv6 address provided.<br>
+    * <b>expected</b>: IPv6 socket connected to given address and port.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, getaddrinfo(_,_,_,_)).Times(0);
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET6, SOCK_STREAM, 0)).WillOnce(Return(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, sizeof(struct sockaddr_in6)))
+         .WillOnce(Invoke([&](int, const struct sockaddr* address, socklen_t)->int
+         {
+            const struct sockaddr_in6* inet6_addr = reinterpret_cast<const struct sockaddr_in6*>(address);
+            EXPECT_EQ(inet6_addr->sin6_family, AF_INET6);
+            EXPECT_EQ(ntohs(inet6_addr->sin6_port), 1111);
+            EXPECT_TRUE(IN6_IS_ADDR_LOOPBACK(&inet6_addr->sin6_addr));
+            return 0;
+         }));
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).WillRepeatedly(Return(1));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   EXPECT_TRUE(m_test_subject->connect("::1", 1111));
+   m_test_subject->disconnect();
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+
+   /**
+    * <b>scenario</b>: Host name provided, connection repeated.<br>
+    * <b>expected</b>: Host name resolved once, next connection uses cached address.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, getaddrinfo(StrEq("localhost"),_,_,_)).WillOnce(Invoke(&::getaddrinfo));
+   EXPECT_CALL(*sys_call_mock, socket(AnyOf(AF_INET, AF_INET6), SOCK_STREAM, 0)).Times(2).WillRepeatedly(Return(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, _)).Times(2).WillRepeatedly(Return(0));
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).WillRepeatedly(Return(1));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD)).Times(2);
+   EXPECT_TRUE(m_test_subject->connect("localhost", 1111));
+   m_test_subject->disconnect();
+   EXPECT_TRUE(m_test_subject->connect("localhost", 1111));
+   m_test_subject->disconnect();
+}
+
+/**
+ * @test Tests of connection to host name with several addresses
+ */
+TEST_F(SocketDriverFixture, host_name_all_addresses_tests)
+{
+   int SOCK_FD_INET6 = 1;
+   int SOCK_FD_INET = 2;
+   /**
+    * <b>scenario</b>: Host name resolved to IPv6 and IPv4 address, server listens on IPv4 only.<br>
+    * <b>expected</b>: IPv6 connection refused, connected to IPv4 address.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, getaddrinfo(StrEq("dualhost"),_,_,_)).WillOnce(Invoke(&resolve_dual_stack));
+   {
+      InSequence seq;
+      EXPECT_CALL(*sys_call_mock, socket(AF_INET6, SOCK_STREAM, 0)).WillOnce(Return(SOCK_FD_INET6));
+      EXPECT_CALL(*sys_call_mock, connect(SOCK_FD_INET6, _, sizeof(struct sockaddr_in6)))
+            .WillOnce(Invoke([](int, const struct sockaddr*, socklen_t)->int { errno = ECONNREFUSED; return -1; }));
+      EXPECT_CALL(*sys_call_mock, close(SOCK_FD_INET6));
+      EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(SOCK_FD_INET));
+      EXPECT_CALL(*sys_call_mock, connect(SOCK_FD_INET, _, sizeof(struct sockaddr_in)))
+            .WillOnce(Invoke([&](int, const struct sockaddr* address, socklen_t)->int
+            {
+               const struct sockaddr_in* inet_addr = reinterpret_cast<const struct sockaddr_in*>(address);
+               EXPECT_EQ(ntohs(inet_addr->sin_port), 1111);
+               EXPECT_EQ(ntohl(inet_addr->sin_addr.s_addr), INADDR_LOOPBACK);
+               return 0;
+            }));
+   }
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).WillRepeatedly(Return(1));
+   EXPECT_TRUE(m_test_subject->connect("dualhost", 1111));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD_INET));
+   m_test_subject->disconnect();
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+
+   /**
+    * <b>scenario</b>: Connection to every address refused.<br>
+    * <b>expected</b>: Each socket closed, connection failed.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, getaddrinfo(_,_,_,_)).Times(0);
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET6, SOCK_STREAM, 0)).WillOnce(Return(SOCK_FD_INET6));
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(SOCK_FD_INET));
+   EXPECT_CALL(*sys_call_mock, connect(_,_,_)).Times(2)
+         .WillRepeatedly(Invoke([](int, const struct sockaddr*, socklen_t)->int { errno = ECONNREFUSED; return -1; }));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD_INET6));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD_INET));
+   EXPECT_FALSE(m_test_subject->connect("dualhost", 1111));
+}
+
+/**
+ * @test Tests of connection to local server
+ */
+TEST_F(SocketDriverFixture, unix_socket_connect_tests)
+{
+   int SOCK_FD = 1;
+   m_test_subject->addListener(&listener_mock);
+   /**
+    * <b>scenario</b>: Unix socket path too long.<br>
+    * <b>expected</b>: Connection not started, socket not created.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, socket(_,_,_)).Times(0);
+   EXPECT_CALL(*sys_call_mock, connect(_,_,_)).Times(0);
+   EXPECT_FALSE(m_test_subject->connect(SOCKDRV_UNIX_SCHEME + std::string(200, 'a'), 0));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+
+   /**
+    * <b>scenario</b>: Unix socket address provided without port.<br>
+    * <b>expected</b>: Unix domain socket connected to given path, TCP options not set.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, socket(AF_UNIX, SOCK_STREAM, 0)).WillOnce(Return(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, sizeof(struct sockaddr_un)))
+         .WillOnce(Invoke([&](int, const struct sockaddr* address, socklen_t)->int
+         {
+            const struct sockaddr_un* unix_addr = reinterpret_cast<const struct sockaddr_un*>(address);
+            EXPECT_EQ(unix_addr->sun_family, AF_UNIX);
+            EXPECT_STREQ(unix_addr->sun_path, "/run/smarthome.sock");
+            return 0;
+         }));
+   EXPECT_CALL(*sys_call_mock, setsockopt(_,_,_,_,_)).Times(0);
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).WillRepeatedly(Return(1));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   EXPECT_TRUE(m_test_subject->connect("unix:/run/smarthome.sock", 0));
+   m_test_subject->disconnect();
+
+   m_test_subject->removeListener(&listener_mock);
+}
+
+/**
+ * @test Tests of stopping receiving thread
+ */
+TEST_F(SocketDriverFixture, disconnect_blocked_receive_tests)
+{
+   int SOCK_FD = 1;
+   std::mutex mtx;
+   std::condition_variable cv;
+   bool shut_down = false;
+   m_test_subject->addListener(&listener_mock);
+   EXPECT_CALL(*sys_call_mock, socket(_,_,_)).WillOnce(Return(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, _)).WillOnce(Return(0));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   EXPECT_CALL(*sys_call_mock, recv(SOCK_FD,_,_,_)).WillRepeatedly(Invoke([&](int, void*, size_t, int)->ssize_t
+         {
+            std::unique_lock<std::mutex> lock (mtx);
+            cv.wait(lock, [&](){ return shut_down; });
+            return 0;
+         }));
+   EXPECT_TRUE(m_test_subject->connect("192.168.100.100", 1111));
+   /**
+    * <b>scenario</b>: Disconnect requested when receiving thread waits for data.<br>
+    * <b>expected</b>: Socket shut down to unblock the thread, disconnection not reported to listeners.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, shutdown(SOCK_FD, SHUT_RDWR)).WillOnce(Invoke([&](int, int)->int
+         {
+            std::lock_guard<std::mutex> lock (mtx);
+            shut_down = true;
+            cv.notify_all();
+            return 0;
+         }));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DISCONNECTED,_,_)).Times(0);
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   m_test_subject->disconnect();
+   EXPECT_FALSE(m_test_subject->isConnected());
+   m_test_subject->removeListener(&listener_mock);
+}
+
+/**
+ * @test Tests of driver statistics
+ */
+TEST_F(SocketDriverFixture, statistics_tests)
+{
+   int SOCK_FD = 1;
+   EventLoopMock loop_mock;
+   IEventLoop::FdCallback fd_callback;
+   std::unique_ptr<ISocketDriver> driver (new SocketDriver(loop_mock));
+   EXPECT_CALL(*sys_call_mock, socket(_,_,_)).WillRepeatedly(Return(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, _)).WillRepeatedly(Return(0));
+   EXPECT_CALL(loop_mock, addFd(SOCK_FD, EVLOOP_READ, _)).WillRepeatedly(DoAll(SaveArg<2>(&fd_callback), Return(true)));
+   EXPECT_CALL(loop_mock, modifyFd(SOCK_FD, _)).WillRepeatedly(Return(true));
+
+   /**
+    * <b>scenario</b>: Driver created.<br>
+    * <b>expected</b>: All counters zeroed.<br>
+    * ************************************************
+    */
+   SocketDriverStats stats = driver->getStats();
+   EXPECT_EQ(stats.bytes_received, 0);
+   EXPECT_EQ(stats.bytes_sent, 0);
+   EXPECT_EQ(stats.frames_delivered, 0);
+   EXPECT_EQ(stats.frames_dropped, 0);
+   EXPECT_EQ(stats.reconnects, 0);
+   EXPECT_EQ(stats.connected_time_ms, 0);
+   EXPECT_EQ(stats.recv_buffer_high_water, 0);
+   EXPECT_EQ(stats.write_queue_bytes, 0);
+   EXPECT_EQ(stats.write_queue_frames, 0);
+
+   /**
+    * <b>scenario</b>: Connected, two frames and beginning of the third received.<br>
+    * <b>expected</b>: Connection time counted, received bytes and frames counted.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(driver->connect("192.168.100.100", 1111));
+   std::this_thread::sleep_for(std::chrono::milliseconds(20));
+   EXPECT_CALL(*sys_call_mock, recv(SOCK_FD,_,_,_)).WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            const std::vector<uint8_t> chunk = {1, 2, '\n', 3, '\n', 4};
+            std::copy(chunk.begin(), chunk.end(), static_cast<uint8_t*>(buffer));
+            return chunk.size();
+         }));
+   fd_callback(EVLOOP_READ);
+   stats = driver->getStats();
+   EXPECT_GE(stats.connected_time_ms, 20);
+   EXPECT_EQ(stats.reconnects, 0);
+   EXPECT_EQ(stats.bytes_received, 6);
+   EXPECT_EQ(stats.frames_delivered, 2);
+   EXPECT_EQ(stats.frames_dropped, 0);
+   EXPECT_EQ(stats.recv_buffer_high_water, 6);
+
+   /**
+    * <b>scenario</b>: Frame bigger than receive buffer received.<br>
+    * <b>expected</b>: Frame dropped, buffer high water mark equal to its size.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, recv(SOCK_FD,_,_,_)).WillRepeatedly(Invoke([&](int, void *buffer, size_t length, int)->ssize_t
+         {
+            memset(buffer, 'a', length);
+            return length;
+         }));
+   fd_callback(EVLOOP_READ);
+   fd_callback(EVLOOP_READ);
+   stats = driver->getStats();
+   EXPECT_EQ(stats.frames_delivered, 2);
+   EXPECT_EQ(stats.frames_dropped, 1);
+   EXPECT_EQ(stats.recv_buffer_high_water, SOCKDRV_RECV_BUFFER_SIZE);
+   EXPECT_EQ(stats.bytes_received, 6 + SOCKDRV_RECV_BUFFER_SIZE - 1);
+
+   /**
+    * <b>scenario</b>: Two frames queued, then sent.<br>
+    * <b>expected</b>: Queue depth reported until data is sent, sent bytes counted.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(driver->writeAsync({1, 2, 3}));
+   EXPECT_TRUE(driver->writeAsync({4, 5}));
+   stats = driver->getStats();
+   EXPECT_EQ(stats.write_queue_bytes, 5);
+   EXPECT_EQ(stats.write_queue_frames, 2);
+   EXPECT_EQ(stats.bytes_sent, 0);
+   EXPECT_CALL(*sys_call_mock, sendmsg(SOCK_FD,_,_)).WillOnce(Return(5));
+   fd_callback(EVLOOP_WRITE);
+   EXPECT_CALL(*sys_call_mock, send(SOCK_FD,_,2,_)).WillOnce(Return(2));
+   EXPECT_TRUE(driver->write({6, 7}));
+   stats = driver->getStats();
+   EXPECT_EQ(stats.write_queue_bytes, 0);
+   EXPECT_EQ(stats.write_queue_frames, 0);
+   EXPECT_EQ(stats.bytes_sent, 7);
+
+   /**
+    * <b>scenario</b>: Connection lost, then established again.<br>
+    * <b>expected</b>: Connection time zeroed when disconnected, reconnection counted, other counters kept.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, recv(SOCK_FD,_,_,_)).WillOnce(Return(0));
+   EXPECT_CALL(loop_mock, removeFd(SOCK_FD)).Times(AtLeast(1));
+   fd_callback(EVLOOP_READ);
+   stats = driver->getStats();
+   EXPECT_EQ(stats.connected_time_ms, 0);
+   EXPECT_EQ(stats.reconnects, 0);
+   EXPECT_TRUE(driver->connect("192.168.100.100", 1111));
+   stats = driver->getStats();
+   EXPECT_EQ(stats.reconnects, 1);
+   EXPECT_EQ(stats.frames_delivered, 2);
+   EXPECT_EQ(stats.bytes_sent, 7);
+}
+
+/**
+ * @test Tests of non-blocking connection
+ */
+TEST_F(SocketDriverFixture, connect_timeout_tests)
+{
+   int SOCK_FD = 1;
+   int FLAGS = 0x02;
+   auto connect_in_progress = [](int, const struct sockaddr*, socklen_t)->int { errno = EINPROGRESS; return -1; };
+   auto set_error = [](int error)
+   {
+      return [error](int, int level, int option, void* value, socklen_t*)->int
+      {
+         EXPECT_EQ(level, SOL_SOCKET);
+         EXPECT_EQ(option, SO_ERROR);
+         *static_cast<int*>(value) = error;
+         return 0;
+      };
+   };
+   EXPECT_CALL(*sys_call_mock, socket(_,_,_)).WillRepeatedly(Return(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, fcntl(SOCK_FD, F_GETFL, _)).WillRepeatedly(Return(FLAGS));
+   /**
+    * <b>scenario</b>: Server does not respond until timeout.<br>
+    * <b>expected</b>: Connection not established, socket closed.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, fcntl(SOCK_FD, F_SETFL, FLAGS | O_NONBLOCK)).WillOnce(Return(0));
+   EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, _)).WillOnce(Invoke(connect_in_progress));
+   EXPECT_CALL(*sys_call_mock, poll(_, 1, SOCKDRV_CONNECT_TIMEOUT_MS)).WillOnce(Return(0));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   EXPECT_FALSE(m_test_subject->connect("192.168.100.100", 1111));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+
+   /**
+    * <b>scenario</b>: Server refused connection.<br>
+    * <b>expected</b>: Connection not established, socket closed.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, socket(_,_,_)).WillRepeatedly(Return(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, fcntl(SOCK_FD, F_GETFL, _)).WillRepeatedly(Return(FLAGS));
+   EXPECT_CALL(*sys_call_mock, fcntl(SOCK_FD, F_SETFL, _)).WillRepeatedly(Return(0));
+   EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, _)).WillOnce(Invoke(connect_in_progress));
+   EXPECT_CALL(*sys_call_mock, poll(_, 1, SOCKDRV_CONNECT_TIMEOUT_MS)).WillOnce(Return(1));
+   EXPECT_CALL(*sys_call_mock, getsockopt(SOCK_FD, _, _, _, _)).WillOnce(Invoke(set_error(ECONNREFUSED)));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   EXPECT_FALSE(m_test_subject->connect("192.168.100.100", 1111));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+
+   /**
+    * <b>scenario</b>: Connection established before timeout.<br>
+    * <b>expected</b>: Socket switched back to blocking mode, connection started.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, socket(_,_,_)).WillRepeatedly(Return(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, fcntl(SOCK_FD, F_GETFL, _)).WillRepeatedly(Return(FLAGS));
+   {
+      InSequence seq;
+      EXPECT_CALL(*sys_call_mock, fcntl(SOCK_FD, F_SETFL, FLAGS | O_NONBLOCK)).WillOnce(Return(0));
+      EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, _)).WillOnce(Invoke(connect_in_progress));
+      EXPECT_CALL(*sys_call_mock, poll(_, 1, SOCKDRV_CONNECT_TIMEOUT_MS)).WillOnce(Invoke([&](struct pollfd* fds, nfds_t, int)->int
+            {
+               EXPECT_EQ(fds[0].fd, SOCK_FD);
+               EXPECT_EQ(fds[0].events, POLLOUT);
+               return 1;
+            }));
+      EXPECT_CALL(*sys_call_mock, getsockopt(SOCK_FD, _, _, _, _)).WillOnce(Invoke(set_error(0)));
+      EXPECT_CALL(*sys_call_mock, fcntl(SOCK_FD, F_SETFL, FLAGS)).WillOnce(Return(0));
+   }
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).WillRepeatedly(Return(1));
+   EXPECT_TRUE(m_test_subject->connect("192.168.100.100", 1111));
+
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   m_test_subject->disconnect();
+}
+
+/**
+ * @test Tests of connection to one of several servers
+ */
+TEST_F(SocketDriverFixture, connect_any_tests)
+{
+   int FD_A = 3;
+   int FD_B = 4;
+   int FLAGS = 0x02;
+   const std::vector<SocketEndpoint> endpoints = {{"192.168.100.100", 1111}, {"192.168.100.101", 1111}};
+   auto connect_in_progress = [](int, const struct sockaddr*, socklen_t)->int { errno = EINPROGRESS; return -1; };
+   auto set_error = [](int error)
+   {
+      return [error](int, int, int, void* value, socklen_t*)->int
+      {
+         *static_cast<int*>(value) = error;
+         return 0;
+      };
+   };
+   /* marks last socket from poll set as ready */
+   auto last_ready = [](struct pollfd* fds, nfds_t nfds, int)->int
+   {
+      fds[nfds - 1].revents = POLLOUT;
+      return 1;
+   };
+   m_test_subject->addListener(&listener_mock);
+   /**
+    * <b>scenario</b>: No endpoints provided.<br>
+    * <b>expected</b>: Connection not started.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, socket(_,_,_)).Times(0);
+   EXPECT_EQ(m_test_subject->connectAny({}), -1);
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+
+   /**
+    * <b>scenario</b>: First server refused connection immediately.<br>
+    * <b>expected</b>: Second server tried without waiting for hedge delay, connection established with it.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, fcntl(_, F_GETFL, _)).WillRepeatedly(Return(FLAGS));
+   EXPECT_CALL(*sys_call_mock, fcntl(_, F_SETFL, _)).WillRepeatedly(Return(0));
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).WillRepeatedly(Return(1));
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(FD_A)).WillOnce(Return(FD_B));
+   EXPECT_CALL(*sys_call_mock, connect(FD_A, _, _)).WillOnce(Invoke([](int, const struct sockaddr*, socklen_t)->int { errno = ECONNREFUSED; return -1; }));
+   EXPECT_CALL(*sys_call_mock, close(FD_A));
+   EXPECT_CALL(*sys_call_mock, connect(FD_B, _, _)).WillOnce(Invoke(connect_in_progress));
+   EXPECT_CALL(*sys_call_mock, poll(_, 1, _)).WillOnce(Invoke([&](struct pollfd* fds, nfds_t nfds, int timeout)->int
+         {
+            EXPECT_EQ(fds[0].fd, FD_B);
+            EXPECT_EQ(fds[0].events, POLLOUT);
+            EXPECT_LE(timeout, SOCKDRV_CONNECT_TIMEOUT_MS);
+            return last_ready(fds, nfds, timeout);
+         }));
+   EXPECT_CALL(*sys_call_mock, getsockopt(FD_B, SOL_SOCKET, SO_ERROR, _, _)).WillOnce(Invoke(set_error(0)));
+   EXPECT_CALL(*sys_call_mock, fcntl(FD_B, F_SETFL, FLAGS)).WillOnce(Return(0));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   EXPECT_EQ(m_test_subject->connectAny(endpoints), 1);
+   EXPECT_TRUE(m_test_subject->isConnected());
+   EXPECT_CALL(*sys_call_mock, close(FD_B));
+   m_test_subject->disconnect();
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+   Mock::VerifyAndClearExpectations(&listener_mock);
+
+   /**
+    * <b>scenario</b>: First server does not respond, second one accepts the connection.<br>
+    * <b>expected</b>: Second server tried after hedge delay, connection established with it, first attempt abandoned.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, fcntl(_, F_GETFL, _)).WillRepeatedly(Return(FLAGS));
+   EXPECT_CALL(*sys_call_mock, fcntl(_, F_SETFL, _)).WillRepeatedly(Return(0));
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).WillRepeatedly(Return(1));
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(FD_A)).WillOnce(Return(FD_B));
+   EXPECT_CALL(*sys_call_mock, connect(_, _, _)).WillRepeatedly(Invoke(connect_in_progress));
+   EXPECT_CALL(*sys_call_mock, poll(_, 1, _)).WillRepeatedly(Invoke([&](struct pollfd* fds, nfds_t, int timeout)->int
+         {
+            EXPECT_EQ(fds[0].fd, FD_A);
+            EXPECT_LE(timeout, SOCKDRV_HEDGE_DELAY_MS);
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+            return 0;
+         }));
+   EXPECT_CALL(*sys_call_mock, poll(_, 2, _)).WillOnce(Invoke(last_ready));
+   EXPECT_CALL(*sys_call_mock, getsockopt(FD_A, _, _, _, _)).Times(0);
+   EXPECT_CALL(*sys_call_mock, getsockopt(FD_B, _, _, _, _)).WillOnce(Invoke(set_error(0)));
+   EXPECT_CALL(*sys_call_mock, close(FD_A));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   EXPECT_EQ(m_test_subject->connectAny(endpoints), 1);
+   EXPECT_CALL(*sys_call_mock, close(FD_B));
+   m_test_subject->disconnect();
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+   Mock::VerifyAndClearExpectations(&listener_mock);
+
+   /**
+    * <b>scenario</b>: Both servers refused connection.<br>
+    * <b>expected</b>: Connection not established, all sockets closed.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, fcntl(_, F_GETFL, _)).WillRepeatedly(Return(FLAGS));
+   EXPECT_CALL(*sys_call_mock, fcntl(_, F_SETFL, _)).WillRepeatedly(Return(0));
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(FD_A)).WillOnce(Return(FD_B));
+   EXPECT_CALL(*sys_call_mock, connect(_, _, _)).WillRepeatedly(Invoke(connect_in_progress));
+   EXPECT_CALL(*sys_call_mock, poll(_, _, _)).WillRepeatedly(Invoke(last_ready));
+   EXPECT_CALL(*sys_call_mock, getsockopt(_, _, _, _, _)).WillRepeatedly(Invoke(set_error(ECONNREFUSED)));
+   EXPECT_CALL(*sys_call_mock, close(FD_A));
+   EXPECT_CALL(*sys_call_mock, close(FD_B));
+   EXPECT_CALL(listener_mock, onSocketEvent(_,_,_)).Times(0);
+   EXPECT_EQ(m_test_subject->connectAny(endpoints), -1);
+   EXPECT_FALSE(m_test_subject->isConnected());
+
+   m_test_subject->removeListener(&listener_mock);
+}
+
 /**
  * @test Tests of writing data to socket
  */
 TEST_F(SocketDriverFixture, socket_write_tests)
 {
+   int SOCK_FD = 1;
    uint8_t data_size = 20;
    std::vector<uint8_t> test_bytes = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19};
+   SocketDriver* driver = static_cast<SocketDriver*>(m_test_subject.get());
+   /**
+    * <b>scenario</b>: Data written when not connected.<br>
+    * <b>expected</b>: Nothing sent, false returned.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, send(_,_,_,_)).Times(0);
+   EXPECT_FALSE(m_test_subject->write(test_bytes, data_size));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+   driver->m_sock_fd = SOCK_FD;
+   driver->m_is_connected = true;
+
    /**
     * <b>scenario</b>: Data size to write is bigger than possible.<br>
     * <b>expected</b>: Data not written.<br>
@@ -166,7 +799,7 @@ TEST_F(SocketDriverFixture, socket_write_tests)
     * <b>expected</b>: Data sent correctly.<br>
     * ************************************************
     */
-   EXPECT_CALL(*sys_call_mock, send(_,_,_,_))
+   EXPECT_CALL(*sys_call_mock, send(SOCK_FD,_,_,_))
          .WillOnce(Invoke([&](int, const void *message, size_t length, int)->ssize_t
          {
             const uint8_t* data = static_cast<const uint8_t*>(message);
@@ -211,6 +844,25 @@ TEST_F(SocketDriverFixture, socket_write_tests)
    EXPECT_CALL(*sys_call_mock, send(_,_,_,_)).WillOnce(Return(0));
    EXPECT_FALSE(m_test_subject->write(test_bytes, data_size));
 
+   /**
+    * <b>scenario</b>: Send 20 bytes - bytes written to socket in 3 parts.<br>
+    * <b>expected</b>: Remaining bytes requested in each call, data sent correctly.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, send(_,_,20,_)).WillOnce(Return(5));
+   EXPECT_CALL(*sys_call_mock, send(_,_,15,_)).WillOnce(Invoke([&](int, const void *message, size_t, int)->ssize_t
+         {
+            EXPECT_EQ(static_cast<const uint8_t*>(message)[0], 5);
+            return 10;
+         }));
+   EXPECT_CALL(*sys_call_mock, send(_,_,5,_)).WillOnce(Invoke([&](int, const void *message, size_t, int)->ssize_t
+         {
+            EXPECT_EQ(static_cast<const uint8_t*>(message)[0], 15);
+            return 5;
+         }));
+   EXPECT_TRUE(m_test_subject->write(test_bytes, data_size));
+
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
 }
 
 /**
@@ -247,27 +899,46 @@ TEST_F(SocketDriverFixture, socket_read_tests)
             EXPECT_EQ(ev, DriverEvent::DRIVER_DATA_RECV);
             EXPECT_THAT(data, ElementsAre(0,1,2,3,4));
          }));
+   static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = true;
    static_cast<SocketDriver*>(m_test_subject.get())->threadExecute();
    m_test_subject->removeListener(&listener_mock);
 
    /**
-    * <b>scenario</b>: Delimiter received in the middle of the data.<br>
-    * <b>expected</b>: Rest of the message should be kept and waits for next chunk.<br>
+    * <b>scenario</b>: Message received after listener removal.<br>
+    * <b>expected</b>: Listener not notified.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            static_cast<uint8_t*>(buffer)[0] = '\n';
+            static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = false;
+            return 1;
+         }));
+   EXPECT_CALL(listener_mock, onSocketEvent(_,_,_)).Times(0);
+   static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = true;
+   static_cast<SocketDriver*>(m_test_subject.get())->threadExecute();
+   Mock::VerifyAndClearExpectations(&listener_mock);
+   m_test_subject->addListener(&listener_mock);
+
+   /**
+    * <b>scenario</b>: Delimiter received in the middle of the data.<br>
+    * <b>expected</b>: Rest of the message should be kept and waits for next chunk.<br>
     * ************************************************
     */
    EXPECT_CALL(*sys_call_mock, recv(_,_,_,_))
          .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
          {
             uint8_t* buf = static_cast<uint8_t*>(buffer);
-            for (uint8_t i = 0; i < 15; i++)
-            {
-               buf[i] = i;
-            }
-            return 15;
-         }))
-         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
-         {
-            uint8_t* buf = static_cast<uint8_t*>(buffer);
+            for (uint8_t i = 0; i < 15; i++)
+            {
+               buf[i] = i;
+            }
+            return 15;
+         }))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            uint8_t* buf = static_cast<uint8_t*>(buffer);
             buf[0] = '\n';
             static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = false;
             return 1;
@@ -286,18 +957,1157 @@ TEST_F(SocketDriverFixture, socket_read_tests)
             EXPECT_THAT(data, ElementsAre(11,12,13,14));
          }));
 
+   static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = true;
+
    static_cast<SocketDriver*>(m_test_subject.get())->threadExecute();
 
    /**
-    * <b>scenario</b>: Driver error occurs - e.g. server has been closed suddenly.<br>
-    * <b>expected</b>: Callback notified.<br>
+    * <b>scenario</b>: Server closed the connection, errno left from previous call.<br>
+    * <b>expected</b>: Treated as clean close - callback notified, socket closed.<br>
     * ************************************************
     */
-   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).WillOnce(Return(0));
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).WillOnce(Invoke([](int, void*, size_t, int)->ssize_t
+         {
+            errno = EAGAIN;
+            return 0;
+         }));
    EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DISCONNECTED,_,_));
-   EXPECT_CALL(*sys_call_mock, close(_));
+   EXPECT_CALL(*sys_call_mock, close(1));
+   static_cast<SocketDriver*>(m_test_subject.get())->m_sock_fd = 1;
+   static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = true;
+   static_cast<SocketDriver*>(m_test_subject.get())->threadExecute();
+
+   m_test_subject->removeListener(&listener_mock);
+
+}
+
+/**
+ * @test Tests of delivering all frames received in single read
+ */
+TEST_F(SocketDriverFixture, socket_read_batch_tests)
+{
+   BatchListenerMock batch_listener;
+   m_test_subject->addListener(&batch_listener);
+   /**
+    * <b>scenario</b>: Three complete messages and beginning of the fourth received in single chunk.<br>
+    * <b>expected</b>: Three frames delivered in one batch, rest of the data waits for next chunk.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            const std::vector<uint8_t> chunk = {1, 2, '\n', 3, '\n', 4, 5, '\n', 6};
+            std::copy(chunk.begin(), chunk.end(), static_cast<uint8_t*>(buffer));
+            return chunk.size();
+         }))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            const std::vector<uint8_t> chunk = {7, '\n'};
+            std::copy(chunk.begin(), chunk.end(), static_cast<uint8_t*>(buffer));
+            static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = false;
+            return chunk.size();
+         }));
+   EXPECT_CALL(batch_listener, onSocketEvent(_,_,_)).Times(0);
+   EXPECT_CALL(batch_listener, onSocketBatch(_,_))
+   .WillOnce(Invoke([&](const std::vector<std::vector<uint8_t>>& frames, size_t count)
+         {
+            ASSERT_EQ(count, 3);
+            ASSERT_GE(frames.size(), count);
+            EXPECT_THAT(frames[0], ElementsAre(1,2));
+            EXPECT_THAT(frames[1], ElementsAre(3));
+            EXPECT_THAT(frames[2], ElementsAre(4,5));
+         }))
+   .WillOnce(Invoke([&](const std::vector<std::vector<uint8_t>>& frames, size_t count)
+         {
+            ASSERT_EQ(count, 1);
+            EXPECT_THAT(frames[0], ElementsAre(6,7));
+         }));
+   static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = true;
+   static_cast<SocketDriver*>(m_test_subject.get())->threadExecute();
+
+   /**
+    * <b>scenario</b>: Listener without batch support, two messages received in single chunk.<br>
+    * <b>expected</b>: Each frame delivered by separate onSocketEvent() call.<br>
+    * ************************************************
+    */
+   m_test_subject->removeListener(&batch_listener);
+   SocketDriver driver;
+   driver.addListener(&listener_mock);
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            const std::vector<uint8_t> chunk = {8, '\n', 9, '\n'};
+            std::copy(chunk.begin(), chunk.end(), static_cast<uint8_t*>(buffer));
+            driver.m_thread_running = false;
+            return chunk.size();
+         }));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre(8), 1));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre(9), 1));
+   driver.m_thread_running = true;
+   driver.threadExecute();
+   driver.removeListener(&listener_mock);
+}
+
+/**
+ * @test Tests of receiving data without copying
+ */
+TEST_F(SocketDriverFixture, socket_read_zero_copy_tests)
+{
+   struct FramesListenerMock : public SocketListener
+   {
+      MOCK_METHOD3(onSocketEvent, void(DriverEvent, const std::vector<uint8_t>&, size_t));
+      MOCK_METHOD2(onSocketFrames, void(const FrameView*, size_t));
+   } frames_listener;
+   uint8_t* first_chunk = nullptr;
+   m_test_subject->addListener(&frames_listener);
+   /**
+    * <b>scenario</b>: Message received in two chunks.<br>
+    * <b>expected</b>: recv() never asked for more bytes than free space, frame view points to receive buffer.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, recv(_,_,SOCKDRV_RECV_BUFFER_SIZE,_))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            first_chunk = static_cast<uint8_t*>(buffer);
+            memset(first_chunk, 0xAA, 10);
+            return 10;
+         }));
+   EXPECT_CALL(*sys_call_mock, recv(_,_,SOCKDRV_RECV_BUFFER_SIZE - 10,_))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            EXPECT_EQ(static_cast<uint8_t*>(buffer), first_chunk + 10);
+            static_cast<uint8_t*>(buffer)[0] = '\n';
+            static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = false;
+            return 1;
+         }));
+   EXPECT_CALL(frames_listener, onSocketFrames(_, 1)).WillOnce(Invoke([&](const FrameView* frames, size_t)
+         {
+            EXPECT_EQ(frames[0].data, first_chunk);
+            EXPECT_EQ(frames[0].size, 10);
+         }));
+   EXPECT_CALL(frames_listener, onSocketEvent(_,_,_)).Times(0);
+   static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = true;
    static_cast<SocketDriver*>(m_test_subject.get())->threadExecute();
+   m_test_subject->removeListener(&frames_listener);
+}
 
+/**
+ * @test Tests of length-prefixed framing mode
+ */
+TEST_F(SocketDriverFixture, socket_read_length_prefixed_tests)
+{
+   m_test_subject->addListener(&listener_mock);
+   m_test_subject->setFrameLayout({2, 1, 1, 16});
+   m_test_subject->setFraming(FramingMode::LENGTH_PREFIXED);
+   /**
+    * <b>scenario</b>: Two messages received, payload contains delimiter.<br>
+    * <b>expected</b>: Messages cut using length from header.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            const std::vector<uint8_t> chunk = {1, 2, '\n', '\n', '\n', 2, 0, '\n'};
+            std::copy(chunk.begin(), chunk.end(), static_cast<uint8_t*>(buffer));
+            static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = false;
+            return chunk.size();
+         }));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre(1, 2, '\n', '\n'), 4));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre(2, 0), 2));
+   static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = true;
+   static_cast<SocketDriver*>(m_test_subject.get())->threadExecute();
    m_test_subject->removeListener(&listener_mock);
+}
+
+/**
+ * @test Tests of COBS framing mode
+ */
+TEST_F(SocketDriverFixture, socket_cobs_framing_tests)
+{
+   m_test_subject->addListener(&listener_mock);
+   m_test_subject->setFraming(FramingMode::COBS);
+   static_cast<SocketDriver*>(m_test_subject.get())->m_sock_fd = 1;
+   static_cast<SocketDriver*>(m_test_subject.get())->m_is_connected = true;
+   /**
+    * <b>scenario</b>: Data containing zero and delimiter bytes written.<br>
+    * <b>expected</b>: Encoded data with trailing zero sent.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> sent;
+   EXPECT_CALL(*sys_call_mock, send(_,_,_,_))
+         .WillOnce(Invoke([&](int, const void *message, size_t length, int)->ssize_t
+         {
+            const uint8_t* data = static_cast<const uint8_t*>(message);
+            sent.assign(data, data + length);
+            return length;
+         }));
+   EXPECT_TRUE(m_test_subject->write({1, 0, '\n'}));
+   EXPECT_THAT(sent, ElementsAre(2, 1, 2, '\n', 0));
+
+   /**
+    * <b>scenario</b>: Encoded messages received.<br>
+    * <b>expected</b>: Decoded messages passed to listener.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            const std::vector<uint8_t> chunk = {2, 1, 2, '\n', 0, 3, '\n', '\n', 0};
+            std::copy(chunk.begin(), chunk.end(), static_cast<uint8_t*>(buffer));
+            static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = false;
+            return chunk.size();
+         }));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre(1, 0, '\n'), 3));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre('\n', '\n'), 2));
+   static_cast<SocketDriver*>(m_test_subject.get())->m_thread_running = true;
+   static_cast<SocketDriver*>(m_test_subject.get())->threadExecute();
+   m_test_subject->removeListener(&listener_mock);
+}
+
+/**
+ * @test Tests of recording received data to capture file
+ */
+TEST_F(SocketDriverFixture, socket_capture_tests)
+{
+   SocketDriver* driver = static_cast<SocketDriver*>(m_test_subject.get());
+   const std::string path = "/tmp/smarthome_sockdrv_capture_" + std::to_string(getpid());
+   /**
+    * <b>scenario</b>: Capture file cannot be created.<br>
+    * <b>expected</b>: Recording not started.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(driver->startCapture("/not/existing/dir/capture"));
+
+   /**
+    * <b>scenario</b>: Recording started, message received in two chunks.<br>
+    * <b>expected</b>: Both chunks stored in capture file with increasing timestamps.<br>
+    * ************************************************
+    */
+   ASSERT_TRUE(driver->startCapture(path));
+   m_test_subject->addListener(&listener_mock);
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            memcpy(buffer, "ab", 2);
+            return 2;
+         }))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            memcpy(buffer, "c\n", 2);
+            driver->m_thread_running = false;
+            return 2;
+         }));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre('a', 'b', 'c'), 3));
+   driver->m_thread_running = true;
+   driver->threadExecute();
+   m_test_subject->removeListener(&listener_mock);
+   driver->stopCapture();
+   CaptureReader reader;
+   ASSERT_TRUE(reader.open(path));
+   ASSERT_EQ(reader.chunks(), 2);
+   EXPECT_EQ(reader.chunk(0).end, 2);
+   EXPECT_EQ(reader.chunk(1).end, 4);
+   EXPECT_LE(reader.chunk(0).timestamp_ns, reader.chunk(1).timestamp_ns);
+   EXPECT_EQ(std::string((const char*)reader.data(), 4), "abc\n");
+   unlink(path.c_str());
+}
+
+/**
+ * @test Tests of write queue in event loop mode
+ */
+TEST_F(SocketDriverFixture, write_queue_event_loop_tests)
+{
+   int SOCK_FD = 1;
+   EventLoopMock loop_mock;
+   IEventLoop::FdCallback fd_callback;
+   std::unique_ptr<ISocketDriver> driver (new SocketDriver(loop_mock));
+   std::vector<bool> results;
+   auto callback = [&](bool result){ results.push_back(result); };
+
+   /**
+    * <b>scenario</b>: Data queued when not connected.<br>
+    * <b>expected</b>: Data rejected.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(driver->writeAsync({1, 2, 3}, callback));
+
+   EXPECT_CALL(*sys_call_mock, socket(_,_,_)).WillOnce(Return(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, _)).WillOnce(Return(1));
+   EXPECT_CALL(loop_mock, addFd(SOCK_FD, EVLOOP_READ, _)).WillOnce(DoAll(SaveArg<2>(&fd_callback), Return(true)));
+   EXPECT_TRUE(driver->connect("192.168.100.100", 1111));
+
+   /**
+    * <b>scenario</b>: Three frames queued.<br>
+    * <b>expected</b>: Nothing sent from caller thread, write event requested once.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, sendmsg(_,_,_)).Times(0);
+   EXPECT_CALL(*sys_call_mock, send(_,_,_,_)).Times(0);
+   EXPECT_CALL(loop_mock, modifyFd(SOCK_FD, EVLOOP_READ | EVLOOP_WRITE)).WillOnce(Return(true));
+   EXPECT_TRUE(driver->writeAsync({1, 2, 3}, callback));
+   EXPECT_TRUE(driver->writeAsync({4, 5}, callback));
+   EXPECT_TRUE(driver->writeAsync({6}));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+   Mock::VerifyAndClearExpectations(&loop_mock);
+
+   /**
+    * <b>scenario</b>: Socket writable, only part of the data accepted by kernel.<br>
+    * <b>expected</b>: All frames passed in single sendmsg(), first frame completed.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, sendmsg(SOCK_FD,_,_))
+         .WillOnce(Invoke([&](int, const struct msghdr* msg, int flags)->ssize_t
+         {
+            EXPECT_TRUE(flags & MSG_DONTWAIT);
+            EXPECT_THAT(get_iovecs(msg), ElementsAre(ElementsAre(1, 2, 3), ElementsAre(4, 5), ElementsAre(6)));
+            return 4;
+         }))
+         .WillOnce(Invoke([](int, const struct msghdr*, int)->ssize_t{ errno = EAGAIN; return -1; }));
+   EXPECT_CALL(loop_mock, modifyFd(_,_)).Times(0);
+   fd_callback(EVLOOP_WRITE);
+   EXPECT_THAT(results, ElementsAre(true));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+   Mock::VerifyAndClearExpectations(&loop_mock);
+
+   /**
+    * <b>scenario</b>: Synchronous write requested when queue is not empty.<br>
+    * <b>expected</b>: Pending frames sent first from caller thread, then data sent, true returned when written.<br>
+    * ************************************************
+    */
+   {
+      InSequence seq;
+      EXPECT_CALL(*sys_call_mock, sendmsg(SOCK_FD,_,_))
+            .WillOnce(Invoke([&](int, const struct msghdr* msg, int)->ssize_t
+            {
+               EXPECT_THAT(get_iovecs(msg), ElementsAre(ElementsAre(5), ElementsAre(6)));
+               return 2;
+            }));
+      EXPECT_CALL(*sys_call_mock, send(SOCK_FD,_,1,_))
+            .WillOnce(Invoke([&](int, const void *message, size_t, int)->ssize_t
+            {
+               EXPECT_EQ(static_cast<const uint8_t*>(message)[0], 7);
+               return 1;
+            }));
+   }
+   EXPECT_TRUE(driver->write({7}));
+   EXPECT_THAT(results, ElementsAre(true, true));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+
+   /**
+    * <b>scenario</b>: Socket writable again.<br>
+    * <b>expected</b>: Nothing to send, write event not observed anymore.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, sendmsg(_,_,_)).Times(0);
+   EXPECT_CALL(loop_mock, modifyFd(SOCK_FD, EVLOOP_READ)).WillOnce(Return(true));
+   fd_callback(EVLOOP_WRITE);
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+   Mock::VerifyAndClearExpectations(&loop_mock);
+
+   /**
+    * <b>scenario</b>: More data queued than allowed by high water mark.<br>
+    * <b>expected</b>: Data rejected.<br>
+    * ************************************************
+    */
+   driver->setWriteHighWaterMark(4);
+   EXPECT_CALL(loop_mock, modifyFd(SOCK_FD, EVLOOP_READ | EVLOOP_WRITE)).WillOnce(Return(true));
+   EXPECT_TRUE(driver->writeAsync({1, 2, 3}, callback));
+   EXPECT_FALSE(driver->writeAsync({4, 5}, callback));
+
+   /**
+    * <b>scenario</b>: All queue entries used.<br>
+    * <b>expected</b>: Asynchronous write rejected, queued frames not overwritten.<br>
+    * ************************************************
+    */
+   driver->setWriteHighWaterMark(SOCKDRV_WRITE_HIGH_WATER_MARK);
+   for (size_t i = 1; i < SOCKDRV_WRITE_POOL_BLOCKS; i++)
+   {
+      EXPECT_TRUE(driver->writeAsync({8}));
+   }
+   EXPECT_FALSE(driver->writeAsync({9}));
+   EXPECT_EQ(driver->getStats().write_queue_frames, SOCKDRV_WRITE_POOL_BLOCKS);
+
+   /**
+    * <b>scenario</b>: Synchronous write requested, socket does not accept queued frames.<br>
+    * <b>expected</b>: Data not sent before queued frames, false returned, queued frames kept.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, sendmsg(SOCK_FD,_,_)).WillOnce(Invoke([](int, const struct msghdr*, int)->ssize_t{ errno = EAGAIN; return -1; }));
+   EXPECT_CALL(*sys_call_mock, poll(_, 1, SOCKDRV_WRITE_POLL_TIMEOUT_MS)).WillOnce(Return(0));
+   EXPECT_CALL(*sys_call_mock, send(_,_,_,_)).Times(0);
+   EXPECT_FALSE(driver->write({9}));
+   EXPECT_EQ(driver->getStats().write_queue_frames, SOCKDRV_WRITE_POOL_BLOCKS);
+
+   /**
+    * <b>scenario</b>: Disconnected with data in queue.<br>
+    * <b>expected</b>: Queued data dropped.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(loop_mock, removeFd(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   driver->disconnect();
+   EXPECT_THAT(results, ElementsAre(true, true, false));
+}
+
+/**
+ * @test Tests of write queue in thread mode
+ */
+TEST_F(SocketDriverFixture, write_queue_thread_tests)
+{
+   int SOCK_FD = 1;
+   std::mutex mtx;
+   std::condition_variable cv;
+   std::vector<bool> results;
+   auto callback = [&](bool result)
+   {
+      std::lock_guard<std::mutex> lock (mtx);
+      results.push_back(result);
+      cv.notify_all();
+   };
+   auto wait_results = [&](size_t count)
+   {
+      std::unique_lock<std::mutex> lock (mtx);
+      return cv.wait_for(lock, std::chrono::seconds(1), [&](){ return results.size() == count; });
+   };
+   SocketDriver* driver = static_cast<SocketDriver*>(m_test_subject.get());
+   driver->m_sock_fd = SOCK_FD;
+   driver->m_is_connected = true;
+
+   /**
+    * <b>scenario</b>: Frame queued, socket buffer full.<br>
+    * <b>expected</b>: Writer thread waits until socket is writable, then sends the frame.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, sendmsg(SOCK_FD,_,_))
+         .WillOnce(Invoke([](int, const struct msghdr*, int)->ssize_t{ errno = EAGAIN; return -1; }))
+         .WillOnce(Invoke([&](int, const struct msghdr* msg, int)->ssize_t
+         {
+            EXPECT_THAT(get_iovecs(msg), ElementsAre(ElementsAre(1, 2)));
+            return 2;
+         }));
+   EXPECT_CALL(*sys_call_mock, poll(_, 1, SOCKDRV_WRITE_POLL_TIMEOUT_MS))
+         .WillOnce(Invoke([&](struct pollfd* fds, nfds_t, int)->int
+         {
+            EXPECT_EQ(fds[0].fd, SOCK_FD);
+            EXPECT_EQ(fds[0].events, POLLOUT);
+            return 1;
+         }));
+   EXPECT_TRUE(m_test_subject->writeAsync({1, 2}, callback));
+   EXPECT_TRUE(wait_results(1));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+
+   /**
+    * <b>scenario</b>: Write error.<br>
+    * <b>expected</b>: Frame dropped.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, sendmsg(SOCK_FD,_,_)).WillOnce(Invoke([](int, const struct msghdr*, int)->ssize_t{ errno = EPIPE; return -1; }));
+   EXPECT_TRUE(m_test_subject->writeAsync({3}, callback));
+   EXPECT_TRUE(wait_results(2));
+   EXPECT_THAT(results, ElementsAre(true, false));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+
+   /**
+    * <b>scenario</b>: Frame queued while synchronous write blocks in send().<br>
+    * <b>expected</b>: Caller of writeAsync() not blocked, frame sent after synchronous write.<br>
+    * ************************************************
+    */
+   bool send_started = false;
+   bool send_released = false;
+   EXPECT_CALL(*sys_call_mock, send(SOCK_FD,_,1,_))
+         .WillOnce(Invoke([&](int, const void*, size_t length, int)->ssize_t
+         {
+            std::unique_lock<std::mutex> lock (mtx);
+            send_started = true;
+            cv.notify_all();
+            cv.wait(lock, [&](){ return send_released; });
+            return length;
+         }));
+   std::thread writer ([&](){ EXPECT_TRUE(m_test_subject->write({4})); });
+   {
+      std::unique_lock<std::mutex> lock (mtx);
+      ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(1), [&](){ return send_started; }));
+   }
+   EXPECT_CALL(*sys_call_mock, sendmsg(SOCK_FD,_,_)).WillOnce(Invoke([&](int, const struct msghdr* msg, int)->ssize_t
+         {
+            EXPECT_TRUE(send_released);
+            EXPECT_THAT(get_iovecs(msg), ElementsAre(ElementsAre(5)));
+            return 1;
+         }));
+   EXPECT_TRUE(m_test_subject->writeAsync({5}, callback));
+   {
+      std::lock_guard<std::mutex> lock (mtx);
+      send_released = true;
+      cv.notify_all();
+   }
+   writer.join();
+   EXPECT_TRUE(wait_results(3));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+
+   /**
+    * <b>scenario</b>: Disconnected while synchronous write blocks in send().<br>
+    * <b>expected</b>: Socket shut down to finish the write, socket closed after it, write failed.<br>
+    * ************************************************
+    */
+   send_started = false;
+   send_released = false;
+   EXPECT_CALL(*sys_call_mock, send(SOCK_FD,_,1,_))
+         .WillOnce(Invoke([&](int, const void*, size_t, int)->ssize_t
+         {
+            std::unique_lock<std::mutex> lock (mtx);
+            send_started = true;
+            cv.notify_all();
+            cv.wait(lock, [&](){ return send_released; });
+            errno = EPIPE;
+            return -1;
+         }));
+   writer = std::thread([&](){ EXPECT_FALSE(m_test_subject->write({6})); });
+   {
+      std::unique_lock<std::mutex> lock (mtx);
+      ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(1), [&](){ return send_started; }));
+   }
+   {
+      InSequence seq;
+      EXPECT_CALL(*sys_call_mock, shutdown(SOCK_FD, SHUT_RDWR)).WillOnce(Invoke([&](int, int)->int
+            {
+               std::lock_guard<std::mutex> lock (mtx);
+               send_released = true;
+               cv.notify_all();
+               return 0;
+            }));
+      EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   }
+   EXPECT_CALL(*sys_call_mock, sendmsg(_,_,_)).Times(0);
+   m_test_subject->disconnect();
+   writer.join();
+   EXPECT_FALSE(m_test_subject->writeAsync({7}, callback));
+   EXPECT_FALSE(m_test_subject->write({7}));
+}
+
+/**
+ * @test Tests of driver working in event loop mode
+ */
+TEST_F(SocketDriverFixture, event_loop_mode_tests)
+{
+   int SOCK_FD = 1;
+   EventLoopMock loop_mock;
+   IEventLoop::FdCallback fd_callback;
+   std::unique_ptr<ISocketDriver> driver (new SocketDriver(loop_mock));
+   driver->addListener(&listener_mock);
+
+   /**
+    * <b>scenario</b>: Connected to server.<br>
+    * <b>expected</b>: Socket registered in event loop, no recv() called from connect.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, _)).WillOnce(Return(1));
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).Times(0);
+   EXPECT_CALL(loop_mock, addFd(SOCK_FD, EVLOOP_READ, _)).WillOnce(DoAll(SaveArg<2>(&fd_callback), Return(true)));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   EXPECT_TRUE(driver->connect("192.168.100.100", 1111));
+   EXPECT_TRUE(driver->isConnected());
+   ASSERT_TRUE(!!fd_callback);
+
+   /**
+    * <b>scenario</b>: Socket readable, complete message received.<br>
+    * <b>expected</b>: Single recv() called, listener notified.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, recv(SOCK_FD,_,_,_))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            uint8_t* buf = static_cast<uint8_t*>(buffer);
+            buf[0] = 1;
+            buf[1] = 2;
+            buf[2] = '\n';
+            return 3;
+         }));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV,_,_)).WillOnce(Invoke([&](DriverEvent, const std::vector<uint8_t>& data, size_t size)
+         {
+            EXPECT_EQ(size, 2);
+            EXPECT_THAT(data, ElementsAre(1,2));
+         }));
+   fd_callback(EVLOOP_READ);
+
+   /**
+    * <b>scenario</b>: Server closed connection.<br>
+    * <b>expected</b>: Socket removed from event loop and closed, listener notified.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, recv(SOCK_FD,_,_,_)).WillOnce(Return(0));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DISCONNECTED,_,_));
+   EXPECT_CALL(loop_mock, removeFd(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   fd_callback(EVLOOP_READ);
+   EXPECT_FALSE(driver->isConnected());
+
+   /**
+    * <b>scenario</b>: Connection lost again, listener disconnects the driver when notified.<br>
+    * <b>expected</b>: Socket removed from event loop and closed only once.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, _)).WillOnce(Return(1));
+   EXPECT_CALL(loop_mock, addFd(SOCK_FD, EVLOOP_READ, _)).WillOnce(DoAll(SaveArg<2>(&fd_callback), Return(true)));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   EXPECT_TRUE(driver->connect("192.168.100.100", 1111));
+   EXPECT_CALL(*sys_call_mock, recv(SOCK_FD,_,_,_)).WillOnce(Return(0));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DISCONNECTED,_,_)).WillOnce(InvokeWithoutArgs([&](){ driver->disconnect(); }));
+   EXPECT_CALL(loop_mock, removeFd(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   fd_callback(EVLOOP_READ);
+   EXPECT_FALSE(driver->isConnected());
+
+   /**
+    * <b>scenario</b>: Driver destroyed after connection lost.<br>
+    * <b>expected</b>: Socket not closed twice.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, close(_)).Times(0);
+   driver.reset(nullptr);
+}
+
+/**
+ * @test Tests of connection established by event loop
+ */
+TEST_F(SocketDriverFixture, connect_event_loop_tests)
+{
+   int SOCK_FD = 1;
+   int FLAGS = 0x02;
+   const IEventLoop::TimerId TIMER_ID = 7;
+   EventLoopMock loop_mock;
+   IEventLoop::TimerCallback timer_callback;
+   IEventLoop::FdCallback fd_callback;
+   std::vector<int> results;
+   auto on_result = [&](int index){ results.push_back(index); };
+   auto connect_in_progress = [](int, const struct sockaddr*, socklen_t)->int { errno = EINPROGRESS; return -1; };
+   auto set_error = [](int error)
+   {
+      return [error](int, int, int, void* value, socklen_t*)->int
+      {
+         *static_cast<int*>(value) = error;
+         return 0;
+      };
+   };
+   std::unique_ptr<ISocketDriver> driver (new SocketDriver(loop_mock));
+   driver->addListener(&listener_mock);
+   /* connection started from loop thread, connecting socket observed by the loop */
+   auto start_connection = [&]()
+   {
+      EXPECT_CALL(loop_mock, addTimer(std::chrono::milliseconds(0), _)).WillOnce(DoAll(SaveArg<1>(&timer_callback), Return(TIMER_ID)));
+      EXPECT_CALL(*sys_call_mock, socket(_,_,_)).Times(0);
+      driver->connectAsync({{"192.168.100.100", 1111}}, on_result);
+      Mock::VerifyAndClearExpectations(sys_call_mock);
+      Mock::VerifyAndClearExpectations(&loop_mock);
+      ASSERT_TRUE(!!timer_callback);
+
+      EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(SOCK_FD));
+      EXPECT_CALL(*sys_call_mock, fcntl(SOCK_FD, F_GETFL, _)).WillRepeatedly(Return(FLAGS));
+      EXPECT_CALL(*sys_call_mock, fcntl(SOCK_FD, F_SETFL, FLAGS | O_NONBLOCK)).WillOnce(Return(0));
+      EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, _)).WillOnce(Invoke(connect_in_progress));
+      EXPECT_CALL(*sys_call_mock, poll(_,_,_)).Times(0);
+      EXPECT_CALL(loop_mock, addFd(SOCK_FD, EVLOOP_WRITE, _)).WillOnce(DoAll(SaveArg<2>(&fd_callback), Return(true)));
+      EXPECT_CALL(loop_mock, addTimer(Le(std::chrono::milliseconds(SOCKDRV_CONNECT_TIMEOUT_MS)), _))
+            .WillOnce(DoAll(SaveArg<1>(&timer_callback), Return(TIMER_ID + 1)));
+      IEventLoop::TimerCallback callback = timer_callback;
+      callback();
+      ASSERT_TRUE(!!fd_callback);
+   };
+
+   /**
+    * <b>scenario</b>: Server accepts connection after connect is started.<br>
+    * <b>expected</b>: Loop thread not blocked, socket observed for reading after connection, result reported.<br>
+    * ************************************************
+    */
+   start_connection();
+   EXPECT_TRUE(results.empty());
+   EXPECT_FALSE(driver->isConnected());
+   EXPECT_CALL(*sys_call_mock, getsockopt(SOCK_FD, SOL_SOCKET, SO_ERROR, _, _)).WillOnce(Invoke(set_error(0)));
+   EXPECT_CALL(*sys_call_mock, fcntl(SOCK_FD, F_SETFL, FLAGS)).WillOnce(Return(0));
+   EXPECT_CALL(loop_mock, cancelTimer(TIMER_ID + 1));
+   {
+      InSequence seq;
+      EXPECT_CALL(loop_mock, removeFd(SOCK_FD));
+      EXPECT_CALL(loop_mock, addFd(SOCK_FD, EVLOOP_READ, _)).WillOnce(Return(true));
+   }
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   fd_callback(EVLOOP_WRITE);
+   EXPECT_THAT(results, ElementsAre(0));
+   EXPECT_TRUE(driver->isConnected());
+   EXPECT_CALL(loop_mock, removeFd(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   driver->disconnect();
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+   Mock::VerifyAndClearExpectations(&loop_mock);
+   Mock::VerifyAndClearExpectations(&listener_mock);
+   results.clear();
 
+   /**
+    * <b>scenario</b>: Server refused connection.<br>
+    * <b>expected</b>: Socket closed, failure reported.<br>
+    * ************************************************
+    */
+   start_connection();
+   EXPECT_CALL(*sys_call_mock, getsockopt(SOCK_FD, SOL_SOCKET, SO_ERROR, _, _)).WillOnce(Invoke(set_error(ECONNREFUSED)));
+   EXPECT_CALL(loop_mock, removeFd(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   EXPECT_CALL(loop_mock, cancelTimer(TIMER_ID + 1));
+   EXPECT_CALL(listener_mock, onSocketEvent(_,_,_)).Times(0);
+   fd_callback(EVLOOP_WRITE | EVLOOP_ERROR);
+   EXPECT_THAT(results, ElementsAre(-1));
+   EXPECT_FALSE(driver->isConnected());
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+   Mock::VerifyAndClearExpectations(&loop_mock);
+   results.clear();
+
+   /**
+    * <b>scenario</b>: Server does not respond until timeout.<br>
+    * <b>expected</b>: Socket closed when deadline timer expires, failure reported.<br>
+    * ************************************************
+    */
+   start_connection();
+   std::this_thread::sleep_for(std::chrono::milliseconds(SOCKDRV_CONNECT_TIMEOUT_MS));
+   EXPECT_CALL(loop_mock, removeFd(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   timer_callback();
+   EXPECT_THAT(results, ElementsAre(-1));
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+   Mock::VerifyAndClearExpectations(&loop_mock);
+   results.clear();
+
+   /**
+    * <b>scenario</b>: Driver disconnected while connection is in progress.<br>
+    * <b>expected</b>: Attempt abandoned, result not reported.<br>
+    * ************************************************
+    */
+   start_connection();
+   EXPECT_CALL(loop_mock, cancelTimer(TIMER_ID + 1));
+   EXPECT_CALL(loop_mock, removeFd(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   driver->disconnect();
+   EXPECT_TRUE(results.empty());
+
+   driver->removeListener(&listener_mock);
+}
+
+/**
+ * @test Tests of connection to one of several servers established by event loop
+ */
+TEST_F(SocketDriverFixture, connect_any_event_loop_tests)
+{
+   int FD_A = 3;
+   int FD_B = 4;
+   int FD_C = 5;
+   int FLAGS = 0x02;
+   const IEventLoop::TimerId TIMER_ID = 7;
+   const std::vector<SocketEndpoint> endpoints = {{"192.168.100.100", 1111}, {"192.168.100.101", 1111}, {"192.168.100.102", 1111}};
+   EventLoopMock loop_mock;
+   IEventLoop::TimerCallback timer_callback;
+   std::map<int, IEventLoop::FdCallback> fd_callbacks;
+   std::vector<int> results;
+   auto connect_in_progress = [](int, const struct sockaddr*, socklen_t)->int { errno = EINPROGRESS; return -1; };
+   auto save_fd_callback = [&](int fd, uint32_t, IEventLoop::FdCallback callback)->bool
+   {
+      fd_callbacks[fd] = callback;
+      return true;
+   };
+   std::unique_ptr<ISocketDriver> driver (new SocketDriver(loop_mock));
+   driver->addListener(&listener_mock);
+   EXPECT_CALL(*sys_call_mock, fcntl(_, F_GETFL, _)).WillRepeatedly(Return(FLAGS));
+   EXPECT_CALL(*sys_call_mock, fcntl(_, F_SETFL, _)).WillRepeatedly(Return(0));
+   EXPECT_CALL(loop_mock, addTimer(std::chrono::milliseconds(0), _)).WillOnce(DoAll(SaveArg<1>(&timer_callback), Return(TIMER_ID)));
+   driver->connectAsync(endpoints, [&](int index){ results.push_back(index); });
+   ASSERT_TRUE(!!timer_callback);
+
+   /**
+    * <b>scenario</b>: First server refused connection immediately, second one does not respond.<br>
+    * <b>expected</b>: Second server tried without waiting for hedge delay, timer armed for hedge delay, loop thread not blocked.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, poll(_,_,_)).Times(0);
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(FD_A)).WillOnce(Return(FD_B));
+   EXPECT_CALL(*sys_call_mock, connect(FD_A, _, _)).WillOnce(Invoke([](int, const struct sockaddr*, socklen_t)->int { errno = ECONNREFUSED; return -1; }));
+   EXPECT_CALL(*sys_call_mock, close(FD_A));
+   EXPECT_CALL(*sys_call_mock, connect(FD_B, _, _)).WillOnce(Invoke(connect_in_progress));
+   EXPECT_CALL(loop_mock, addFd(FD_B, EVLOOP_WRITE, _)).WillOnce(Invoke(save_fd_callback));
+   EXPECT_CALL(loop_mock, addTimer(Le(std::chrono::milliseconds(SOCKDRV_HEDGE_DELAY_MS)), _))
+         .WillOnce(DoAll(SaveArg<1>(&timer_callback), Return(TIMER_ID + 1)));
+   IEventLoop::TimerCallback callback = timer_callback;
+   callback();
+   EXPECT_TRUE(results.empty());
+   Mock::VerifyAndClearExpectations(&loop_mock);
+
+   /**
+    * <b>scenario</b>: Hedge delay expired.<br>
+    * <b>expected</b>: Third server tried without abandoning the second one.<br>
+    * ************************************************
+    */
+   std::this_thread::sleep_for(std::chrono::milliseconds(SOCKDRV_HEDGE_DELAY_MS));
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(FD_C));
+   EXPECT_CALL(*sys_call_mock, connect(FD_C, _, _)).WillOnce(Invoke(connect_in_progress));
+   EXPECT_CALL(loop_mock, addFd(FD_C, EVLOOP_WRITE, _)).WillOnce(Invoke(save_fd_callback));
+   EXPECT_CALL(loop_mock, addTimer(Le(std::chrono::milliseconds(SOCKDRV_CONNECT_TIMEOUT_MS)), _)).WillOnce(Return(TIMER_ID + 2));
+   EXPECT_CALL(*sys_call_mock, close(_)).Times(0);
+   callback = timer_callback;
+   callback();
+   EXPECT_TRUE(results.empty());
+   Mock::VerifyAndClearExpectations(sys_call_mock);
+   Mock::VerifyAndClearExpectations(&loop_mock);
+
+   /**
+    * <b>scenario</b>: Third server accepts the connection.<br>
+    * <b>expected</b>: Connection established with it, second attempt abandoned, index reported.<br>
+    * ************************************************
+    */
+   ASSERT_TRUE(fd_callbacks.count(FD_C));
+   EXPECT_CALL(*sys_call_mock, fcntl(_, F_SETFL, _)).WillRepeatedly(Return(0));
+   EXPECT_CALL(*sys_call_mock, getsockopt(FD_B, _, _, _, _)).Times(0);
+   EXPECT_CALL(*sys_call_mock, getsockopt(FD_C, SOL_SOCKET, SO_ERROR, _, _)).WillOnce(Return(0));
+   EXPECT_CALL(loop_mock, removeFd(FD_B));
+   EXPECT_CALL(*sys_call_mock, close(FD_B));
+   EXPECT_CALL(loop_mock, cancelTimer(TIMER_ID + 2));
+   EXPECT_CALL(loop_mock, removeFd(FD_C));
+   EXPECT_CALL(loop_mock, addFd(FD_C, EVLOOP_READ, _)).WillOnce(Return(true));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   fd_callbacks[FD_C](EVLOOP_WRITE);
+   EXPECT_THAT(results, ElementsAre(2));
+   EXPECT_TRUE(driver->isConnected());
+
+   EXPECT_CALL(loop_mock, removeFd(FD_C));
+   EXPECT_CALL(*sys_call_mock, close(FD_C));
+   driver->removeListener(&listener_mock);
+   driver.reset(nullptr);
+}
+
+/**
+ * @test Tests of event loop connection to host name which is not resolved yet
+ */
+TEST_F(SocketDriverFixture, connect_async_host_name_tests)
+{
+   int FD_INET6 = 1;
+   int FD_INET = 2;
+   const IEventLoop::TimerId TIMER_ID = 7;
+   EventLoopMock loop_mock;
+   IEventLoop::TimerCallback timer_callback;
+   IEventLoop::FdCallback fd_callback;
+   std::vector<int> results;
+   std::mutex mtx;
+   std::condition_variable cv;
+   bool dns_answered = false;
+   std::unique_ptr<ISocketDriver> driver (new SocketDriver(loop_mock));
+   driver->addListener(&listener_mock);
+
+   /**
+    * <b>scenario</b>: Connection requested, DNS server does not answer yet.<br>
+    * <b>expected</b>: Loop thread not blocked, resolution checked again by timer.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, getaddrinfo(StrEq("dualhost"),_,_,_))
+         .WillOnce(Invoke([&](const char* node, const char* service, const struct addrinfo* hints, struct addrinfo** res)->int
+         {
+            std::unique_lock<std::mutex> lock (mtx);
+            cv.wait_for(lock, std::chrono::seconds(5), [&](){ return dns_answered; });
+            return resolve_dual_stack(node, service, hints, res);
+         }));
+   EXPECT_CALL(loop_mock, addTimer(std::chrono::milliseconds(0), _)).WillOnce(DoAll(SaveArg<1>(&timer_callback), Return(TIMER_ID)));
+   driver->connectAsync({{"dualhost", 1111}}, [&](int index){ results.push_back(index); });
+   EXPECT_CALL(*sys_call_mock, socket(_,_,_)).Times(0);
+   EXPECT_CALL(loop_mock, addTimer(std::chrono::milliseconds(SOCKDRV_RESOLVE_POLL_MS), _))
+         .WillOnce(DoAll(SaveArg<1>(&timer_callback), Return(TIMER_ID + 1)));
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   IEventLoop::TimerCallback callback = timer_callback;
+   callback();
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(SOCKDRV_RESOLVE_POLL_MS));
+   EXPECT_TRUE(results.empty());
+   /* expectations of system calls are kept, resolver thread is still waiting for DNS answer */
+   Mock::VerifyAndClearExpectations(&loop_mock);
+
+   /**
+    * <b>scenario</b>: Host resolved to IPv6 and IPv4 address, IPv6 connection refused.<br>
+    * <b>expected</b>: IPv4 address tried without waiting for hedge delay, connected.<br>
+    * ************************************************
+    */
+   {
+      std::lock_guard<std::mutex> lock (mtx);
+      dns_answered = true;
+      cv.notify_all();
+   }
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET6, SOCK_STREAM, 0)).WillOnce(Return(FD_INET6));
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(FD_INET));
+   EXPECT_CALL(*sys_call_mock, connect(FD_INET6, _, _))
+         .WillOnce(Invoke([](int, const struct sockaddr*, socklen_t)->int { errno = ECONNREFUSED; return -1; }));
+   EXPECT_CALL(*sys_call_mock, connect(FD_INET, _, _))
+         .WillOnce(Invoke([](int, const struct sockaddr*, socklen_t)->int { errno = EINPROGRESS; return -1; }));
+   EXPECT_CALL(*sys_call_mock, close(FD_INET6));
+   EXPECT_CALL(loop_mock, addFd(FD_INET, EVLOOP_WRITE, _)).WillOnce(DoAll(SaveArg<2>(&fd_callback), Return(true)));
+   EXPECT_CALL(loop_mock, addTimer(_, _)).WillRepeatedly(DoAll(SaveArg<1>(&timer_callback), Return(TIMER_ID + 2)));
+   EXPECT_CALL(loop_mock, cancelTimer(_)).Times(AnyNumber());
+   /* resolver thread stores the result shortly after DNS answer */
+   for (size_t i = 0; i < 100 && !fd_callback; i++)
+   {
+      std::this_thread::sleep_for(std::chrono::milliseconds(SOCKDRV_RESOLVE_POLL_MS));
+      callback = timer_callback;
+      callback();
+   }
+   ASSERT_TRUE(!!fd_callback);
+   EXPECT_CALL(*sys_call_mock, getsockopt(FD_INET, SOL_SOCKET, SO_ERROR, _, _)).WillOnce(Return(0));
+   EXPECT_CALL(loop_mock, removeFd(FD_INET));
+   EXPECT_CALL(loop_mock, addFd(FD_INET, EVLOOP_READ, _)).WillOnce(Return(true));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   fd_callback(EVLOOP_WRITE);
+   EXPECT_THAT(results, ElementsAre(0));
+   EXPECT_TRUE(driver->isConnected());
+
+   EXPECT_CALL(loop_mock, removeFd(FD_INET));
+   EXPECT_CALL(*sys_call_mock, close(FD_INET));
+   driver->removeListener(&listener_mock);
+   driver.reset(nullptr);
+}
+
+#if defined (SOCKDRV_URING)
+/**
+ * @test Tests of io_uring backend when io_uring is not available
+ */
+TEST_F(SocketDriverFixture, uring_fallback_tests)
+{
+   int SOCK_FD = 1;
+   EventLoopMock loop_mock;
+   IEventLoop::FdCallback fd_callback;
+   std::unique_ptr<ISocketDriver> driver (new SocketDriver(loop_mock, SocketBackend::URING));
+   driver->addListener(&listener_mock);
+
+   /**
+    * <b>scenario</b>: Connected to server, kernel does not support io_uring.<br>
+    * <b>expected</b>: Socket registered in event loop, data received by recv().<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, connect(SOCK_FD, _, _)).WillOnce(Return(1));
+   EXPECT_CALL(*sys_call_mock, io_uring_setup(_,_)).WillOnce(Invoke([](uint32_t, struct io_uring_params*)->int
+         {
+            errno = ENOSYS;
+            return -1;
+         }));
+   EXPECT_CALL(loop_mock, addFd(SOCK_FD, EVLOOP_READ, _)).WillOnce(DoAll(SaveArg<2>(&fd_callback), Return(true)));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   EXPECT_TRUE(driver->connect("192.168.100.100", 1111));
+   ASSERT_TRUE(!!fd_callback);
+
+   EXPECT_CALL(*sys_call_mock, recv(SOCK_FD,_,_,_))
+         .WillOnce(Invoke([&](int, void *buffer, size_t, int)->ssize_t
+         {
+            uint8_t* buf = static_cast<uint8_t*>(buffer);
+            buf[0] = 1;
+            buf[1] = '\n';
+            return 2;
+         }));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre(1), 1));
+   fd_callback(EVLOOP_READ);
+
+   /**
+    * <b>scenario</b>: Frame queued for sending.<br>
+    * <b>expected</b>: Socket observed for writing, frame sent by sendmsg().<br>
+    * ************************************************
+    */
+   EXPECT_CALL(loop_mock, modifyFd(SOCK_FD, EVLOOP_READ | EVLOOP_WRITE)).WillOnce(Return(true));
+   EXPECT_TRUE(driver->writeAsync({1, 2}));
+   EXPECT_CALL(*sys_call_mock, sendmsg(SOCK_FD, _, _)).WillOnce(Return(2));
+   EXPECT_CALL(loop_mock, modifyFd(SOCK_FD, EVLOOP_READ)).WillOnce(Return(true));
+   fd_callback(EVLOOP_WRITE);
+
+   EXPECT_CALL(loop_mock, removeFd(SOCK_FD));
+   EXPECT_CALL(*sys_call_mock, close(SOCK_FD));
+   driver->disconnect();
+   driver->removeListener(&listener_mock);
+}
+
+/**
+ * @test Tests of io_uring backend in event loop mode
+ */
+TEST_F(SocketDriverFixture, uring_event_loop_tests)
+{
+   int sockets [2];
+   int ring_fd = -1;
+   EventLoopMock loop_mock;
+   IEventLoop::FdCallback fd_callback;
+   std::vector<bool> write_results;
+   useRealUring();
+   if (!isUringSupported())
+   {
+      GTEST_SKIP() << "io_uring not supported";
+   }
+   ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+   std::unique_ptr<ISocketDriver> driver (new SocketDriver(loop_mock, SocketBackend::URING));
+   driver->addListener(&listener_mock);
+   /* runs single event loop iteration */
+   auto run_loop = [&]()
+   {
+      struct pollfd fd = {ring_fd, POLLIN, 0};
+      ASSERT_EQ(::poll(&fd, 1, 1000), 1);
+      fd_callback(EVLOOP_READ);
+   };
+
+   /**
+    * <b>scenario</b>: Connected to server.<br>
+    * <b>expected</b>: Ring registered in event loop instead of socket.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, socket(AF_INET, SOCK_STREAM, 0)).WillOnce(Return(sockets[0]));
+   EXPECT_CALL(*sys_call_mock, connect(sockets[0], _, _)).WillOnce(Return(0));
+   EXPECT_CALL(loop_mock, addFd(Ne(sockets[0]), EVLOOP_READ, _)).WillOnce(DoAll(SaveArg<0>(&ring_fd), SaveArg<2>(&fd_callback), Return(true)));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   EXPECT_TRUE(driver->connect("192.168.100.100", 1111));
+   ASSERT_TRUE(!!fd_callback);
+
+   /**
+    * <b>scenario</b>: Server sends two frames and beginning of the third.<br>
+    * <b>expected</b>: Frames delivered without recv() call.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).Times(0);
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre(1, 2), 2));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV, ElementsAre(3), 1));
+   ASSERT_EQ(::write(sockets[1], "\x01\x02\n\x03\n\x04", 6), 6);
+   run_loop();
+   Mock::VerifyAndClearExpectations(&listener_mock);
+
+   /**
+    * <b>scenario</b>: Server sends more data than all io_uring buffers can hold.<br>
+    * <b>expected</b>: All frames delivered.<br>
+    * ************************************************
+    */
+   const size_t FRAMES_COUNT = SOCKDRV_URING_BUFFER_COUNT * SOCKDRV_URING_BUFFER_SIZE / 4;
+   std::vector<uint8_t> stream;
+   for (size_t i = 0; i < FRAMES_COUNT; i++)
+   {
+      stream.insert(stream.end(), {5, 6, 7, '\n'});
+   }
+   size_t frames = 0;
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV,_,_)).WillRepeatedly(Invoke([&](DriverEvent, const std::vector<uint8_t>& data, size_t)
+         {
+            frames++;
+            EXPECT_EQ(data, frames == 1? std::vector<uint8_t>({4, 5, 6, 7}) : std::vector<uint8_t>({5, 6, 7}));
+         }));
+   ASSERT_EQ(::write(sockets[1], stream.data(), stream.size()), (ssize_t)stream.size());
+   while (frames < FRAMES_COUNT)
+   {
+      run_loop();
+   }
+   EXPECT_EQ(frames, FRAMES_COUNT);
+   Mock::VerifyAndClearExpectations(&listener_mock);
+
+   /**
+    * <b>scenario</b>: Two frames queued for sending.<br>
+    * <b>expected</b>: Frames sent by io_uring, callbacks called from loop thread on completion.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, sendmsg(_,_,_)).Times(0);
+   EXPECT_CALL(loop_mock, modifyFd(_,_)).Times(0);
+   EXPECT_TRUE(driver->writeAsync({8, 9}, [&](bool result){ write_results.push_back(result); }));
+   EXPECT_TRUE(driver->writeAsync({10}, [&](bool result){ write_results.push_back(result); }));
+   while (write_results.size() < 2)
+   {
+      run_loop();
+   }
+   EXPECT_THAT(write_results, ElementsAre(true, true));
+   uint8_t buffer [8];
+   EXPECT_EQ(::read(sockets[1], buffer, sizeof(buffer)), 3);
+   EXPECT_THAT(std::vector<uint8_t>(buffer, buffer + 3), ElementsAre(8, 9, 10));
+   EXPECT_EQ(driver->getStats().bytes_sent, 3);
+   EXPECT_EQ(driver->getStats().write_queue_frames, 0);
+
+   /**
+    * <b>scenario</b>: Server closed connection.<br>
+    * <b>expected</b>: Ring removed from event loop, socket closed, listener notified.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DISCONNECTED,_,_));
+   EXPECT_CALL(loop_mock, removeFd(ring_fd));
+   EXPECT_CALL(*sys_call_mock, close(sockets[0]));
+   ::close(sockets[1]);
+   run_loop();
+   EXPECT_FALSE(driver->isConnected());
+   driver->removeListener(&listener_mock);
+   driver.reset(nullptr);
+   ::close(sockets[0]);
+}
+
+/**
+ * @test Tests of io_uring backend in thread mode
+ */
+TEST_F(SocketDriverFixture, uring_thread_tests)
+{
+   int sockets [2];
+   std::mutex mtx;
+   std::condition_variable cv;
+   size_t frames = 0;
+   useRealUring();
+   if (!isUringSupported())
+   {
+      GTEST_SKIP() << "io_uring not supported";
+   }
+   ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+   m_test_subject.reset(new SocketDriver(SocketBackend::URING));
+   m_test_subject->addListener(&listener_mock);
+
+   /**
+    * <b>scenario</b>: Connected to server, server sends frames.<br>
+    * <b>expected</b>: Frames delivered from driver thread without recv() call.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, socket(_,_,_)).WillOnce(Return(sockets[0]));
+   EXPECT_CALL(*sys_call_mock, connect(sockets[0], _, _)).WillOnce(Return(0));
+   EXPECT_CALL(*sys_call_mock, recv(_,_,_,_)).Times(0);
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_CONNECTED,_,_));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DATA_RECV,_,_)).Times(2).WillRepeatedly(InvokeWithoutArgs([&]()
+         {
+            std::lock_guard<std::mutex> lock (mtx);
+            frames++;
+            cv.notify_all();
+         }));
+   EXPECT_TRUE(m_test_subject->connect("192.168.100.100", 1111));
+   ASSERT_EQ(::write(sockets[1], "\x01\n\x02\n", 4), 4);
+   {
+      std::unique_lock<std::mutex> lock (mtx);
+      EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&](){ return frames == 2; }));
+   }
+
+   /**
+    * <b>scenario</b>: Frame queued for sending while driver thread waits for data.<br>
+    * <b>expected</b>: Frame sent without writer thread and sendmsg() call.<br>
+    * ************************************************
+    */
+   bool written = false;
+   EXPECT_CALL(*sys_call_mock, sendmsg(_,_,_)).Times(0);
+   EXPECT_TRUE(m_test_subject->writeAsync({3, 4}, [&](bool result)
+         {
+            std::lock_guard<std::mutex> lock (mtx);
+            written = result;
+            cv.notify_all();
+         }));
+   {
+      std::unique_lock<std::mutex> lock (mtx);
+      EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&](){ return written; }));
+   }
+   uint8_t buffer [8];
+   EXPECT_EQ(::read(sockets[1], buffer, sizeof(buffer)), 2);
+
+   /**
+    * <b>scenario</b>: Disconnect requested when driver thread waits for completions.<br>
+    * <b>expected</b>: Socket shut down to wake up the thread, disconnection not reported.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*sys_call_mock, shutdown(sockets[0], SHUT_RDWR)).WillOnce(Invoke([](int socket, int how)->int
+         {
+            return ::shutdown(socket, how);
+         }));
+   EXPECT_CALL(listener_mock, onSocketEvent(DriverEvent::DRIVER_DISCONNECTED,_,_)).Times(0);
+   EXPECT_CALL(*sys_call_mock, close(sockets[0]));
+   m_test_subject->disconnect();
+   EXPECT_FALSE(m_test_subject->isConnected());
+   m_test_subject->removeListener(&listener_mock);
+   ::close(sockets[0]);
+   ::close(sockets[1]);
 }
+#endif
@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "StateCache.h"
+/* ============================= */
+/**
+ * @file StateCacheTests.cpp
+ *
+ * @brief Unit tests to verify behavior of StateCache.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+/**
+ * @test Tests of input and fan change detection
+ */
+TEST(StateCacheTests, state_change_tests)
+{
+   StateCache cache;
+   /**
+    * <b>scenario</b>: First state of input received.<br>
+    * <b>expected</b>: State forwarded.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(cache.updateInput(3, 0));
+
+   /**
+    * <b>scenario</b>: Same state received again.<br>
+    * <b>expected</b>: State suppressed and counted for this input only.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(cache.updateInput(3, 0));
+   EXPECT_FALSE(cache.updateInput(3, 0));
+   EXPECT_EQ(cache.inputSuppressed(3), 2);
+   EXPECT_EQ(cache.inputSuppressed(4), 0);
+
+   /**
+    * <b>scenario</b>: State of other input and changed state received.<br>
+    * <b>expected</b>: States forwarded.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(cache.updateInput(4, 0));
+   EXPECT_TRUE(cache.updateInput(3, 1));
+
+   /**
+    * <b>scenario</b>: Fan state received twice, then changed.<br>
+    * <b>expected</b>: Repeated state suppressed.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(cache.updateFan(2));
+   EXPECT_FALSE(cache.updateFan(2));
+   EXPECT_TRUE(cache.updateFan(0));
+   EXPECT_EQ(cache.fanSuppressed(), 1);
+}
+
+/**
+ * @test Tests of env change detection
+ */
+TEST(StateCacheTests, env_change_tests)
+{
+   StateCache cache;
+   /**
+    * <b>scenario</b>: Env state received, then repeated.<br>
+    * <b>expected</b>: Repeated state suppressed.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(cache.updateEnv(1, 21, 5, 40, 0));
+   EXPECT_FALSE(cache.updateEnv(1, 21, 5, 40, 0));
+   EXPECT_EQ(cache.envSuppressed(1), 1);
+
+   /**
+    * <b>scenario</b>: Smallest change of temperature or humidity without hysteresis.<br>
+    * <b>expected</b>: States forwarded.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(cache.updateEnv(1, 21, 6, 40, 0));
+   EXPECT_TRUE(cache.updateEnv(1, 21, 6, 40, 1));
+   EXPECT_EQ(cache.envSuppressed(1), 1);
+}
+
+/**
+ * @test Tests of env hysteresis
+ */
+TEST(StateCacheTests, env_hysteresis_tests)
+{
+   StateCache cache;
+   cache.setEnvHysteresis(5, 10);
+   EXPECT_TRUE(cache.updateEnv(2, 21, 5, 40, 0));
+   /**
+    * <b>scenario</b>: Changes smaller than hysteresis received.<br>
+    * <b>expected</b>: States suppressed.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(cache.updateEnv(2, 21, 9, 40, 0));
+   EXPECT_FALSE(cache.updateEnv(2, 21, 1, 40, 9));
+   EXPECT_EQ(cache.envSuppressed(2), 2);
+
+   /**
+    * <b>scenario</b>: Temperature drifts slowly, each step smaller than hysteresis.<br>
+    * <b>expected</b>: State forwarded when difference from last forwarded value reaches hysteresis.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(cache.updateEnv(2, 21, 8, 40, 0));
+   EXPECT_TRUE(cache.updateEnv(2, 22, 0, 40, 0));
+   EXPECT_FALSE(cache.updateEnv(2, 22, 4, 40, 0));
+
+   /**
+    * <b>scenario</b>: Humidity changes by hysteresis.<br>
+    * <b>expected</b>: State forwarded.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(cache.updateEnv(2, 22, 0, 39, 0));
+
+   /**
+    * <b>scenario</b>: Temperature crosses zero.<br>
+    * <b>expected</b>: Fraction part follows the sign, difference calculated correctly.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(cache.updateEnv(3, 0, 2, 50, 0));
+   EXPECT_FALSE(cache.updateEnv(3, 0, 0, 50, 0));
+   EXPECT_TRUE(cache.updateEnv(3, -1, 5, 50, 0));
+   EXPECT_FALSE(cache.updateEnv(3, -1, 1, 50, 0));
+}
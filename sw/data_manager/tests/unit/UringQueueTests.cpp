@@ -0,0 +1,271 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "UringQueue.h"
+#include "logger_mock.hpp"
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <errno.h>
+/* ============================= */
+/**
+ * @file UringQueueTests.cpp
+ *
+ * @brief Unit tests to verify behavior of UringQueue.
+ *
+ * @details Tests are using real io_uring and socket pair, they are skipped when io_uring is not supported.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+/* mock for system functions */
+struct UringCallMock
+{
+   MOCK_METHOD2(io_uring_setup, int(uint32_t, struct io_uring_params*));
+   MOCK_METHOD4(io_uring_register, int(int, uint32_t, void*, uint32_t));
+};
+UringCallMock* uring_call_mock;
+
+/* system calls to replace with mocked on linking stage */
+namespace system_call
+{
+__attribute__((weak)) int io_uring_setup(uint32_t entries, struct io_uring_params* params)
+{
+   return uring_call_mock->io_uring_setup(entries, params);
+}
+__attribute__((weak)) int io_uring_register(int fd, uint32_t opcode, void* arg, uint32_t nr_args)
+{
+   return uring_call_mock->io_uring_register(fd, opcode, arg, nr_args);
+}
+}
+
+struct UringQueueFixture : public testing::Test
+{
+   void SetUp()
+   {
+      mock_logger_init();
+      uring_call_mock = new NiceMock<UringCallMock>;
+      ON_CALL(*uring_call_mock, io_uring_setup(_,_)).WillByDefault(Invoke([](uint32_t entries, struct io_uring_params* params)->int
+            {
+               return syscall(__NR_io_uring_setup, entries, params);
+            }));
+      ON_CALL(*uring_call_mock, io_uring_register(_,_,_,_)).WillByDefault(Invoke([](int fd, uint32_t opcode, void* arg, uint32_t nr_args)->int
+            {
+               return syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+            }));
+      ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, m_sockets), 0);
+   }
+   void TearDown()
+   {
+      close(m_sockets[0]);
+      close(m_sockets[1]);
+      delete uring_call_mock;
+      mock_logger_deinit();
+   }
+   /* waits for single completion */
+   UringCompletion waitCompletion(UringQueue& queue)
+   {
+      UringCompletion result = {};
+      while (queue.reap(&result, 1) == 0)
+      {
+         queue.wait();
+      }
+      return result;
+   }
+   int m_sockets[2];
+};
+
+/**
+ * @test Tests of setting up the ring
+ */
+TEST_F(UringQueueFixture, init_tests)
+{
+   UringQueue queue;
+   /**
+    * <b>scenario</b>: io_uring blocked or not supported by kernel.<br>
+    * <b>expected</b>: Queue not initialized.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*uring_call_mock, io_uring_setup(_,_)).WillOnce(Invoke([](uint32_t, struct io_uring_params*)->int
+         {
+            errno = ENOSYS;
+            return -1;
+         }));
+   EXPECT_FALSE(queue.init(8, 4, 64));
+   EXPECT_FALSE(queue.isActive());
+   EXPECT_EQ(queue.fd(), -1);
+   Mock::VerifyAndClearExpectations(uring_call_mock);
+   if (!queue.init(8, 4, 64))
+   {
+      GTEST_SKIP() << "io_uring not supported";
+   }
+   queue.deinit();
+
+   /**
+    * <b>scenario</b>: Kernel does not support all required operations.<br>
+    * <b>expected</b>: Queue not initialized, ring closed.<br>
+    * ************************************************
+    */
+   EXPECT_CALL(*uring_call_mock, io_uring_register(_, IORING_REGISTER_PROBE, _, _)).WillOnce(Invoke([](int fd, uint32_t opcode, void* arg, uint32_t nr_args)->int
+         {
+            int result = syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+            static_cast<struct io_uring_probe*>(arg)->ops[IORING_OP_SEND_ZC].flags = 0;
+            return result;
+         }));
+   EXPECT_FALSE(queue.init(8, 4, 64));
+   EXPECT_FALSE(queue.isActive());
+   Mock::VerifyAndClearExpectations(uring_call_mock);
+
+   /**
+    * <b>scenario</b>: Buffer count is not a power of 2.<br>
+    * <b>expected</b>: Queue not initialized.<br>
+    * ************************************************
+    */
+   EXPECT_FALSE(queue.init(8, 3, 64));
+   EXPECT_FALSE(queue.isActive());
+
+   /**
+    * <b>scenario</b>: Correct parameters, queue initialized twice.<br>
+    * <b>expected</b>: Queue initialized only once.<br>
+    * ************************************************
+    */
+   EXPECT_TRUE(queue.init(8, 4, 64));
+   EXPECT_TRUE(queue.isActive());
+   EXPECT_GE(queue.fd(), 0);
+   EXPECT_FALSE(queue.init(8, 4, 64));
+   queue.deinit();
+   EXPECT_FALSE(queue.isActive());
+}
+
+/**
+ * @test Tests of multishot receive
+ */
+TEST_F(UringQueueFixture, receive_tests)
+{
+   const uint64_t RECV_ID = 7;
+   const uint32_t BUFFER_COUNT = 4;
+   const uint32_t BUFFER_SIZE = 16;
+   UringQueue queue;
+   if (!queue.init(8, BUFFER_COUNT, BUFFER_SIZE))
+   {
+      GTEST_SKIP() << "io_uring not supported";
+   }
+   ASSERT_TRUE(queue.recvMultishot(m_sockets[0], RECV_ID));
+   ASSERT_TRUE(queue.submit());
+   /**
+    * <b>scenario</b>: Data written by peer.<br>
+    * <b>expected</b>: Data placed in provided buffer, request still active.<br>
+    * ************************************************
+    */
+   ASSERT_EQ(write(m_sockets[1], "hello", 5), 5);
+   UringCompletion completion = waitCompletion(queue);
+   EXPECT_EQ(completion.user_data, RECV_ID);
+   EXPECT_EQ(completion.result, 5);
+   EXPECT_TRUE(completion.hasBuffer());
+   EXPECT_TRUE(completion.hasMore());
+   EXPECT_EQ(std::string((const char*)queue.buffer(completion.bufferId()), 5), "hello");
+   queue.recycle(completion.bufferId());
+
+   /**
+    * <b>scenario</b>: Peer writes more data than all buffers can hold, buffers returned only when request ends.<br>
+    * <b>expected</b>: Request ends with ENOBUFS, rest of data received after submitting the request again.<br>
+    * ************************************************
+    */
+   std::vector<uint8_t> data (BUFFER_COUNT * BUFFER_SIZE * 2);
+   for (size_t i = 0; i < data.size(); i++)
+   {
+      data[i] = i;
+   }
+   ASSERT_EQ(write(m_sockets[1], data.data(), data.size()), (ssize_t)data.size());
+   std::vector<uint8_t> received;
+   std::vector<uint16_t> used_buffers;
+   bool no_buffers = false;
+   while (received.size() < data.size())
+   {
+      completion = waitCompletion(queue);
+      if (completion.hasBuffer())
+      {
+         const uint8_t* buffer = queue.buffer(completion.bufferId());
+         received.insert(received.end(), buffer, buffer + completion.result);
+         used_buffers.push_back(completion.bufferId());
+      }
+      if (!completion.hasMore())
+      {
+         no_buffers |= completion.result == -ENOBUFS;
+         for (uint16_t id : used_buffers)
+         {
+            queue.recycle(id);
+         }
+         used_buffers.clear();
+         ASSERT_TRUE(queue.recvMultishot(m_sockets[0], RECV_ID));
+         ASSERT_TRUE(queue.submit());
+      }
+   }
+   EXPECT_TRUE(no_buffers);
+   EXPECT_EQ(received, data);
+   for (uint16_t id : used_buffers)
+   {
+      queue.recycle(id);
+   }
+
+   /**
+    * <b>scenario</b>: Peer closed the connection.<br>
+    * <b>expected</b>: Request ends with result 0.<br>
+    * ************************************************
+    */
+   shutdown(m_sockets[1], SHUT_WR);
+   completion = waitCompletion(queue);
+   EXPECT_EQ(completion.user_data, RECV_ID);
+   EXPECT_EQ(completion.result, 0);
+   EXPECT_FALSE(completion.hasMore());
+}
+
+/**
+ * @test Tests of sending data
+ */
+TEST_F(UringQueueFixture, send_tests)
+{
+   const uint64_t SEND_ID = 9;
+   UringQueue queue;
+   if (!queue.init(8, 4, 16))
+   {
+      GTEST_SKIP() << "io_uring not supported";
+   }
+   /**
+    * <b>scenario</b>: Message with two buffers sent.<br>
+    * <b>expected</b>: Both buffers written to socket in single request.<br>
+    * ************************************************
+    */
+   char first [] = "abc";
+   char second [] = "de";
+   struct iovec iov [2] = {{first, 3}, {second, 2}};
+   struct msghdr msg = {};
+   msg.msg_iov = iov;
+   msg.msg_iovlen = 2;
+   ASSERT_TRUE(queue.sendmsg(m_sockets[0], &msg, SEND_ID));
+   ASSERT_TRUE(queue.submit());
+   UringCompletion completion = waitCompletion(queue);
+   EXPECT_EQ(completion.user_data, SEND_ID);
+   EXPECT_EQ(completion.result, 5);
+   char buffer [8] = {};
+   EXPECT_EQ(read(m_sockets[1], buffer, sizeof(buffer)), 5);
+   EXPECT_STREQ(buffer, "abcde");
+
+   /**
+    * <b>scenario</b>: More requests queued than submission queue can hold.<br>
+    * <b>expected</b>: Request rejected until queue is submitted.<br>
+    * ************************************************
+    */
+   size_t queued = 0;
+   while (queue.sendmsg(m_sockets[0], &msg, SEND_ID))
+   {
+      queued++;
+   }
+   EXPECT_EQ(queued, 8);
+   EXPECT_TRUE(queue.submit());
+   EXPECT_TRUE(queue.sendmsg(m_sockets[0], &msg, SEND_ID));
+}
@@ -0,0 +1,53 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "WakeupEvent.h"
+#include <thread>
+/* ============================= */
+/**
+ * @file WakeupEventTests.cpp
+ *
+ * @brief Unit tests to verify behavior of WakeupEvent.
+ *
+ * @author Jacek Skowronek
+ * @date 17/10/2026
+ */
+/* ============================= */
+
+using namespace testing;
+
+/**
+ * @test Tests of waking up the thread
+ */
+TEST(WakeupEventTests, wakeup_tests)
+{
+   WakeupEvent event;
+   /**
+    * <b>scenario</b>: Nobody notifies the event.<br>
+    * <b>expected</b>: False returned after timeout.<br>
+    * ************************************************
+    */
+   auto start = std::chrono::steady_clock::now();
+   EXPECT_FALSE(event.waitFor(std::chrono::milliseconds(20)));
+   EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+   /**
+    * <b>scenario</b>: Event notified before waiting.<br>
+    * <b>expected</b>: Notification not lost, it is consumed by first wait.<br>
+    * ************************************************
+    */
+   event.notify();
+   EXPECT_TRUE(event.waitFor(std::chrono::milliseconds(0)));
+   EXPECT_FALSE(event.waitFor(std::chrono::milliseconds(0)));
+
+   /**
+    * <b>scenario</b>: Event notified from other thread during long wait.<br>
+    * <b>expected</b>: Waiting thread woken up immediately.<br>
+    * ************************************************
+    */
+   start = std::chrono::steady_clock::now();
+   std::thread notifier ([&](){ std::this_thread::sleep_for(std::chrono::milliseconds(10)); event.notify(); });
+   EXPECT_TRUE(event.waitFor(std::chrono::seconds(10)));
+   EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+   notifier.join();
+}
@@ -3,10 +3,13 @@
  * =============================*/
 #include <stdlib.h>
 #include <stdarg.h>
-#include <string>
-#include <iostream>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
 #include <vector>
+#include <mutex>
 #include <chrono>
+#include <algorithm>
 /* =============================
  *  Includes of project headers
  * =============================*/
@@ -18,7 +21,8 @@
 /* =============================
  *   Internal module functions
  * =============================*/
-void logger_notify_data();
+void logger_notify_data(size_t size);
+void logger_format(LogGroup group, const char* prefix, const char* fmt, va_list va);
 /* =============================
  *       Internal types
  * =============================*/
@@ -32,6 +36,8 @@ typedef struct LOG_GROUP
  *      Module variables
  * =============================*/
 std::vector<char> m_logger_buffer;
+/* buffer is shared by all threads */
+std::mutex m_logger_mutex;
 LOG_GROUP LOGGER_GROUPS[LOG_ENUM_MAX] = {
       {LOGGER_GROUP_ENABLE, LOG_ERROR,   "ERROR"   },
       {LOGGER_GROUP_ENABLE, LOG_SOCKDRV, "SOCKDRV" },
@@ -69,9 +75,44 @@ uint8_t logger_get_group_state(LogGroup group)
    }
    return result;
 }
-void logger_notify_data()
+void logger_notify_data(size_t size)
 {
-   std::cout << std::string(m_logger_buffer.data());
+   /* written directly to descriptor - no stream buffers or strings are allocated per log */
+   size_t written = 0;
+   while (written < size)
+   {
+      ssize_t result = write(STDOUT_FILENO, m_logger_buffer.data() + written, size - written);
+      if (result <= 0)
+      {
+         break;
+      }
+      written += result;
+   }
+}
+void logger_format(LogGroup group, const char* prefix, const char* fmt, va_list va)
+{
+   std::lock_guard<std::mutex> lock (m_logger_mutex);
+   if (!m_logger_buffer.empty())
+   {
+      const size_t size = m_logger_buffer.size();
+      auto currentTime = std::chrono::system_clock::now();
+      auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime.time_since_epoch()).count() % 1000;
+      std::time_t tt = std::chrono::system_clock::to_time_t ( currentTime );
+      struct tm timeinfo;
+      localtime_r (&tt, &timeinfo);
+      size_t idx = strftime (m_logger_buffer.data(), size, "[%F %H:%M:%S", &timeinfo);
+      idx += snprintf(m_logger_buffer.data() + idx, size - idx, ":%03d] %s - %s - ", (int)millis, LOGGER_GROUPS[group].name, prefix);
+      if (idx < size)
+      {
+         int result = vsnprintf(m_logger_buffer.data() + idx, size - idx, fmt, va);
+         idx += (result > 0)? result : 0;
+      }
+      /* too long log is truncated, there is always place for new line */
+      idx = std::min(idx, size - 2);
+      m_logger_buffer[idx++] = '\n';
+      m_logger_buffer[idx] = 0x00;
+      logger_notify_data(idx);
+   }
 }
 void logger_send(LogGroup group, const char* prefix, const char* fmt, ...)
 {
@@ -80,22 +121,9 @@ void logger_send(LogGroup group, const char* prefix, const char* fmt, ...)
       if (LOGGER_GROUPS[group].state == LOGGER_GROUP_ENABLE)
       {
          va_list va;
-         {
-            auto currentTime = std::chrono::system_clock::now();
-            auto millis = (currentTime.time_since_epoch().count() / 1000000) % 1000;
-            std::time_t tt = std::chrono::system_clock::to_time_t ( currentTime );
-            auto timeinfo = localtime (&tt);
-            int idx = strftime (m_logger_buffer.data(),80,"[%F %H:%M:%S",timeinfo);
-            idx = sprintf(m_logger_buffer.data(), "%s:%03d] %s - %s - ",m_logger_buffer.data(),(int)millis, LOGGER_GROUPS[group].name, prefix);
-            va_start(va, fmt);
-            {
-                idx += vsprintf(m_logger_buffer.data() + idx, fmt, va);
-            }
-            va_end(va);
-            m_logger_buffer[idx++] = '\n';
-            m_logger_buffer[idx] = 0x00;
-            logger_notify_data();
-         }
+         va_start(va, fmt);
+         logger_format(group, prefix, fmt, va);
+         va_end(va);
       }
    }
 }
@@ -106,22 +134,9 @@ void logger_send_if(uint8_t cond_bool, LogGroup group, const char* prefix, const
       if (LOGGER_GROUPS[group].state == LOGGER_GROUP_ENABLE)
       {
          va_list va;
-         {
-            auto currentTime = std::chrono::system_clock::now();
-            auto millis = (currentTime.time_since_epoch().count() / 1000000) % 1000;
-            std::time_t tt = std::chrono::system_clock::to_time_t ( currentTime );
-            auto timeinfo = localtime (&tt);
-            int idx = strftime (m_logger_buffer.data(),80,"[%F %H:%M:%S",timeinfo);
-            idx = sprintf(m_logger_buffer.data(), "%s:%03d] %s - %s - ",m_logger_buffer.data(),(int)millis, LOGGER_GROUPS[group].name, prefix);
-            va_start(va, fmt);
-            {
-               idx = vsprintf(m_logger_buffer.data() + idx, fmt, va);
-            }
-            va_end(va);
-            m_logger_buffer[idx++] = '\n';
-            m_logger_buffer[idx] = 0x00;
-            logger_notify_data();
-         }
+         va_start(va, fmt);
+         logger_format(group, prefix, fmt, va);
+         va_end(va);
       }
    }
 }
@@ -4,6 +4,10 @@
 #include "Logger.h"
 #include "DataProvider.h"
 #include "SocketDriver.h"
+#include "ShmDriver.h"
+#include "DriverSelector.h"
+#include "ReplayDriver.h"
+#include "EventLoop.h"
 
 int main(int argc, char *argv[])
 {
@@ -11,9 +15,54 @@ int main(int argc, char *argv[])
 
    QApplication a(argc, argv);
    MainWindow w;
-   std::unique_ptr<ISocketDriver> sock_driver(new SocketDriver());
-   std::unique_ptr<IDataProvider> data_provider(new DataProvider(w, *sock_driver));
-   data_provider->run("127.0.0.1", 2222, '\n');
+   std::unique_ptr<IEventLoop> event_loop(new EventLoop());
+   event_loop->start();
+#if defined (SOCKDRV_URING)
+   /* io_uring is used when supported by kernel, otherwise regular system calls */
+   const SocketBackend backend = SocketBackend::URING;
+#else
+   /* toolchain headers too old for io_uring backend */
+   const SocketBackend backend = SocketBackend::SYSCALL;
+#endif
+   std::unique_ptr<SocketDriver> sock_driver(new SocketDriver(*event_loop, backend));
+   std::unique_ptr<ISocketDriver> shm_driver(new ShmDriver());
+   std::unique_ptr<ISocketDriver> driver(new DriverSelector(*sock_driver, *shm_driver));
+   /* received stream is recorded to file, so the session can be replayed later */
+   const char* capture_path = getenv("SMARTHOME_CAPTURE");
+   if (capture_path)
+   {
+      sock_driver->startCapture(capture_path);
+   }
+   /* server addresses in order of priority, local transport can be used, e.g. unix:/run/smarthome.sock or shm:/smarthome */
+   std::vector<SocketEndpoint> endpoints;
+   for (int i = 1; i < argc; i++)
+   {
+      endpoints.push_back({argv[i], 2222});
+   }
+   if (endpoints.empty())
+   {
+      endpoints.push_back({"127.0.0.1", 2222});
+   }
+   /* recorded session is replayed instead of connecting to CoreApplication */
+   const char* replay_path = getenv("SMARTHOME_REPLAY");
+   if (replay_path)
+   {
+      driver.reset(new ReplayDriver());
+      endpoints = {{replay_path, 0}};
+   }
+   std::unique_ptr<IDataProvider> data_provider(new DataProvider(w, *driver, *event_loop));
+   /* silent link is reconnected after given time in ms, idle server is pinged to tell it apart from dead one.
+    * Replayed session never answers pings, so it is not supervised. */
+   const char* link_timeout = getenv("SMARTHOME_LINK_TIMEOUT_MS");
+   if (link_timeout && !replay_path)
+   {
+      std::chrono::milliseconds timeout (atoi(link_timeout));
+      if (timeout.count() > 0)
+      {
+         data_provider->setLinkTimeout(timeout, timeout / 3);
+      }
+   }
+   data_provider->run(endpoints, '\n');
    w.setWindowState(Qt::WindowFullScreen);
    w.show();
 
@@ -7,6 +7,8 @@
 #include "IMainWindowWrapper.h"
 #include <vector>
 
+Q_DECLARE_METATYPE(StateUpdateBatch)
+
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
@@ -97,6 +99,7 @@ private:
     void setEnvState (ENV_ITEM_ID id, int8_t temp_h, int8_t temp_l, uint8_t hum_h, uint8_t hum_l);
     void setInputState(INPUT_ID id, INPUT_STATE state);
     void setFanState(FAN_STATE state);
+    void setStateBatch(const StateUpdateBatch& batch);
 
 
 
@@ -105,11 +108,13 @@ signals:
    void requestEnvUpdate(ENV_ITEM_ID id, int8_t temp_h, int8_t temp_l, uint8_t hum_h, uint8_t hum_l);
    void requestInputUpdate(INPUT_ID id, INPUT_STATE state);
    void requestFanUpdate(FAN_STATE state);
+   void requestBatchUpdate(StateUpdateBatch batch);
 
 public slots:
    void updateEnvState(ENV_ITEM_ID id, int8_t temp_h, int8_t temp_l, uint8_t hum_h, uint8_t hum_l);
    void updateInputState(INPUT_ID id, INPUT_STATE state);
    void updateFanState(FAN_STATE state);
+   void updateBatchState(StateUpdateBatch batch);
 
 };
 #endif
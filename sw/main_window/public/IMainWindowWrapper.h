@@ -8,6 +8,7 @@
  *    Interface responsible for control MainWindow GUI.
  * @details
  *    Using this interface it is possible set current temperatures, light states and so on.
+ *    Updates received together shall be passed by setStateBatch(), so GUI handles them in single event.
  *
  * @author Jacek Skowronek
  * @date   07/02/2021
@@ -24,6 +25,7 @@
 #include "env_types.h"
 #include "inputs_types.h"
 #include "fan_types.h"
+#include "StateUpdateBatch.h"
 
 class IMainWindowWrapper
 {
@@ -51,6 +53,12 @@ public:
     * @return True if set successfully, otherwise false.
     */
    virtual void setFanState(FAN_STATE state) = 0;
+   /**
+    * @brief Set states of many items at once.
+    * @param[in] batch - updates to apply, only items marked as set are changed.
+    * @return None.
+    */
+   virtual void setStateBatch(const StateUpdateBatch& batch) = 0;
 
    virtual ~IMainWindowWrapper(){};
 };
@@ -0,0 +1,34 @@
+#ifndef _ITEM_COUNTS_H_
+#define _ITEM_COUNTS_H_
+
+/**
+ * @file ItemCounts.h
+ *
+ * @brief
+ *    Sizes of arrays indexed by item ID, shared by all stores of item states.
+ * @details
+ *    Item IDs start from 1, so element 0 of such arrays is not used. Counts are checked against the ranges
+ *    of ID enums at compile time - when new item is added, build fails until the count is updated.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "env_types.h"
+#include "inputs_types.h"
+/* =============================
+ *           Defines
+ * =============================*/
+/* ENV_OUTSIDE .. ENV_STAIRS */
+#define ENV_ITEMS_COUNT 7
+/* INPUT_WARDROBE_AC .. INPUT_SOCKETS */
+#define INPUT_ITEMS_COUNT 11
+
+static_assert(ENV_OUTSIDE > 0 && ENV_STAIRS == ENV_ITEMS_COUNT - 1, "ENV_ITEMS_COUNT does not match ENV_ITEM_ID range");
+static_assert(INPUT_WARDROBE_AC > 0 && INPUT_SOCKETS == INPUT_ITEMS_COUNT - 1, "INPUT_ITEMS_COUNT does not match INPUT_ID range");
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef _STATE_UPDATE_BATCH_H_
+#define _STATE_UPDATE_BATCH_H_
+
+/**
+ * @file StateUpdateBatch.h
+ *
+ * @brief
+ *    Set of GUI updates passed to IMainWindowWrapper in one call.
+ * @details
+ *    Updates are kept in fixed arrays indexed by item ID, so storing update of already stored item overwrites it
+ *    (latest wins) and the batch never allocates memory - it can be copied into single queued event.
+ *
+ * @author Jacek Skowronek
+ * @date   17/10/2026
+ *
+ */
+
+/* =============================
+ *   Includes of common headers
+ * =============================*/
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+/* =============================
+ *   Includes of project headers
+ * =============================*/
+#include "env_types.h"
+#include "inputs_types.h"
+#include "fan_types.h"
+#include "ItemCounts.h"
+
+struct StateUpdateBatch
+{
+   StateUpdateBatch():
+   temp_h_values(),
+   temp_l_values(),
+   hum_h_values(),
+   hum_l_values(),
+   input_values(),
+   fan_value(FAN_STATE_OFF)
+   {
+      clear();
+   }
+   /**
+    * @brief Stores temperature and humidity update.
+    * @param[in] id - id of the entity.
+    * @param[in] temp_h - decimal part of temperature.
+    * @param[in] temp_l - fraction part of temperature.
+    * @param[in] hum_h - decimal part of humidity.
+    * @param[in] hum_l - fraction part of humidity.
+    * @return True if stored, false if id is out of range.
+    */
+   bool setEnvState(ENV_ITEM_ID id, int8_t temp_h, int8_t temp_l, uint8_t hum_h, uint8_t hum_l)
+   {
+      bool result = false;
+      if ((size_t)id < ENV_ITEMS_COUNT)
+      {
+         updates_count += env_set[id]? 0 : 1;
+         env_set[id] = true;
+         temp_h_values[id] = temp_h;
+         temp_l_values[id] = temp_l;
+         hum_h_values[id] = hum_h;
+         hum_l_values[id] = hum_l;
+         result = true;
+      }
+      return result;
+   }
+   /**
+    * @brief Stores input state update.
+    * @param[in] id - id of the entity.
+    * @param[in] state - state of id.
+    * @return True if stored, false if id is out of range.
+    */
+   bool setInputState(INPUT_ID id, INPUT_STATE state)
+   {
+      bool result = false;
+      if ((size_t)id < INPUT_ITEMS_COUNT)
+      {
+         updates_count += input_set[id]? 0 : 1;
+         input_set[id] = true;
+         input_values[id] = state;
+         result = true;
+      }
+      return result;
+   }
+   /**
+    * @brief Stores fan state update.
+    * @param[in] state - fan state.
+    * @return None.
+    */
+   void setFanState(FAN_STATE state)
+   {
+      updates_count += fan_set? 0 : 1;
+      fan_set = true;
+      fan_value = state;
+   }
+   /**
+    * @brief Passes stored updates to handlers in order of item IDs, so every receiver applies batch the same way.
+    * @param[in] on_env - called as on_env(ENV_ITEM_ID, temp_h, temp_l, hum_h, hum_l) for each env update.
+    * @param[in] on_input - called as on_input(INPUT_ID, INPUT_STATE) for each input update.
+    * @param[in] on_fan - called as on_fan(FAN_STATE) if fan update is stored.
+    * @return None.
+    */
+   template <class EnvHandler, class InputHandler, class FanHandler>
+   void apply(EnvHandler on_env, InputHandler on_input, FanHandler on_fan) const
+   {
+      for (size_t i = 0; i < ENV_ITEMS_COUNT; i++)
+      {
+         if (env_set[i])
+         {
+            on_env((ENV_ITEM_ID)i, temp_h_values[i], temp_l_values[i], hum_h_values[i], hum_l_values[i]);
+         }
+      }
+      for (size_t i = 0; i < INPUT_ITEMS_COUNT; i++)
+      {
+         if (input_set[i])
+         {
+            on_input((INPUT_ID)i, input_values[i]);
+         }
+      }
+      if (fan_set)
+      {
+         on_fan(fan_value);
+      }
+   }
+   /**
+    * @brief Checks if there is any update stored.
+    * @return True if batch is empty.
+    */
+   bool empty() const
+   {
+      return updates_count == 0;
+   }
+   /**
+    * @brief Removes all updates.
+    * @return None.
+    */
+   void clear()
+   {
+      memset(env_set, 0, sizeof(env_set));
+      memset(input_set, 0, sizeof(input_set));
+      fan_set = false;
+      updates_count = 0;
+   }
+
+   bool env_set [ENV_ITEMS_COUNT];
+   int8_t temp_h_values [ENV_ITEMS_COUNT];
+   int8_t temp_l_values [ENV_ITEMS_COUNT];
+   uint8_t hum_h_values [ENV_ITEMS_COUNT];
+   uint8_t hum_l_values [ENV_ITEMS_COUNT];
+   bool input_set [INPUT_ITEMS_COUNT];
+   INPUT_STATE input_values [INPUT_ITEMS_COUNT];
+   bool fan_set;
+   FAN_STATE fan_value;
+   /* number of distinct items, overwritten updates are not counted */
+   size_t updates_count;
+};
+
+#endif
@@ -7,6 +7,7 @@ MainWindow::MainWindow(QWidget *parent)
     , ui(new Ui::MainWindow)
 {
     ui->setupUi(this);
+    qRegisterMetaType<StateUpdateBatch>("StateUpdateBatch");
 
     QObject::connect(this, SIGNAL(requestEnvUpdate(ENV_ITEM_ID, int8_t, int8_t, uint8_t, uint8_t)),
                      this, SLOT(updateEnvState(ENV_ITEM_ID, int8_t, int8_t, uint8_t, uint8_t)));
@@ -14,6 +15,8 @@ MainWindow::MainWindow(QWidget *parent)
                      this, SLOT(updateInputState(INPUT_ID, INPUT_STATE)));
     QObject::connect(this, SIGNAL(requestFanUpdate(FAN_STATE)),
                      this, SLOT(updateFanState(FAN_STATE)));
+    QObject::connect(this, SIGNAL(requestBatchUpdate(StateUpdateBatch)),
+                     this, SLOT(updateBatchState(StateUpdateBatch)));
 
     m_env_objects.push_back(EnvObject(ENV_BATHROOM, ui->sum_bath_temp, ui->sum_bath_hum));
     m_env_objects.push_back(EnvObject(ENV_BEDROOM, ui->sum_bed_temp, ui->sum_bed_hum));
@@ -64,6 +67,11 @@ void MainWindow::setFanState(FAN_STATE state)
 {
    emit requestFanUpdate(state);
 }
+void MainWindow::setStateBatch(const StateUpdateBatch& batch)
+{
+   /* whole batch is copied into single queued event */
+   emit requestBatchUpdate(batch);
+}
 void MainWindow::updateEnvState(ENV_ITEM_ID id, int8_t temp_h, int8_t temp_l, uint8_t hum_h, uint8_t hum_l)
 {
    auto it = std::find_if(m_env_objects.begin(), m_env_objects.end(), [&](EnvObject& obj){ return obj.m_id == id;});
@@ -99,6 +107,12 @@ void MainWindow::updateFanState(FAN_STATE state)
       ui->sum_bath_fan->setStyleSheet(Icons::FAN_OFF);
    }
 }
+void MainWindow::updateBatchState(StateUpdateBatch batch)
+{
+   batch.apply([this](ENV_ITEM_ID id, int8_t temp_h, int8_t temp_l, uint8_t hum_h, uint8_t hum_l){ updateEnvState(id, temp_h, temp_l, hum_h, hum_l); },
+               [this](INPUT_ID id, INPUT_STATE state){ updateInputState(id, state); },
+               [this](FAN_STATE state){ updateFanState(state); });
+}
 MainWindow::~MainWindow()
 {
     delete ui;
@@ -8,9 +8,22 @@
 class MainWindowWrapperMock : public IMainWindowWrapper
 {
 public:
+   MainWindowWrapperMock()
+   {
+      /* batch is passed to single item methods by default, so expectations can be set per item */
+      ON_CALL(*this, setStateBatch(testing::_)).WillByDefault(testing::Invoke(this, &MainWindowWrapperMock::forwardBatch));
+   }
    MOCK_METHOD5(setEnvState, void(ENV_ITEM_ID, int8_t, int8_t, uint8_t, uint8_t));
    MOCK_METHOD2(setInputState, void(INPUT_ID, INPUT_STATE));
    MOCK_METHOD1(setFanState, void(FAN_STATE));
+   MOCK_METHOD1(setStateBatch, void(const StateUpdateBatch&));
+
+   void forwardBatch(const StateUpdateBatch& batch)
+   {
+      batch.apply([this](ENV_ITEM_ID id, int8_t temp_h, int8_t temp_l, uint8_t hum_h, uint8_t hum_l){ setEnvState(id, temp_h, temp_l, hum_h, hum_l); },
+                  [this](INPUT_ID id, INPUT_STATE state){ setInputState(id, state); },
+                  [this](FAN_STATE state){ setFanState(state); });
+   }
 
 };
 
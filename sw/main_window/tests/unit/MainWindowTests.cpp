@@ -5,6 +5,7 @@
 #include "main_window.h"
 #include "../../../gui/ui_main_window.h"
 #include "logger_mock.hpp"
+#include <thread>
 /* ============================= */
 /**
  * @file MainWindowTests.cpp
@@ -110,3 +111,52 @@ TEST_F(MainWindowFixture, set_fan_state_tests)
    m_test_subject->setFanState(FAN_STATE_SUSPEND);
    EXPECT_STREQ(m_test_subject->ui->sum_bath_fan->styleSheet().toUtf8(), Icons::FAN_OFF.toUtf8());
 }
+
+TEST_F(MainWindowFixture, set_state_batch_tests)
+{
+   /**
+    * <b>scenario</b>: Batch with env, input and fan states set, BATHROOM_AC input set twice.<br>
+    * <b>expected</b>: All items presented on GUI updated, last state of BATHROOM_AC used.<br>
+    * ************************************************
+    */
+   StateUpdateBatch batch;
+   batch.setEnvState(ENV_BATHROOM, 21, 3, 50, 1);
+   batch.setInputState(INPUT_BATHROOM_AC, INPUT_STATE_ACTIVE);
+   batch.setInputState(INPUT_BATHROOM_LED, INPUT_STATE_ACTIVE);
+   batch.setInputState(INPUT_BATHROOM_AC, INPUT_STATE_INACTIVE);
+   batch.setFanState(FAN_STATE_ON);
+   EXPECT_EQ(batch.updates_count, 4);
+
+   m_test_subject->setStateBatch(batch);
+
+   EXPECT_THAT(m_test_subject->ui->sum_bath_temp->text().toUtf8(), HasSubstr("21.3"));
+   EXPECT_THAT(m_test_subject->ui->sum_bath_hum->text().toUtf8(), HasSubstr("50.1"));
+   EXPECT_STREQ(m_test_subject->ui->sum_bath_light->styleSheet().toUtf8(), Icons::LIGHT_OFF.toUtf8());
+   EXPECT_STREQ(m_test_subject->ui->sum_bath_led->styleSheet().toUtf8(), Icons::LED_ON.toUtf8());
+   EXPECT_STREQ(m_test_subject->ui->sum_bath_fan->styleSheet().toUtf8(), Icons::FAN_ON.toUtf8());
+
+   /**
+    * <b>scenario</b>: Empty batch.<br>
+    * <b>expected</b>: GUI not changed.<br>
+    * ************************************************
+    */
+   batch.clear();
+   EXPECT_TRUE(batch.empty());
+   m_test_subject->setStateBatch(batch);
+   EXPECT_STREQ(m_test_subject->ui->sum_bath_led->styleSheet().toUtf8(), Icons::LED_ON.toUtf8());
+   EXPECT_STREQ(m_test_subject->ui->sum_bath_fan->styleSheet().toUtf8(), Icons::FAN_ON.toUtf8());
+
+   /**
+    * <b>scenario</b>: Batch passed from other thread (as from DataProvider), then cleared by the caller.<br>
+    * <b>expected</b>: Batch copied into queued event, GUI updated when event is processed by GUI thread.<br>
+    * ************************************************
+    */
+   batch.setInputState(INPUT_BATHROOM_LED, INPUT_STATE_INACTIVE);
+   batch.setFanState(FAN_STATE_OFF);
+   std::thread([&](){ m_test_subject->setStateBatch(batch); }).join();
+   batch.clear();
+   EXPECT_STREQ(m_test_subject->ui->sum_bath_led->styleSheet().toUtf8(), Icons::LED_ON.toUtf8());
+   QCoreApplication::processEvents();
+   EXPECT_STREQ(m_test_subject->ui->sum_bath_led->styleSheet().toUtf8(), Icons::LED_OFF.toUtf8());
+   EXPECT_STREQ(m_test_subject->ui->sum_bath_fan->styleSheet().toUtf8(), Icons::FAN_OFF.toUtf8());
+}